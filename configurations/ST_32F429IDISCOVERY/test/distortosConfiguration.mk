@@ -463,6 +463,7 @@ CONFIG_ARCHITECTURE_FLAGS="-mcpu=cortex-m4 -mthumb -mfloat-abi=hard -mfpu=fpv4-s
 # ARMv7-M architecture options
 #
 CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI=0
+CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER=y
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M3 is not set
 CONFIG_ARCHITECTURE_ARM_CORTEX_M4=y
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M4_R0P0 is not set
@@ -487,6 +488,15 @@ CONFIG_TICK_FREQUENCY=1000
 CONFIG_ROUND_ROBIN_FREQUENCY=10
 CONFIG_SIGNALS_ENABLE=y
 CONFIG_THREAD_DETACH_ENABLE=y
+CONFIG_BOUND_FUNCTION_STORAGE_SIZE=32
+CONFIG_MUTEX_STATISTICS_ENABLE=y
+CONFIG_QUEUE_STATISTICS_ENABLE=y
+CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE=y
+CONFIG_INTERRUPT_MASKING_STATISTICS_LONGEST_SECTIONS=4
+CONFIG_TLSF_HEAP_ENABLE=y
+CONFIG_HEAP_TRACE_ENABLE=y
+CONFIG_HEAP_TRACE_ENTRIES=64
+CONFIG_HEAP_ARENAS_ENABLE=y
 
 #
 # main() thread options
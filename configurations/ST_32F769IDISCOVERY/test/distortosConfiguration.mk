@@ -368,6 +368,7 @@ CONFIG_ARCHITECTURE_FLAGS="-mcpu=cortex-m7 -mthumb -mfloat-abi=hard -mfpu=fpv5-d
 # ARMv7-M architecture options
 #
 CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI=0
+CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER=y
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M3 is not set
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M4 is not set
 CONFIG_ARCHITECTURE_ARM_CORTEX_M7=y
@@ -395,6 +396,7 @@ CONFIG_TICK_FREQUENCY=1000
 CONFIG_ROUND_ROBIN_FREQUENCY=10
 CONFIG_SIGNALS_ENABLE=y
 CONFIG_THREAD_DETACH_ENABLE=y
+CONFIG_BOUND_FUNCTION_STORAGE_SIZE=32
 
 #
 # main() thread options
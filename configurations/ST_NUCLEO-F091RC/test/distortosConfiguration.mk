@@ -325,6 +325,7 @@ CONFIG_TICK_FREQUENCY=1000
 CONFIG_ROUND_ROBIN_FREQUENCY=10
 CONFIG_SIGNALS_ENABLE=y
 CONFIG_THREAD_DETACH_ENABLE=y
+CONFIG_BOUND_FUNCTION_STORAGE_SIZE=32
 
 #
 # main() thread options
@@ -464,6 +464,7 @@ CONFIG_ARCHITECTURE_FLAGS="-mcpu=cortex-m4 -mthumb -mfloat-abi=hard -mfpu=fpv4-s
 # ARMv7-M architecture options
 #
 CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI=0
+CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER=y
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M3 is not set
 CONFIG_ARCHITECTURE_ARM_CORTEX_M4=y
 # CONFIG_ARCHITECTURE_ARM_CORTEX_M4_R0P0 is not set
@@ -488,6 +489,7 @@ CONFIG_TICK_FREQUENCY=1000
 CONFIG_ROUND_ROBIN_FREQUENCY=10
 CONFIG_SIGNALS_ENABLE=y
 CONFIG_THREAD_DETACH_ENABLE=y
+CONFIG_BOUND_FUNCTION_STORAGE_SIZE=32
 
 #
 # main() thread options
@@ -0,0 +1,235 @@
+/**
+ * \file
+ * \brief Barrier class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_BARRIER_HPP_
+#define INCLUDE_DISTORTOS_BARRIER_HPP_
+
+#include "distortos/internal/scheduler/ThreadList.hpp"
+
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief Barrier is a cyclic synchronization primitive which blocks a group of threads until all of them arrive
+ *
+ * Similar to POSIX barriers - http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_barrier_wait.html#
+ *
+ * Each call to wait() (or its timed variants) is an arrival. When the number of arrivals reaches the count given during
+ * construction, the phase is completed - optional completion function is executed in the context of the last arriving
+ * thread, then all blocked threads are released in a single critical section and the barrier is reset for the next
+ * phase. Released threads don't have to re-acquire any lock, so they are just made runnable in priority order.
+ *
+ * \ingroup synchronization
+ */
+
+class Barrier
+{
+public:
+
+	/// type of completion function executed once per phase, it receives the argument given during construction
+	using CompletionFunction = void(void*);
+
+	/// type used for number of threads
+	using Value = unsigned int;
+
+	/**
+	 * \brief Barrier's constructor
+	 *
+	 * Similar to pthread_barrier_init() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_barrier_init.html#
+	 *
+	 * \param [in] count is the number of threads that must arrive at the barrier to complete the phase, if this value
+	 * is 0, it will be changed to 1
+	 * \param [in] completionFunction is a pointer to function executed in the context of the last arriving thread
+	 * before the other threads are released, nullptr to skip this step, default - nullptr
+	 * \param [in] completionArgument is the argument passed to \a completionFunction, default - nullptr
+	 */
+
+	constexpr explicit Barrier(const Value count, CompletionFunction* const completionFunction = {},
+			void* const completionArgument = {}) :
+					blockedList_{},
+					completionFunction_{completionFunction},
+					completionArgument_{completionArgument},
+					arrived_{},
+					count_{count != 0 ? count : 1},
+					phase_{}
+	{
+
+	}
+
+	/**
+	 * \brief Barrier's destructor
+	 *
+	 * Similar to pthread_barrier_destroy() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_barrier_destroy.html#
+	 *
+	 * It is safe to destroy a barrier upon which no threads are currently blocked. The effect of destroying a barrier
+	 * upon which other threads are currently blocked is system error.
+	 */
+
+	~Barrier() = default;
+
+	/**
+	 * \return number of threads that must arrive at the barrier to complete the phase
+	 */
+
+	Value getCount() const
+	{
+		return count_;
+	}
+
+	/**
+	 * \brief Tries to wait at the barrier for given duration of time.
+	 *
+	 * If the calling thread is not the last one to arrive, it shall block until the phase is completed as in wait()
+	 * function. If the phase is not completed before the specified timeout expires, the arrival of the calling thread
+	 * is withdrawn, so the remaining threads still need \a count arrivals to complete the phase.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the phase was not completed before the specified timeout expired;
+	 */
+
+	int tryWaitFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to wait at the barrier for given duration of time.
+	 *
+	 * Template variant of tryWaitFor(TickClock::duration duration).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the phase was not completed before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryWaitFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryWaitFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to wait at the barrier until given time point.
+	 *
+	 * If the calling thread is not the last one to arrive, it shall block until the phase is completed as in wait()
+	 * function. If the phase is not completed before the specified timeout expires, the arrival of the calling thread
+	 * is withdrawn, so the remaining threads still need \a count arrivals to complete the phase.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the phase was not completed before the specified timeout expired;
+	 */
+
+	int tryWaitUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to wait at the barrier until given time point.
+	 *
+	 * Template variant of tryWaitUntil(TickClock::time_point timePoint).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the phase was not completed before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryWaitUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryWaitUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Waits at the barrier.
+	 *
+	 * Similar to pthread_barrier_wait() -
+	 * http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_barrier_wait.html#
+	 *
+	 * If the calling thread is not the last one to arrive, it shall not return from the call until the phase is
+	 * completed or the call is interrupted by a signal - in the latter case the arrival of the calling thread is
+	 * withdrawn. The last arriving thread executes the completion function (if any), releases all blocked threads and
+	 * returns immediately.
+	 *
+	 * If the wait of a thread is terminated while the last arriving thread is already executing the completion
+	 * function, the phase cannot be cancelled anymore - such thread waits for the release and returns successfully.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	int wait();
+
+	Barrier(const Barrier&) = delete;
+	Barrier(Barrier&&) = default;
+	const Barrier& operator=(const Barrier&) = delete;
+	Barrier& operator=(Barrier&&) = delete;
+
+private:
+
+	/**
+	 * \brief Implementation of wait(), tryWaitFor() and tryWaitUntil().
+	 *
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, nullptr to block without
+	 * timeout
+	 *
+	 * \return 0 if the phase was completed, error code otherwise:
+	 * - error codes returned by internal::Scheduler::block() (for blocking without timeout) /
+	 * internal::Scheduler::blockUntil() (for blocking with timeout);
+	 */
+
+	int waitImplementation(const TickClock::time_point* timePoint);
+
+	/// ThreadControlBlock objects blocked on this barrier
+	internal::ThreadList blockedList_;
+
+	/// pointer to function executed in the context of the last arriving thread, nullptr if not used
+	CompletionFunction* completionFunction_;
+
+	/// argument passed to completionFunction_
+	void* completionArgument_;
+
+	/// number of threads that arrived in current phase, equal to count_ while the phase is being completed
+	Value arrived_;
+
+	/// number of threads that must arrive at the barrier to complete the phase
+	Value count_;
+
+	/// generation counter, incremented each time a phase is completed
+	Value phase_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_BARRIER_HPP_
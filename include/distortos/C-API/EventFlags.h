@@ -0,0 +1,299 @@
+/**
+ * \file
+ * \brief Header of C-API for distortos::EventFlags
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_C_API_EVENTFLAGS_H_
+#define INCLUDE_DISTORTOS_C_API_EVENTFLAGS_H_
+
+#include "estd/C-API/IntrusiveList.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	/* def __cplusplus */
+
+/**
+ * \addtogroup eventFlagsCApi
+ * \{
+ */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags
+ *
+ * \sa distortos::EventFlags
+ */
+
+struct distortos_EventFlags
+{
+	/** list of threads waiting for this object */
+	struct estd_IntrusiveList waitersList;
+
+	/** current value of event flags */
+	uint32_t value;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+enum
+{
+	/** wait for any of the flags from the bitmask */
+	distortos_EventFlags_WaitMode_any,
+	/** wait for all of the flags from the bitmask */
+	distortos_EventFlags_WaitMode_all
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Initializer for distortos_EventFlags
+ *
+ * \sa distortos::EventFlags::EventFlags()
+ *
+ * \param [in] self is an equivalent of `this` hidden argument
+ * \param [in] value is the initial value of event flags
+ */
+
+#define DISTORTOS_EVENTFLAGS_INITIALIZER(self, value)	{ESTD_INTRUSIVELIST_INITIALIZER((self).waitersList), (value)}
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags's constructor
+ *
+ * \sa distortos::EventFlags::EventFlags()
+ *
+ * \param [in] name is the name of the object that will be instantiated
+ * \param [in] value is the initial value of event flags
+ */
+
+#define DISTORTOS_EVENTFLAGS_CONSTRUCT_1(name, value) \
+		struct distortos_EventFlags name = DISTORTOS_EVENTFLAGS_INITIALIZER(name, value)
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags's constructor, value == 0
+ *
+ * \sa distortos::EventFlags::EventFlags()
+ *
+ * \param [in] name is the name of the object that will be instantiated
+ */
+
+#define DISTORTOS_EVENTFLAGS_CONSTRUCT(name)	DISTORTOS_EVENTFLAGS_CONSTRUCT_1(name, 0)
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags's constructor
+ *
+ * \sa distortos::EventFlags::EventFlags()
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] value is the initial value of event flags
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags is invalid;
+ */
+
+int distortos_EventFlags_construct_1(struct distortos_EventFlags* eventFlags, uint32_t value);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags's constructor, value == 0
+ *
+ * \sa distortos::EventFlags::EventFlags()
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags is invalid;
+ */
+
+static inline int distortos_EventFlags_construct(struct distortos_EventFlags* const eventFlags)
+{
+	return distortos_EventFlags_construct_1(eventFlags, 0);
+}
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags's destructor
+ *
+ * \sa distortos::EventFlags::~EventFlags()
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags is invalid;
+ */
+
+int distortos_EventFlags_destruct(struct distortos_EventFlags* eventFlags);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::clear()
+ *
+ * \sa distortos::EventFlags::clear()
+ *
+ * \note This function can be used from interrupt context.
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be cleared
+ * \param [out] previousValue is a pointer to variable into which value of event flags before clearing will be
+ * written, NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags is invalid;
+ */
+
+int distortos_EventFlags_clear(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint32_t* previousValue);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::get()
+ *
+ * \sa distortos::EventFlags::get()
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [out] value is a pointer to variable into which current value of event flags will be written
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags and/or \a value are invalid;
+ */
+
+int distortos_EventFlags_get(const struct distortos_EventFlags* eventFlags, uint32_t* value);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::set()
+ *
+ * \sa distortos::EventFlags::set()
+ *
+ * \note This function can be used from interrupt context.
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be set
+ * \param [out] previousValue is a pointer to variable into which value of event flags before setting will be written,
+ * NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a eventFlags is invalid;
+ */
+
+int distortos_EventFlags_set(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint32_t* previousValue);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::tryWait()
+ *
+ * \sa distortos::EventFlags::tryWait()
+ *
+ * \note This function can be used from interrupt context.
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be waited for
+ * \param [in] mode is the mode of waiting - distortos_EventFlags_WaitMode_any or distortos_EventFlags_WaitMode_all
+ * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+ * or not (false)
+ * \param [out] value is a pointer to variable into which value of event flags will be written - which satisfied the
+ * wait (before clearing) on success, current one otherwise; NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EAGAIN - the wait condition is not satisfied;
+ * - EINVAL - \a eventFlags and/or \a mode are invalid, \a bitmask is 0;
+ */
+
+int distortos_EventFlags_tryWait(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint8_t mode,
+		bool clearOnExit, uint32_t* value);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::tryWaitFor()
+ *
+ * \sa distortos::EventFlags::tryWaitFor()
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be waited for
+ * \param [in] mode is the mode of waiting - distortos_EventFlags_WaitMode_any or distortos_EventFlags_WaitMode_all
+ * \param [in] duration is the duration in system ticks after which the wait will be terminated
+ * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+ * or not (false)
+ * \param [out] value is a pointer to variable into which value of event flags will be written - which satisfied the
+ * wait (before clearing) on success, current one otherwise; NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a eventFlags and/or \a mode are invalid, \a bitmask is 0;
+ * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+ */
+
+int distortos_EventFlags_tryWaitFor(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint8_t mode,
+		int64_t duration, bool clearOnExit, uint32_t* value);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::tryWaitUntil()
+ *
+ * \sa distortos::EventFlags::tryWaitUntil()
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be waited for
+ * \param [in] mode is the mode of waiting - distortos_EventFlags_WaitMode_any or distortos_EventFlags_WaitMode_all
+ * \param [in] timePoint is the time point in system ticks at which the wait will be terminated
+ * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+ * or not (false)
+ * \param [out] value is a pointer to variable into which value of event flags will be written - which satisfied the
+ * wait (before clearing) on success, current one otherwise; NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a eventFlags and/or \a mode are invalid, \a bitmask is 0;
+ * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+ */
+
+int distortos_EventFlags_tryWaitUntil(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint8_t mode,
+		int64_t timePoint, bool clearOnExit, uint32_t* value);
+
+/**
+ * \brief C-API equivalent of distortos::EventFlags::wait()
+ *
+ * \sa distortos::EventFlags::wait()
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] eventFlags is a pointer to distortos_EventFlags object
+ * \param [in] bitmask is the bitmask of flags that will be waited for
+ * \param [in] mode is the mode of waiting - distortos_EventFlags_WaitMode_any or distortos_EventFlags_WaitMode_all
+ * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+ * or not (false)
+ * \param [out] value is a pointer to variable into which value of event flags will be written - which satisfied the
+ * wait (before clearing) on success, current one otherwise; NULL to ignore
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a eventFlags and/or \a mode are invalid, \a bitmask is 0;
+ */
+
+int distortos_EventFlags_wait(struct distortos_EventFlags* eventFlags, uint32_t bitmask, uint8_t mode,
+		bool clearOnExit, uint32_t* value);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}	/* extern "C" */
+#endif	/* def __cplusplus */
+
+#endif	/* INCLUDE_DISTORTOS_C_API_EVENTFLAGS_H_ */
@@ -12,6 +12,8 @@
 #ifndef INCLUDE_DISTORTOS_C_API_MUTEX_H_
 #define INCLUDE_DISTORTOS_C_API_MUTEX_H_
 
+#include "distortos/distortosConfiguration.h"
+
 #include "estd/C-API/IntrusiveList.h"
 
 #include <stdint.h>
@@ -59,6 +61,13 @@ struct distortos_Mutex
 
 	/** type of mutex and its protocol */
 	uint8_t typeProtocol;
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	/** pointer to MutexStatistics object associated with the mutex, NULL if the mutex is not instrumented */
+	void* statistics;
+
+#endif	/* CONFIG_MUTEX_STATISTICS_ENABLE == 1 */
 };
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -101,6 +110,18 @@ enum
 | global defines
 +---------------------------------------------------------------------------------------------------------------------*/
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+/** \brief Initializer of distortos_Mutex::statistics, including preceding comma */
+#define DISTORTOS_MUTEX_STATISTICS_INITIALIZER	, NULL
+
+#else	/* CONFIG_MUTEX_STATISTICS_ENABLE != 1 */
+
+/** \brief Initializer of distortos_Mutex::statistics - empty, as this member is not present */
+#define DISTORTOS_MUTEX_STATISTICS_INITIALIZER
+
+#endif	/* CONFIG_MUTEX_STATISTICS_ENABLE != 1 */
+
 /**
  * \brief Initializer for distortos_Mutex
  *
@@ -123,7 +144,8 @@ enum
 				(uint8_t)(type) : (uint8_t)distortos_Mutex_Type_normal) << distortos_Mutex_typeShift | \
 		((protocol) == distortos_Mutex_Protocol_none || (protocol) == distortos_Mutex_Protocol_priorityInheritance || \
 				(protocol) == distortos_Mutex_Protocol_priorityProtect ? \
-				(uint8_t)(protocol) : (uint8_t)distortos_Mutex_Protocol_none) << distortos_Mutex_protocolShift)}
+				(uint8_t)(protocol) : (uint8_t)distortos_Mutex_Protocol_none) << distortos_Mutex_protocolShift) \
+		DISTORTOS_MUTEX_STATISTICS_INITIALIZER}
 
 /**
  * \brief C-API equivalent of distortos::Mutex's constructor
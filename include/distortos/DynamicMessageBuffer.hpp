@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief DynamicMessageBuffer class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DYNAMICMESSAGEBUFFER_HPP_
+#define INCLUDE_DISTORTOS_DYNAMICMESSAGEBUFFER_HPP_
+
+#include "distortos/MessageBuffer.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief DynamicMessageBuffer class is a variant of MessageBuffer that has dynamic storage for messages.
+ *
+ * \ingroup queues
+ */
+
+class DynamicMessageBuffer : public MessageBuffer
+{
+public:
+
+	/**
+	 * \brief DynamicMessageBuffer's constructor
+	 *
+	 * \param [in] size is the size of storage, bytes
+	 */
+
+	explicit DynamicMessageBuffer(size_t size);
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DYNAMICMESSAGEBUFFER_HPP_
@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief DynamicSharedMutex class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DYNAMICSHAREDMUTEX_HPP_
+#define INCLUDE_DISTORTOS_DYNAMICSHAREDMUTEX_HPP_
+
+#include "SharedMutex.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief DynamicSharedMutex class is a variant of SharedMutex that has dynamic storage for threads with shared
+ * ownership.
+ *
+ * \ingroup synchronization
+ */
+
+class DynamicSharedMutex : public SharedMutex
+{
+public:
+
+	/**
+	 * \brief DynamicSharedMutex's constructor
+	 *
+	 * \param [in] maxReaders is the maximum number of threads that can have shared ownership at the same time
+	 * \param [in] policy is the policy of granting ownership, default - Policy::writerPreference
+	 * \param [in] protocol is the shared mutex protocol, default - Protocol::none
+	 */
+
+	explicit DynamicSharedMutex(size_t maxReaders, Policy policy = Policy::writerPreference,
+			Protocol protocol = Protocol::none);
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DYNAMICSHAREDMUTEX_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief DynamicSoftwareTimer class header
  *
- * \author Copyright (C) 2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2017-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,6 +14,8 @@
 
 #include "distortos/SoftwareTimerCommon.hpp"
 
+#include "estd/InplaceFunction.hpp"
+
 #include <functional>
 
 namespace distortos
@@ -23,8 +25,11 @@ namespace distortos
 /// \{
 
 /**
- * \brief DynamicSoftwareTimer class is a type-erased interface for software timer that has dynamic storage for bound
- * function.
+ * \brief DynamicSoftwareTimer class is a type-erased interface for software timer that stores bound function in the
+ * object.
+ *
+ * Bound function (with its arguments) is stored in estd::InplaceFunction with CONFIG_BOUND_FUNCTION_STORAGE_SIZE bytes
+ * of storage, so no dynamic allocation takes place. If the bound function doesn't fit, compilation fails.
  */
 
 class DynamicSoftwareTimer : public SoftwareTimerCommon
@@ -55,7 +60,7 @@ private:
 	void run() override;
 
 	/// bound function object
-	std::function<void()> boundFunction_;
+	estd::InplaceFunction<void(), CONFIG_BOUND_FUNCTION_STORAGE_SIZE> boundFunction_;
 };
 
 /**
@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief DynamicStreamBuffer class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DYNAMICSTREAMBUFFER_HPP_
+#define INCLUDE_DISTORTOS_DYNAMICSTREAMBUFFER_HPP_
+
+#include "distortos/StreamBuffer.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief DynamicStreamBuffer class is a variant of StreamBuffer that has dynamic storage for data.
+ *
+ * \ingroup queues
+ */
+
+class DynamicStreamBuffer : public StreamBuffer
+{
+public:
+
+	/**
+	 * \brief DynamicStreamBuffer's constructor
+	 *
+	 * \param [in] size is the size of storage, bytes
+	 * \param [in] triggerLevel is the number of bytes which must be available in the buffer to unblock the reader,
+	 * values outside of [1; size] range are clamped to this range, default - 1
+	 */
+
+	explicit DynamicStreamBuffer(size_t size, size_t triggerLevel = 1);
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DYNAMICSTREAMBUFFER_HPP_
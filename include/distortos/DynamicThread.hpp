@@ -2,7 +2,7 @@
  * \file
  * \brief DynamicThread class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -68,13 +68,7 @@ public:
 	 */
 
 	template<typename Function, typename... Args>
-	DynamicThread(const DynamicThreadParameters parameters, Function&& function, Args&&... args) :
-			DynamicThread{parameters.stackSize, parameters.canReceiveSignals, parameters.queuedSignals,
-					parameters.signalActions, parameters.priority, parameters.schedulingPolicy,
-					std::forward<Function>(function), std::forward<Args>(args)...}
-	{
-
-	}
+	DynamicThread(DynamicThreadParameters parameters, Function&& function, Args&&... args);
 
 	/**
 	 * \brief DynamicThread's destructor
@@ -160,6 +154,19 @@ public:
 
 	uint8_t getPriority() const override;
 
+	/**
+	 * \return length of round-robin quantum of the thread
+	 */
+
+	TickClock::duration getRoundRobinQuantum() const override;
+
+	/**
+	 * \return number of times the thread was moved to the end of the group of threads with the same priority because
+	 * its round-robin quantum was used
+	 */
+
+	uint64_t getRoundRobinRotationCount() const override;
+
 	/**
 	 * \return scheduling policy of the thread
 	 */
@@ -241,6 +248,23 @@ public:
 
 	void setPriority(uint8_t priority, bool alwaysBehind = {}) override;
 
+	/**
+	 * \brief Changes length of round-robin quantum of the thread.
+	 *
+	 * New length is used when the quantum is reloaded - after the thread is rotated or when its scheduling policy is
+	 * changed. If current value of quantum is greater than new length, it is truncated. Threads which use
+	 * SchedulingPolicy::fifo are not affected. To get different quantum for each priority level, set the same length
+	 * for all threads with given priority.
+	 *
+	 * \param [in] quantum is the new length of round-robin quantum of the thread, [1 tick; 255 ticks]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - internal thread object was detached;
+	 * - error codes returned by internal::DynamicThreadBase::setRoundRobinQuantum();
+	 */
+
+	int setRoundRobinQuantum(TickClock::duration quantum) override;
+
 	/**
 	 * param [in] schedulingPolicy is the new scheduling policy of the thread
 	 */
@@ -403,6 +427,14 @@ DynamicThread::DynamicThread(const size_t stackSize, const bool canReceiveSignal
 
 }
 
+template<typename Function, typename... Args>
+DynamicThread::DynamicThread(const DynamicThreadParameters parameters, Function&& function, Args&&... args) :
+		detachableThread_{new internal::DynamicThreadBase{parameters, *this, std::forward<Function>(function),
+				std::forward<Args>(args)...}}
+{
+
+}
+
 #endif	// def CONFIG_THREAD_DETACH_ENABLE
 
 }	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief DynamicThreadParameters class header
  *
- * \author Copyright (C) 2015-2016 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -12,6 +12,7 @@
 #ifndef INCLUDE_DISTORTOS_DYNAMICTHREADPARAMETERS_HPP_
 #define INCLUDE_DISTORTOS_DYNAMICTHREADPARAMETERS_HPP_
 
+#include "distortos/distortosConfiguration.h"
 #include "distortos/SchedulingPolicy.hpp"
 
 #include <cstddef>
@@ -19,6 +20,12 @@
 namespace distortos
 {
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+class HeapArena;
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 /**
  * \brief DynamicThreadParameters struct is a helper with parameters for DynamicThread's constructor
  *
@@ -48,6 +55,9 @@ struct DynamicThreadParameters
 	constexpr DynamicThreadParameters(const size_t stackSizee, const bool canReceiveSignalss,
 			const size_t queuedSignalss, const size_t signalActionss, const uint8_t priorityy,
 			const SchedulingPolicy schedulingPolicyy = SchedulingPolicy::roundRobin) :
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+					heapArena{},
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
 					queuedSignals{queuedSignalss},
 					signalActions{signalActionss},
 					stackSize{stackSizee},
@@ -73,6 +83,13 @@ struct DynamicThreadParameters
 
 	}
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	/// pointer to arena used by this thread for allocations, nullptr to use the main heap
+	HeapArena* heapArena;
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 	/// max number of queued signals for this thread, relevant only if \a canReceiveSignals == true, 0 to disable
 	/// queuing of signals for this thread
 	size_t queuedSignals;
@@ -0,0 +1,293 @@
+/**
+ * \file
+ * \brief EventFlags class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_EVENTFLAGS_HPP_
+#define INCLUDE_DISTORTOS_EVENTFLAGS_HPP_
+
+#include "distortos/internal/synchronization/EventFlagsWaiter.hpp"
+
+#include "distortos/TickClock.hpp"
+
+#include <utility>
+
+namespace distortos
+{
+
+/**
+ * \brief EventFlags is a group of 32 binary flags which can be set and cleared by threads or interrupts, and which can
+ * be waited for by threads
+ *
+ * A thread may wait for any or all flags from given bitmask. When flags are set with set(), all threads which wait
+ * condition is satisfied are unblocked in a single pass. Optionally the flags which satisfied the wait may be
+ * automatically cleared - in that case all waiters satisfied by the same call to set() see the same value of flags
+ * and the flags are cleared after all of them were unblocked.
+ *
+ * \ingroup synchronization
+ */
+
+class EventFlags
+{
+public:
+
+	/// type used for event flags' value
+	using Value = uint32_t;
+
+	/// mode of waiting
+	using WaitMode = EventFlagsWaitMode;
+
+	/**
+	 * \brief EventFlags's constructor
+	 *
+	 * \param [in] value is the initial value of event flags, default - 0
+	 */
+
+	constexpr explicit EventFlags(const Value value = {}) :
+			waitersList_{},
+			value_{value}
+	{
+
+	}
+
+	/**
+	 * \brief EventFlags's destructor
+	 *
+	 * It is safe to destroy event flags upon which no threads are currently blocked. The effect of destroying event
+	 * flags upon which other threads are currently blocked is system error.
+	 */
+
+	~EventFlags() = default;
+
+	/**
+	 * \brief Clears flags.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be cleared
+	 *
+	 * \return value of event flags before clearing
+	 */
+
+	Value clear(Value bitmask);
+
+	/**
+	 * \return current value of event flags
+	 */
+
+	Value get() const
+	{
+		return value_;
+	}
+
+	/**
+	 * \brief Sets flags.
+	 *
+	 * All threads which wait condition is satisfied by the new value of event flags are unblocked. If any of these
+	 * threads requested clearing of flags on exit, these flags are cleared after all satisfied threads are unblocked.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be set
+	 *
+	 * \return value of event flags before setting
+	 */
+
+	Value set(Value bitmask);
+
+	/**
+	 * \brief Tries to wait for flags.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EAGAIN - the wait condition is not satisfied;
+	 * - EINVAL - \a bitmask is 0;
+	 */
+
+	std::pair<int, Value> tryWait(Value bitmask, WaitMode mode, bool clearOnExit = {});
+
+	/**
+	 * \brief Tries to wait for flags for given duration of time.
+	 *
+	 * If the wait condition is not satisfied, the calling thread shall block until it becomes satisfied as in wait()
+	 * function. If this cannot happen without waiting for another thread or interrupt, this wait shall be terminated
+	 * when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - EINVAL - \a bitmask is 0;
+	 * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+	 */
+
+	std::pair<int, Value> tryWaitFor(Value bitmask, WaitMode mode, TickClock::duration duration,
+			bool clearOnExit = {});
+
+	/**
+	 * \brief Tries to wait for flags for given duration of time.
+	 *
+	 * Template variant of tryWaitFor(Value bitmask, WaitMode mode, TickClock::duration duration, bool clearOnExit).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - EINVAL - \a bitmask is 0;
+	 * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, Value> tryWaitFor(const Value bitmask, const WaitMode mode,
+			const std::chrono::duration<Rep, Period> duration, const bool clearOnExit = {})
+	{
+		return tryWaitFor(bitmask, mode, std::chrono::duration_cast<TickClock::duration>(duration), clearOnExit);
+	}
+
+	/**
+	 * \brief Tries to wait for flags until given time point.
+	 *
+	 * If the wait condition is not satisfied, the calling thread shall block until it becomes satisfied as in wait()
+	 * function. If this cannot happen without waiting for another thread or interrupt, this wait shall be terminated
+	 * when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - EINVAL - \a bitmask is 0;
+	 * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+	 */
+
+	std::pair<int, Value> tryWaitUntil(Value bitmask, WaitMode mode, TickClock::time_point timePoint,
+			bool clearOnExit = {});
+
+	/**
+	 * \brief Tries to wait for flags until given time point.
+	 *
+	 * Template variant of tryWaitUntil(Value bitmask, WaitMode mode, TickClock::time_point timePoint,
+	 * bool clearOnExit).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - EINVAL - \a bitmask is 0;
+	 * - ETIMEDOUT - the wait condition was not satisfied before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	std::pair<int, Value> tryWaitUntil(const Value bitmask, const WaitMode mode,
+			const std::chrono::time_point<TickClock, Duration> timePoint, const bool clearOnExit = {})
+	{
+		return tryWaitUntil(bitmask, mode, std::chrono::time_point_cast<TickClock::duration>(timePoint),
+				clearOnExit);
+	}
+
+	/**
+	 * \brief Waits for flags.
+	 *
+	 * If the wait condition is not satisfied, the calling thread shall not return from the call until the condition
+	 * becomes satisfied or the call is interrupted by a signal.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false), default - false
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - EINVAL - \a bitmask is 0;
+	 */
+
+	std::pair<int, Value> wait(Value bitmask, WaitMode mode, bool clearOnExit = {});
+
+	EventFlags(const EventFlags&) = delete;
+	EventFlags(EventFlags&&) = default;
+	const EventFlags& operator=(const EventFlags&) = delete;
+	EventFlags& operator=(EventFlags&&) = delete;
+
+private:
+
+	/**
+	 * \brief Implementation of wait(), tryWait(), tryWaitFor() and tryWaitUntil().
+	 *
+	 * \param [in] bitmask is the bitmask of flags that will be waited for
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false)
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of event flags - which satisfied
+	 * the wait (before clearing) on success, current one otherwise; error codes:
+	 * - EAGAIN - the wait condition is not satisfied and non-blocking mode was selected;
+	 * - EINVAL - \a bitmask is 0;
+	 * - error codes returned by internal::Scheduler::block() (for blocking mode without timeout) /
+	 * internal::Scheduler::blockUntil() (for blocking mode with timeout);
+	 */
+
+	std::pair<int, Value> waitImplementation(Value bitmask, WaitMode mode, bool clearOnExit, bool nonBlocking,
+			const TickClock::time_point* timePoint);
+
+	/// list of threads waiting for this object
+	internal::EventFlagsWaiterList waitersList_;
+
+	/// current value of event flags
+	Value value_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_EVENTFLAGS_HPP_
@@ -0,0 +1,31 @@
+/**
+ * \file
+ * \brief EventFlagsWaitMode enum class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_EVENTFLAGSWAITMODE_HPP_
+#define INCLUDE_DISTORTOS_EVENTFLAGSWAITMODE_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+/// mode of waiting for event flags
+enum class EventFlagsWaitMode : uint8_t
+{
+	/// wait for any of the flags from the bitmask
+	any,
+	/// wait for all of the flags from the bitmask
+	all,
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_EVENTFLAGSWAITMODE_HPP_
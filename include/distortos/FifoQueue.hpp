@@ -2,7 +2,7 @@
  * \file
  * \brief FifoQueue class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -43,6 +43,9 @@ namespace distortos
 template<typename T>
 class FifoQueue
 {
+	friend class QueueStatistics;
+	friend class WaitableObject;
+
 public:
 
 	/// type of uninitialized storage for data
@@ -0,0 +1,124 @@
+/**
+ * \file
+ * \brief HeapArena class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_HEAPARENA_HPP_
+#define INCLUDE_DISTORTOS_HEAPARENA_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/internal/memory/HeapArenaControlBlock.hpp"
+
+#include <mutex>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+class DynamicThreadBase;
+
+}	// namespace internal
+
+/**
+ * \brief HeapArena class is a separate heap used by a group of threads instead of the main heap.
+ *
+ * Threads are assigned to the arena with DynamicThreadParameters::heapArena. All their allocations - with malloc() and
+ * friends, operator new, ... - are served from the arena, which has its own mutex, so they don't contend with other
+ * threads for the mutex of the main heap. If the arena has no free block large enough, the allocation is served from
+ * the main heap.
+ *
+ * Memory of the arena is allocated from the main heap during the first allocation from the arena. If this fails, the
+ * allocation is served from the main heap and the next one tries again.
+ *
+ * Blocks allocated from the arena can be freed by any thread. Threads which are not assigned to the arena don't lock
+ * its mutex - their blocks are queued and returned to the arena during its next allocation or deallocation.
+ *
+ * \warning Arena must outlive all threads assigned to it and all blocks allocated from it.
+ *
+ * \ingroup memory
+ */
+
+class HeapArena
+{
+	friend class internal::DynamicThreadBase;
+
+public:
+
+	/**
+	 * \brief HeapArena's constructor
+	 *
+	 * \param [in] size is the size of memory of the arena which will be allocated from the main heap, bytes
+	 */
+
+	constexpr explicit HeapArena(const size_t size) :
+			controlBlock_{size}
+	{
+
+	}
+
+	/**
+	 * \return max sum of sizes of all blocks allocated from the arena ("high-water mark"), bytes
+	 */
+
+	size_t getMaxUsedSize()
+	{
+		const std::lock_guard<Mutex> lockGuard {controlBlock_.getMutex()};
+		return controlBlock_.getTlsfHeap().getMaxUsedSize();
+	}
+
+	/**
+	 * \return size of memory of the arena, bytes
+	 */
+
+	size_t getSize() const
+	{
+		return controlBlock_.getSize();
+	}
+
+	/**
+	 * \return sum of sizes of all blocks allocated from the arena (including queued blocks which were not yet returned
+	 * to the arena), bytes
+	 */
+
+	size_t getUsedSize()
+	{
+		const std::lock_guard<Mutex> lockGuard {controlBlock_.getMutex()};
+		return controlBlock_.getTlsfHeap().getUsedSize();
+	}
+
+	/**
+	 * \return true if memory of the arena was already allocated from the main heap, false otherwise
+	 */
+
+	bool isInitialized() const
+	{
+		return controlBlock_.isInitialized();
+	}
+
+	HeapArena(const HeapArena&) = delete;
+	HeapArena(HeapArena&&) = delete;
+	const HeapArena& operator=(const HeapArena&) = delete;
+	HeapArena& operator=(HeapArena&&) = delete;
+
+private:
+
+	/// internal HeapArenaControlBlock object
+	internal::HeapArenaControlBlock controlBlock_;
+};
+
+}	// namespace distortos
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_HEAPARENA_HPP_
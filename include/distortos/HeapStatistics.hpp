@@ -0,0 +1,177 @@
+/**
+ * \file
+ * \brief HeapStatistics class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_HEAPSTATISTICS_HPP_
+#define INCLUDE_DISTORTOS_HEAPSTATISTICS_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+#include "distortos/ThreadIdentifier.hpp"
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+/**
+ * \brief HeapStatistics class provides statistics of the heap used by malloc() and friends.
+ *
+ * Statistics are collected by TLSF heap allocator - they include current and maximal usage of the heap, summary of free
+ * blocks (which can be used to detect fragmentation) and the number of allocations and deallocations (which can be used
+ * to detect leaks).
+ *
+ * When enabled in configuration, each allocation, deallocation and reallocation is also recorded in a trace, which is a
+ * ring buffer holding the most recent operations. Each entry identifies the thread and the address of code which
+ * executed the operation - the address can be translated to function name and line with tools like addr2line. For
+ * allocations executed with operator new this is the address in operator new.
+ *
+ * \note Functions of this class lock the same mutex as malloc(), so they cannot be used from interrupt context.
+ *
+ * \ingroup statistics
+ */
+
+class HeapStatistics
+{
+public:
+
+	/// snapshot of statistics of the heap
+	struct Snapshot
+	{
+		/// number of successful allocations
+		uint64_t allocationCount;
+
+		/// number of allocations which failed because there was not enough memory
+		uint64_t failedAllocationCount;
+
+		/// number of deallocations
+		uint64_t freeCount;
+
+		/// size of the heap, bytes, 0 if the heap was not used yet
+		size_t size;
+
+		/// sum of sizes of all allocated blocks (without headers), bytes
+		size_t usedSize;
+
+		/// max value of Snapshot::usedSize ("high-water mark"), bytes
+		size_t maxUsedSize;
+
+		/// sum of sizes of all free blocks, bytes
+		size_t freeSize;
+
+		/// number of free blocks
+		size_t freeBlockCount;
+
+		/// size of the largest free block, bytes
+		size_t largestFreeBlockSize;
+
+		/// fragmentation of free memory, per mille - (1 - largestFreeBlockSize / freeSize) * 1000, 0 if there's no free
+		/// memory
+		uint16_t fragmentation;
+	};
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+	/// number of the most recent operations which are recorded in the trace
+	constexpr static size_t traceSize {CONFIG_HEAP_TRACE_ENTRIES};
+
+	/// type of operation recorded in the trace
+	enum class Operation : uint8_t
+	{
+		/// allocation - malloc(), calloc() or memalign()
+		allocation,
+		/// deallocation - free()
+		deallocation,
+		/// reallocation - realloc()
+		reallocation,
+	};
+
+	/// single entry of the trace
+	struct TraceEntry
+	{
+		/// identifier of thread which executed the operation
+		ThreadIdentifier thread;
+
+		/// address of code which executed the operation
+		const void* returnAddress;
+
+		/// pointer to allocated (or freed) block, nullptr if allocation failed
+		const void* memory;
+
+		/// pointer to previous block for reallocation, nullptr otherwise
+		const void* previousMemory;
+
+		/// requested size, bytes, 0 for deallocation
+		size_t size;
+
+		/// type of operation
+		Operation operation;
+	};
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+	/**
+	 * \brief Gets consistent snapshot of statistics of the heap.
+	 *
+	 * \warning Execution time of this function is proportional to the number of free blocks in the heap.
+	 *
+	 * \return snapshot of statistics of the heap
+	 */
+
+	static Snapshot getSnapshot();
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+	/**
+	 * \brief Gets the most recent entries of the trace.
+	 *
+	 * \warning Entries are copied with interrupts masked, so this operation should be done with moderate \a size.
+	 *
+	 * \param [out] entries is a pointer to array in which entries will be stored, sorted from the oldest one
+	 * \param [in] size is the number of elements in \a entries array
+	 *
+	 * \return number of entries stored in \a entries
+	 */
+
+	static size_t getTrace(TraceEntry* entries, size_t size);
+
+	/**
+	 * \return number of all entries recorded in the trace since last reset(), including the ones which were already
+	 * overwritten
+	 */
+
+	static uint64_t getTraceCount();
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+	/**
+	 * \brief Resets statistics of the heap.
+	 *
+	 * All counters are zeroed, "high-water mark" is set to current usage of the heap and the trace (if enabled) is
+	 * cleared.
+	 */
+
+	static void reset();
+
+	HeapStatistics() = delete;
+};
+
+}	// namespace distortos
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_HEAPSTATISTICS_HPP_
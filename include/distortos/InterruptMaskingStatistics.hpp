@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief InterruptMaskingStatistics class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERRUPTMASKINGSTATISTICS_HPP_
+#define INCLUDE_DISTORTOS_INTERRUPTMASKINGSTATISTICS_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+/**
+ * \brief InterruptMaskingStatistics class collects statistics of sections of code executed with interrupts masked.
+ *
+ * Each transition from unmasked to masked interrupts (architecture::enableInterruptMasking() or
+ * architecture::restoreInterruptMasking(), used for example by InterruptMaskingLock) starts a section and each
+ * transition from masked to unmasked interrupts (architecture::disableInterruptMasking() or
+ * architecture::restoreInterruptMasking()) finishes it. Nested masking doesn't start new sections, so recorded duration
+ * is the whole time for which interrupts were masked. Durations are measured with architecture::getCycleCounter(), so
+ * they are expressed in core clock cycles. Sections executed entirely in architecture-specific code which manipulates
+ * interrupt mask directly (like context switch) are not recorded.
+ *
+ * The longest sections are identified by the address of code which started them - in most cases this is the address of
+ * function which constructed InterruptMaskingLock. The address can be translated to function name and line with tools
+ * like addr2line.
+ *
+ * \ingroup statistics
+ */
+
+class InterruptMaskingStatistics
+{
+public:
+
+	/// number of histogram bins, bin n counts sections with duration in [2^n; 2^(n+1)) cycles, bin 0 also counts 0
+	constexpr static size_t histogramSize {32};
+
+	/// number of the longest sections which are recorded
+	constexpr static size_t longestSectionsSize {CONFIG_INTERRUPT_MASKING_STATISTICS_LONGEST_SECTIONS};
+
+	/// single recorded section
+	struct Section
+	{
+		/// address of code which started the section, nullptr if this entry is not used
+		const void* returnAddress;
+
+		/// duration of the section, core clock cycles
+		uint32_t duration;
+	};
+
+	/// snapshot of collected statistics
+	struct Snapshot
+	{
+		/// number of recorded sections
+		uint64_t sectionCount;
+
+		/// the longest sections - each one with different address - sorted from the longest one
+		Section longestSections[longestSectionsSize];
+
+		/// histogram of durations of sections
+		uint32_t histogram[histogramSize];
+	};
+
+	/**
+	 * \brief Gets consistent snapshot of collected statistics.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return snapshot of collected statistics
+	 */
+
+	static Snapshot getSnapshot();
+
+	/**
+	 * \return maximum duration of section, core clock cycles
+	 */
+
+	static uint32_t getMaxDuration()
+	{
+		return getSnapshot().longestSections[0].duration;
+	}
+
+	/**
+	 * \brief Resets all collected statistics.
+	 *
+	 * \note This function can be used from interrupt context.
+	 */
+
+	static void reset();
+
+	InterruptMaskingStatistics() = delete;
+};
+
+}	// namespace distortos
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_INTERRUPTMASKINGSTATISTICS_HPP_
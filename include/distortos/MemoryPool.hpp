@@ -0,0 +1,266 @@
+/**
+ * \file
+ * \brief MemoryPool class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_MEMORYPOOL_HPP_
+#define INCLUDE_DISTORTOS_MEMORYPOOL_HPP_
+
+#include "distortos/Semaphore.hpp"
+
+#include <memory>
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+class SemaphoreFunctor;
+
+}	// namespace internal
+
+/**
+ * \brief MemoryPool class is a pool of fixed-size memory blocks, which can be allocated and freed in constant time.
+ *
+ * Free blocks are linked into an intrusive singly-linked list - the "next" pointer is stored in the first bytes of each
+ * free block, so the pool has no per-block overhead. Availability of blocks is tracked with a semaphore, so a thread
+ * which tries to allocate a block from an empty pool may block until another thread or interrupt frees some block.
+ *
+ * Each block is aligned to MemoryPool::alignment, so blocks can be used for objects of any type. Because of that the
+ * size of each block is rounded up with getRoundedBlockSize().
+ *
+ * \ingroup memory
+ */
+
+class MemoryPool
+{
+public:
+
+	/// unique_ptr (with deleter) to storage
+	using StorageUniquePointer = std::unique_ptr<void, void(&)(void*)>;
+
+	/// alignment of each block, bytes
+	constexpr static size_t alignment {alignof(std::max_align_t)};
+
+	/**
+	 * \brief MemoryPool's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for blocks
+	 * (sufficiently large for \a blocks, each getRoundedBlockSize(blockSize) bytes long, aligned to
+	 * MemoryPool::alignment) and appropriate deleter
+	 * \param [in] blockSize is the size of single block, bytes
+	 * \param [in] blocks is the number of blocks in storage memory block
+	 */
+
+	MemoryPool(StorageUniquePointer&& storageUniquePointer, size_t blockSize, size_t blocks);
+
+	/**
+	 * \brief Allocates a block from the pool.
+	 *
+	 * If the pool is empty, the calling thread shall block until a block is freed or the call is interrupted by a
+	 * signal.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::wait();
+	 */
+
+	std::pair<int, void*> allocate();
+
+	/**
+	 * \brief Frees a block, returning it to the pool.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] block is a pointer to block which was allocated from this pool
+	 *
+	 * \return 0 if block was freed successfully, error code otherwise:
+	 * - EINVAL - \a block doesn't point to the beginning of any block of this pool;
+	 * - EOVERFLOW - all blocks of this pool are already free, so \a block is not allocated (pool is not modified);
+	 */
+
+	int free(void* block);
+
+	/**
+	 * \return size of single block, bytes, rounded up with getRoundedBlockSize()
+	 */
+
+	size_t getBlockSize() const
+	{
+		return blockSize_;
+	}
+
+	/**
+	 * \return total number of blocks in the pool
+	 */
+
+	size_t getBlocks() const
+	{
+		return blocks_;
+	}
+
+	/**
+	 * \return number of blocks that are currently free
+	 */
+
+	size_t getFreeBlocks() const
+	{
+		return semaphore_.getValue();
+	}
+
+	/**
+	 * \return maximum number of blocks that were used at the same time ("high-water mark")
+	 */
+
+	size_t getMaxUsedBlocks() const
+	{
+		return maxUsedBlocks_;
+	}
+
+	/**
+	 * \brief Tries to allocate a block from the pool.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::tryWait();
+	 */
+
+	std::pair<int, void*> tryAllocate();
+
+	/**
+	 * \brief Tries to allocate a block from the pool for a given duration of time.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without allocating the block
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::tryWaitFor();
+	 */
+
+	std::pair<int, void*> tryAllocateFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to allocate a block from the pool for a given duration of time.
+	 *
+	 * Template variant of tryAllocateFor(TickClock::duration).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without allocating the block
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::tryWaitFor();
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, void*> tryAllocateFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryAllocateFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to allocate a block from the pool until a given time point.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without allocating the block
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::tryWaitUntil();
+	 */
+
+	std::pair<int, void*> tryAllocateUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to allocate a block from the pool until a given time point.
+	 *
+	 * Template variant of tryAllocateUntil(TickClock::time_point).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without allocating the block
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by Semaphore::tryWaitUntil();
+	 */
+
+	template<typename Duration>
+	std::pair<int, void*> tryAllocateUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryAllocateUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Rounds size of block up to a multiple of MemoryPool::alignment.
+	 *
+	 * \param [in] blockSize is the size of single block, bytes
+	 *
+	 * \return \a blockSize rounded up to a multiple of MemoryPool::alignment, never less than MemoryPool::alignment
+	 */
+
+	constexpr static size_t getRoundedBlockSize(const size_t blockSize)
+	{
+		return blockSize == 0 ? alignment : (blockSize + alignment - 1) / alignment * alignment;
+	}
+
+private:
+
+	/**
+	 * \brief Allocates a block from the pool.
+	 *
+	 * Internal version - takes a block from the list of free blocks after \a waitSemaphoreFunctor succeeds.
+	 *
+	 * \param [in] waitSemaphoreFunctor is a reference to SemaphoreFunctor which will be executed with \a semaphore_
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated block (valid only if
+	 * return code is 0); error codes:
+	 * - error codes returned by \a waitSemaphoreFunctor's operator() call;
+	 */
+
+	std::pair<int, void*> allocateInternal(const internal::SemaphoreFunctor& waitSemaphoreFunctor);
+
+	/// semaphore with value equal to the number of free blocks
+	Semaphore semaphore_;
+
+	/// storage for blocks
+	const StorageUniquePointer storageUniquePointer_;
+
+	/// pointer to first free block, the beginning of each free block holds pointer to next free block
+	void* freeList_;
+
+	/// size of single block, bytes
+	const size_t blockSize_;
+
+	/// total number of blocks in the pool
+	const size_t blocks_;
+
+	/// maximum number of blocks that were used at the same time
+	size_t maxUsedBlocks_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_MEMORYPOOL_HPP_
@@ -0,0 +1,352 @@
+/**
+ * \file
+ * \brief MessageBuffer class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_MESSAGEBUFFER_HPP_
+#define INCLUDE_DISTORTOS_MESSAGEBUFFER_HPP_
+
+#include "distortos/internal/synchronization/StreamBufferBase.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief MessageBuffer class is a buffer for messages of variable size.
+ *
+ * Each message is stored contiguously in a circular buffer, preceded by its length (of MessageBuffer::Length type), so
+ * the memory used by a message is equal to its size plus `sizeof(MessageBuffer::Length)`. Messages are received in the
+ * same order in which they were sent. Unlike RawFifoQueue and RawMessageQueue, storage doesn't have to be sized for the
+ * largest possible message in each slot.
+ *
+ * \ingroup queues
+ */
+
+class MessageBuffer
+{
+public:
+
+	/// type of length which is stored before each message
+	using Length = size_t;
+
+	/// unique_ptr (with deleter) to storage
+	using StorageUniquePointer = internal::StreamBufferBase::StorageUniquePointer;
+
+	/**
+	 * \brief MessageBuffer's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for messages
+	 * (sufficiently large for \a size bytes) and appropriate deleter
+	 * \param [in] size is the size of storage, bytes, must be greater than `sizeof(MessageBuffer::Length)`
+	 */
+
+	MessageBuffer(StorageUniquePointer&& storageUniquePointer, size_t size);
+
+	/**
+	 * \return capacity of buffer, bytes
+	 */
+
+	size_t getCapacity() const
+	{
+		return streamBufferBase_.getCapacity();
+	}
+
+	/**
+	 * \return maximum size of single message, bytes
+	 */
+
+	size_t getMaxMessageSize() const
+	{
+		return getCapacity() - sizeof(Length);
+	}
+
+	/**
+	 * \brief Receives the oldest message from the buffer.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	std::pair<int, size_t> receive(void* buffer, size_t size);
+
+	/**
+	 * \brief Sends the message to the buffer.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	int send(const void* data, size_t size);
+
+	/**
+	 * \brief Tries to receive the oldest message from the buffer.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EAGAIN - the buffer is empty;
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 */
+
+	std::pair<int, size_t> tryReceive(void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to receive the oldest message from the buffer for a given duration of time.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without receiving the message
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryReceiveFor(TickClock::duration duration, void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to receive the oldest message from the buffer for a given duration of time.
+	 *
+	 * Template variant of tryReceiveFor(TickClock::duration, void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without receiving the message
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, size_t> tryReceiveFor(const std::chrono::duration<Rep, Period> duration, void* const buffer,
+			const size_t size)
+	{
+		return tryReceiveFor(std::chrono::duration_cast<TickClock::duration>(duration), buffer, size);
+	}
+
+	/**
+	 * \brief Tries to receive the oldest message from the buffer until a given time point.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without receiving the message
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryReceiveUntil(TickClock::time_point timePoint, void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to receive the oldest message from the buffer until a given time point.
+	 *
+	 * Template variant of tryReceiveUntil(TickClock::time_point, void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without receiving the message
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	std::pair<int, size_t> tryReceiveUntil(const std::chrono::time_point<TickClock, Duration> timePoint,
+			void* const buffer, const size_t size)
+	{
+		return tryReceiveUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), buffer, size);
+	}
+
+	/**
+	 * \brief Tries to send the message to the buffer.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EAGAIN - there is not enough free space in the buffer;
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 */
+
+	int trySend(const void* data, size_t size);
+
+	/**
+	 * \brief Tries to send the message to the buffer for a given duration of time.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without sending the message
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	int trySendFor(TickClock::duration duration, const void* data, size_t size);
+
+	/**
+	 * \brief Tries to send the message to the buffer for a given duration of time.
+	 *
+	 * Template variant of trySendFor(TickClock::duration, const void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the call will be terminated without sending the message
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int trySendFor(const std::chrono::duration<Rep, Period> duration, const void* const data, const size_t size)
+	{
+		return trySendFor(std::chrono::duration_cast<TickClock::duration>(duration), data, size);
+	}
+
+	/**
+	 * \brief Tries to send the message to the buffer until a given time point.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without sending the message
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	int trySendUntil(TickClock::time_point timePoint, const void* data, size_t size);
+
+	/**
+	 * \brief Tries to send the message to the buffer until a given time point.
+	 *
+	 * Template variant of trySendUntil(TickClock::time_point, const void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without sending the message
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int trySendUntil(const std::chrono::time_point<TickClock, Duration> timePoint, const void* const data,
+			const size_t size)
+	{
+		return trySendUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), data, size);
+	}
+
+private:
+
+	/**
+	 * \brief Implementation of receive(), tryReceive(), tryReceiveFor() and tryReceiveUntil().
+	 *
+	 * \param [out] buffer is a pointer to buffer for received message
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the oldest message, bytes (valid
+	 * if return code is 0 or EMSGSIZE); error codes:
+	 * - EMSGSIZE - \a size is less than the size of the oldest message, message is not removed from the buffer;
+	 * - error codes returned by internal::StreamBufferBase::waitForData();
+	 */
+
+	std::pair<int, size_t> receiveImplementation(void* buffer, size_t size, bool nonBlocking,
+			const TickClock::time_point* timePoint);
+
+	/**
+	 * \brief Implementation of send(), trySend(), trySendFor() and trySendUntil().
+	 *
+	 * \param [in] data is a pointer to message that will be sent
+	 * \param [in] size is the size of \a data, bytes
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return 0 if message was sent successfully, error code otherwise:
+	 * - EMSGSIZE - \a size is greater than getMaxMessageSize();
+	 * - error codes returned by internal::StreamBufferBase::waitForSpace();
+	 */
+
+	int sendImplementation(const void* data, size_t size, bool nonBlocking, const TickClock::time_point* timePoint);
+
+	/// contained internal::StreamBufferBase object which implements base functionality
+	internal::StreamBufferBase streamBufferBase_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_MESSAGEBUFFER_HPP_
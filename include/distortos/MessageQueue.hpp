@@ -2,7 +2,7 @@
  * \file
  * \brief MessageQueue class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -45,6 +45,9 @@ namespace distortos
 template<typename T>
 class MessageQueue
 {
+	friend class QueueStatistics;
+	friend class WaitableObject;
+
 public:
 
 	/// type of uninitialized storage for Entry with link
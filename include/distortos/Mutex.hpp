@@ -2,7 +2,7 @@
  * \file
  * \brief Mutex class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -29,6 +29,12 @@ namespace distortos
 
 class Mutex : private internal::MutexControlBlock
 {
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	friend class MutexStatistics;
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 public:
 
 	/// mutex protocols
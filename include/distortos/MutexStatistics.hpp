@@ -0,0 +1,281 @@
+/**
+ * \file
+ * \brief MutexStatistics class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_MUTEXSTATISTICS_HPP_
+#define INCLUDE_DISTORTOS_MUTEXSTATISTICS_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+#include "distortos/ThreadIdentifier.hpp"
+#include "distortos/TickClock.hpp"
+
+#include "estd/IntrusiveList.hpp"
+#include "estd/TypeErasedFunctor.hpp"
+
+#include <cstdint>
+
+namespace distortos
+{
+
+class Mutex;
+
+namespace internal
+{
+
+class MutexControlBlock;
+class ThreadControlBlock;
+
+}	// namespace internal
+
+/**
+ * \brief MutexStatistics class collects contention and hold-time statistics of single Mutex.
+ *
+ * Mutex is instrumented by constructing MutexStatistics object associated with it. The object attaches itself to the
+ * mutex and links itself into the global list of instrumented mutexes, which can be enumerated with forEach(). When the
+ * object is destroyed, it detaches from the mutex and is removed from the list. Mutexes without associated
+ * MutexStatistics object pay only for single pointer check in their lock and unlock paths.
+ *
+ * All times are measured with TickClock, so their resolution is equal to the tick period.
+ *
+ * \ingroup statistics
+ */
+
+class MutexStatistics
+{
+	friend class internal::MutexControlBlock;
+
+public:
+
+	/// snapshot of collected statistics
+	struct Snapshot
+	{
+		/// identifier of the thread which locked the mutex most recently
+		ThreadIdentifier lastOwner;
+
+		/// longest time for which the mutex was held
+		TickClock::duration maxHoldTime;
+
+		/// longest time for which any thread was blocked waiting for the mutex
+		TickClock::duration maxWaitTime;
+
+		/// cumulative time for which all threads were blocked waiting for the mutex
+		TickClock::duration totalWaitTime;
+
+		/// number of times the mutex was locked after blocking, timed-out waits are not counted
+		uint32_t contendedLockCount;
+
+		/// number of times the mutex was locked (recursive locks are not counted)
+		uint32_t lockCount;
+
+		/// number of times locking or waiting for the mutex boosted the priority of its owner
+		uint32_t priorityBoostCount;
+	};
+
+	/// type-erased functor executed by forEach() for each instrumented mutex
+	using Visitor = estd::TypeErasedFunctor<void(const MutexStatistics&)>;
+
+	/**
+	 * \brief MutexStatistics's constructor
+	 *
+	 * Attaches the object to \a mutex and adds it to the global list of instrumented mutexes.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] mutex is a reference to Mutex which will be instrumented, it must not have any other MutexStatistics
+	 * object associated
+	 * \param [in] name is the name of instrumented mutex, nullptr if mutex has no name, default - nullptr
+	 */
+
+	explicit MutexStatistics(Mutex& mutex, const char* name = {});
+
+	/**
+	 * \brief MutexStatistics's destructor
+	 *
+	 * Detaches the object from associated mutex and removes it from the global list of instrumented mutexes.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 */
+
+	~MutexStatistics();
+
+	/**
+	 * \brief Calls given functor for each instrumented mutex.
+	 *
+	 * The global list of instrumented mutexes is protected with internal mutex while \a functor is executed, so it may
+	 * perform lengthy operations (like printing the statistics), but it must not construct or destroy any
+	 * MutexStatistics objects.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Functor is the type of functor, it should be callable as `void(const MutexStatistics&)`
+	 *
+	 * \param [in] functor is the functor which will be called for each instrumented mutex
+	 */
+
+	template<typename Functor>
+	static void forEach(Functor&& functor);
+
+	/**
+	 * \return reference to instrumented mutex
+	 */
+
+	Mutex& getMutex() const
+	{
+		return mutex_;
+	}
+
+	/**
+	 * \return name of instrumented mutex, nullptr if mutex has no name
+	 */
+
+	const char* getName() const
+	{
+		return name_;
+	}
+
+	/**
+	 * \brief Gets consistent snapshot of collected statistics.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return snapshot of collected statistics
+	 */
+
+	Snapshot getSnapshot() const;
+
+	/**
+	 * \brief Resets all collected statistics.
+	 *
+	 * \note This function can be used from interrupt context.
+	 */
+
+	void reset();
+
+	MutexStatistics(const MutexStatistics&) = delete;
+	MutexStatistics(MutexStatistics&&) = delete;
+	const MutexStatistics& operator=(const MutexStatistics&) = delete;
+	MutexStatistics& operator=(MutexStatistics&&) = delete;
+
+	/// node for intrusive list
+	estd::IntrusiveListNode node;
+
+private:
+
+	/**
+	 * \brief Implementation of forEach().
+	 *
+	 * \param [in] visitor is a reference to type-erased functor which will be called for each instrumented mutex
+	 */
+
+	static void forEachImplementation(const Visitor& visitor);
+
+	/**
+	 * \brief Records locking of the mutex.
+	 *
+	 * \note This function must be called with interrupts masked.
+	 *
+	 * \param [in] owner is a reference to ThreadControlBlock of new owner of the mutex
+	 */
+
+	void recordLock(const internal::ThreadControlBlock& owner);
+
+	/**
+	 * \brief Records boost of owner's priority caused by the mutex.
+	 *
+	 * \note This function must be called with interrupts masked.
+	 */
+
+	void recordPriorityBoost()
+	{
+		++snapshot_.priorityBoostCount;
+	}
+
+	/**
+	 * \brief Records unlocking of the mutex (or transfer of its lock to other thread).
+	 *
+	 * \note This function must be called with interrupts masked.
+	 */
+
+	void recordUnlock();
+
+	/**
+	 * \brief Records successfully completed wait for the mutex.
+	 *
+	 * Called once per contended lock operation, even if the wait was interrupted by signals and restarted.
+	 *
+	 * \note This function must be called with interrupts masked.
+	 *
+	 * \param [in] waitTime is the time for which the thread was blocked waiting for the mutex, measured from the first
+	 * block
+	 */
+
+	void recordWait(TickClock::duration waitTime);
+
+	/// collected statistics
+	Snapshot snapshot_;
+
+	/// time point at which the mutex was locked most recently
+	TickClock::time_point lockTimePoint_;
+
+	/// reference to instrumented mutex
+	Mutex& mutex_;
+
+	/// name of instrumented mutex, nullptr if mutex has no name
+	const char* name_;
+};
+
+template<typename Functor>
+void MutexStatistics::forEach(Functor&& functor)
+{
+	/// BoundVisitor class is a type-erased wrapper for \a functor
+	class BoundVisitor : public Visitor
+	{
+	public:
+
+		/**
+		 * \brief BoundVisitor's constructor
+		 *
+		 * \param [in] boundFunctor is a reference to bound functor
+		 */
+
+		constexpr explicit BoundVisitor(Functor& boundFunctor) :
+				boundFunctor_{boundFunctor}
+		{
+
+		}
+
+		/**
+		 * \brief BoundVisitor's function call operator
+		 *
+		 * \param [in] mutexStatistics is a reference to MutexStatistics object of visited mutex
+		 */
+
+		void operator()(const MutexStatistics& mutexStatistics) const override
+		{
+			boundFunctor_(mutexStatistics);
+		}
+
+	private:
+
+		/// reference to bound functor
+		Functor& boundFunctor_;
+	};
+
+	forEachImplementation(BoundVisitor{functor});
+}
+
+}	// namespace distortos
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_MUTEXSTATISTICS_HPP_
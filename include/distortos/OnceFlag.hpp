@@ -2,7 +2,7 @@
  * \file
  * \brief OnceFlag class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -12,7 +12,9 @@
 #ifndef INCLUDE_DISTORTOS_ONCEFLAG_HPP_
 #define INCLUDE_DISTORTOS_ONCEFLAG_HPP_
 
-#include "distortos/Mutex.hpp"
+#include <atomic>
+
+#include <cstdint>
 
 namespace distortos
 {
@@ -23,6 +25,10 @@ namespace distortos
  * Similar to std::once_flag - http://en.cppreference.com/w/cpp/thread/once_flag
  * Similar to POSIX pthread_once_t - http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_once.html#
  *
+ * The object consists of single byte of state. When the function was already called, callOnce() needs just one load
+ * with acquire semantics. Threads which have to wait for the function to finish are blocked on a list shared by all
+ * OnceFlag objects.
+ *
  * \ingroup synchronization
  */
 
@@ -38,19 +44,52 @@ public:
 	 */
 
 	constexpr OnceFlag() :
-			mutex_{},
-			done_{}
+			state_{State::notCalled}
 	{
 
 	}
 
 private:
 
-	/// internal mutex used by callOnce()
-	Mutex mutex_;
+	/// state of the object
+	enum class State : uint8_t
+	{
+		/// function was not called yet
+		notCalled,
+		/// function is being executed
+		inProgress,
+		/// function was already called
+		done,
+	};
+
+	/**
+	 * \brief Starts slow path of callOnce().
+	 *
+	 * If the function is being executed by another thread, the calling thread is blocked until it finishes.
+	 *
+	 * \return true if the calling thread must execute the function and then call finish(), false if the function was
+	 * already called
+	 */
+
+	bool start();
+
+	/**
+	 * \brief Marks the function as called and unblocks all threads which waited for it.
+	 */
+
+	void finish();
+
+	/**
+	 * \return true if function was already called for this object, false otherwise
+	 */
+
+	bool isDone() const
+	{
+		return state_.load(std::memory_order_acquire) == State::done;
+	}
 
-	/// tells whether any function was already called for this object (true) or not (false)
-	volatile bool done_;
+	/// current state of the object, modified only with interrupts masked
+	std::atomic<State> state_;
 };
 
 }	// namespace distortos
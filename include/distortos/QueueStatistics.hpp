@@ -0,0 +1,324 @@
+/**
+ * \file
+ * \brief QueueStatistics class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_QUEUESTATISTICS_HPP_
+#define INCLUDE_DISTORTOS_QUEUESTATISTICS_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+#include "distortos/FifoQueue.hpp"
+#include "distortos/MessageQueue.hpp"
+
+#include "estd/IntrusiveList.hpp"
+#include "estd/TypeErasedFunctor.hpp"
+
+namespace distortos
+{
+
+class RawFifoQueue;
+class RawMessageQueue;
+
+/**
+ * \brief QueueStatistics class collects occupancy and throughput statistics of single queue.
+ *
+ * Any queue type (FifoQueue, MessageQueue, RawFifoQueue, RawMessageQueue and their static/dynamic variants) is
+ * instrumented by constructing QueueStatistics object associated with it. The object attaches itself to the queue and
+ * links itself into the global list of instrumented queues, which can be enumerated with forEach(). When the object is
+ * destroyed, it detaches from the queue and is removed from the list. Queues without associated QueueStatistics object
+ * pay only for single pointer check in their push and pop paths.
+ *
+ * All times are measured with TickClock, so their resolution is equal to the tick period.
+ *
+ * \ingroup statistics
+ */
+
+class QueueStatistics
+{
+	friend class internal::FifoQueueBase;
+	friend class internal::MessageQueueBase;
+
+public:
+
+	/// snapshot of collected statistics
+	struct Snapshot
+	{
+		/// cumulative time for which all producers and consumers were blocked waiting for the queue
+		TickClock::duration totalBlockedTime;
+
+		/// number of elements currently in the queue
+		size_t depth;
+
+		/// maximum number of elements which were in the queue at the same time ("high-water mark")
+		size_t maxDepth;
+
+		/// number of times a consumer had to block waiting for an element
+		uint32_t blockedPopCount;
+
+		/// number of times a producer had to block waiting for a free slot
+		uint32_t blockedPushCount;
+
+		/// number of unsuccessful pushes (full queue, timeout or interruption)
+		uint32_t failedPushCount;
+
+		/// number of successful pops
+		uint32_t popCount;
+
+		/// number of successful pushes
+		uint32_t pushCount;
+	};
+
+	/// type-erased functor executed by forEach() for each instrumented queue
+	using Visitor = estd::TypeErasedFunctor<void(const QueueStatistics&)>;
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam T is the type of data in queue
+	 *
+	 * \param [in] fifoQueue is a reference to FifoQueue which will be instrumented, it must not have any other
+	 * QueueStatistics object associated
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name, default - nullptr
+	 */
+
+	template<typename T>
+	explicit QueueStatistics(FifoQueue<T>& fifoQueue, const char* const name = {}) :
+			QueueStatistics{fifoQueue.fifoQueueBase_, name}
+	{
+
+	}
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam T is the type of data in queue
+	 *
+	 * \param [in] messageQueue is a reference to MessageQueue which will be instrumented, it must not have any other
+	 * QueueStatistics object associated
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name, default - nullptr
+	 */
+
+	template<typename T>
+	explicit QueueStatistics(MessageQueue<T>& messageQueue, const char* const name = {}) :
+			QueueStatistics{messageQueue.messageQueueBase_, name}
+	{
+
+	}
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] rawFifoQueue is a reference to RawFifoQueue which will be instrumented, it must not have any other
+	 * QueueStatistics object associated
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name, default - nullptr
+	 */
+
+	explicit QueueStatistics(RawFifoQueue& rawFifoQueue, const char* name = {});
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] rawMessageQueue is a reference to RawMessageQueue which will be instrumented, it must not have any
+	 * other QueueStatistics object associated
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name, default - nullptr
+	 */
+
+	explicit QueueStatistics(RawMessageQueue& rawMessageQueue, const char* name = {});
+
+	/**
+	 * \brief QueueStatistics's destructor
+	 *
+	 * Detaches the object from associated queue and removes it from the global list of instrumented queues.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 */
+
+	~QueueStatistics();
+
+	/**
+	 * \brief Calls given functor for each instrumented queue.
+	 *
+	 * The global list of instrumented queues is protected with internal mutex while \a functor is executed, so it may
+	 * perform lengthy operations (like printing the statistics), but it must not construct or destroy any
+	 * QueueStatistics objects.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Functor is the type of functor, it should be callable as `void(const QueueStatistics&)`
+	 *
+	 * \param [in] functor is the functor which will be called for each instrumented queue
+	 */
+
+	template<typename Functor>
+	static void forEach(Functor&& functor);
+
+	/**
+	 * \return name of instrumented queue, nullptr if queue has no name
+	 */
+
+	const char* getName() const
+	{
+		return name_;
+	}
+
+	/**
+	 * \brief Gets consistent snapshot of collected statistics.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return snapshot of collected statistics
+	 */
+
+	Snapshot getSnapshot() const;
+
+	/**
+	 * \brief Resets all collected statistics.
+	 *
+	 * Maximum depth is set to current depth of the queue.
+	 *
+	 * \note This function can be used from interrupt context.
+	 */
+
+	void reset();
+
+	QueueStatistics(const QueueStatistics&) = delete;
+	QueueStatistics(QueueStatistics&&) = delete;
+	const QueueStatistics& operator=(const QueueStatistics&) = delete;
+	QueueStatistics& operator=(QueueStatistics&&) = delete;
+
+	/// node for intrusive list
+	estd::IntrusiveListNode node;
+
+private:
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * Attaches the object to \a fifoQueueBase and adds it to the global list of instrumented queues.
+	 *
+	 * \param [in] fifoQueueBase is a reference to internal::FifoQueueBase of instrumented queue
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name
+	 */
+
+	QueueStatistics(internal::FifoQueueBase& fifoQueueBase, const char* name);
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * Attaches the object to \a messageQueueBase and adds it to the global list of instrumented queues.
+	 *
+	 * \param [in] messageQueueBase is a reference to internal::MessageQueueBase of instrumented queue
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name
+	 */
+
+	QueueStatistics(internal::MessageQueueBase& messageQueueBase, const char* name);
+
+	/**
+	 * \brief QueueStatistics's constructor
+	 *
+	 * Attaches the object to the queue and adds it to the global list of instrumented queues.
+	 *
+	 * \param [in] statisticsPointer is a reference to pointer to QueueStatistics in the queue
+	 * \param [in] popSemaphore is a reference to "pop" semaphore of the queue
+	 * \param [in] name is the name of instrumented queue, nullptr if queue has no name
+	 */
+
+	QueueStatistics(QueueStatistics*& statisticsPointer, const Semaphore& popSemaphore, const char* name);
+
+	/**
+	 * \brief Implementation of forEach().
+	 *
+	 * \param [in] visitor is a reference to type-erased functor which will be called for each instrumented queue
+	 */
+
+	static void forEachImplementation(const Visitor& visitor);
+
+	/**
+	 * \brief Records single push or pop operation.
+	 *
+	 * \note This function must be called with interrupts masked, after waiting for the semaphore and before posting
+	 * the other one.
+	 *
+	 * \param [in] push selects whether recorded operation is push (true) or pop (false)
+	 * \param [in] ret is the value returned by semaphore functor
+	 * \param [in] waitStart is the time point at which the operation started waiting for the semaphore,
+	 * TickClock::time_point::min() if the semaphore was available immediately
+	 */
+
+	void record(bool push, int ret, TickClock::time_point waitStart);
+
+	/// collected statistics, Snapshot::depth is not used
+	Snapshot snapshot_;
+
+	/// reference to "pop" semaphore of the queue - its value is equal to the number of elements in the queue
+	const Semaphore& popSemaphore_;
+
+	/// reference to pointer to QueueStatistics in the queue
+	QueueStatistics*& statisticsPointer_;
+
+	/// name of instrumented queue, nullptr if queue has no name
+	const char* name_;
+};
+
+template<typename Functor>
+void QueueStatistics::forEach(Functor&& functor)
+{
+	/// BoundVisitor class is a type-erased wrapper for \a functor
+	class BoundVisitor : public Visitor
+	{
+	public:
+
+		/**
+		 * \brief BoundVisitor's constructor
+		 *
+		 * \param [in] boundFunctor is a reference to bound functor
+		 */
+
+		constexpr explicit BoundVisitor(Functor& boundFunctor) :
+				boundFunctor_{boundFunctor}
+		{
+
+		}
+
+		/**
+		 * \brief BoundVisitor's function call operator
+		 *
+		 * \param [in] queueStatistics is a reference to QueueStatistics object of visited queue
+		 */
+
+		void operator()(const QueueStatistics& queueStatistics) const override
+		{
+			boundFunctor_(queueStatistics);
+		}
+
+	private:
+
+		/// reference to bound functor
+		Functor& boundFunctor_;
+	};
+
+	forEachImplementation(BoundVisitor{functor});
+}
+
+}	// namespace distortos
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_QUEUESTATISTICS_HPP_
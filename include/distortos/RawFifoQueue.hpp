@@ -2,7 +2,7 @@
  * \file
  * \brief RawFifoQueue class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -29,6 +29,9 @@ namespace distortos
 
 class RawFifoQueue
 {
+	friend class QueueStatistics;
+	friend class WaitableObject;
+
 public:
 
 	/// unique_ptr (with deleter) to storage
@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \brief RunToCompletionTask class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_RUNTOCOMPLETIONTASK_HPP_
+#define INCLUDE_DISTORTOS_RUNTOCOMPLETIONTASK_HPP_
+
+#include "distortos/WorkQueue.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief RunToCompletionTask class is a lightweight task which runs to completion on the shared stack of its preemption
+ * level.
+ *
+ * Preemption level is a WorkQueue (usually StaticWorkQueue) - all tasks assigned to given level are executed one after
+ * another by the same worker thread, on its single stack. Levels are ordinary threads, so they coexist with other
+ * threads in the scheduler - task of higher level (worker thread with higher priority) preempts task of lower level,
+ * while tasks of the same level never preempt each other. Activation is a constant-time operation which doesn't
+ * allocate any memory and - unlike waking a blocked thread - doesn't require a separate stack for each task.
+ *
+ * Tasks are activated by events - from interrupt handlers, software timers or other tasks and threads - with
+ * activate(). Activation of task which is already activated (but not yet started) is coalesced. Task must not block -
+ * access to data shared between tasks of different levels must be protected with TaskResource, which implements Stack
+ * Resource Policy (priority ceiling) and never blocks.
+ *
+ * \ingroup synchronization
+ */
+
+class RunToCompletionTask
+{
+public:
+
+	/// type of function executed by the task, it receives the argument given during construction
+	using Function = WorkItem::Function;
+
+	/**
+	 * \brief RunToCompletionTask's constructor
+	 *
+	 * \param [in] preemptionLevel is a reference to work queue which executes the task
+	 * \param [in] function is a reference to function executed by the task
+	 * \param [in] argument is the argument passed to \a function, default - nullptr
+	 */
+
+	constexpr RunToCompletionTask(WorkQueue& preemptionLevel, Function& function, void* const argument = {}) :
+			workItem_{function, argument},
+			preemptionLevel_{preemptionLevel}
+	{
+
+	}
+
+	/**
+	 * \brief Activates the task.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by WorkQueue::submit();
+	 */
+
+	int activate()
+	{
+		return preemptionLevel_.submit(workItem_);
+	}
+
+	/**
+	 * \brief Cancels activation of the task.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by WorkQueue::cancel();
+	 */
+
+	int cancel()
+	{
+		return preemptionLevel_.cancel(workItem_);
+	}
+
+	/**
+	 * \return true if the task is activated (its execution didn't start yet), false otherwise
+	 */
+
+	bool isActivated() const
+	{
+		return workItem_.isQueued();
+	}
+
+	RunToCompletionTask(const RunToCompletionTask&) = delete;
+	RunToCompletionTask(RunToCompletionTask&&) = delete;
+	const RunToCompletionTask& operator=(const RunToCompletionTask&) = delete;
+	RunToCompletionTask& operator=(RunToCompletionTask&&) = delete;
+
+private:
+
+	/// work item submitted to preemptionLevel_ during activation
+	WorkItem workItem_;
+
+	/// reference to work queue which executes the task
+	WorkQueue& preemptionLevel_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_RUNTOCOMPLETIONTASK_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief Semaphore class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -93,7 +93,32 @@ public:
 	 * - EOVERFLOW - the maximum allowable value for a semaphore would be exceeded;
 	 */
 
-	int post();
+	int post()
+	{
+		return post(1);
+	}
+
+	/**
+	 * \brief Unlocks the semaphore multiple times.
+	 *
+	 * This function shall perform \a count semaphore unlock operations at once. Blocked threads are examined in the
+	 * order in which post() would unblock them and are unblocked as long as their requests (number of units passed to
+	 * wait() and similar functions) can be satisfied with the units that remain available - the first thread whose
+	 * request cannot be satisfied stops the operation, so threads waiting behind it never take the units it waits for.
+	 * Units which are not consumed by unblocked threads are added to the semaphore value. The whole operation is
+	 * performed in single critical section, so at most one context switch results from it, no matter how many threads
+	 * are unblocked.
+	 *
+	 * If the operation would make the semaphore value higher than the max value, nothing is changed and an error is
+	 * returned.
+	 *
+	 * \param [in] count is the number of unlock operations that will be performed
+	 *
+	 * \return 0 if the calling process successfully "posted" the semaphore, error code otherwise:
+	 * - EOVERFLOW - the maximum allowable value for a semaphore would be exceeded;
+	 */
+
+	int post(Value count);
 
 	/**
 	 * \brief Tries to lock the semaphore.
@@ -108,7 +133,27 @@ public:
 	 * - EAGAIN - semaphore was already locked, so it cannot be immediately locked by the tryWait() operation;
 	 */
 
-	int tryWait();
+	int tryWait()
+	{
+		return tryWait(1);
+	}
+
+	/**
+	 * \brief Tries to acquire multiple units of the semaphore.
+	 *
+	 * This function shall succeed only if the semaphore value is currently not lower than \a count and no thread with
+	 * the same or higher priority than the calling thread is blocked waiting for the semaphore, in which case the value
+	 * is decreased by \a count. Otherwise the semaphore is not modified.
+	 *
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EAGAIN - semaphore value is lower than \a count or a thread with the same or higher priority waits for the
+	 * semaphore, so it cannot be immediately locked by the tryWait() operation;
+	 */
+
+	int tryWait(Value count);
 
 	/**
 	 * \brief Tries to lock the semaphore for given duration of time.
@@ -131,7 +176,28 @@ public:
 	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
 	 */
 
-	int tryWaitFor(TickClock::duration duration);
+	int tryWaitFor(const TickClock::duration duration)
+	{
+		return tryWaitFor(duration, 1);
+	}
+
+	/**
+	 * \brief Tries to acquire multiple units of the semaphore for given duration of time.
+	 *
+	 * Similar to tryWaitFor(TickClock::duration), but \a count units are acquired at once, as in wait(Value).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the semaphore
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
+	 */
+
+	int tryWaitFor(TickClock::duration duration, Value count);
 
 	/**
 	 * \brief Tries to lock the semaphore for given duration of time.
@@ -156,6 +222,31 @@ public:
 		return tryWaitFor(std::chrono::duration_cast<TickClock::duration>(duration));
 	}
 
+	/**
+	 * \brief Tries to acquire multiple units of the semaphore for given duration of time.
+	 *
+	 * Template variant of tryWaitFor(TickClock::duration duration, Value count).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the semaphore
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryWaitFor(const std::chrono::duration<Rep, Period> duration, const Value count)
+	{
+		return tryWaitFor(std::chrono::duration_cast<TickClock::duration>(duration), count);
+	}
+
 	/**
 	 * \brief Tries to lock the semaphore until given time point.
 	 *
@@ -177,7 +268,28 @@ public:
 	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
 	 */
 
-	int tryWaitUntil(TickClock::time_point timePoint);
+	int tryWaitUntil(const TickClock::time_point timePoint)
+	{
+		return tryWaitUntil(timePoint, 1);
+	}
+
+	/**
+	 * \brief Tries to acquire multiple units of the semaphore until given time point.
+	 *
+	 * Similar to tryWaitUntil(TickClock::time_point), but \a count units are acquired at once, as in wait(Value).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the semaphore
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
+	 */
+
+	int tryWaitUntil(TickClock::time_point timePoint, Value count);
 
 	/**
 	 * \brief Tries to lock the semaphore until given time point.
@@ -201,6 +313,30 @@ public:
 		return tryWaitUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
 	}
 
+	/**
+	 * \brief Tries to acquire multiple units of the semaphore until given time point.
+	 *
+	 * Template variant of tryWaitUntil(TickClock::time_point timePoint, Value count).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the semaphore
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the semaphore could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryWaitUntil(const std::chrono::time_point<TickClock, Duration> timePoint, const Value count)
+	{
+		return tryWaitUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), count);
+	}
+
 	/**
 	 * \brief Locks the semaphore.
 	 *
@@ -217,7 +353,34 @@ public:
 	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
 	 */
 
-	int wait();
+	int wait()
+	{
+		return wait(1);
+	}
+
+	/**
+	 * \brief Acquires multiple units of the semaphore.
+	 *
+	 * This function shall decrease the semaphore value by \a count. If the semaphore value is currently lower than
+	 * \a count, then the calling thread shall not return from the call until all units are acquired at once or the call
+	 * is interrupted by a signal. Units are never acquired partially.
+	 *
+	 * Requests are satisfied in priority order (and in FIFO order among threads with the same priority), so a large
+	 * request is not starved by a stream of smaller ones - while a thread waits for units, threads with the same or
+	 * lower priority cannot take them ahead of it, even if there are enough units for their requests. When a wait is
+	 * terminated by timeout or signal, threads blocked behind the terminated one may acquire the units that are already
+	 * available.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] count is the number of units that will be acquired
+	 *
+	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	int wait(Value count);
 
 	Semaphore(const Semaphore&) = delete;
 	Semaphore(Semaphore&&) = default;
@@ -226,16 +389,35 @@ public:
 
 private:
 
+	class SemaphoreUnblockFunctor;
+
 	/**
 	 * \brief Internal version of tryWait().
 	 *
 	 * Internal version with no interrupt masking.
 	 *
+	 * \param [in] count is the number of units that will be acquired
+	 *
 	 * \return 0 if the calling process successfully performed the semaphore lock operation, error code otherwise:
-	 * - EAGAIN - semaphore was already locked, so it cannot be immediately locked by the tryWait() operation;
+	 * - EINVAL - \a count is greater than max value of semaphore;
+	 * - EAGAIN - semaphore value is lower than \a count or a thread with the same or higher priority waits for the
+	 * semaphore, so it cannot be immediately locked by the tryWait() operation;
+	 */
+
+	int tryWaitInternal(Value count);
+
+	/**
+	 * \brief Unblocks threads whose requests can be satisfied.
+	 *
+	 * Blocked threads are examined in order and unblocked as long as their requests can be satisfied with available
+	 * units - the first thread whose request cannot be satisfied stops the operation.
+	 *
+	 * \param [in] available is the number of available units
+	 *
+	 * \return number of units which remain available after unblocked threads took their units
 	 */
 
-	int tryWaitInternal();
+	uint64_t unblockWaiters(uint64_t available);
 
 	/// ThreadControlBlock objects blocked on this semaphore
 	internal::ThreadList blockedList_;
@@ -0,0 +1,369 @@
+/**
+ * \file
+ * \brief SharedMutex class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_SHAREDMUTEX_HPP_
+#define INCLUDE_DISTORTOS_SHAREDMUTEX_HPP_
+
+#include "distortos/internal/synchronization/SharedMutexControlBlock.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief SharedMutex is a synchronization primitive which can be owned exclusively by a single thread or shared by
+ * multiple threads
+ *
+ * Similar to std::shared_timed_mutex - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex
+ * Similar to POSIX pthread_rwlock_t
+ *
+ * Number of threads which can have shared ownership at the same time is limited by the size of storage provided to the
+ * constructor. With Policy::writerPreference new threads are not granted shared ownership while any thread waits for
+ * exclusive ownership. With Policy::fair ownership is granted in the order of the list of blocked threads (by priority,
+ * FIFO among threads of the same priority).
+ *
+ * With Protocol::priorityInheritance the priority of blocked threads is inherited by the thread with exclusive
+ * ownership or - when the shared mutex is owned by multiple "readers" - by the highest priority of them.
+ *
+ * \note All threads which have shared ownership must release it before the object is destroyed or the storage is
+ * deallocated.
+ *
+ * \ingroup synchronization
+ */
+
+class SharedMutex : private internal::SharedMutexControlBlock
+{
+public:
+
+	/// policies of granting ownership
+	using Policy = SharedMutexControlBlock::Policy;
+
+	/// shared mutex protocols
+	using Protocol = SharedMutexControlBlock::Protocol;
+
+	/// type of single element of storage for threads with shared ownership
+	using Storage = SharedMutexControlBlock::Storage;
+
+	/// unique_ptr (with deleter) to Storage[]
+	using StorageUniquePointer = SharedMutexControlBlock::StorageUniquePointer;
+
+	using SharedMutexControlBlock::getMaxReaders;
+	using SharedMutexControlBlock::getReadersCount;
+
+	/**
+	 * \brief SharedMutex's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for \a maxReaders
+	 * elements (sufficiently large for \a maxReaders * sizeof(Storage) bytes) and appropriate deleter
+	 * \param [in] maxReaders is the maximum number of threads that can have shared ownership at the same time
+	 * \param [in] policy is the policy of granting ownership, default - Policy::writerPreference
+	 * \param [in] protocol is the shared mutex protocol, default - Protocol::none
+	 */
+
+	SharedMutex(StorageUniquePointer&& storageUniquePointer, const size_t maxReaders,
+			const Policy policy = Policy::writerPreference, const Protocol protocol = Protocol::none) :
+					SharedMutexControlBlock{std::move(storageUniquePointer), maxReaders, policy, protocol}
+	{
+
+	}
+
+	/**
+	 * \brief SharedMutex's destructor
+	 *
+	 * It shall be safe to destroy a shared mutex that is unlocked. Attempting to destroy a locked shared mutex, or a
+	 * shared mutex that another thread is attempting to lock, results in undefined behavior.
+	 */
+
+	~SharedMutex() = default;
+
+	/**
+	 * \brief Locks the shared mutex for exclusive ownership.
+	 *
+	 * Similar to std::shared_timed_mutex::lock() - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/lock
+	 * Similar to pthread_rwlock_wrlock()
+	 *
+	 * If the shared mutex is already locked (exclusively or shared) by another thread, the calling thread shall block
+	 * until exclusive ownership is granted.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 */
+
+	int lock();
+
+	/**
+	 * \brief Locks the shared mutex for shared ownership.
+	 *
+	 * Similar to std::shared_timed_mutex::lock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/lock_shared
+	 * Similar to pthread_rwlock_rdlock()
+	 *
+	 * If the shared mutex is owned exclusively by another thread, if the policy requires the calling thread to wait
+	 * behind threads waiting for exclusive ownership or if the maximum number of threads with shared ownership was
+	 * reached, the calling thread shall block until shared ownership is granted.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 */
+
+	int lockShared();
+
+	/**
+	 * \brief Tries to lock the shared mutex for exclusive ownership.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock
+	 * Similar to pthread_rwlock_trywrlock()
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EBUSY - the shared mutex could not be acquired because it was already locked (by any thread, including the
+	 * current thread);
+	 */
+
+	int tryLock();
+
+	/**
+	 * \brief Tries to lock the shared mutex for exclusive ownership for given duration of time.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_for() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_for
+	 *
+	 * If the shared mutex is already locked, the calling thread shall block as in lock() function. This wait shall be
+	 * terminated when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to lock the shared mutex for exclusive ownership for given duration of time.
+	 *
+	 * Template variant of tryLockFor(TickClock::duration duration).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryLockFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryLockFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to lock the shared mutex for shared ownership.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared
+	 * Similar to pthread_rwlock_tryrdlock()
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EAGAIN - the maximum number of threads with shared ownership was reached;
+	 * - EBUSY - the shared mutex could not be acquired because it was owned exclusively, the policy requires the calling
+	 * thread to wait behind threads waiting for exclusive ownership or the current thread already has exclusive or
+	 * shared ownership;
+	 */
+
+	int tryLockShared();
+
+	/**
+	 * \brief Tries to lock the shared mutex for shared ownership for given duration of time.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared_for() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared_for
+	 *
+	 * If shared ownership cannot be granted immediately, the calling thread shall block as in lockShared() function.
+	 * This wait shall be terminated when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockSharedFor(TickClock::duration duration);
+
+	/**
+	 * \brief Tries to lock the shared mutex for shared ownership for given duration of time.
+	 *
+	 * Template variant of tryLockSharedFor(TickClock::duration duration).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	int tryLockSharedFor(const std::chrono::duration<Rep, Period> duration)
+	{
+		return tryLockSharedFor(std::chrono::duration_cast<TickClock::duration>(duration));
+	}
+
+	/**
+	 * \brief Tries to lock the shared mutex for shared ownership until given time point.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_shared_until() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_shared_until
+	 * Similar to pthread_rwlock_timedrdlock()
+	 *
+	 * If shared ownership cannot be granted immediately, the calling thread shall block as in lockShared() function.
+	 * This wait shall be terminated when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockSharedUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to lock the shared mutex for shared ownership until given time point.
+	 *
+	 * Template variant of tryLockSharedUntil(TickClock::time_point timePoint).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryLockSharedUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryLockSharedUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Tries to lock the shared mutex for exclusive ownership until given time point.
+	 *
+	 * Similar to std::shared_timed_mutex::try_lock_until() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/try_lock_until
+	 * Similar to pthread_rwlock_timedwrlock()
+	 *
+	 * If the shared mutex is already locked, the calling thread shall block as in lock() function. This wait shall be
+	 * terminated when the specified timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	int tryLockUntil(TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to lock the shared mutex for exclusive ownership until given time point.
+	 *
+	 * Template variant of tryLockUntil(TickClock::time_point timePoint).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated without locking the shared mutex
+	 *
+	 * \return 0 if the caller successfully locked the shared mutex, error code otherwise:
+	 * - EDEADLK - the current thread already has exclusive or shared ownership;
+	 * - ETIMEDOUT - the shared mutex could not be locked before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	int tryLockUntil(const std::chrono::time_point<TickClock, Duration> timePoint)
+	{
+		return tryLockUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint));
+	}
+
+	/**
+	 * \brief Releases exclusive ownership of the shared mutex.
+	 *
+	 * Similar to std::shared_timed_mutex::unlock() - http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/unlock
+	 * Similar to pthread_rwlock_unlock()
+	 *
+	 * If there are threads blocked on this shared mutex, ownership is transferred to them according to the policy -
+	 * either to a single thread waiting for exclusive ownership or to all threads waiting for shared ownership which
+	 * can be granted.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully unlocked the shared mutex, error code otherwise:
+	 * - EPERM - the current thread does not have exclusive ownership;
+	 */
+
+	int unlock();
+
+	/**
+	 * \brief Releases shared ownership of the shared mutex.
+	 *
+	 * Similar to std::shared_timed_mutex::unlock_shared() -
+	 * http://en.cppreference.com/w/cpp/thread/shared_timed_mutex/unlock_shared
+	 * Similar to pthread_rwlock_unlock()
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the caller successfully unlocked the shared mutex, error code otherwise:
+	 * - EPERM - the current thread does not have shared ownership;
+	 */
+
+	int unlockShared();
+
+	SharedMutex(const SharedMutex&) = delete;
+	SharedMutex(SharedMutex&&) = default;
+	const SharedMutex& operator=(const SharedMutex&) = delete;
+	SharedMutex& operator=(SharedMutex&&) = delete;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SHAREDMUTEX_HPP_
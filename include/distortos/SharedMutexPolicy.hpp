@@ -0,0 +1,33 @@
+/**
+ * \file
+ * \brief SharedMutexPolicy enum class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_SHAREDMUTEXPOLICY_HPP_
+#define INCLUDE_DISTORTOS_SHAREDMUTEXPOLICY_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+/// policies of granting ownership of shared mutex
+enum class SharedMutexPolicy : uint8_t
+{
+	/// any thread waiting for exclusive ownership prevents new threads from acquiring shared ownership, exclusive
+	/// ownership is granted before shared ownership, similar to PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP
+	writerPreference,
+	/// ownership is granted strictly in the order of waiting threads - by their effective priority, with FIFO order
+	/// for threads of equal priority
+	fair,
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SHAREDMUTEXPOLICY_HPP_
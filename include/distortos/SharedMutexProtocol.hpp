@@ -0,0 +1,32 @@
+/**
+ * \file
+ * \brief SharedMutexProtocol enum class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_SHAREDMUTEXPROTOCOL_HPP_
+#define INCLUDE_DISTORTOS_SHAREDMUTEXPROTOCOL_HPP_
+
+#include "distortos/MutexProtocol.hpp"
+
+namespace distortos
+{
+
+/// shared mutex protocols, values are identical to corresponding values of MutexProtocol
+enum class SharedMutexProtocol : uint8_t
+{
+	/// no protocol, similar to PTHREAD_PRIO_NONE
+	none = static_cast<uint8_t>(MutexProtocol::none),
+	/// priority inheritance protocol - effective priority of the highest priority thread blocked on the shared mutex is
+	/// inherited by the thread with exclusive ownership or by the highest priority thread with shared ownership
+	priorityInheritance = static_cast<uint8_t>(MutexProtocol::priorityInheritance),
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_SHAREDMUTEXPROTOCOL_HPP_
@@ -16,6 +16,8 @@
 
 #include "distortos/internal/memory/dummyDeleter.hpp"
 
+#include <array>
+
 namespace distortos
 {
 
@@ -0,0 +1,61 @@
+/**
+ * \file
+ * \brief StaticMemoryPool class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICMEMORYPOOL_HPP_
+#define INCLUDE_DISTORTOS_STATICMEMORYPOOL_HPP_
+
+#include "distortos/MemoryPool.hpp"
+
+#include "distortos/internal/memory/dummyDeleter.hpp"
+
+#include <array>
+
+namespace distortos
+{
+
+/**
+ * \brief StaticMemoryPool class is a variant of MemoryPool that has automatic storage for blocks.
+ *
+ * \tparam T is the type of objects which will be stored in blocks, used only to select the size of single block
+ * \tparam Blocks is the number of blocks in the pool
+ *
+ * \ingroup memory
+ */
+
+template<typename T, size_t Blocks>
+class StaticMemoryPool : public MemoryPool
+{
+public:
+
+	/**
+	 * \brief StaticMemoryPool's constructor
+	 */
+
+	explicit StaticMemoryPool() :
+			MemoryPool{{storage_.data(), internal::dummyDeleter<Block>}, sizeof(T), Blocks}
+	{
+
+	}
+
+private:
+
+	static_assert(alignof(T) <= alignment, "Alignment of T is too large for MemoryPool!");
+
+	/// type of uninitialized storage for single block
+	using Block = typename std::aligned_storage<getRoundedBlockSize(sizeof(T)), alignment>::type;
+
+	/// storage for blocks
+	std::array<Block, Blocks> storage_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICMEMORYPOOL_HPP_
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief StaticMessageBuffer class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICMESSAGEBUFFER_HPP_
+#define INCLUDE_DISTORTOS_STATICMESSAGEBUFFER_HPP_
+
+#include "distortos/MessageBuffer.hpp"
+
+#include "distortos/internal/memory/dummyDeleter.hpp"
+
+#include <array>
+
+namespace distortos
+{
+
+/**
+ * \brief StaticMessageBuffer class is a variant of MessageBuffer that has automatic storage for messages.
+ *
+ * \tparam Size is the size of storage, bytes
+ *
+ * \ingroup queues
+ */
+
+template<size_t Size>
+class StaticMessageBuffer : public MessageBuffer
+{
+public:
+
+	/**
+	 * \brief StaticMessageBuffer's constructor
+	 */
+
+	explicit StaticMessageBuffer() :
+			MessageBuffer{{storage_.data(), internal::dummyDeleter<uint8_t>}, Size}
+	{
+
+	}
+
+private:
+
+	/// storage for messages
+	std::array<uint8_t, Size> storage_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICMESSAGEBUFFER_HPP_
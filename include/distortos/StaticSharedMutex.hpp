@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief StaticSharedMutex class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICSHAREDMUTEX_HPP_
+#define INCLUDE_DISTORTOS_STATICSHAREDMUTEX_HPP_
+
+#include "SharedMutex.hpp"
+
+#include "distortos/internal/memory/dummyDeleter.hpp"
+
+#include <array>
+
+namespace distortos
+{
+
+/**
+ * \brief StaticSharedMutex class is a variant of SharedMutex that has automatic storage for threads with shared
+ * ownership.
+ *
+ * \tparam MaxReaders is the maximum number of threads that can have shared ownership at the same time
+ *
+ * \ingroup synchronization
+ */
+
+template<size_t MaxReaders>
+class StaticSharedMutex : public SharedMutex
+{
+public:
+
+	/**
+	 * \brief StaticSharedMutex's constructor
+	 *
+	 * \param [in] policy is the policy of granting ownership, default - Policy::writerPreference
+	 * \param [in] protocol is the shared mutex protocol, default - Protocol::none
+	 */
+
+	explicit StaticSharedMutex(const Policy policy = Policy::writerPreference, const Protocol protocol = Protocol::none) :
+			SharedMutex{{storage_.data(), internal::dummyDeleter<Storage>}, storage_.size(), policy, protocol}
+	{
+
+	}
+
+private:
+
+	/// storage for pointers to ThreadControlBlock objects of threads with shared ownership
+	std::array<Storage, MaxReaders> storage_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICSHAREDMUTEX_HPP_
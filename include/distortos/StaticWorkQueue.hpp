@@ -0,0 +1,95 @@
+/**
+ * \file
+ * \brief StaticWorkQueue class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STATICWORKQUEUE_HPP_
+#define INCLUDE_DISTORTOS_STATICWORKQUEUE_HPP_
+
+#include "distortos/StaticThread.hpp"
+#include "distortos/WorkQueue.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief StaticWorkQueue class is a variant of WorkQueue that has its own worker thread with automatic storage for
+ * stack.
+ *
+ * \tparam StackSize is the size of stack of worker thread, bytes
+ *
+ * \ingroup synchronization
+ */
+
+template<size_t StackSize>
+class StaticWorkQueue : public WorkQueue
+{
+public:
+
+	/**
+	 * \brief StaticWorkQueue's constructor
+	 *
+	 * \param [in] priority is the priority of worker thread, 0 - lowest, UINT8_MAX - highest
+	 * \param [in] schedulingPolicy is the scheduling policy of worker thread, default - SchedulingPolicy::fifo
+	 */
+
+	explicit StaticWorkQueue(const uint8_t priority, const SchedulingPolicy schedulingPolicy = SchedulingPolicy::fifo) :
+			WorkQueue{},
+			thread_{priority, schedulingPolicy, &StaticWorkQueue::run, this}
+	{
+
+	}
+
+	/**
+	 * \brief StaticWorkQueue's destructor
+	 *
+	 * \pre Worker thread is not started or it was already terminated and joined.
+	 */
+
+	~StaticWorkQueue() = default;
+
+	/**
+	 * \brief Waits for termination of worker thread.
+	 *
+	 * Worker thread terminates only when one of executed work items calls ThisThread::exit().
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Thread::join();
+	 */
+
+	int join()
+	{
+		return thread_.join();
+	}
+
+	/**
+	 * \brief Starts worker thread.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by StaticThread::start();
+	 */
+
+	int start()
+	{
+		return thread_.start();
+	}
+
+private:
+
+	/// worker thread
+	StaticThread<StackSize, false, 0, 0, void (WorkQueue::*)(), WorkQueue*> thread_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STATICWORKQUEUE_HPP_
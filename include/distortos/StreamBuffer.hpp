@@ -0,0 +1,400 @@
+/**
+ * \file
+ * \brief StreamBuffer class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_STREAMBUFFER_HPP_
+#define INCLUDE_DISTORTOS_STREAMBUFFER_HPP_
+
+#include "distortos/internal/synchronization/StreamBufferBase.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief StreamBuffer class is a buffer for stream of bytes.
+ *
+ * Blocking read operations return when the number of bytes in the buffer reaches the trigger level (or the requested
+ * size, if it is lower than the trigger level). Blocking write operations return when all bytes are written to the
+ * buffer.
+ *
+ * Data can also be written without additional copying - reserve() returns the first contiguous free block of the
+ * buffer, which can be filled by the producer and then marked as written with commit(). This mechanism assumes that
+ * there is only one producer at a time.
+ *
+ * \ingroup queues
+ */
+
+class StreamBuffer
+{
+public:
+
+	/// unique_ptr (with deleter) to storage
+	using StorageUniquePointer = internal::StreamBufferBase::StorageUniquePointer;
+
+	/**
+	 * \brief StreamBuffer's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for data
+	 * (sufficiently large for \a size bytes) and appropriate deleter
+	 * \param [in] size is the size of storage, bytes
+	 * \param [in] triggerLevel is the number of bytes which must be available in the buffer to unblock the reader,
+	 * values outside of [1; size] range are clamped to this range, default - 1
+	 */
+
+	StreamBuffer(StorageUniquePointer&& storageUniquePointer, size_t size, size_t triggerLevel = 1);
+
+	/**
+	 * \brief Marks first \a size bytes of block returned by reserve() as written.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] size is the number of bytes that were written to the block returned by reserve()
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a size is greater than the size of block returned by reserve();
+	 */
+
+	int commit(size_t size);
+
+	/**
+	 * \return capacity of buffer, bytes
+	 */
+
+	size_t getCapacity() const
+	{
+		return streamBufferBase_.getCapacity();
+	}
+
+	/**
+	 * \return number of bytes stored in the buffer
+	 */
+
+	size_t getSize() const
+	{
+		return streamBufferBase_.getSize();
+	}
+
+	/**
+	 * \return number of bytes which must be available in the buffer to unblock the reader
+	 */
+
+	size_t getTriggerLevel() const
+	{
+		return triggerLevel_;
+	}
+
+	/**
+	 * \brief Reads data from the buffer.
+	 *
+	 * The calling thread blocks until at least `min(size, getTriggerLevel())` bytes are available, then up to \a size
+	 * bytes are read.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	std::pair<int, size_t> read(void* buffer, size_t size);
+
+	/**
+	 * \brief Reserves the first contiguous free block of the buffer.
+	 *
+	 * The block may be filled directly by the producer and then marked as written with commit(), which avoids
+	 * additional copying of data.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \return pair with pointer to the first contiguous free block of the buffer and its size, bytes (0 if the buffer
+	 * is full)
+	 */
+
+	std::pair<void*, size_t> reserve() const;
+
+	/**
+	 * \brief Sets trigger level.
+	 *
+	 * \param [in] triggerLevel is the number of bytes which must be available in the buffer to unblock the reader,
+	 * must be in [1; getCapacity()] range
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a triggerLevel is out of range;
+	 */
+
+	int setTriggerLevel(size_t triggerLevel);
+
+	/**
+	 * \brief Tries to read data from the buffer.
+	 *
+	 * Up to \a size bytes are read, trigger level is ignored.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EAGAIN - the buffer is empty;
+	 */
+
+	std::pair<int, size_t> tryRead(void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to read data from the buffer for a given duration of time.
+	 *
+	 * Works like read(), but if the timeout expires before the trigger level is reached, all available bytes are read.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal, only if no bytes were read;
+	 * - ETIMEDOUT - no data was received before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryReadFor(TickClock::duration duration, void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to read data from the buffer for a given duration of time.
+	 *
+	 * Template variant of tryReadFor(TickClock::duration, void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal, only if no bytes were read;
+	 * - ETIMEDOUT - no data was received before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, size_t> tryReadFor(const std::chrono::duration<Rep, Period> duration, void* const buffer,
+			const size_t size)
+	{
+		return tryReadFor(std::chrono::duration_cast<TickClock::duration>(duration), buffer, size);
+	}
+
+	/**
+	 * \brief Tries to read data from the buffer until a given time point.
+	 *
+	 * Works like read(), but if the timeout expires before the trigger level is reached, all available bytes are read.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal, only if no bytes were read;
+	 * - ETIMEDOUT - no data was received before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryReadUntil(TickClock::time_point timePoint, void* buffer, size_t size);
+
+	/**
+	 * \brief Tries to read data from the buffer until a given time point.
+	 *
+	 * Template variant of tryReadUntil(TickClock::time_point, void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal, only if no bytes were read;
+	 * - ETIMEDOUT - no data was received before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	std::pair<int, size_t> tryReadUntil(const std::chrono::time_point<TickClock, Duration> timePoint,
+			void* const buffer, const size_t size)
+	{
+		return tryReadUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), buffer, size);
+	}
+
+	/**
+	 * \brief Tries to write data to the buffer.
+	 *
+	 * As many bytes as possible are written.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EAGAIN - the buffer is full;
+	 */
+
+	std::pair<int, size_t> tryWrite(const void* data, size_t size);
+
+	/**
+	 * \brief Tries to write data to the buffer for a given duration of time.
+	 *
+	 * Works like write(), but the wait for free space is terminated when the timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryWriteFor(TickClock::duration duration, const void* data, size_t size);
+
+	/**
+	 * \brief Tries to write data to the buffer for a given duration of time.
+	 *
+	 * Template variant of tryWriteFor(TickClock::duration, const void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Rep is type of tick counter
+	 * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+	 *
+	 * \param [in] duration is the duration after which the wait will be terminated
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Rep, typename Period>
+	std::pair<int, size_t> tryWriteFor(const std::chrono::duration<Rep, Period> duration, const void* const data,
+			const size_t size)
+	{
+		return tryWriteFor(std::chrono::duration_cast<TickClock::duration>(duration), data, size);
+	}
+
+	/**
+	 * \brief Tries to write data to the buffer until a given time point.
+	 *
+	 * Works like write(), but the wait for free space is terminated when the timeout expires.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	std::pair<int, size_t> tryWriteUntil(TickClock::time_point timePoint, const void* data, size_t size);
+
+	/**
+	 * \brief Tries to write data to the buffer until a given time point.
+	 *
+	 * Template variant of tryWriteUntil(TickClock::time_point, const void*, size_t).
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \tparam Duration is a std::chrono::duration type used to measure duration
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the operation could not be completed before the specified timeout expired;
+	 */
+
+	template<typename Duration>
+	std::pair<int, size_t> tryWriteUntil(const std::chrono::time_point<TickClock, Duration> timePoint,
+			const void* const data, const size_t size)
+	{
+		return tryWriteUntil(std::chrono::time_point_cast<TickClock::duration>(timePoint), data, size);
+	}
+
+	/**
+	 * \brief Writes data to the buffer.
+	 *
+	 * The calling thread blocks until all bytes are written.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 */
+
+	std::pair<int, size_t> write(const void* data, size_t size);
+
+private:
+
+	/**
+	 * \brief Implementation of read(), tryReadFor() and tryReadUntil().
+	 *
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, nullptr to block without
+	 * timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes read; error codes:
+	 * - error codes returned by internal::StreamBufferBase::waitForData(), only if no bytes were read;
+	 */
+
+	std::pair<int, size_t> readImplementation(void* buffer, size_t size, const TickClock::time_point* timePoint);
+
+	/**
+	 * \brief Implementation of write(), tryWrite(), tryWriteFor() and tryWriteUntil().
+	 *
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of bytes written; error codes:
+	 * - error codes returned by internal::StreamBufferBase::waitForSpace();
+	 */
+
+	std::pair<int, size_t> writeImplementation(const void* data, size_t size, bool nonBlocking,
+			const TickClock::time_point* timePoint);
+
+	/// contained internal::StreamBufferBase object which implements base functionality
+	internal::StreamBufferBase streamBufferBase_;
+
+	/// number of bytes which must be available in the buffer to unblock the reader
+	size_t triggerLevel_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_STREAMBUFFER_HPP_
@@ -0,0 +1,109 @@
+/**
+ * \file
+ * \brief TaskResource class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_TASKRESOURCE_HPP_
+#define INCLUDE_DISTORTOS_TASKRESOURCE_HPP_
+
+#include "distortos/Mutex.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief TaskResource class is a resource shared by run-to-completion tasks, accessed according to Stack Resource
+ * Policy.
+ *
+ * Ceiling of the resource is the priority of the highest preemption level (priority of its worker thread) which uses
+ * the resource. While the resource is locked, priority of current worker thread is raised to the ceiling, so no other
+ * task which uses the resource can start. Therefore the resource is always free when a task tries to lock it - lock()
+ * never blocks and tasks executed on shared stacks never have to wait in the middle of their execution.
+ *
+ * If the ceiling is too low (resource is used by a task of preemption level above the ceiling) or the resource is also
+ * used by threads which may block while holding it, lock() fails instead of blocking.
+ *
+ * \ingroup synchronization
+ */
+
+class TaskResource
+{
+public:
+
+	/**
+	 * \brief TaskResource's constructor
+	 *
+	 * \param [in] ceiling is the ceiling of the resource - priority of the highest preemption level which uses it
+	 */
+
+	constexpr explicit TaskResource(const uint8_t ceiling) :
+			mutex_{Mutex::Type::errorChecking, Mutex::Protocol::priorityProtect, ceiling},
+			ceiling_{ceiling}
+	{
+
+	}
+
+	/**
+	 * \return ceiling of the resource
+	 */
+
+	uint8_t getCeiling() const
+	{
+		return ceiling_;
+	}
+
+	/**
+	 * \brief Locks the resource, raising priority of current thread to the ceiling.
+	 *
+	 * This function never blocks.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the resource was locked, error code otherwise:
+	 * - EBUSY - the resource is already locked, so the ceiling is too low or the resource is used by a thread which
+	 * blocked while holding it;
+	 * - EINVAL - priority of current thread is higher than the ceiling;
+	 */
+
+	int lock()
+	{
+		return mutex_.tryLock();
+	}
+
+	/**
+	 * \brief Unlocks the resource, restoring previous priority of current thread.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 if the resource was unlocked, error code otherwise:
+	 * - error codes returned by Mutex::unlock();
+	 */
+
+	int unlock()
+	{
+		return mutex_.unlock();
+	}
+
+	TaskResource(const TaskResource&) = delete;
+	TaskResource(TaskResource&&) = delete;
+	const TaskResource& operator=(const TaskResource&) = delete;
+	TaskResource& operator=(TaskResource&&) = delete;
+
+private:
+
+	/// mutex with priority protect protocol, its priority ceiling is the ceiling of the resource
+	Mutex mutex_;
+
+	/// ceiling of the resource
+	uint8_t ceiling_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_TASKRESOURCE_HPP_
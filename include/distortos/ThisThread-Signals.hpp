@@ -2,7 +2,7 @@
  * \file
  * \brief ThisThread::Signals namespace header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -55,6 +55,28 @@ namespace Signals
 
 int generateSignal(uint8_t signalNumber);
 
+/**
+ * \brief Generates signal for all threads in the thread group of current thread.
+ *
+ * Signal is generated for all threads of the group (including current thread) in single critical section, so all
+ * threads waiting for this signal are unblocked at once. This is much faster than calling Thread::generateSignal() for
+ * each thread separately.
+ *
+ * Failures for individual threads are not reported as errors - threads which cannot receive signals, which ignore the
+ * signal or for which generation failed are skipped and are only missing from the number of threads which accepted the
+ * signal. Compare this number with the expected one if each thread of the group must receive the signal.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] signalNumber is the signal that will be generated, [0; 31]
+ *
+ * \return pair with return code (0 on success, error code otherwise) and number of threads which accepted the signal;
+ * error codes:
+ * - error codes returned by internal::ThreadGroupControlBlock::generateSignal();
+ */
+
+std::pair<int, size_t> generateSignalForThreadGroup(uint8_t signalNumber);
+
 /**
  * \brief Gets set of currently pending signals for current thread.
  *
@@ -116,6 +138,30 @@ SignalSet getSignalMask();
 
 int queueSignal(uint8_t signalNumber, sigval value);
 
+/**
+ * \brief Queues signal for all threads in the thread group of current thread.
+ *
+ * Signal is queued for all threads of the group (including current thread) in single critical section, so all threads
+ * waiting for this signal are unblocked at once. This is much faster than calling Thread::queueSignal() for each thread
+ * separately.
+ *
+ * Failures for individual threads are not reported as errors - threads which cannot receive or queue signals, which
+ * ignore the signal or which have no space to queue it (Thread::queueSignal() would fail with EAGAIN) are skipped and
+ * are only missing from the number of threads which accepted the signal. Compare this number with the expected one if
+ * each thread of the group must receive the signal.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] signalNumber is the signal that will be queued, [0; 31]
+ * \param [in] value is the signal value
+ *
+ * \return pair with return code (0 on success, error code otherwise) and number of threads which accepted the signal;
+ * error codes:
+ * - error codes returned by internal::ThreadGroupControlBlock::queueSignal();
+ */
+
+std::pair<int, size_t> queueSignalForThreadGroup(uint8_t signalNumber, sigval value);
+
 /**
  * \brief Sets association for given signal number.
  *
@@ -2,7 +2,7 @@
  * \file
  * \brief ThisThread namespace header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -92,6 +92,14 @@ ThreadIdentifier getIdentifier();
 
 uint8_t getPriority();
 
+/**
+ * \warning This function must not be called from interrupt context!
+ *
+ * \return length of round-robin quantum of calling (current) thread
+ */
+
+TickClock::duration getRoundRobinQuantum();
+
 /**
  * \return scheduling policy of calling (current) thread
  */
@@ -127,6 +135,19 @@ size_t getStackSize();
 
 void setPriority(uint8_t priority, bool alwaysBehind = {});
 
+/**
+ * \brief Changes length of round-robin quantum of calling (current) thread.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] quantum is the new length of round-robin quantum of calling (current) thread, [1 tick; 255 ticks]
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by Thread::setRoundRobinQuantum();
+ */
+
+int setRoundRobinQuantum(TickClock::duration quantum);
+
 /**
  * param [in] schedulingPolicy is the new scheduling policy of calling (current) thread
  */
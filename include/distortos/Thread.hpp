@@ -2,7 +2,7 @@
  * \file
  * \brief Thread class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -17,6 +17,7 @@
 #include "distortos/SchedulingPolicy.hpp"
 #include "distortos/SignalSet.hpp"
 #include "distortos/ThreadState.hpp"
+#include "distortos/TickClock.hpp"
 
 #include <csignal>
 
@@ -121,6 +122,19 @@ public:
 
 	virtual uint8_t getPriority() const = 0;
 
+	/**
+	 * \return length of round-robin quantum of the thread
+	 */
+
+	virtual TickClock::duration getRoundRobinQuantum() const = 0;
+
+	/**
+	 * \return number of times the thread was moved to the end of the group of threads with the same priority because
+	 * its round-robin quantum was used
+	 */
+
+	virtual uint64_t getRoundRobinRotationCount() const = 0;
+
 	/**
 	 * \return scheduling policy of the thread
 	 */
@@ -205,6 +219,22 @@ public:
 
 	virtual void setPriority(uint8_t priority, bool alwaysBehind = {}) = 0;
 
+	/**
+	 * \brief Changes length of round-robin quantum of the thread.
+	 *
+	 * New length is used when the quantum is reloaded - after the thread is rotated or when its scheduling policy is
+	 * changed. If current value of quantum is greater than new length, it is truncated. Threads which use
+	 * SchedulingPolicy::fifo are not affected. To get different quantum for each priority level, set the same length
+	 * for all threads with given priority.
+	 *
+	 * \param [in] quantum is the new length of round-robin quantum of the thread, [1 tick; 255 ticks]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a quantum is out of range;
+	 */
+
+	virtual int setRoundRobinQuantum(TickClock::duration quantum) = 0;
+
 	/**
 	 * param [in] schedulingPolicy is the new scheduling policy of the thread
 	 */
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadState enum class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -43,6 +43,20 @@ enum class ThreadState : uint8_t
 	blockedOnMutex,
 	/// thread is blocked on ConditionVariable
 	blockedOnConditionVariable,
+	/// thread is blocked on EventFlags
+	blockedOnEventFlags,
+	/// thread is blocked on SharedMutex, waiting for exclusive ownership
+	blockedOnSharedMutexExclusive,
+	/// thread is blocked on SharedMutex, waiting for shared ownership
+	blockedOnSharedMutexShared,
+	/// thread is blocked while waiting for any of multiple objects
+	blockedOnMultipleObjects,
+	/// thread is blocked on Barrier
+	blockedOnBarrier,
+	/// thread is blocked while waiting for callOnce() executed by another thread
+	blockedOnOnceFlag,
+	/// thread is blocked on MessageBuffer or StreamBuffer
+	blockedOnStreamBuffer,
 
 #if CONFIG_SIGNALS_ENABLE == 1
 
@@ -0,0 +1,211 @@
+/**
+ * \file
+ * \brief WaitableObject class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_WAITABLEOBJECT_HPP_
+#define INCLUDE_DISTORTOS_WAITABLEOBJECT_HPP_
+
+#include "distortos/EventFlags.hpp"
+
+namespace distortos
+{
+
+template<typename T>
+class FifoQueue;
+
+template<typename T>
+class MessageQueue;
+
+class RawFifoQueue;
+class RawMessageQueue;
+class Semaphore;
+
+namespace devices
+{
+
+class SerialPort;
+
+}	// namespace devices
+
+/**
+ * \brief WaitableObject class is a descriptor of a single object waited for with waitForAny() and its variants
+ *
+ * The object is "ready" when the associated operation can be executed without blocking:
+ * - Semaphore - value of semaphore is not 0 (Semaphore::tryWait() would succeed),
+ * - EventFlags - wait condition for given bitmask and mode is satisfied (EventFlags::tryWait() would succeed),
+ * - FifoQueue, RawFifoQueue, MessageQueue, RawMessageQueue - queue is not empty (tryPop() would succeed),
+ * - devices::SerialPort - some data was received (read() would not block).
+ *
+ * Readiness is only reported, it is not consumed - the thread should execute non-blocking operation on the object
+ * which became ready, as another thread or interrupt may have consumed the readiness in the meantime.
+ *
+ * \ingroup synchronization
+ */
+
+class WaitableObject
+{
+public:
+
+	/**
+	 * \brief WaitableObject's constructor for Semaphore
+	 *
+	 * \param [in] semaphore is a reference to semaphore which is ready when its value is not 0
+	 */
+
+	constexpr explicit WaitableObject(const Semaphore& semaphore) :
+			semaphore_{&semaphore},
+			bitmask_{},
+			mode_{},
+			type_{Type::semaphore}
+	{
+
+	}
+
+	/**
+	 * \brief WaitableObject's constructor for EventFlags
+	 *
+	 * \param [in] eventFlags is a reference to event flags which are ready when the wait condition is satisfied
+	 * \param [in] bitmask is the bitmask of flags that are "waited for", must not be 0
+	 * \param [in] mode is the mode of waiting - any or all flags from \a bitmask
+	 */
+
+	constexpr WaitableObject(const EventFlags& eventFlags, const EventFlags::Value bitmask,
+			const EventFlags::WaitMode mode) :
+					eventFlags_{&eventFlags},
+					bitmask_{bitmask},
+					mode_{mode},
+					type_{Type::eventFlags}
+	{
+
+	}
+
+	/**
+	 * \brief WaitableObject's constructor for FifoQueue
+	 *
+	 * \tparam T is the type of data in queue
+	 *
+	 * \param [in] fifoQueue is a reference to FIFO queue which is ready when it is not empty
+	 */
+
+	template<typename T>
+	constexpr explicit WaitableObject(const FifoQueue<T>& fifoQueue) :
+			WaitableObject{fifoQueue.fifoQueueBase_.getPopSemaphore()}
+	{
+
+	}
+
+	/**
+	 * \brief WaitableObject's constructor for MessageQueue
+	 *
+	 * \tparam T is the type of data in queue
+	 *
+	 * \param [in] messageQueue is a reference to message queue which is ready when it is not empty
+	 */
+
+	template<typename T>
+	constexpr explicit WaitableObject(const MessageQueue<T>& messageQueue) :
+			WaitableObject{messageQueue.messageQueueBase_.getPopSemaphore()}
+	{
+
+	}
+
+	/**
+	 * \brief WaitableObject's constructor for RawFifoQueue
+	 *
+	 * \param [in] rawFifoQueue is a reference to raw FIFO queue which is ready when it is not empty
+	 */
+
+	explicit WaitableObject(const RawFifoQueue& rawFifoQueue);
+
+	/**
+	 * \brief WaitableObject's constructor for RawMessageQueue
+	 *
+	 * \param [in] rawMessageQueue is a reference to raw message queue which is ready when it is not empty
+	 */
+
+	explicit WaitableObject(const RawMessageQueue& rawMessageQueue);
+
+	/**
+	 * \brief WaitableObject's constructor for devices::SerialPort
+	 *
+	 * \note Readiness of serial port is reliably reported only if no other thread reads from it at the same time.
+	 *
+	 * \param [in] serialPort is a reference to serial port which is ready when some data was received
+	 */
+
+	constexpr explicit WaitableObject(devices::SerialPort& serialPort) :
+			serialPort_{&serialPort},
+			bitmask_{},
+			mode_{},
+			type_{Type::serialPort}
+	{
+
+	}
+
+	/**
+	 * \return pointer to object which is used to identify notifications about readiness
+	 */
+
+	const void* getObject() const;
+
+	/**
+	 * \return true if the object is ready, false otherwise
+	 */
+
+	bool isReady() const;
+
+	/**
+	 * \brief Prepares the object for waiting.
+	 *
+	 * Arranges notification about readiness of the object, if it is not generated automatically.
+	 *
+	 * \note This function must be called with interrupts masked.
+	 */
+
+	void prepare() const;
+
+private:
+
+	/// type of waitable object
+	enum class Type : uint8_t
+	{
+		/// Semaphore (also used for all queue types)
+		semaphore,
+		/// EventFlags
+		eventFlags,
+		/// devices::SerialPort
+		serialPort,
+	};
+
+	union
+	{
+		/// pointer to Semaphore, valid only if type_ == Type::semaphore
+		const Semaphore* semaphore_;
+
+		/// pointer to EventFlags, valid only if type_ == Type::eventFlags
+		const EventFlags* eventFlags_;
+
+		/// pointer to devices::SerialPort, valid only if type_ == Type::serialPort
+		devices::SerialPort* serialPort_;
+	};
+
+	/// bitmask of flags that are "waited for", valid only if type_ == Type::eventFlags
+	EventFlags::Value bitmask_;
+
+	/// mode of waiting, valid only if type_ == Type::eventFlags
+	EventFlags::WaitMode mode_;
+
+	/// type of waitable object
+	Type type_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WAITABLEOBJECT_HPP_
@@ -0,0 +1,84 @@
+/**
+ * \file
+ * \brief WorkItem class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_WORKITEM_HPP_
+#define INCLUDE_DISTORTOS_WORKITEM_HPP_
+
+#include "estd/IntrusiveList.hpp"
+
+namespace distortos
+{
+
+class WorkQueue;
+
+/**
+ * \brief WorkItem class is a single unit of deferred work which can be submitted to WorkQueue.
+ *
+ * Work item is a function with an argument. It doesn't allocate any memory - it is linked directly into the queue, so
+ * it must remain valid while it is queued. Typically it is an object with static storage duration owned by a driver,
+ * submitted from interrupt handler and executed later in the context of work queue's thread.
+ *
+ * \ingroup synchronization
+ */
+
+class WorkItem
+{
+	friend class WorkQueue;
+
+public:
+
+	/// type of function executed by work queue's thread, it receives the argument given during construction
+	using Function = void(void*);
+
+	/**
+	 * \brief WorkItem's constructor
+	 *
+	 * \param [in] function is a reference to function executed by work queue's thread
+	 * \param [in] argument is the argument passed to \a function, default - nullptr
+	 */
+
+	constexpr explicit WorkItem(Function& function, void* const argument = {}) :
+			node{},
+			function_{function},
+			argument_{argument}
+	{
+
+	}
+
+	/**
+	 * \return true if the work item is queued (it was submitted, but its execution didn't start yet), false otherwise
+	 */
+
+	bool isQueued() const
+	{
+		return node.isLinked();
+	}
+
+	WorkItem(const WorkItem&) = delete;
+	WorkItem(WorkItem&&) = delete;
+	const WorkItem& operator=(const WorkItem&) = delete;
+	WorkItem& operator=(WorkItem&&) = delete;
+
+	/// node for intrusive list
+	estd::IntrusiveListNode node;
+
+private:
+
+	/// reference to function executed by work queue's thread
+	Function& function_;
+
+	/// argument passed to function_
+	void* argument_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WORKITEM_HPP_
@@ -0,0 +1,118 @@
+/**
+ * \file
+ * \brief WorkQueue class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_WORKQUEUE_HPP_
+#define INCLUDE_DISTORTOS_WORKQUEUE_HPP_
+
+#include "distortos/Semaphore.hpp"
+#include "distortos/WorkItem.hpp"
+
+namespace distortos
+{
+
+/**
+ * \brief WorkQueue class is a queue of deferred work items executed in thread context.
+ *
+ * Work items are submitted (usually from interrupt handlers) with submit() and executed in FIFO order by thread(s)
+ * executing run(). Submission is a constant-time operation - work item is linked at the end of intrusive list in short
+ * critical section and the worker is woken with semaphore. Submission of work item which is already queued is coalesced
+ * - the item is executed only once. Work item may be submitted again during its execution, in that case it will be
+ * executed once more.
+ *
+ * Priority of deferred work is the priority of thread executing run(), so work items with different urgency should be
+ * submitted to different work queues. StaticWorkQueue combines work queue with its own worker thread.
+ *
+ * \ingroup synchronization
+ */
+
+class WorkQueue
+{
+public:
+
+	/**
+	 * \brief WorkQueue's constructor
+	 */
+
+	constexpr WorkQueue() :
+			list_{},
+			semaphore_{0}
+	{
+
+	}
+
+	/**
+	 * \brief WorkQueue's destructor
+	 *
+	 * \pre There are no queued work items and no threads are executing run().
+	 */
+
+	~WorkQueue() = default;
+
+	/**
+	 * \brief Cancels queued work item.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] workItem is a reference to work item which will be cancelled, it must be either queued in this work
+	 * queue or not queued at all
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a workItem is not queued;
+	 */
+
+	int cancel(WorkItem& workItem);
+
+	/**
+	 * \brief Executes work items.
+	 *
+	 * This is the function of worker thread - it waits for work items and executes them in FIFO order. It never
+	 * returns, unless the executed work item terminates the thread. This function may be executed by more than one
+	 * thread, in that case work items may be executed concurrently.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 */
+
+	void run();
+
+	/**
+	 * \brief Submits work item.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] workItem is a reference to work item which will be submitted, it must remain valid while it is queued
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EALREADY - \a workItem is already queued, so the submission was coalesced with the previous one;
+	 * - error codes returned by Semaphore::post();
+	 */
+
+	int submit(WorkItem& workItem);
+
+	WorkQueue(const WorkQueue&) = delete;
+	WorkQueue(WorkQueue&&) = delete;
+	const WorkQueue& operator=(const WorkQueue&) = delete;
+	WorkQueue& operator=(WorkQueue&&) = delete;
+
+private:
+
+	/// type of list of queued work items
+	using List = estd::IntrusiveList<WorkItem, &WorkItem::node>;
+
+	/// list of queued work items
+	List list_;
+
+	/// semaphore posted once for each submitted work item, its value may be higher after cancellation
+	Semaphore semaphore_;
+};
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WORKQUEUE_HPP_
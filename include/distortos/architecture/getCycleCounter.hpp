@@ -0,0 +1,40 @@
+/**
+ * \file
+ * \brief getCycleCounter() declaration
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_ARCHITECTURE_GETCYCLECOUNTER_HPP_
+#define INCLUDE_DISTORTOS_ARCHITECTURE_GETCYCLECOUNTER_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace architecture
+{
+
+/**
+ * \brief Gets current value of core clock cycle counter.
+ *
+ * The counter is free-running and wraps around, so only differences of two values are meaningful. This function is
+ * available only when the architecture has a cycle counter (CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER is defined). The
+ * counter is started during low-level initialization only when CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE is selected,
+ * otherwise it is not running and trace & debug blocks of the core are left in their default state.
+ *
+ * \return current value of core clock cycle counter
+ */
+
+uint32_t getCycleCounter();
+
+}	// namespace architecture
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_ARCHITECTURE_GETCYCLECOUNTER_HPP_
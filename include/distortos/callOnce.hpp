@@ -18,8 +18,6 @@
 
 #include "estd/invoke.hpp"
 
-#include <mutex>
-
 namespace distortos
 {
 
@@ -46,16 +44,14 @@ void callOnce(OnceFlag& onceFlag, Function&& function, Args&&... args)
 {
 	CHECK_FUNCTION_CONTEXT();
 
-	if (onceFlag.done_ == true)
+	if (onceFlag.isDone() == true)
 		return;
 
-	const std::lock_guard<Mutex> lockGuard {onceFlag.mutex_};
-
-	if (onceFlag.done_ == true)
+	if (onceFlag.start() == false)
 		return;
 
 	estd::invoke(std::forward<Function>(function), std::forward<Args>(args)...);
-	onceFlag.done_ = true;
+	onceFlag.finish();
 }
 
 }	// namespace distortos
@@ -0,0 +1,455 @@
+/**
+ * \file
+ * \brief CachedBlockDevice class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHEDBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHEDBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/BlockDevice.hpp"
+
+#include "distortos/Mutex.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * CachedBlockDevice class is a write-back cache layer for another block device.
+ *
+ * The cache consists of configurable number of lines, each holding one aligned block of associated block device with
+ * size of the line. Reads which hit the cache are served from memory, reads which miss it fill the lines - runs of
+ * consecutive missing lines are read from associated block device with a single operation. Programs only modify the
+ * lines and mark them as dirty - dirty lines are written back when they are evicted, when the device is synchronized
+ * and when it is closed. During write-back, dirty lines which hold consecutive blocks are gathered in adjacent slots of
+ * the cache and coalesced into a single program operation. Victim for eviction is selected with either LRU or CLOCK
+ * policy.
+ *
+ * Program block size of the device is equal to the size of cache line, so the lines are always programmed completely.
+ * Erase block size is the greater of line size and erase block size of associated block device.
+ *
+ * \note Errors of deferred programs are reported by the operation which caused the write-back - synchronize(),
+ * close() or read() / program() which evicted the dirty line.
+ *
+ * \ingroup devices
+ */
+
+class CachedBlockDevice : public BlockDevice
+{
+public:
+
+	/// policy of selecting a victim for eviction
+	enum class EvictionPolicy : uint8_t
+	{
+		/// least recently used line is evicted
+		lru,
+		/// CLOCK (second chance) approximation of LRU
+		clock,
+	};
+
+	/// descriptor of single cache line
+	struct Line
+	{
+		/// address of block cached in this line, valid only if \a valid is true
+		uint64_t address;
+
+		/// value of use counter during most recent access to this line
+		uint32_t lastUse;
+
+		/// true if this line holds data which was not yet written back, false otherwise
+		bool dirty;
+
+		/// true if this line was accessed since CLOCK hand passed it, false otherwise
+		bool referenced;
+
+		/// true if this line holds data, false otherwise
+		bool valid;
+	};
+
+	/// statistics of cache
+	struct Statistics
+	{
+		/// number of lines which were evicted to make room for other blocks
+		size_t evictions;
+
+		/// number of accesses which were served by the cache
+		size_t hits;
+
+		/// number of accesses which required filling or allocating a line
+		size_t misses;
+
+		/// number of program operations executed on associated block device during write-back
+		size_t writeBacks;
+	};
+
+	/**
+	 * \brief CachedBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 * \param [in] lines is a pointer to array of \a linesCount descriptors of cache lines
+	 * \param [in] buffer is a pointer to buffer for contents of cache lines, its size must be equal to
+	 * \a linesCount * \a lineSize
+	 * \param [in] linesCount is the number of cache lines, must not be 0
+	 * \param [in] lineSize is the size of single cache line, bytes, must be a multiple of read and program block sizes
+	 * of \a blockDevice, must be a multiple or a divisor of erase block size of \a blockDevice
+	 * \param [in] evictionPolicy is the policy of selecting a victim for eviction, default - EvictionPolicy::lru
+	 */
+
+	constexpr CachedBlockDevice(BlockDevice& blockDevice, Line* const lines, void* const buffer,
+			const size_t linesCount, const size_t lineSize, const EvictionPolicy evictionPolicy = EvictionPolicy::lru) :
+					mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+					statistics_{},
+					blockDevice_{blockDevice},
+					lines_{lines},
+					buffer_{static_cast<uint8_t*>(buffer)},
+					clockHand_{},
+					linesCount_{linesCount},
+					lineSize_{lineSize},
+					useCounter_{},
+					evictionPolicy_{evictionPolicy},
+					openCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief CachedBlockDevice's destructor
+	 *
+	 * \pre Device is closed.
+	 */
+
+	~CachedBlockDevice() override;
+
+	/**
+	 * \brief Closes cached block device.
+	 *
+	 * Last close writes back all dirty lines and closes associated block device.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is already completely closed;
+	 * - error codes returned by BlockDevice::close();
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Erases blocks on a cached block device.
+	 *
+	 * Cache lines in selected range are discarded - including dirty ones - and the range is erased on associated block
+	 * device.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of erase block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by BlockDevice::erase();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \return erase block size, bytes - the greater of cache line size and erase block size of associated block device
+	 */
+
+	size_t getEraseBlockSize() const override;
+
+	/**
+	 * \return erased value of associated block device
+	 */
+
+	std::pair<bool, uint8_t> getErasedValue() const override;
+
+	/**
+	 * \return program block size, bytes - equal to cache line size
+	 */
+
+	size_t getProgramBlockSize() const override;
+
+	/**
+	 * \return read block size of associated block device, bytes
+	 */
+
+	size_t getReadBlockSize() const override;
+
+	/**
+	 * \return size of associated block device, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \return statistics of cache
+	 */
+
+	Statistics getStatistics();
+
+	/**
+	 * \brief Locks the device for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::lock();
+	 */
+
+	int lock() override;
+
+	/**
+	 * \brief Opens cached block device.
+	 *
+	 * First open opens associated block device and checks whether its geometry is compatible with cache lines.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - size of cache line is not compatible with block sizes or size of associated block device;
+	 * - EMFILE - this device is already opened too many times;
+	 * - error codes returned by BlockDevice::open();
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Programs data to a cached block device.
+	 *
+	 * Data is copied to cache lines, which are marked as dirty - it will be programmed to associated block device
+	 * during write-back.
+	 *
+	 * \param [in] address is the address of data that will be programmed, must be a multiple of program block size
+	 * \param [in] buffer is the buffer with data that will be programmed
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of program block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of programmed bytes (valid even
+	 * when error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a buffer and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	std::pair<int, size_t> program(uint64_t address, const void* buffer, size_t size) override;
+
+	/**
+	 * \brief Reads data from a cached block device.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of read block size
+	 * \param [out] buffer is the buffer into which the data will be read
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of read block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of read bytes (valid even when
+	 * error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a buffer and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by BlockDevice::program();
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	std::pair<int, size_t> read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Resets statistics of cache.
+	 */
+
+	void resetStatistics();
+
+	/**
+	 * \brief Synchronizes state of a cached block device.
+	 *
+	 * All dirty lines are written back and associated block device is synchronized.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - error codes returned by BlockDevice::program();
+	 * - error codes returned by BlockDevice::synchronize();
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Trims unused blocks on a cached block device.
+	 *
+	 * Cache lines in selected range are discarded - including dirty ones - and the range is trimmed on associated
+	 * block device.
+	 *
+	 * \param [in] address is the address of range that will be trimmed, must be a multiple of erase block size
+	 * \param [in] size is the size of trimmed range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by BlockDevice::trim();
+	 */
+
+	int trim(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Unlocks the device which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::unlock();
+	 */
+
+	int unlock() override;
+
+private:
+
+	/**
+	 * \brief Allocates cache line for a block.
+	 *
+	 * Unused line is preferred, otherwise a victim selected with eviction policy is evicted - it is written back first
+	 * if it is dirty.
+	 *
+	 * \param [in] address is the address of block which will be cached in allocated line
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and pointer to allocated line (valid only when
+	 * 0 is returned); error codes:
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	std::pair<int, Line*> allocateLine(uint64_t address);
+
+	/**
+	 * \brief Checks whether selected range is valid.
+	 *
+	 * \param [in] address is the address of range, must be a multiple of \a blockSize
+	 * \param [in] size is the size of range, bytes, must be a multiple of \a blockSize
+	 * \param [in] blockSize is the block size of operation, bytes
+	 *
+	 * \return 0 if the range is valid, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 */
+
+	int checkRange(uint64_t address, uint64_t size, size_t blockSize) const;
+
+	/**
+	 * \brief Discards all cache lines in selected range, including dirty ones.
+	 *
+	 * \param [in] address is the address of range
+	 * \param [in] size is the size of range, bytes
+	 */
+
+	void discardLines(uint64_t address, uint64_t size);
+
+	/**
+	 * \brief Finds cache line with a block.
+	 *
+	 * \param [in] address is the address of block
+	 *
+	 * \return pointer to line with block at \a address, nullptr if the block is not cached
+	 */
+
+	Line* findLine(uint64_t address) const;
+
+	/**
+	 * \brief Writes back all dirty lines in ascending order of addresses.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	int flush();
+
+	/**
+	 * \param [in] line is a reference to cache line
+	 *
+	 * \return pointer to contents of \a line
+	 */
+
+	uint8_t* getLineBuffer(const Line& line) const
+	{
+		return buffer_ + (&line - lines_) * lineSize_;
+	}
+
+	/**
+	 * \brief Selects a victim for eviction according to eviction policy.
+	 *
+	 * \return reference to selected line
+	 */
+
+	Line& selectVictim();
+
+	/**
+	 * \brief Marks cache line as most recently used.
+	 *
+	 * \param [in] line is a reference to cache line
+	 */
+
+	void touchLine(Line& line);
+
+	/**
+	 * \brief Writes back dirty cache line.
+	 *
+	 * Dirty lines which hold consecutive blocks are coalesced with \a line into single program operation - they are
+	 * moved to adjacent slots of the cache first, so after this function returns \a line may refer to a different
+	 * block.
+	 *
+	 * \param [in] line is a reference to dirty cache line
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	int writeBack(Line& line);
+
+	/// mutex used to serialize access to this object
+	Mutex mutex_;
+
+	/// statistics of cache
+	Statistics statistics_;
+
+	/// reference to associated block device
+	BlockDevice& blockDevice_;
+
+	/// pointer to array of descriptors of cache lines
+	Line* lines_;
+
+	/// pointer to buffer for contents of cache lines
+	uint8_t* buffer_;
+
+	/// index of line pointed by CLOCK hand
+	size_t clockHand_;
+
+	/// number of cache lines
+	size_t linesCount_;
+
+	/// size of single cache line, bytes
+	size_t lineSize_;
+
+	/// use counter, incremented on each access to any line
+	uint32_t useCounter_;
+
+	/// policy of selecting a victim for eviction
+	EvictionPolicy evictionPolicy_;
+
+	/// number of times this device was opened but not yet closed
+	uint8_t openCount_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_CACHEDBLOCKDEVICE_HPP_
@@ -0,0 +1,358 @@
+/**
+ * \file
+ * \brief RamBlockDevice class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_RAMBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_RAMBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/BlockDevice.hpp"
+
+#include "distortos/Mutex.hpp"
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * RamBlockDevice class is a block device which keeps its contents in a memory buffer.
+ *
+ * The device behaves like a flash memory - read, program and erase block sizes and the value of erased bytes are
+ * configurable and each program block must be erased before it is programmed again. Number of operations and
+ * transferred bytes is counted and optional latency of each operation can be simulated, so the device can be used to
+ * test and profile consumers of BlockDevice (e.g. file systems) without real hardware, modeling timing of SD cards,
+ * EEPROMs or NOR flash.
+ *
+ * \ingroup devices
+ */
+
+class RamBlockDevice : public BlockDevice
+{
+public:
+
+	/// latencies of operations
+	struct Latencies
+	{
+		/// latency of each read operation
+		TickClock::duration read;
+
+		/// latency of each program operation
+		TickClock::duration program;
+
+		/// latency of each erase operation
+		TickClock::duration erase;
+	};
+
+	/// statistics of operations
+	struct Statistics
+	{
+		/// number of erased bytes
+		uint64_t erasedBytes;
+
+		/// number of programmed bytes
+		uint64_t programmedBytes;
+
+		/// number of read bytes
+		uint64_t readBytes;
+
+		/// number of erase operations
+		size_t erases;
+
+		/// number of program operations
+		size_t programs;
+
+		/// number of read operations
+		size_t reads;
+
+		/// number of trim operations
+		size_t trims;
+	};
+
+	/**
+	 * \brief RamBlockDevice's constructor
+	 *
+	 * \param [in] buffer is a pointer to memory buffer with contents of device
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of \a eraseBlockSize
+	 * \param [in] readBlockSize is the read block size, bytes, default - 1
+	 * \param [in] programBlockSize is the program block size, bytes, must be a multiple of \a readBlockSize,
+	 * default - 1
+	 * \param [in] eraseBlockSize is the erase block size, bytes, must be a multiple of \a programBlockSize,
+	 * default - 1
+	 * \param [in] erasedValue is the value of erased bytes, default - 0xff
+	 */
+
+	constexpr RamBlockDevice(void* const buffer, const size_t size, const size_t readBlockSize = 1,
+			const size_t programBlockSize = 1, const size_t eraseBlockSize = 1, const uint8_t erasedValue = 0xff) :
+					mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+					latencies_{},
+					statistics_{},
+					buffer_{static_cast<uint8_t*>(buffer)},
+					eraseBlockSize_{eraseBlockSize},
+					programBlockSize_{programBlockSize},
+					readBlockSize_{readBlockSize},
+					size_{size},
+					erasedValue_{erasedValue},
+					openCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief RamBlockDevice's destructor
+	 *
+	 * \pre Device is closed.
+	 */
+
+	~RamBlockDevice() override;
+
+	/**
+	 * \brief Closes RAM block device.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is already completely closed;
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Erases blocks on a RAM block device.
+	 *
+	 * Selected range is filled with erased value.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of erase block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by ThisThread::sleepFor();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \return erase block size, bytes
+	 */
+
+	size_t getEraseBlockSize() const override;
+
+	/**
+	 * \return pair with bool telling whether erased value is defined (always true) and value of erased bytes
+	 */
+
+	std::pair<bool, uint8_t> getErasedValue() const override;
+
+	/**
+	 * \return program block size, bytes
+	 */
+
+	size_t getProgramBlockSize() const override;
+
+	/**
+	 * \return read block size, bytes
+	 */
+
+	size_t getReadBlockSize() const override;
+
+	/**
+	 * \return size of RAM block device, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \return statistics of operations
+	 */
+
+	Statistics getStatistics();
+
+	/**
+	 * \brief Locks the device for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::lock();
+	 */
+
+	int lock() override;
+
+	/**
+	 * \brief Opens RAM block device.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EMFILE - this device is already opened too many times;
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Programs data to a RAM block device.
+	 *
+	 * Selected range of blocks must have been erased prior to being programmed - all bytes in this range must be equal
+	 * to erased value.
+	 *
+	 * \param [in] address is the address of data that will be programmed, must be a multiple of program block size
+	 * \param [in] buffer is the buffer with data that will be programmed
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of program block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of programmed bytes (valid even
+	 * when error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a buffer and/or \a size are not valid;
+	 * - EIO - selected range was not erased;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by ThisThread::sleepFor();
+	 */
+
+	std::pair<int, size_t> program(uint64_t address, const void* buffer, size_t size) override;
+
+	/**
+	 * \brief Reads data from a RAM block device.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of read block size
+	 * \param [out] buffer is the buffer into which the data will be read
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of read block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of read bytes (valid even when
+	 * error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a buffer and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by ThisThread::sleepFor();
+	 */
+
+	std::pair<int, size_t> read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Resets statistics of operations.
+	 */
+
+	void resetStatistics();
+
+	/**
+	 * \brief Sets simulated latencies of operations.
+	 *
+	 * Each read, program and erase operation blocks the calling thread (with the device locked) for given duration
+	 * before it is executed.
+	 *
+	 * \param [in] latencies are the new latencies of operations, zero durations disable simulation of latency
+	 */
+
+	void setLatencies(const Latencies& latencies);
+
+	/**
+	 * \brief Synchronizes state of a RAM block device - this function does nothing.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Trims unused blocks on a RAM block device - this function does nothing apart from counting the operation.
+	 *
+	 * \param [in] address is the address of range that will be trimmed, must be a multiple of erase block size
+	 * \param [in] size is the size of trimmed range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 */
+
+	int trim(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Unlocks the device which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::unlock();
+	 */
+
+	int unlock() override;
+
+private:
+
+	/**
+	 * \brief Checks whether selected range is valid.
+	 *
+	 * \param [in] address is the address of range, must be a multiple of \a blockSize
+	 * \param [in] size is the size of range, bytes, must be a multiple of \a blockSize
+	 * \param [in] blockSize is the block size of operation, bytes
+	 *
+	 * \return 0 if the range is valid, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 */
+
+	int checkRange(uint64_t address, uint64_t size, size_t blockSize) const;
+
+	/**
+	 * \brief Simulates latency of an operation.
+	 *
+	 * \param [in] latency is the latency of operation
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by ThisThread::sleepFor();
+	 */
+
+	static int simulateLatency(TickClock::duration latency);
+
+	/// mutex used to serialize access to this object
+	Mutex mutex_;
+
+	/// simulated latencies of operations
+	Latencies latencies_;
+
+	/// statistics of operations
+	Statistics statistics_;
+
+	/// pointer to memory buffer with contents of device
+	uint8_t* buffer_;
+
+	/// erase block size, bytes
+	size_t eraseBlockSize_;
+
+	/// program block size, bytes
+	size_t programBlockSize_;
+
+	/// read block size, bytes
+	size_t readBlockSize_;
+
+	/// size of device, bytes
+	size_t size_;
+
+	/// value of erased bytes
+	uint8_t erasedValue_;
+
+	/// number of times this device was opened but not yet closed
+	uint8_t openCount_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_RAMBLOCKDEVICE_HPP_
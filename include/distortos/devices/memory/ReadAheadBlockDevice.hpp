@@ -0,0 +1,299 @@
+/**
+ * \file
+ * \brief ReadAheadBlockDevice class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_READAHEADBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_READAHEADBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/BlockDevice.hpp"
+
+#include "distortos/Mutex.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * ReadAheadBlockDevice class is a sequential read-ahead layer for another block device.
+ *
+ * When a read starts exactly where the previous one ended, the access is considered sequential and the data following
+ * the requested range is prefetched into the buffer with a single read operation of associated block device (for
+ * SpiSdMmcCard this is a single CMD18 multi-block read). Following reads are served from the buffer. The size of
+ * prefetch window starts at a quarter of the buffer and is doubled with each prefetch of a sequential stream, up to
+ * the size of the buffer - any non-sequential read resets it. Sequential reads which are not smaller than the window
+ * bypass the buffer and are read directly.
+ *
+ * Program, erase and trim operations are forwarded to associated block device and invalidate the buffer if they
+ * overlap with it.
+ *
+ * \ingroup devices
+ */
+
+class ReadAheadBlockDevice : public BlockDevice
+{
+public:
+
+	/// statistics of read-ahead
+	struct Statistics
+	{
+		/// number of reads which were served completely from the buffer
+		size_t hits;
+
+		/// number of reads which required access to associated block device
+		size_t misses;
+
+		/// number of prefetch operations
+		size_t prefetches;
+	};
+
+	/**
+	 * \brief ReadAheadBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 * \param [in] buffer is a pointer to buffer for prefetched data
+	 * \param [in] bufferSize is the size of \a buffer, bytes, must not be less than read block size of \a blockDevice
+	 */
+
+	constexpr ReadAheadBlockDevice(BlockDevice& blockDevice, void* const buffer, const size_t bufferSize) :
+			mutex_{Mutex::Type::recursive, Mutex::Protocol::priorityInheritance},
+			statistics_{},
+			blockDevice_{blockDevice},
+			bufferAddress_{},
+			nextAddress_{},
+			buffer_{static_cast<uint8_t*>(buffer)},
+			bufferedSize_{},
+			bufferSize_{bufferSize},
+			windowSize_{},
+			openCount_{}
+	{
+
+	}
+
+	/**
+	 * \brief ReadAheadBlockDevice's destructor
+	 *
+	 * \pre Device is closed.
+	 */
+
+	~ReadAheadBlockDevice() override;
+
+	/**
+	 * \brief Closes read-ahead block device.
+	 *
+	 * Last close closes associated block device.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is already completely closed;
+	 * - error codes returned by BlockDevice::close();
+	 */
+
+	int close() override;
+
+	/**
+	 * \brief Erases blocks on associated block device.
+	 *
+	 * \param [in] address is the address of range that will be erased, must be a multiple of erase block size
+	 * \param [in] size is the size of erased range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - error codes returned by BlockDevice::erase();
+	 */
+
+	int erase(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \return erase block size of associated block device, bytes
+	 */
+
+	size_t getEraseBlockSize() const override;
+
+	/**
+	 * \return erased value of associated block device
+	 */
+
+	std::pair<bool, uint8_t> getErasedValue() const override;
+
+	/**
+	 * \return program block size of associated block device, bytes
+	 */
+
+	size_t getProgramBlockSize() const override;
+
+	/**
+	 * \return read block size of associated block device, bytes
+	 */
+
+	size_t getReadBlockSize() const override;
+
+	/**
+	 * \return size of associated block device, bytes
+	 */
+
+	uint64_t getSize() const override;
+
+	/**
+	 * \return statistics of read-ahead
+	 */
+
+	Statistics getStatistics();
+
+	/**
+	 * \brief Locks the device for exclusive use by current thread.
+	 *
+	 * When the object is locked, any call to any member function from other thread will be blocked until the object is
+	 * unlocked. Locking is optional, but may be useful when more than one transaction must be done atomically.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::lock();
+	 */
+
+	int lock() override;
+
+	/**
+	 * \brief Opens read-ahead block device.
+	 *
+	 * First open opens associated block device and checks whether the buffer can hold at least one read block.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - buffer is smaller than read block size of associated block device;
+	 * - EMFILE - this device is already opened too many times;
+	 * - error codes returned by BlockDevice::open();
+	 */
+
+	int open() override;
+
+	/**
+	 * \brief Programs data to associated block device.
+	 *
+	 * \param [in] address is the address of data that will be programmed, must be a multiple of program block size
+	 * \param [in] buffer is the buffer with data that will be programmed
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of program block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of programmed bytes (valid even
+	 * when error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - error codes returned by BlockDevice::program();
+	 */
+
+	std::pair<int, size_t> program(uint64_t address, const void* buffer, size_t size) override;
+
+	/**
+	 * \brief Reads data from read-ahead block device.
+	 *
+	 * \param [in] address is the address of data that will be read, must be a multiple of read block size
+	 * \param [out] buffer is the buffer into which the data will be read
+	 * \param [in] size is the size of \a buffer, bytes, must be a multiple of read block size
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of read bytes (valid even when
+	 * error code is returned); error codes:
+	 * - EBADF - the device is not opened;
+	 * - EINVAL - \a address and/or \a buffer and/or \a size are not valid;
+	 * - ENOSPC - selected range is greater than size of device;
+	 * - error codes returned by BlockDevice::read();
+	 */
+
+	std::pair<int, size_t> read(uint64_t address, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Resets statistics of read-ahead.
+	 */
+
+	void resetStatistics();
+
+	/**
+	 * \brief Synchronizes state of associated block device.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - error codes returned by BlockDevice::synchronize();
+	 */
+
+	int synchronize() override;
+
+	/**
+	 * \brief Trims unused blocks on associated block device.
+	 *
+	 * \param [in] address is the address of range that will be trimmed, must be a multiple of erase block size
+	 * \param [in] size is the size of trimmed range, bytes, must be a multiple of erase block size
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the device is not opened;
+	 * - error codes returned by BlockDevice::trim();
+	 */
+
+	int trim(uint64_t address, uint64_t size) override;
+
+	/**
+	 * \brief Unlocks the device which was previously locked by current thread.
+	 *
+	 * \note Locks are recursive.
+	 *
+	 * \warning This function must not be called from interrupt context!
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Mutex::unlock();
+	 */
+
+	int unlock() override;
+
+private:
+
+	/**
+	 * \brief Invalidates the buffer if it overlaps with selected range.
+	 *
+	 * \param [in] address is the address of range
+	 * \param [in] size is the size of range, bytes
+	 */
+
+	void invalidate(uint64_t address, uint64_t size);
+
+	/// mutex used to serialize access to this object
+	Mutex mutex_;
+
+	/// statistics of read-ahead
+	Statistics statistics_;
+
+	/// reference to associated block device
+	BlockDevice& blockDevice_;
+
+	/// address of data in the buffer
+	uint64_t bufferAddress_;
+
+	/// address at which next sequential read is expected
+	uint64_t nextAddress_;
+
+	/// pointer to buffer for prefetched data
+	uint8_t* buffer_;
+
+	/// size of valid data in the buffer, bytes
+	size_t bufferedSize_;
+
+	/// size of buffer for prefetched data, bytes
+	size_t bufferSize_;
+
+	/// current size of prefetch window, bytes, 0 if access is not sequential
+	size_t windowSize_;
+
+	/// number of times this device was opened but not yet closed
+	uint8_t openCount_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_READAHEADBLOCKDEVICE_HPP_
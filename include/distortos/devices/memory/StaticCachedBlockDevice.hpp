@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief StaticCachedBlockDevice class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICCACHEDBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICCACHEDBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/CachedBlockDevice.hpp"
+
+#include <array>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief StaticCachedBlockDevice class is a variant of CachedBlockDevice that has automatic storage for cache lines.
+ *
+ * \tparam LinesCount is the number of cache lines
+ * \tparam LineSize is the size of single cache line, bytes
+ *
+ * \ingroup devices
+ */
+
+template<size_t LinesCount, size_t LineSize>
+class StaticCachedBlockDevice : public CachedBlockDevice
+{
+	static_assert(LinesCount != 0, "Number of cache lines must not be 0!");
+	static_assert(LineSize != 0, "Size of cache line must not be 0!");
+
+public:
+
+	/**
+	 * \brief StaticCachedBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 * \param [in] evictionPolicy is the policy of selecting a victim for eviction, default - EvictionPolicy::lru
+	 */
+
+	explicit StaticCachedBlockDevice(BlockDevice& blockDevice,
+			const EvictionPolicy evictionPolicy = EvictionPolicy::lru) :
+			CachedBlockDevice{blockDevice, lines_.data(), buffer_.data(), LinesCount, LineSize, evictionPolicy}
+	{
+
+	}
+
+private:
+
+	/// storage for contents of cache lines
+	std::array<uint8_t, LinesCount * LineSize> buffer_;
+
+	/// storage for descriptors of cache lines
+	std::array<Line, LinesCount> lines_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICCACHEDBLOCKDEVICE_HPP_
@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief StaticReadAheadBlockDevice class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICREADAHEADBLOCKDEVICE_HPP_
+#define INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICREADAHEADBLOCKDEVICE_HPP_
+
+#include "distortos/devices/memory/ReadAheadBlockDevice.hpp"
+
+#include <array>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * \brief StaticReadAheadBlockDevice class is a variant of ReadAheadBlockDevice that has automatic storage for
+ * prefetched data.
+ *
+ * \tparam BufferSize is the size of buffer for prefetched data, bytes
+ *
+ * \ingroup devices
+ */
+
+template<size_t BufferSize>
+class StaticReadAheadBlockDevice : public ReadAheadBlockDevice
+{
+	static_assert(BufferSize != 0, "Size of buffer must not be 0!");
+
+public:
+
+	/**
+	 * \brief StaticReadAheadBlockDevice's constructor
+	 *
+	 * \param [in] blockDevice is a reference to associated block device
+	 */
+
+	explicit StaticReadAheadBlockDevice(BlockDevice& blockDevice) :
+			ReadAheadBlockDevice{blockDevice, buffer_.data(), BufferSize}
+	{
+
+	}
+
+private:
+
+	/// storage for prefetched data
+	std::array<uint8_t, BufferSize> buffer_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_DEVICES_MEMORY_STATICREADAHEADBLOCKDEVICE_HPP_
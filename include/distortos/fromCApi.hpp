@@ -2,7 +2,7 @@
  * \file
  * \brief Definitions of fromCApi() converter functions
  *
- * \author Copyright (C) 2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2017-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -16,6 +16,7 @@ extern "C"
 {
 
 struct distortos_ConditionVariable;
+struct distortos_EventFlags;
 struct distortos_Mutex;
 struct distortos_Semaphore;
 
@@ -25,6 +26,7 @@ namespace distortos
 {
 
 class ConditionVariable;
+class EventFlags;
 class Mutex;
 class Semaphore;
 
@@ -54,6 +56,32 @@ inline static const distortos::ConditionVariable& fromCApi(const distortos_Condi
 	return reinterpret_cast<const distortos::ConditionVariable&>(conditionVariable);
 }
 
+/**
+ * \brief Casts C-API distortos_EventFlags to distortos::EventFlags.
+ *
+ * \param [in] eventFlags is a reference to distortos_EventFlags object
+ *
+ * \return reference to distortos::EventFlags object, casted from \a eventFlags
+ */
+
+inline static distortos::EventFlags& fromCApi(distortos_EventFlags& eventFlags)
+{
+	return reinterpret_cast<distortos::EventFlags&>(eventFlags);
+}
+
+/**
+ * \brief Casts const C-API distortos_EventFlags to const distortos::EventFlags.
+ *
+ * \param [in] eventFlags is a const reference to distortos_EventFlags object
+ *
+ * \return const reference to distortos::EventFlags object, casted from \a eventFlags
+ */
+
+inline static const distortos::EventFlags& fromCApi(const distortos_EventFlags& eventFlags)
+{
+	return reinterpret_cast<const distortos::EventFlags&>(eventFlags);
+}
+
 /**
  * \brief Casts C-API distortos_Mutex to distortos::Mutex.
  *
@@ -2,7 +2,7 @@
  * \file
  * \brief DeferredThreadDeleter class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -16,7 +16,7 @@
 
 #ifdef CONFIG_THREAD_DETACH_ENABLE
 
-#include "distortos/Mutex.hpp"
+#include "distortos/internal/scheduler/ThreadList.hpp"
 
 namespace distortos
 {
@@ -24,7 +24,14 @@ namespace distortos
 namespace internal
 {
 
-/// DeferredThreadDeleter class can be used to defer deletion of dynamic detached threads
+/**
+ * \brief DeferredThreadDeleter class can be used to defer deletion of dynamic detached threads
+ *
+ * Terminated threads are added to internal list without locking any mutex - interrupts are masked for a constant time
+ * instead - so exiting threads never block on the allocator. Threads are deleted in batches by tryCleanup(), which is
+ * called at safe points - by idle thread and (if TLSF heap is enabled) at the beginning of each allocation.
+ */
+
 class DeferredThreadDeleter
 {
 public:
@@ -35,7 +42,6 @@ public:
 
 	constexpr DeferredThreadDeleter() :
 			list_{},
-			mutex_{Mutex::Protocol::priorityInheritance},
 			notEmpty_{}
 	{
 
@@ -46,42 +52,21 @@ public:
 	 *
 	 * Adds thread to internal list of threads scheduled for deferred deletion and marks the list as "not empty".
 	 *
-	 * \note The object must be locked (with a successful call to DeferredThreadDeleter::lock()) before this function is
-	 * used!
+	 * \note This function may be called with masked interrupts, it never blocks.
 	 *
 	 * \param [in] threadControlBlock is a reference to ThreadControlBlock object associated with dynamic and detached
 	 * thread that has terminated its execution
-	 *
-	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by Mutex::unlock();
-	 */
-
-	int operator()(ThreadControlBlock& threadControlBlock);
-
-	/**
-	 * \brief Locks the object, preparing it for adding thread to internal list.
-	 *
-	 * Locks the mutex that synchronizes access to internal list. Locking (performed in this function) and unlocking
-	 * (performed at the end of function call operator) are separated, because the locking must be done while the thread
-	 * is still runnable, while the transfer to internal list is performed when the thread is not in this state.
-	 *
-	 * \note This function must be called before function call operator is used!
-	 *
-	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by Mutex::lock();
 	 */
 
-	int lock();
+	void operator()(ThreadControlBlock& threadControlBlock);
 
 	/**
 	 * \brief Tries to perform deferred deletion of threads.
 	 *
-	 * Does nothing is the list is not marked as "not empty". Otherwise this function first tries to lock following two
-	 * mutexes:
-	 * - mutex that protects dynamic memory allocator;
-	 * - mutex that synchronizes access to list of threads scheduled for deferred deletion;
-	 * If any Mutex::tryLock() call fails, this function just returns (unlocking any mutexes is necessary). Otherwise
-	 * the threads are removed from the list and deleted, while the list's "not empty" marker is cleared.
+	 * Does nothing is the list is not marked as "not empty". Otherwise this function first tries to lock mutex that
+	 * protects dynamic memory allocator. If Mutex::tryLock() call fails, this function just returns. Otherwise all
+	 * threads are removed from the list at once, the list's "not empty" marker is cleared and the threads are deleted
+	 * with the mutex locked only once for the whole batch.
 	 *
 	 * \return 0 on success, error code otherwise:
 	 * - error codes returned by Mutex::tryLock();
@@ -92,22 +77,9 @@ public:
 
 private:
 
-	/**
-	 * \brief Internals of tryCleanup().
-	 *
-	 * \return 0 on success, error code otherwise:
-	 * - error codes returned by Mutex::tryLock();
-	 * - error codes returned by Mutex::unlock();
-	 */
-
-	int tryCleanupInternal();
-
-	/// list of threads scheduled for deferred deletion
+	/// list of threads scheduled for deferred deletion, protected with interrupt masking
 	ThreadList::UnsortedIntrusiveList list_;
 
-	/// mutex that synchronizes access to the \a list_
-	Mutex mutex_;
-
 	/// true if \a list_ is not empty, false otherwise
 	volatile bool notEmpty_;
 };
@@ -0,0 +1,249 @@
+/**
+ * \file
+ * \brief HeapArenaControlBlock class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPARENACONTROLBLOCK_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPARENACONTROLBLOCK_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include "distortos/Mutex.hpp"
+
+#include "estd/IntrusiveList.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/**
+ * \brief HeapArenaControlBlock class is a control block of HeapArena.
+ *
+ * The arena is a TlsfHeap with its own mutex, which is used by a group of threads instead of the main heap. Memory of
+ * the arena is provided with initialize(), which also adds the arena to the global list of arenas, so that blocks can
+ * be matched with their arena with find().
+ *
+ * Blocks may be freed by any thread - the ones which don't use the arena call queueFree(), which doesn't lock the mutex
+ * of the arena. Queued blocks are returned to the arena during next allocate(), free() or reallocate().
+ */
+
+class HeapArenaControlBlock
+{
+public:
+
+	/**
+	 * \brief HeapArenaControlBlock's constructor
+	 *
+	 * \param [in] size is the size of memory of the arena which will be allocated from the main heap, bytes
+	 */
+
+	constexpr explicit HeapArenaControlBlock(const size_t size) :
+			node{},
+			tlsfHeap_{},
+			mutex_{Mutex::Protocol::priorityInheritance},
+			memory_{},
+			queuedFreeList_{},
+			size_{size}
+	{
+
+	}
+
+	/**
+	 * \brief HeapArenaControlBlock's destructor
+	 *
+	 * Removes the arena from the global list of arenas and frees its memory back to the main heap.
+	 *
+	 * \warning Arena must not be used by any thread and all blocks allocated from it must be already freed.
+	 */
+
+	~HeapArenaControlBlock();
+
+	/**
+	 * \brief Allocates a block of memory from the arena.
+	 *
+	 * Queued blocks are freed before the allocation.
+	 *
+	 * \note This function must be called with locked mutex of the arena, the arena must be initialized.
+	 *
+	 * \param [in] alignment is the required alignment of the block, must be a power of 2
+	 * \param [in] size is the size of requested block, bytes
+	 *
+	 * \return pointer to allocated block, nullptr if the arena has no free block large enough
+	 */
+
+	void* allocate(size_t alignment, size_t size);
+
+	/**
+	 * \param [in] memory is a pointer to block
+	 *
+	 * \return true if \a memory is inside the arena, false otherwise
+	 */
+
+	bool contains(const void* const memory) const
+	{
+		const auto address = reinterpret_cast<uintptr_t>(memory);
+		const auto begin = reinterpret_cast<uintptr_t>(memory_);
+		return address >= begin && address < begin + size_ && memory_ != nullptr;
+	}
+
+	/**
+	 * \brief Finds initialized arena which contains given block.
+	 *
+	 * \param [in] memory is a pointer to block
+	 *
+	 * \return pointer to arena which contains \a memory, nullptr if \a memory is not inside any arena
+	 */
+
+	static HeapArenaControlBlock* find(const void* memory);
+
+	/**
+	 * \brief Frees a block of memory to the arena.
+	 *
+	 * Queued blocks are also freed.
+	 *
+	 * \note This function must be called with locked mutex of the arena.
+	 *
+	 * \param [in] memory is a pointer to block which was allocated from this arena
+	 */
+
+	void free(void* memory);
+
+	/**
+	 * \return reference to mutex of the arena
+	 */
+
+	Mutex& getMutex()
+	{
+		return mutex_;
+	}
+
+	/**
+	 * \return size of memory of the arena, bytes
+	 */
+
+	size_t getSize() const
+	{
+		return size_;
+	}
+
+	/**
+	 * \return const reference to internal TlsfHeap object
+	 */
+
+	const TlsfHeap& getTlsfHeap() const
+	{
+		return tlsfHeap_;
+	}
+
+	/**
+	 * \brief Initializes the arena.
+	 *
+	 * On success the arena is added to the global list of arenas.
+	 *
+	 * \note This function must be called with locked mutex of the arena.
+	 *
+	 * \param [in] memory is a pointer to memory of the arena allocated from the main heap, its size must be equal to
+	 * getSize()
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by TlsfHeap::initialize();
+	 */
+
+	int initialize(void* memory);
+
+	/**
+	 * \return true if the arena is initialized, false otherwise
+	 */
+
+	bool isInitialized() const
+	{
+		return memory_ != nullptr;
+	}
+
+	/**
+	 * \brief Queues a block of memory which will be freed to the arena later.
+	 *
+	 * This function doesn't lock the mutex of the arena - the block is added to the list of queued blocks with
+	 * interrupts masked for a constant time. It is used by threads which don't use the arena.
+	 *
+	 * \param [in] memory is a pointer to block which was allocated from this arena
+	 */
+
+	void queueFree(void* memory);
+
+	/**
+	 * \brief Changes size of block of memory allocated from the arena.
+	 *
+	 * Queued blocks are freed before the reallocation.
+	 *
+	 * \note This function must be called with locked mutex of the arena.
+	 *
+	 * \param [in] memory is a pointer to block which was allocated from this arena
+	 * \param [in] size is the new size of block, bytes, must not be 0
+	 *
+	 * \return pointer to resized block, nullptr if the block could not be resized in the arena (in that case \a memory
+	 * is not freed)
+	 */
+
+	void* reallocate(void* memory, size_t size);
+
+	HeapArenaControlBlock(const HeapArenaControlBlock&) = delete;
+	HeapArenaControlBlock(HeapArenaControlBlock&&) = delete;
+	const HeapArenaControlBlock& operator=(const HeapArenaControlBlock&) = delete;
+	HeapArenaControlBlock& operator=(HeapArenaControlBlock&&) = delete;
+
+	/// node for intrusive list
+	estd::IntrusiveListNode node;
+
+private:
+
+	/// queued block - stored in memory of the block itself
+	struct QueuedFree
+	{
+		/// pointer to next queued block, nullptr if this is the last one
+		QueuedFree* next;
+	};
+
+	/**
+	 * \brief Frees all queued blocks to the arena.
+	 *
+	 * \note This function must be called with locked mutex of the arena.
+	 */
+
+	void freeQueued();
+
+	/// internal TlsfHeap object
+	TlsfHeap tlsfHeap_;
+
+	/// mutex of the arena
+	Mutex mutex_;
+
+	/// memory of the arena, nullptr if the arena is not initialized
+	void* memory_;
+
+	/// list of queued blocks
+	QueuedFree* queuedFreeList_;
+
+	/// size of memory of the arena, bytes
+	size_t size_;
+};
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPARENACONTROLBLOCK_HPP_
@@ -0,0 +1,374 @@
+/**
+ * \file
+ * \brief TlsfHeap class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_MEMORY_TLSFHEAP_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_MEMORY_TLSFHEAP_HPP_
+
+#include <utility>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/**
+ * \brief TlsfHeap class is a heap with "two-level segregated fit" (TLSF) allocation algorithm.
+ *
+ * Free blocks are kept in an array of segregated lists - the first level splits sizes in powers of two, the second
+ * level splits each power of two into TlsfHeap::secondLevelIndexCount linear ranges. Non-empty lists are marked in
+ * bitmaps, so a list with suitable free block is found with a few bit-scan instructions. Freed blocks are immediately
+ * merged with their physical neighbours. Thanks to that allocate(), allocateAligned(), free() and reallocate() (when
+ * it doesn't need to copy data) execute in constant time, independent from the number of blocks in the heap, and
+ * fragmentation stays bounded.
+ *
+ * Each block has a header of two words - pointer to previous physical block and size of the block. Each allocated
+ * block is aligned to TlsfHeap::alignment.
+ *
+ * The object doesn't provide any synchronization - it must be done by the user.
+ */
+
+class TlsfHeap
+{
+public:
+
+	/// alignment of each allocated block, bytes
+	constexpr static size_t alignment {alignof(std::max_align_t)};
+
+	/// log2 of number of second level lists in each first level range
+	constexpr static uint8_t secondLevelIndexLog2 {4};
+
+	/// number of second level lists in each first level range
+	constexpr static uint8_t secondLevelIndexCount {1 << secondLevelIndexLog2};
+
+	/// log2 of the limit for the size of any block in the heap (the size is always lower than this limit)
+	constexpr static uint8_t maxBlockSizeLog2 {sizeof(size_t) * CHAR_BIT - 3};
+
+	/// max size of single allocation, bytes
+	constexpr static size_t maxAllocationSize {(static_cast<size_t>(1) << (maxBlockSizeLog2 - 1)) - alignment};
+
+	/// summary of free blocks of the heap
+	struct FreeBlocksSummary
+	{
+		/// number of free blocks
+		size_t count;
+
+		/// size of the largest free block, bytes
+		size_t largestSize;
+
+		/// sum of sizes of all free blocks, bytes
+		size_t totalSize;
+	};
+
+	/**
+	 * \brief TlsfHeap's constructor
+	 *
+	 * Constructs an empty heap - it must be initialized with initialize() before it can be used.
+	 */
+
+	constexpr TlsfHeap() :
+			freeLists_{},
+			secondLevelBitmaps_{},
+			allocationCount_{},
+			failedAllocationCount_{},
+			freeCount_{},
+			firstLevelBitmap_{},
+			maxUsedSize_{},
+			size_{},
+			usedSize_{}
+	{
+
+	}
+
+	/**
+	 * \brief Allocates a block of memory.
+	 *
+	 * \param [in] size is the size of requested block, bytes, 0 is treated as the smallest possible block
+	 *
+	 * \return pointer to allocated block aligned to TlsfHeap::alignment, nullptr if there is no free block large
+	 * enough or \a size is greater than TlsfHeap::maxAllocationSize
+	 */
+
+	void* allocate(size_t size);
+
+	/**
+	 * \brief Allocates a block of memory with given alignment.
+	 *
+	 * \param [in] requiredAlignment is the required alignment of the block, must be a power of 2
+	 * \param [in] size is the size of requested block, bytes, 0 is treated as the smallest possible block
+	 *
+	 * \return pointer to allocated block aligned to \a requiredAlignment (and at least to TlsfHeap::alignment),
+	 * nullptr if \a requiredAlignment is invalid, there is no free block large enough or the request is too large
+	 */
+
+	void* allocateAligned(size_t requiredAlignment, size_t size);
+
+	/**
+	 * \brief Frees a block of memory.
+	 *
+	 * \param [in] memory is a pointer to block which was allocated from this heap, nullptr is ignored
+	 */
+
+	void free(void* memory);
+
+	/**
+	 * \return number of successful allocations
+	 */
+
+	uint64_t getAllocationCount() const
+	{
+		return allocationCount_;
+	}
+
+	/**
+	 * \return number of allocations which failed because there was no free block large enough or the request was too
+	 * large
+	 */
+
+	uint64_t getFailedAllocationCount() const
+	{
+		return failedAllocationCount_;
+	}
+
+	/**
+	 * \return number of deallocations
+	 */
+
+	uint64_t getFreeCount() const
+	{
+		return freeCount_;
+	}
+
+	/**
+	 * \return max sum of sizes of all allocated blocks ("high-water mark"), bytes
+	 */
+
+	size_t getMaxUsedSize() const
+	{
+		return maxUsedSize_;
+	}
+
+	/**
+	 * \return size of the heap (sum of sizes of all blocks and their headers), bytes, 0 if the heap is not initialized
+	 */
+
+	size_t getSize() const
+	{
+		return size_;
+	}
+
+	/**
+	 * \return sum of sizes of all allocated blocks (without headers), bytes
+	 */
+
+	size_t getUsedSize() const
+	{
+		return usedSize_;
+	}
+
+	/**
+	 * \param [in] memory is a pointer to block which was allocated from this heap
+	 *
+	 * \return size of block pointed by \a memory which can be used by the caller, bytes, not smaller than requested
+	 */
+
+	static size_t getUsableSize(const void* memory);
+
+	/**
+	 * \brief Initializes the heap with given memory.
+	 *
+	 * Any previous contents of the heap and all statistics are discarded.
+	 *
+	 * \param [in] buffer is a pointer to memory used by the heap
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a buffer is too small;
+	 */
+
+	int initialize(void* buffer, size_t size);
+
+	/**
+	 * \brief Changes size of allocated block of memory.
+	 *
+	 * If possible, the block is resized in-place - it is shrunk or merged with following free block. Otherwise new
+	 * block is allocated, contents of old block are copied to it and old block is freed.
+	 *
+	 * \param [in] memory is a pointer to block which was allocated from this heap, nullptr is equivalent to
+	 * allocate(size)
+	 * \param [in] size is the new size of block, bytes, 0 is equivalent to free(memory)
+	 *
+	 * \return pointer to resized block, nullptr if \a size is 0 or if the block could not be resized (in that case
+	 * \a memory is not freed)
+	 */
+
+	void* reallocate(void* memory, size_t size);
+
+	/**
+	 * \brief Resets statistics of the heap.
+	 *
+	 * All counters are zeroed and "high-water mark" is set to current sum of sizes of all allocated blocks.
+	 */
+
+	void resetStatistics();
+
+	/**
+	 * \brief Summarizes free blocks of the heap.
+	 *
+	 * \warning Execution time of this function is proportional to the number of free blocks.
+	 *
+	 * \return summary of free blocks of the heap
+	 */
+
+	FreeBlocksSummary summarizeFreeBlocks() const;
+
+	TlsfHeap(const TlsfHeap&) = delete;
+	TlsfHeap(TlsfHeap&&) = delete;
+	const TlsfHeap& operator=(const TlsfHeap&) = delete;
+	TlsfHeap& operator=(TlsfHeap&&) = delete;
+
+private:
+
+	struct Block;
+
+	/// type of bitmap of non-empty lists
+	using Bitmap = unsigned long;
+
+	/// log2 of TlsfHeap::alignment
+	constexpr static uint8_t alignmentLog2 {__builtin_ctz(alignment)};
+
+	/// shift between size and first level index
+	constexpr static uint8_t firstLevelShift {secondLevelIndexLog2 + alignmentLog2};
+
+	/// number of first level ranges, the first one contains blocks smaller than (1 << firstLevelShift)
+	constexpr static uint8_t firstLevelIndexCount {maxBlockSizeLog2 - firstLevelShift + 1};
+
+	static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of 2!");
+	static_assert(firstLevelIndexCount <= sizeof(Bitmap) * CHAR_BIT, "Bitmap type is too small!");
+	static_assert(secondLevelIndexCount <= sizeof(Bitmap) * CHAR_BIT, "Bitmap type is too small!");
+
+	/**
+	 * \brief Converts size of block to indexes of associated list of free blocks.
+	 *
+	 * \param [in] size is the size of block, bytes
+	 *
+	 * \return pair with first level index and second level index
+	 */
+
+	static std::pair<uint8_t, uint8_t> getIndexes(size_t size);
+
+	/**
+	 * \brief Finds and removes free block which is large enough for given size.
+	 *
+	 * The size is rounded up to the beginning of next second level range, so any block on the selected list is large
+	 * enough - no search through the list is needed.
+	 *
+	 * \param [in] size is the required size of block, bytes
+	 *
+	 * \return pointer to removed free block, nullptr if there is no suitable block
+	 */
+
+	Block* extractFreeBlock(size_t size);
+
+	/**
+	 * \brief Adds free block to the appropriate list.
+	 *
+	 * \param [in] block is a reference to free block
+	 */
+
+	void insertFreeBlock(Block& block);
+
+	/**
+	 * \brief Merges free block with its physical neighbours if they are free.
+	 *
+	 * \param [in] block is a reference to free block which is not on any list
+	 *
+	 * \return reference to merged free block, which is not on any list
+	 */
+
+	Block& mergeFreeBlock(Block& block);
+
+	/**
+	 * \brief Removes free block from its list.
+	 *
+	 * \param [in] block is a reference to free block
+	 */
+
+	void removeFreeBlock(Block& block);
+
+	/**
+	 * \brief Marks block as used and trims it, returning excess memory to the heap.
+	 *
+	 * \param [in] block is a reference to block which is not on any list
+	 * \param [in] size is the required size of block, bytes, already adjusted with adjustSize()
+	 *
+	 * \return pointer to memory of the block
+	 */
+
+	void* useBlock(Block& block, size_t size);
+
+	/**
+	 * \brief Trims used block, returning excess memory to the heap.
+	 *
+	 * Nothing is done if the excess is too small to form a separate block.
+	 *
+	 * \param [in] block is a reference to used block
+	 * \param [in] size is the required size of block, bytes, already adjusted with adjustSize()
+	 */
+
+	void trimBlock(Block& block, size_t size);
+
+	/**
+	 * \brief Updates sum of sizes of all allocated blocks and its "high-water mark".
+	 *
+	 * \param [in] difference is the value added to sum of sizes of all allocated blocks (modulo arithmetic, so
+	 * "negative" values decrease the sum), bytes
+	 */
+
+	void updateUsedSize(size_t difference);
+
+	/// array of lists of free blocks, indexed with first level index and second level index
+	Block* freeLists_[firstLevelIndexCount][secondLevelIndexCount];
+
+	/// array of bitmaps of non-empty second level lists
+	Bitmap secondLevelBitmaps_[firstLevelIndexCount];
+
+	/// number of successful allocations
+	uint64_t allocationCount_;
+
+	/// number of failed allocations
+	uint64_t failedAllocationCount_;
+
+	/// number of deallocations
+	uint64_t freeCount_;
+
+	/// bitmap of first level ranges with non-empty lists
+	Bitmap firstLevelBitmap_;
+
+	/// max sum of sizes of all allocated blocks, bytes
+	size_t maxUsedSize_;
+
+	/// size of the heap, bytes
+	size_t size_;
+
+	/// sum of sizes of all allocated blocks, bytes
+	size_t usedSize_;
+};
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_MEMORY_TLSFHEAP_HPP_
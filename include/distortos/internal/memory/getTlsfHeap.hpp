@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief getTlsfHeap() definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_MEMORY_GETTLSFHEAP_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_MEMORY_GETTLSFHEAP_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+namespace distortos
+{
+
+namespace internal
+{
+
+class TlsfHeap;
+
+/**
+ * \return reference to main instance of TlsfHeap, used by malloc() and friends
+ */
+
+constexpr TlsfHeap& getTlsfHeap()
+{
+	extern TlsfHeap tlsfHeapInstance;
+	return tlsfHeapInstance;
+}
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_MEMORY_GETTLSFHEAP_HPP_
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief Header with hook for recording operations of the heap in the trace
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPTRACE_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPTRACE_HPP_
+
+#include "distortos/HeapStatistics.hpp"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1 && CONFIG_HEAP_TRACE_ENABLE == 1
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Records operation of the heap in the trace of HeapStatistics.
+ *
+ * Current thread is recorded as the thread which executed the operation.
+ *
+ * \param [in] operation is the type of operation
+ * \param [in] returnAddress is the address of code which executed the operation
+ * \param [in] memory is a pointer to allocated (or freed) block, nullptr if allocation failed
+ * \param [in] previousMemory is a pointer to previous block for reallocation, nullptr otherwise
+ * \param [in] size is the requested size, bytes, 0 for deallocation
+ */
+
+void recordHeapOperation(HeapStatistics::Operation operation, const void* returnAddress, const void* memory,
+		const void* previousMemory, size_t size);
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1 && CONFIG_HEAP_TRACE_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_MEMORY_HEAPTRACE_HPP_
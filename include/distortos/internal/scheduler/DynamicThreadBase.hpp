@@ -2,7 +2,7 @@
  * \file
  * \brief DynamicThreadBase class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -19,6 +19,8 @@
 
 #include "distortos/internal/scheduler/ThreadCommon.hpp"
 
+#include "estd/InplaceFunction.hpp"
+
 #include <functional>
 
 namespace distortos
@@ -30,6 +32,12 @@ class DynamicThread;
 
 #endif	// CONFIG_THREAD_DETACH_ENABLE == 1
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+class HeapArena;
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 namespace internal
 {
 
@@ -37,6 +45,9 @@ namespace internal
  * \brief DynamicThreadBase class is a type-erased interface for thread that has dynamic storage for bound function,
  * stack and - if signals are enabled - internal DynamicSignalsReceiver object.
  *
+ * Bound function (with its arguments) is stored in estd::InplaceFunction with CONFIG_BOUND_FUNCTION_STORAGE_SIZE bytes
+ * of storage. If the bound function doesn't fit, compilation fails.
+ *
  * If thread detachment is enabled (CONFIG_THREAD_DETACH_ENABLE is defined) then this class is dynamically allocated by
  * DynamicThread - which allows it to be "detached". Otherwise - if thread detachment is disabled
  * (CONFIG_THREAD_DETACH_ENABLE is not defined) - DynamicThread just inherits from this class.
@@ -73,6 +84,30 @@ public:
 			uint8_t priority, SchedulingPolicy schedulingPolicy, DynamicThread& owner, Function&& function,
 			Args&&... args);
 
+	/**
+	 * \brief DynamicThreadBase's constructor
+	 *
+	 * \tparam Function is the function that will be executed in separate thread
+	 * \tparam Args are the arguments for \a Function
+	 *
+	 * \param [in] parameters is a DynamicThreadParameters struct with thread parameters
+	 * \param [in] owner is a reference to owner DynamicThread object
+	 * \param [in] function is a function that will be executed in separate thread
+	 * \param [in] args are arguments for \a function
+	 */
+
+	template<typename Function, typename... Args>
+	DynamicThreadBase(const DynamicThreadParameters parameters, DynamicThread& owner, Function&& function,
+			Args&&... args) :
+			DynamicThreadBase{parameters.stackSize, parameters.canReceiveSignals, parameters.queuedSignals,
+					parameters.signalActions, parameters.priority, parameters.schedulingPolicy, owner,
+					std::forward<Function>(function), std::forward<Args>(args)...}
+	{
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+		setHeapArena(parameters.heapArena);
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+	}
+
 #else	// CONFIG_THREAD_DETACH_ENABLE != 1
 
 	/**
@@ -115,7 +150,9 @@ public:
 					parameters.signalActions, parameters.priority, parameters.schedulingPolicy,
 					std::forward<Function>(function), std::forward<Args>(args)...}
 	{
-
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+		setHeapArena(parameters.heapArena);
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
 	}
 
 #endif	// CONFIG_THREAD_DETACH_ENABLE != 1
@@ -162,16 +199,6 @@ protected:
 
 #if CONFIG_THREAD_DETACH_ENABLE == 1
 
-	/**
-	 * \brief Thread's "exit 0" hook function
-	 *
-	 * This hook will be called early during thread's exit - while the thread is still runnable.
-	 *
-	 * Calls "exit 0" hook of base class and - if thread is detached - locks object used for deferred deletion.
-	 */
-
-	void exit0Hook() override;
-
 	/**
 	 * \brief Thread's "exit 1" hook function
 	 *
@@ -215,6 +242,18 @@ private:
 				adjustedStackSize + stackGuardSize};
 	}
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	/**
+	 * \brief Assigns the thread to heap arena.
+	 *
+	 * \param [in] heapArena is a pointer to arena which will be used by the thread, nullptr to use the main heap
+	 */
+
+	void setHeapArena(HeapArena* heapArena);
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 #if CONFIG_SIGNALS_ENABLE == 1
 
 	/// internal DynamicSignalsReceiver object
@@ -223,7 +262,7 @@ private:
 #endif	// CONFIG_SIGNALS_ENABLE == 1
 
 	/// bound function object
-	std::function<void()> boundFunction_;
+	estd::InplaceFunction<void(), CONFIG_BOUND_FUNCTION_STORAGE_SIZE> boundFunction_;
 
 #if CONFIG_THREAD_DETACH_ENABLE == 1
 
@@ -2,7 +2,7 @@
  * \file
  * \brief RoundRobinQuantum class header
  *
- * \author Copyright (C) 2014-2016 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -20,7 +20,14 @@ namespace distortos
 namespace internal
 {
 
-/// RoundRobinQuantum class is a quantum of time for round-robin scheduling
+/**
+ * \brief RoundRobinQuantum class is a quantum of time for round-robin scheduling
+ *
+ * Each thread has its own length of quantum - initially it is derived from CONFIG_ROUND_ROBIN_FREQUENCY, but it can be
+ * changed at run-time with setLength(). The object also counts how many times the thread was rotated because its
+ * quantum was used.
+ */
+
 class RoundRobinQuantum
 {
 public:
@@ -32,7 +39,7 @@ public:
 	using Duration = std::chrono::duration<Representation, TickClock::period>;
 
 	/**
-	 * \return initial value for round-robin quantum
+	 * \return initial length of round-robin quantum
 	 */
 
 	constexpr static Duration getInitial()
@@ -43,10 +50,12 @@ public:
 	/**
 	 * \brief RoundRobinQuantum's constructor
 	 *
-	 * Initializes quantum value to initial value - just like after call to reset().
+	 * Initializes length of quantum and quantum value to initial value - just like after call to reset().
 	 */
 
 	constexpr RoundRobinQuantum() :
+			rotationCount_{},
+			length_{getInitial()},
 			quantum_{getInitial()}
 	{
 
@@ -78,6 +87,24 @@ public:
 		return quantum_;
 	}
 
+	/**
+	 * \return length of round-robin's quantum
+	 */
+
+	Duration getLength() const
+	{
+		return length_;
+	}
+
+	/**
+	 * \return number of rotations caused by expiration of round-robin's quantum
+	 */
+
+	uint64_t getRotationCount() const
+	{
+		return rotationCount_;
+	}
+
 	/**
 	 * \brief Convenience function to test whether the quantum is already at 0.
 	 *
@@ -97,9 +124,39 @@ public:
 
 	void reset()
 	{
-		quantum_ = getInitial();
+		quantum_ = length_;
+	}
+
+	/**
+	 * \brief Resets value of round-robin's quantum after rotation of the thread.
+	 *
+	 * This function should be called from tick interrupt when the thread is moved to the end of the group of threads
+	 * with the same priority because its quantum was used.
+	 *
+	 * \note this function must be called with enabled interrupt masking
+	 */
+
+	void rotate()
+	{
+		++rotationCount_;
+		reset();
 	}
 
+	/**
+	 * \brief Sets length of round-robin's quantum.
+	 *
+	 * If current value of quantum is greater than new length, it is truncated.
+	 *
+	 * \note this function must be called with enabled interrupt masking
+	 *
+	 * \param [in] length is the new length of round-robin's quantum, [1; Duration::max()]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a length is out of range;
+	 */
+
+	int setLength(TickClock::duration length);
+
 private:
 
 	static_assert(CONFIG_TICK_FREQUENCY > 0, "CONFIG_TICK_FREQUENCY must be positive and non-zero!");
@@ -112,6 +169,12 @@ private:
 	static_assert(quantumRawInitializer_ > 0 || quantumRawInitializer_ <= UINT8_MAX,
 			"CONFIG_TICK_FREQUENCY and CONFIG_ROUND_ROBIN_FREQUENCY values produce invalid round-robin quantum!");
 
+	/// number of rotations caused by expiration of quantum
+	uint64_t rotationCount_;
+
+	/// length of round-robin quantum
+	Duration length_;
+
 	/// round-robin quantum
 	Duration quantum_;
 };
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadCommon class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -112,6 +112,19 @@ public:
 
 	uint8_t getPriority() const override;
 
+	/**
+	 * \return length of round-robin quantum of the thread
+	 */
+
+	TickClock::duration getRoundRobinQuantum() const override;
+
+	/**
+	 * \return number of times the thread was moved to the end of the group of threads with the same priority because
+	 * its round-robin quantum was used
+	 */
+
+	uint64_t getRoundRobinRotationCount() const override;
+
 	/**
 	 * \return scheduling policy of the thread
 	 */
@@ -193,6 +206,22 @@ public:
 
 	void setPriority(uint8_t priority, bool alwaysBehind = {}) override;
 
+	/**
+	 * \brief Changes length of round-robin quantum of the thread.
+	 *
+	 * New length is used when the quantum is reloaded - after the thread is rotated or when its scheduling policy is
+	 * changed. If current value of quantum is greater than new length, it is truncated. Threads which use
+	 * SchedulingPolicy::fifo are not affected. To get different quantum for each priority level, set the same length
+	 * for all threads with given priority.
+	 *
+	 * \param [in] quantum is the new length of round-robin quantum of the thread, [1 tick; 255 ticks]
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by ThreadControlBlock::setRoundRobinQuantum();
+	 */
+
+	int setRoundRobinQuantum(TickClock::duration quantum) override;
+
 	/**
 	 * param [in] schedulingPolicy is the new scheduling policy of the thread
 	 */
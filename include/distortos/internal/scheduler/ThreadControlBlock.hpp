@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadControlBlock class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -30,6 +30,7 @@ class SignalsReceiver;
 namespace internal
 {
 
+class HeapArenaControlBlock;
 class RunnableThread;
 class SignalsReceiverControlBlock;
 class ThreadList;
@@ -91,6 +92,19 @@ public:
 		unblockFunctor_ = unblockFunctor;
 	}
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	/**
+	 * \return pointer to HeapArenaControlBlock of arena used by this thread, nullptr if the thread uses the main heap
+	 */
+
+	HeapArenaControlBlock* getHeapArenaControlBlock() const
+	{
+		return heapArenaControlBlock_;
+	}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 	/**
 	 * \return pointer to list that has this object
 	 */
@@ -127,6 +141,21 @@ public:
 		return roundRobinQuantum_;
 	}
 
+	/**
+	 * \return const reference to internal RoundRobinQuantum object
+	 */
+
+	const RoundRobinQuantum& getRoundRobinQuantum() const
+	{
+		return roundRobinQuantum_;
+	}
+
+	/**
+	 * \return number of rotations caused by expiration of round-robin quantum of the thread
+	 */
+
+	uint64_t getRoundRobinRotationCount() const;
+
 	/**
 	 * \return scheduling policy of the thread
 	 */
@@ -136,6 +165,16 @@ public:
 		return schedulingPolicy_;
 	}
 
+	/**
+	 * \return number of units requested from the semaphore on which the thread is blocked, valid only in
+	 * ThreadState::blockedOnSemaphore state
+	 */
+
+	unsigned int getSemaphoreWaitCount() const
+	{
+		return semaphoreWaitCount_;
+	}
+
 	/**
 	 * \return sequence number, one half of thread identifier
 	 */
@@ -186,6 +225,30 @@ public:
 		return state_;
 	}
 
+	/**
+	 * \return pointer to ThreadGroupControlBlock with which this object is associated, nullptr if this object was not
+	 * added to scheduler yet
+	 */
+
+	ThreadGroupControlBlock* getThreadGroupControlBlock() const
+	{
+		return threadGroupControlBlock_;
+	}
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	/**
+	 * \param [in] heapArenaControlBlock is a pointer to HeapArenaControlBlock of arena which will be used by this
+	 * thread, nullptr to use the main heap
+	 */
+
+	void setHeapArenaControlBlock(HeapArenaControlBlock* const heapArenaControlBlock)
+	{
+		heapArenaControlBlock_ = heapArenaControlBlock;
+	}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 	/**
 	 * \brief Sets the list that has this object.
 	 *
@@ -220,12 +283,33 @@ public:
 		priorityInheritanceMutexControlBlock_ = priorityInheritanceMutexControlBlock;
 	}
 
+	/**
+	 * \brief Sets length of round-robin quantum of the thread.
+	 *
+	 * \param [in] quantum is the new length of round-robin quantum of the thread
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by RoundRobinQuantum::setLength();
+	 */
+
+	int setRoundRobinQuantum(TickClock::duration quantum);
+
 	/**
 	 * param [in] schedulingPolicy is the new scheduling policy of the thread
 	 */
 
 	void setSchedulingPolicy(SchedulingPolicy schedulingPolicy);
 
+	/**
+	 * \param [in] semaphoreWaitCount is the number of units requested from the semaphore on which the thread is about
+	 * to block
+	 */
+
+	void setSemaphoreWaitCount(const unsigned int semaphoreWaitCount)
+	{
+		semaphoreWaitCount_ = semaphoreWaitCount;
+	}
+
 	/**
 	 * \param [in] state is the new state of object
 	 */
@@ -304,6 +388,13 @@ private:
 	/// internal stack object
 	Stack stack_;
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	/// pointer to HeapArenaControlBlock of arena used by this thread, nullptr if the thread uses the main heap
+	HeapArenaControlBlock* heapArenaControlBlock_;
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 	/// pointer to list that has this object
 	ThreadList* list_;
 
@@ -316,6 +407,9 @@ private:
 	/// sequence number, one half of thread identifier
 	uintptr_t sequenceNumber_;
 
+	/// number of units requested from the semaphore on which the thread is blocked
+	unsigned int semaphoreWaitCount_;
+
 #if CONFIG_SIGNALS_ENABLE == 1
 
 	/// pointer to SignalsReceiverControlBlock object for this thread, nullptr if this thread cannot receive signals
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadGroupControlBlock class header
  *
- * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,6 +14,16 @@
 
 #include "distortos/internal/scheduler/ThreadListNode.hpp"
 
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_SIGNALS_ENABLE == 1
+
+#include <csignal>
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
+#include <utility>
+
 namespace distortos
 {
 
@@ -45,11 +55,73 @@ public:
 
 	void add(ThreadControlBlock& threadControlBlock);
 
+#if CONFIG_SIGNALS_ENABLE == 1
+
+	/**
+	 * \brief Generates signal for all threads in the group.
+	 *
+	 * Signal is generated for all threads in single critical section, so all threads waiting for this signal are
+	 * unblocked in single scheduler pass. Threads which cannot receive signals, which ignore the signal or for which
+	 * generation failed are skipped.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] signalNumber is the signal that will be generated, [0; 31]
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of threads which accepted the
+	 * signal; error codes:
+	 * - EINVAL - \a signalNumber value is invalid;
+	 */
+
+	std::pair<int, size_t> generateSignal(uint8_t signalNumber);
+
+	/**
+	 * \brief Queues signal for all threads in the group.
+	 *
+	 * Signal is queued for all threads in single critical section, so all threads waiting for this signal are unblocked
+	 * in single scheduler pass. Threads which cannot receive or queue signals, which ignore the signal or which have no
+	 * space to queue it are skipped.
+	 *
+	 * \note This function can be used from interrupt context.
+	 *
+	 * \param [in] signalNumber is the signal that will be queued, [0; 31]
+	 * \param [in] value is the signal value
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of threads which accepted the
+	 * signal; error codes:
+	 * - EINVAL - \a signalNumber value is invalid;
+	 */
+
+	std::pair<int, size_t> queueSignal(uint8_t signalNumber, sigval value);
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
 private:
 
 	/// intrusive list of threads (thread control blocks)
 	using List = estd::IntrusiveList<ThreadListNode, &ThreadListNode::threadGroupNode, ThreadControlBlock>;
 
+#if CONFIG_SIGNALS_ENABLE == 1
+
+	/**
+	 * \brief Implementation of generateSignal() and queueSignal().
+	 *
+	 * \tparam Functor is the type of functor, it should be callable as
+	 * `std::pair<int, bool>(SignalsReceiverControlBlock&, ThreadControlBlock&)`
+	 *
+	 * \param [in] signalNumber is the signal that will be generated or queued, [0; 31]
+	 * \param [in] functor is a functor which generates or queues the signal for single thread with interrupts masked
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of threads which accepted the
+	 * signal; error codes:
+	 * - EINVAL - \a signalNumber value is invalid;
+	 */
+
+	template<typename Functor>
+	std::pair<int, size_t> generateQueueSignal(uint8_t signalNumber, Functor functor);
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
 	/// list of threads (thread control blocks) in this group
 	List threadList_;
 };
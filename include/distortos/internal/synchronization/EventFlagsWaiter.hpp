@@ -0,0 +1,147 @@
+/**
+ * \file
+ * \brief EventFlagsWaiter class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_EVENTFLAGSWAITER_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_EVENTFLAGSWAITER_HPP_
+
+#include "distortos/EventFlagsWaitMode.hpp"
+
+#include "estd/IntrusiveList.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+class ThreadControlBlock;
+
+/**
+ * \brief EventFlagsWaiter class is a descriptor of a thread which waits for EventFlags
+ *
+ * Objects of this class are created on the stack of the waiting thread and linked into the list of waiters of
+ * EventFlags object for the duration of the wait.
+ */
+
+class EventFlagsWaiter
+{
+public:
+
+	/**
+	 * \brief EventFlagsWaiter's constructor
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of waiting thread
+	 * \param [in] bitmask is the bitmask of flags that are "waited for"
+	 * \param [in] mode is the mode of waiting
+	 * \param [in] clearOnExit selects whether flags from \a bitmask will be cleared when the wait is satisfied (true)
+	 * or not (false)
+	 */
+
+	constexpr EventFlagsWaiter(ThreadControlBlock& threadControlBlock, const uint32_t bitmask,
+			const EventFlagsWaitMode mode, const bool clearOnExit) :
+					node{},
+					threadControlBlock_{threadControlBlock},
+					bitmask_{bitmask},
+					value_{},
+					mode_{mode},
+					clearOnExit_{clearOnExit}
+	{
+
+	}
+
+	/**
+	 * \return bitmask of flags that are "waited for"
+	 */
+
+	uint32_t getBitmask() const
+	{
+		return bitmask_;
+	}
+
+	/**
+	 * \return true if flags from bitmask should be cleared when the wait is satisfied, false otherwise
+	 */
+
+	bool getClearOnExit() const
+	{
+		return clearOnExit_;
+	}
+
+	/**
+	 * \return reference to ThreadControlBlock of waiting thread
+	 */
+
+	ThreadControlBlock& getThreadControlBlock() const
+	{
+		return threadControlBlock_;
+	}
+
+	/**
+	 * \return value of event flags which satisfied the wait, valid only if the wait was satisfied
+	 */
+
+	uint32_t getValue() const
+	{
+		return value_;
+	}
+
+	/**
+	 * \brief Checks whether given value of event flags satisfies the wait.
+	 *
+	 * \param [in] value is the value of event flags that will be checked
+	 *
+	 * \return true if \a value satisfies the wait, false otherwise
+	 */
+
+	bool isSatisfiedBy(const uint32_t value) const
+	{
+		const auto intersection = value & bitmask_;
+		return mode_ == EventFlagsWaitMode::any ? intersection != 0 : intersection == bitmask_;
+	}
+
+	/**
+	 * \param [in] value is the value of event flags which satisfied the wait
+	 */
+
+	void setValue(const uint32_t value)
+	{
+		value_ = value;
+	}
+
+	/// node for intrusive list of waiters
+	estd::IntrusiveListNode node;
+
+private:
+
+	/// reference to ThreadControlBlock of waiting thread
+	ThreadControlBlock& threadControlBlock_;
+
+	/// bitmask of flags that are "waited for"
+	uint32_t bitmask_;
+
+	/// value of event flags which satisfied the wait
+	uint32_t value_;
+
+	/// mode of waiting
+	EventFlagsWaitMode mode_;
+
+	/// selects whether flags from bitmask will be cleared when the wait is satisfied (true) or not (false)
+	bool clearOnExit_;
+};
+
+/// intrusive list of threads waiting for EventFlags
+using EventFlagsWaiterList = estd::IntrusiveList<EventFlagsWaiter, &EventFlagsWaiter::node>;
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_EVENTFLAGSWAITER_HPP_
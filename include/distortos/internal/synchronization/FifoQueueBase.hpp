@@ -2,7 +2,7 @@
  * \file
  * \brief FifoQueueBase class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -17,17 +17,31 @@
 #include "distortos/internal/synchronization/QueueFunctor.hpp"
 #include "distortos/internal/synchronization/SemaphoreFunctor.hpp"
 
+#include "distortos/distortosConfiguration.h"
+
 #include <memory>
 
 namespace distortos
 {
 
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+class QueueStatistics;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 namespace internal
 {
 
 /// FifoQueueBase class implements basic functionality of FifoQueue template class
 class FifoQueueBase
 {
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	friend class distortos::QueueStatistics;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 public:
 
 	/// unique_ptr (with deleter) to storage
@@ -59,6 +73,15 @@ public:
 		return elementSize_;
 	}
 
+	/**
+	 * \return const reference to semaphore which value is equal to the number of elements that can be popped
+	 */
+
+	const Semaphore& getPopSemaphore() const
+	{
+		return popSemaphore_;
+	}
+
 	/**
 	 * \brief Implementation of pop() using type-erased functor
 	 *
@@ -136,6 +159,13 @@ private:
 
 	/// size of single queue element, bytes
 	const size_t elementSize_;
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	/// pointer to QueueStatistics object associated with the queue, nullptr if the queue is not instrumented
+	QueueStatistics* statistics_;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
 };
 
 }	// namespace internal
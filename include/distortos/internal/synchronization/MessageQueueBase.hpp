@@ -2,7 +2,7 @@
  * \file
  * \brief MessageQueueBase class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -17,6 +17,8 @@
 #include "distortos/internal/synchronization/QueueFunctor.hpp"
 #include "distortos/internal/synchronization/SemaphoreFunctor.hpp"
 
+#include "distortos/distortosConfiguration.h"
+
 #include "estd/SortedIntrusiveForwardList.hpp"
 
 #include <memory>
@@ -24,12 +26,24 @@
 namespace distortos
 {
 
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+class QueueStatistics;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 namespace internal
 {
 
 /// MessageQueueBase class implements basic functionality of MessageQueue template class
 class MessageQueueBase
 {
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	friend class distortos::QueueStatistics;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 public:
 
 	/// entry in the MessageQueueBase
@@ -144,6 +158,15 @@ public:
 
 	~MessageQueueBase();
 
+	/**
+	 * \return const reference to semaphore which value is equal to the number of elements that can be popped
+	 */
+
+	const Semaphore& getPopSemaphore() const
+	{
+		return popSemaphore_;
+	}
+
 	/**
 	 * \brief Implementation of pop() using type-erased functor
 	 *
@@ -212,6 +235,13 @@ private:
 
 	/// list of "free" entries
 	FreeEntryList freeEntryList_;
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	/// pointer to QueueStatistics object associated with the queue, nullptr if the queue is not instrumented
+	QueueStatistics* statistics_;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
 };
 
 }	// namespace internal
@@ -0,0 +1,131 @@
+/**
+ * \file
+ * \brief MultiWaiter class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_MULTIWAITER_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_MULTIWAITER_HPP_
+
+#include "estd/IntrusiveList.hpp"
+
+#include <cstddef>
+
+namespace distortos
+{
+
+class WaitableObject;
+
+namespace internal
+{
+
+class ThreadControlBlock;
+
+/**
+ * \brief MultiWaiter class is a descriptor of a thread which waits for any of multiple waitable objects
+ *
+ * Objects of this class are created on the stack of the waiting thread and linked into the global list of multi-waiters
+ * for the duration of the wait.
+ */
+
+class MultiWaiter
+{
+public:
+
+	/**
+	 * \brief MultiWaiter's constructor
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock of waiting thread
+	 * \param [in] objects is a pointer to first element of array with waited objects
+	 * \param [in] size is the number of elements in \a objects array
+	 */
+
+	constexpr MultiWaiter(ThreadControlBlock& threadControlBlock, const WaitableObject* const objects,
+			const size_t size) :
+					node{},
+					threadControlBlock_{threadControlBlock},
+					objects_{objects},
+					size_{size},
+					readyIndex_{}
+	{
+
+	}
+
+	/**
+	 * \brief Finds waited object which matches given object and is ready.
+	 *
+	 * \param [in] object is a pointer to object which may have become ready
+	 *
+	 * \return index of first waited object which matches \a object and is ready, number of waited objects if there is
+	 * no such object
+	 */
+
+	size_t findReady(const void* object) const;
+
+	/**
+	 * \return index of waited object which became ready, valid only if the wait was satisfied
+	 */
+
+	size_t getReadyIndex() const
+	{
+		return readyIndex_;
+	}
+
+	/**
+	 * \return number of waited objects
+	 */
+
+	size_t getSize() const
+	{
+		return size_;
+	}
+
+	/**
+	 * \return reference to ThreadControlBlock of waiting thread
+	 */
+
+	ThreadControlBlock& getThreadControlBlock() const
+	{
+		return threadControlBlock_;
+	}
+
+	/**
+	 * \param [in] readyIndex is the index of waited object which became ready
+	 */
+
+	void setReadyIndex(const size_t readyIndex)
+	{
+		readyIndex_ = readyIndex;
+	}
+
+	/// node for intrusive list of multi-waiters
+	estd::IntrusiveListNode node;
+
+private:
+
+	/// reference to ThreadControlBlock of waiting thread
+	ThreadControlBlock& threadControlBlock_;
+
+	/// pointer to first element of array with waited objects
+	const WaitableObject* objects_;
+
+	/// number of elements in objects_ array
+	size_t size_;
+
+	/// index of waited object which became ready
+	size_t readyIndex_;
+};
+
+/// intrusive list of threads waiting for any of multiple waitable objects
+using MultiWaiterList = estd::IntrusiveList<MultiWaiter, &MultiWaiter::node>;
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_MULTIWAITER_HPP_
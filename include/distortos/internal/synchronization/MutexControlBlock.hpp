@@ -2,7 +2,7 @@
  * \file
  * \brief MutexControlBlock class header
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -20,11 +20,19 @@
 #include "distortos/MutexType.hpp"
 #include "distortos/TickClock.hpp"
 
+#include "distortos/distortosConfiguration.h"
+
 #include <climits>
 
 namespace distortos
 {
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+class MutexStatistics;
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 namespace internal
 {
 
@@ -65,6 +73,29 @@ public:
 		return owner_;
 	}
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	/**
+	 * \return pointer to MutexStatistics object associated with the mutex, nullptr if the mutex is not instrumented
+	 */
+
+	MutexStatistics* getStatistics() const
+	{
+		return statistics_;
+	}
+
+	/**
+	 * \param [in] statistics is a pointer to MutexStatistics object which will be associated with the mutex, nullptr to
+	 * stop collecting statistics
+	 */
+
+	void setStatistics(MutexStatistics* const statistics)
+	{
+		statistics_ = statistics;
+	}
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	/// shift of "type" subfield, bits
 	constexpr static uint8_t typeShift {0};
 
@@ -95,6 +126,9 @@ protected:
 			priorityCeiling_{priorityCeiling},
 			typeProtocol_{static_cast<uint8_t>(static_cast<uint8_t>(type) << typeShift |
 					static_cast<uint8_t>(protocol) << protocolShift)}
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+			, statistics_{}
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
 	{
 
 	}
@@ -137,6 +171,24 @@ protected:
 
 	void doUnlockOrTransferLock();
 
+	/**
+	 * \return reference to list of ThreadControlBlock objects blocked on mutex
+	 */
+
+	ThreadList& getBlockedList()
+	{
+		return blockedList_;
+	}
+
+	/**
+	 * \return const reference to list of ThreadControlBlock objects blocked on mutex
+	 */
+
+	const ThreadList& getBlockedList() const
+	{
+		return blockedList_;
+	}
+
 	/**
 	 * \return priority ceiling of mutex, valid only when protocol_ == Protocol::priorityProtect
 	 */
@@ -164,6 +216,28 @@ protected:
 		return recursiveLocksCount_;
 	}
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	/**
+	 * \brief Records successfully completed wait for the mutex in associated MutexStatistics object (if any).
+	 *
+	 * \param [in] waitTime is the time for which current thread was blocked waiting for the mutex, measured from the
+	 * first block
+	 */
+
+	void recordWait(TickClock::duration waitTime);
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	/**
+	 * \param [in] owner is a pointer to new owner of the mutex, nullptr if mutex is unlocked
+	 */
+
+	void setOwner(ThreadControlBlock* const owner)
+	{
+		owner_ = owner;
+	}
+
 	/**
 	 * \return type of mutex
 	 */
@@ -216,6 +290,13 @@ private:
 
 	/// type of mutex and its protocol
 	uint8_t typeProtocol_;
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	/// pointer to MutexStatistics object associated with the mutex, nullptr if the mutex is not instrumented
+	MutexStatistics* statistics_;
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
 };
 
 }	// namespace internal
@@ -0,0 +1,233 @@
+/**
+ * \file
+ * \brief SharedMutexControlBlock class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_SHAREDMUTEXCONTROLBLOCK_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_SHAREDMUTEXCONTROLBLOCK_HPP_
+
+#include "distortos/internal/synchronization/MutexControlBlock.hpp"
+
+#include "distortos/SharedMutexPolicy.hpp"
+#include "distortos/SharedMutexProtocol.hpp"
+
+#include <memory>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/**
+ * \brief SharedMutexControlBlock class is a control block for SharedMutex
+ *
+ * SharedMutexControlBlock reuses MutexControlBlock's machinery of priority inheritance - all threads waiting for
+ * exclusive or shared ownership are kept on the same list of blocked threads, and the "owner" of the underlying
+ * MutexControlBlock is either the thread with exclusive ownership or the highest priority thread with shared ownership.
+ * Only this thread inherits the priority of blocked threads, so with many threads holding shared ownership the
+ * inheritance is bounded to a single thread at any given moment.
+ */
+
+class SharedMutexControlBlock : public MutexControlBlock
+{
+public:
+
+	/// policies of granting ownership
+	using Policy = SharedMutexPolicy;
+
+	/// shared mutex protocols
+	using Protocol = SharedMutexProtocol;
+
+	/// type of single element of storage for threads with shared ownership
+	using Storage = ThreadControlBlock*;
+
+	/// unique_ptr (with deleter) to Storage[]
+	using StorageUniquePointer = std::unique_ptr<Storage[], void(&)(Storage*)>;
+
+	/**
+	 * \return maximum number of threads that can have shared ownership at the same time
+	 */
+
+	size_t getMaxReaders() const
+	{
+		return maxReaders_;
+	}
+
+	/**
+	 * \return number of threads which currently have shared ownership
+	 */
+
+	size_t getReadersCount() const
+	{
+		return readersCount_;
+	}
+
+protected:
+
+	/**
+	 * \brief SharedMutexControlBlock's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for \a maxReaders
+	 * elements
+	 * \param [in] maxReaders is the maximum number of threads that can have shared ownership at the same time
+	 * \param [in] policy is the policy of granting ownership
+	 * \param [in] protocol is the shared mutex protocol
+	 */
+
+	SharedMutexControlBlock(StorageUniquePointer&& storageUniquePointer, const size_t maxReaders, const Policy policy,
+			const Protocol protocol) :
+					MutexControlBlock{MutexControlBlock::Type::normal, static_cast<MutexControlBlock::Protocol>(protocol),
+							{}},
+					storageUniquePointer_{std::move(storageUniquePointer)},
+					maxReaders_{maxReaders},
+					readersCount_{},
+					blockedWritersCount_{},
+					policy_{policy}
+	{
+
+	}
+
+	/**
+	 * \brief Blocks current thread, transferring it to list of blocked threads.
+	 *
+	 * \param [in] shared selects whether the thread waits for shared (true) or exclusive (false) ownership
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - values returned by Scheduler::block();
+	 */
+
+	int doBlock(bool shared);
+
+	/**
+	 * \brief Blocks current thread with timeout, transferring it to list of blocked threads.
+	 *
+	 * \param [in] shared selects whether the thread waits for shared (true) or exclusive (false) ownership
+	 * \param [in] timePoint is the time point at which the thread will be unblocked (if not already unblocked)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - values returned by Scheduler::blockUntil();
+	 */
+
+	int doBlockUntil(bool shared, TickClock::time_point timePoint);
+
+	/**
+	 * \brief Tries to acquire exclusive ownership for current thread, without blocking.
+	 *
+	 * \return 0 if exclusive ownership was acquired, error code otherwise:
+	 * - EBUSY - some thread has exclusive or shared ownership;
+	 * - EDEADLK - current thread already has exclusive or shared ownership;
+	 */
+
+	int doTryLock();
+
+	/**
+	 * \brief Tries to acquire shared ownership for current thread, without blocking.
+	 *
+	 * \return 0 if shared ownership was acquired, error code otherwise:
+	 * - EAGAIN - maximum number of threads with shared ownership was reached;
+	 * - EBUSY - some thread has exclusive ownership or the policy requires current thread to wait behind threads
+	 * waiting for exclusive ownership;
+	 * - EDEADLK - current thread already has exclusive or shared ownership;
+	 */
+
+	int doTryLockShared();
+
+	/**
+	 * \brief Releases exclusive ownership of current thread and transfers ownership to threads waiting for it.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EPERM - current thread does not have exclusive ownership;
+	 */
+
+	int doUnlock();
+
+	/**
+	 * \brief Releases shared ownership of current thread and transfers ownership to threads waiting for it.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EPERM - current thread does not have shared ownership;
+	 */
+
+	int doUnlockShared();
+
+private:
+
+	class SharedMutexUnblockFunctor;
+
+	/**
+	 * \brief Performs any actions required before actually blocking on the shared mutex.
+	 *
+	 * Increments number of blocked "writers" if required. In case of priorityInheritance protocol, priority of owner
+	 * thread is boosted and this shared mutex is set as the blocking mutex of the calling thread.
+	 *
+	 * \param [in] shared selects whether the thread waits for shared (true) or exclusive (false) ownership
+	 */
+
+	void beforeBlock(bool shared);
+
+	/**
+	 * \param [in] threadControlBlock is a reference to tested ThreadControlBlock
+	 *
+	 * \return true if \a threadControlBlock has shared ownership, false otherwise
+	 */
+
+	bool isReader(const ThreadControlBlock& threadControlBlock) const;
+
+	/**
+	 * \brief Checks whether any thread waiting for exclusive ownership is ahead of given priority in the list of
+	 * blocked threads.
+	 *
+	 * \param [in] priority is the effective priority of thread which tries to acquire shared ownership
+	 *
+	 * \return true if any thread waiting for exclusive ownership has effective priority higher or equal to \a priority,
+	 * false otherwise
+	 */
+
+	bool isWriterAhead(uint8_t priority) const;
+
+	/**
+	 * \brief Transfers ownership to threads from the list of blocked threads, as allowed by current state and policy.
+	 */
+
+	void transferOwnership();
+
+	/**
+	 * \brief Updates owner of the underlying MutexControlBlock and boosted priorities of involved threads.
+	 *
+	 * If the shared mutex is owned by "readers", the highest priority one is selected as the new owner. In case of
+	 * priorityInheritance protocol, this shared mutex is moved to the list of owned mutexes of new owner and boosted
+	 * priorities of previous and new owners are updated.
+	 *
+	 * \param [in] previousOwner is a pointer to previous owner of the underlying MutexControlBlock
+	 */
+
+	void updateOwner(ThreadControlBlock* previousOwner);
+
+	/// storage for pointers to ThreadControlBlock objects of threads with shared ownership
+	StorageUniquePointer storageUniquePointer_;
+
+	/// maximum number of threads that can have shared ownership at the same time
+	size_t maxReaders_;
+
+	/// number of threads with shared ownership
+	size_t readersCount_;
+
+	/// number of threads blocked while waiting for exclusive ownership
+	size_t blockedWritersCount_;
+
+	/// policy of granting ownership
+	Policy policy_;
+};
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_SHAREDMUTEXCONTROLBLOCK_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief SignalInformationQueue class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -18,8 +18,6 @@
 
 #include "distortos/SignalInformation.hpp"
 
-#include "estd/IntrusiveForwardList.hpp"
-
 #include <memory>
 
 namespace distortos
@@ -30,16 +28,23 @@ class SignalSet;
 namespace internal
 {
 
-/// SignalInformationQueue class can be used for queuing of SignalInformation objects
+/**
+ * \brief SignalInformationQueue class can be used for queuing of SignalInformation objects
+ *
+ * Queued objects are kept in separate FIFO for each signal number - circular singly-linked list identified by pointer
+ * to its last element. Together with the bitmask of signal numbers with non-empty FIFOs this makes queuing, accepting
+ * and getting the set of queued signals O(1) operations, regardless of the number of queued objects.
+ */
+
 class SignalInformationQueue
 {
 public:
 
-	/// single node of internal forward list - estd::IntrusiveForwardListNode and SignalInformation
+	/// single node of internal circular singly-linked list - pointer to next node and SignalInformation
 	struct QueueNode
 	{
-		/// node for intrusive forward list
-		estd::IntrusiveForwardListNode node;
+		/// pointer to next node
+		QueueNode* next;
 
 		/// queued SignalInformation
 		SignalInformation signalInformation;
@@ -87,7 +92,7 @@ public:
 
 	bool canQueueSignal() const
 	{
-		return freeSignalInformationList_.empty() == false;
+		return freeQueueNodes_ != nullptr;
 	}
 
 	/**
@@ -116,17 +121,21 @@ public:
 
 private:
 
-	/// type of container with SignalInformation objects
-	using List = estd::IntrusiveForwardList<QueueNode, &QueueNode::node>;
+	/// number of supported signal numbers
+	constexpr static uint8_t signalNumbers {32};
 
 	/// storage for queue elements
 	StorageUniquePointer storageUniquePointer_;
 
-	/// list of queued SignalInformation objects
-	List signalInformationList_;
+	/// pointers to last elements of FIFOs with queued SignalInformation objects for each signal number, nullptr if
+	/// FIFO is empty
+	QueueNode* lastQueueNodes_[signalNumbers];
+
+	/// stack of "free" SignalInformation objects
+	QueueNode* freeQueueNodes_;
 
-	/// list of "free" SignalInformation objects
-	List freeSignalInformationList_;
+	/// bitmask of signal numbers with at least one queued SignalInformation object
+	uint32_t queuedSignalsBitmask_;
 };
 
 }	// namespace internal
@@ -2,7 +2,7 @@
  * \file
  * \brief SignalsReceiverControlBlock class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -84,6 +84,16 @@ public:
 
 	int deliveryOfSignalsStartedHook() const;
 
+	/**
+	 * \brief Actions executed out of critical section after signal is generated with generateSignal() or
+	 * generateSignalLocked() or queued with queueSignal() or queueSignalLocked().
+	 *
+	 * \param [in] signalNumber is the signal that was generated/queued, [0; 31]
+	 * \param [in] threadControlBlock is a reference to associated ThreadControlBlock
+	 */
+
+	void afterGenerateQueueUnlocked(uint8_t signalNumber, ThreadControlBlock& threadControlBlock) const;
+
 	/**
 	 * \brief Generates signal for associated thread.
 	 *
@@ -103,6 +113,26 @@ public:
 
 	int generateSignal(uint8_t signalNumber, ThreadControlBlock& threadControlBlock);
 
+	/**
+	 * \brief Generates signal for associated thread, skipping actions executed out of critical section.
+	 *
+	 * Internal version of generateSignal() with no interrupt masking - it can be used to generate signal for multiple
+	 * threads in single critical section.
+	 *
+	 * \note This function must be called with interrupts masked. If it returns {0, true}, afterGenerateQueueUnlocked()
+	 * must be called after interrupts are unmasked.
+	 *
+	 * \param [in] signalNumber is the signal that will be generated, [0; 31]
+	 * \param [in] threadControlBlock is a reference to associated ThreadControlBlock
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and boolean telling whether the signal was
+	 * generated (true) or ignored (false); error codes:
+	 * - error codes returned by beforeGenerateQueue();
+	 * - error codes returned by isSignalIgnored();
+	 */
+
+	std::pair<int, bool> generateSignalLocked(uint8_t signalNumber, ThreadControlBlock& threadControlBlock);
+
 	/**
 	 * \return set of currently pending signals
 	 */
@@ -157,6 +187,31 @@ public:
 
 	int queueSignal(uint8_t signalNumber, sigval value, ThreadControlBlock& threadControlBlock) const;
 
+	/**
+	 * \brief Queues signal for associated thread, skipping actions executed out of critical section.
+	 *
+	 * Internal version of queueSignal() with no interrupt masking - it can be used to queue signal for multiple threads
+	 * in single critical section.
+	 *
+	 * \note This function must be called with interrupts masked. If it returns {0, true}, afterGenerateQueueUnlocked()
+	 * must be called after interrupts are unmasked.
+	 *
+	 * \param [in] signalNumber is the signal that will be queued, [0; 31]
+	 * \param [in] value is the signal value
+	 * \param [in] threadControlBlock is a reference to associated ThreadControlBlock
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and boolean telling whether the signal was
+	 * queued (true) or ignored (false); error codes:
+	 * - EAGAIN - no resources are available to queue the signal, the limit of signals which may be queued has been
+	 * reached;
+	 * - ENOTSUP - queuing of signals is disabled for this receiver;
+	 * - error codes returned by beforeGenerateQueue();
+	 * - error codes returned by isSignalIgnored();
+	 */
+
+	std::pair<int, bool> queueSignalLocked(uint8_t signalNumber, sigval value,
+			ThreadControlBlock& threadControlBlock) const;
+
 	/**
 	 * \brief Sets association for given signal number.
 	 *
@@ -213,16 +268,6 @@ private:
 
 	void afterGenerateQueueLocked(uint8_t signalNumber, ThreadControlBlock& threadControlBlock) const;
 
-	/**
-	 * \brief Actions executed out of critical section after signal is generated with generateSignal() or queued with
-	 * queueSignal().
-	 *
-	 * \param [in] signalNumber is the signal that was generated/queued, [0; 31]
-	 * \param [in] threadControlBlock is a reference to associated ThreadControlBlock
-	 */
-
-	void afterGenerateQueueUnlocked(uint8_t signalNumber, ThreadControlBlock& threadControlBlock) const;
-
 	/**
 	 * \brief Actions executed before signal is generated with generateSignal() or queued with queueSignal().
 	 *
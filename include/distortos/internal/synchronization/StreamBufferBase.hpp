@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief StreamBufferBase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_STREAMBUFFERBASE_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_STREAMBUFFERBASE_HPP_
+
+#include "distortos/internal/memory/CircularBuffer.hpp"
+
+#include "distortos/internal/scheduler/ThreadList.hpp"
+
+#include "distortos/TickClock.hpp"
+
+#include <memory>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/**
+ * \brief StreamBufferBase class implements basic functionality of MessageBuffer and StreamBuffer classes.
+ *
+ * Data is stored in internal::CircularBuffer. Threads waiting for data and threads waiting for free space are kept in
+ * two lists. Each change of the buffer unblocks all threads from the relevant list and each of them reevaluates its own
+ * wait condition, so threads waiting for different amounts of data or space never miss a change.
+ *
+ * All functions of this class (except constructor) must be called with interrupts masked.
+ */
+
+class StreamBufferBase
+{
+public:
+
+	/// unique_ptr (with deleter) to storage
+	using StorageUniquePointer = std::unique_ptr<void, void(&)(void*)>;
+
+	/**
+	 * \brief StreamBufferBase's constructor
+	 *
+	 * \param [in] storageUniquePointer is a rvalue reference to StorageUniquePointer with storage for data
+	 * (sufficiently large for \a size bytes) and appropriate deleter
+	 * \param [in] size is the size of storage, bytes, must be less than or equal to SIZE_MAX / 2
+	 */
+
+	StreamBufferBase(StorageUniquePointer&& storageUniquePointer, size_t size);
+
+	/**
+	 * \brief Marks first \a size bytes of block returned by getWriteBlock() as written.
+	 *
+	 * \param [in] size is the number of bytes that were written, must not exceed the size of block returned by
+	 * getWriteBlock()
+	 */
+
+	void commit(size_t size);
+
+	/**
+	 * \return capacity of buffer, bytes
+	 */
+
+	size_t getCapacity() const
+	{
+		return circularBuffer_.getCapacity();
+	}
+
+	/**
+	 * \return number of bytes that can be written to the buffer
+	 */
+
+	size_t getFreeSpace() const
+	{
+		return circularBuffer_.getCapacity() - circularBuffer_.getSize();
+	}
+
+	/**
+	 * \return number of bytes stored in the buffer
+	 */
+
+	size_t getSize() const
+	{
+		return circularBuffer_.getSize();
+	}
+
+	/**
+	 * \return pair with pointer to first contiguous free block of the buffer and its size, bytes
+	 */
+
+	std::pair<uint8_t*, size_t> getWriteBlock() const
+	{
+		return circularBuffer_.getWriteBlock();
+	}
+
+	/**
+	 * \brief Copies data from the buffer without removing it.
+	 *
+	 * \param [out] buffer is a pointer to buffer for data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of bytes copied to \a buffer
+	 */
+
+	size_t peek(void* buffer, size_t size) const;
+
+	/**
+	 * \brief Reads data from the buffer.
+	 *
+	 * \param [out] buffer is a pointer to buffer for data, nullptr to discard data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of bytes read from the buffer
+	 */
+
+	size_t read(void* buffer, size_t size);
+
+	/**
+	 * \brief Waits until at least \a size bytes are stored in the buffer.
+	 *
+	 * \param [in] size is the required number of bytes
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return 0 if at least \a size bytes are stored in the buffer, error code otherwise:
+	 * - EAGAIN - the buffer doesn't contain enough data and non-blocking mode was selected;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the wait was not completed before the specified timeout expired;
+	 */
+
+	int waitForData(size_t size, bool nonBlocking, const TickClock::time_point* timePoint);
+
+	/**
+	 * \brief Waits until at least \a size bytes are free in the buffer.
+	 *
+	 * \param [in] size is the required number of bytes
+	 * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+	 * (true)
+	 * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+	 * is selected, nullptr to block without timeout
+	 *
+	 * \return 0 if at least \a size bytes are free in the buffer, error code otherwise:
+	 * - EAGAIN - the buffer doesn't have enough free space and non-blocking mode was selected;
+	 * - EINTR - the wait was interrupted by an unmasked, caught signal;
+	 * - ETIMEDOUT - the wait was not completed before the specified timeout expired;
+	 */
+
+	int waitForSpace(size_t size, bool nonBlocking, const TickClock::time_point* timePoint);
+
+	/**
+	 * \brief Writes data to the buffer.
+	 *
+	 * \param [in] data is a pointer to data
+	 * \param [in] size is the size of \a data, bytes
+	 *
+	 * \return number of bytes written to the buffer
+	 */
+
+	size_t write(const void* data, size_t size);
+
+private:
+
+	/**
+	 * \brief Unblocks all threads waiting for data and/or all threads waiting for space if there are some data and/or
+	 * some free space in the buffer.
+	 */
+
+	void notify();
+
+	/// list of threads waiting for data
+	ThreadList dataWaitersList_;
+
+	/// list of threads waiting for free space
+	ThreadList spaceWaitersList_;
+
+	/// storage for data
+	const StorageUniquePointer storageUniquePointer_;
+
+	/// circular buffer which manages the storage
+	CircularBuffer circularBuffer_;
+};
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_STREAMBUFFERBASE_HPP_
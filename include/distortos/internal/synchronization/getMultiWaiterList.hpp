@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \brief getMultiWaiterList() declaration
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_
+
+#include "distortos/internal/synchronization/MultiWaiter.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/**
+ * \return reference to main instance of MultiWaiterList - list of all threads which wait for any of multiple waitable
+ * objects
+ */
+
+constexpr MultiWaiterList& getMultiWaiterList()
+{
+	extern MultiWaiterList multiWaiterListInstance;
+	return multiWaiterListInstance;
+}
+
+/**
+ * \brief Unblocks threads which wait for given object, if it is ready.
+ *
+ * \note This function must be called with interrupts masked.
+ *
+ * \param [in] object is a pointer to object which may have become ready
+ */
+
+void unblockReadyMultiWaiters(const void* object);
+
+/**
+ * \brief Notifies threads which wait for any of multiple waitable objects that given object may have become ready.
+ *
+ * When no thread waits for multiple objects, only emptiness of the list of multi-waiters is checked, so this function
+ * has negligible cost in single-object fast paths.
+ *
+ * \note This function must be called with interrupts masked.
+ *
+ * \param [in] object is a pointer to object which may have become ready
+ */
+
+inline void notifyMultiWaiters(const void* const object)
+{
+	if (getMultiWaiterList().empty() == false)
+		unblockReadyMultiWaiters(object);
+}
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_
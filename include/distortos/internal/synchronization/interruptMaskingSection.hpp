@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief Header with hooks for sections of code executed with interrupts masked
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_INTERRUPTMASKINGSECTION_HPP_
+#define INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_INTERRUPTMASKINGSECTION_HPP_
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Marks the beginning of section of code executed with interrupts masked.
+ *
+ * Called by architecture-specific code right after interrupts were masked, when they were not masked before.
+ *
+ * \param [in] returnAddress is the address of code which masked interrupts
+ */
+
+void interruptMaskingSectionBegin(const void* returnAddress);
+
+/**
+ * \brief Marks the end of section of code executed with interrupts masked.
+ *
+ * Called by architecture-specific code right before interrupts are unmasked. Duration of the section is recorded in
+ * InterruptMaskingStatistics. Calls without matching interruptMaskingSectionBegin() (for example for sections started
+ * before the statistics were initialized) are ignored.
+ */
+
+void interruptMaskingSectionEnd();
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#endif	// INCLUDE_DISTORTOS_INTERNAL_SYNCHRONIZATION_INTERRUPTMASKINGSECTION_HPP_
@@ -0,0 +1,177 @@
+/**
+ * \file
+ * \brief waitForAny() header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INCLUDE_DISTORTOS_WAITFORANY_HPP_
+#define INCLUDE_DISTORTOS_WAITFORANY_HPP_
+
+#include "distortos/TickClock.hpp"
+#include "distortos/WaitableObject.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+#include <utility>
+
+namespace distortos
+{
+
+/// range of WaitableObject elements
+using WaitableObjectsRange = estd::ContiguousRange<const WaitableObject>;
+
+/**
+ * \brief Tries to wait for any of multiple objects.
+ *
+ * Similar to poll() with zero timeout - http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html
+ *
+ * \param [in] objects is a range of objects that will be checked
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of first object from \a objects which
+ * is ready (valid only on success); error codes:
+ * - EAGAIN - none of the objects is ready;
+ * - EINVAL - \a objects is empty;
+ *
+ * \ingroup synchronization
+ */
+
+std::pair<int, size_t> tryWaitForAny(WaitableObjectsRange objects);
+
+/**
+ * \brief Tries to wait for any of multiple objects for given duration of time.
+ *
+ * If none of the objects is ready, the calling thread shall block until one of them becomes ready as in waitForAny()
+ * function. If this cannot happen without waiting for another thread or interrupt, this wait shall be terminated when
+ * the specified timeout expires.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ * \param [in] duration is the duration after which the wait will be terminated
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a objects is empty;
+ * - ETIMEDOUT - none of the objects became ready before the specified timeout expired;
+ *
+ * \ingroup synchronization
+ */
+
+std::pair<int, size_t> tryWaitForAnyFor(WaitableObjectsRange objects, TickClock::duration duration);
+
+/**
+ * \brief Tries to wait for any of multiple objects for given duration of time.
+ *
+ * Template variant of tryWaitForAnyFor(WaitableObjectsRange objects, TickClock::duration duration).
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \tparam Rep is type of tick counter
+ * \tparam Period is std::ratio type representing the tick period of the clock, seconds
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ * \param [in] duration is the duration after which the wait will be terminated
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a objects is empty;
+ * - ETIMEDOUT - none of the objects became ready before the specified timeout expired;
+ *
+ * \ingroup synchronization
+ */
+
+template<typename Rep, typename Period>
+std::pair<int, size_t> tryWaitForAnyFor(const WaitableObjectsRange objects,
+		const std::chrono::duration<Rep, Period> duration)
+{
+	return tryWaitForAnyFor(objects, std::chrono::duration_cast<TickClock::duration>(duration));
+}
+
+/**
+ * \brief Tries to wait for any of multiple objects until given time point.
+ *
+ * If none of the objects is ready, the calling thread shall block until one of them becomes ready as in waitForAny()
+ * function. If this cannot happen without waiting for another thread or interrupt, this wait shall be terminated when
+ * the specified timeout expires.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ * \param [in] timePoint is the time point at which the wait will be terminated
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a objects is empty;
+ * - ETIMEDOUT - none of the objects became ready before the specified timeout expired;
+ *
+ * \ingroup synchronization
+ */
+
+std::pair<int, size_t> tryWaitForAnyUntil(WaitableObjectsRange objects, TickClock::time_point timePoint);
+
+/**
+ * \brief Tries to wait for any of multiple objects until given time point.
+ *
+ * Template variant of tryWaitForAnyUntil(WaitableObjectsRange objects, TickClock::time_point timePoint).
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \tparam Duration is a std::chrono::duration type used to measure duration
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ * \param [in] timePoint is the time point at which the wait will be terminated
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a objects is empty;
+ * - ETIMEDOUT - none of the objects became ready before the specified timeout expired;
+ *
+ * \ingroup synchronization
+ */
+
+template<typename Duration>
+std::pair<int, size_t> tryWaitForAnyUntil(const WaitableObjectsRange objects,
+		const std::chrono::time_point<TickClock, Duration> timePoint)
+{
+	return tryWaitForAnyUntil(objects, std::chrono::time_point_cast<TickClock::duration>(timePoint));
+}
+
+/**
+ * \brief Waits for any of multiple objects.
+ *
+ * Similar to poll() - http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html
+ *
+ * If none of the objects is ready, the calling thread shall block (once, regardless of the number of objects) until
+ * one of them becomes ready or the call is interrupted by a signal. If multiple objects are ready, index of the first
+ * one is returned.
+ *
+ * Readiness is only reported, it is not consumed - the thread should execute non-blocking operation (like
+ * Semaphore::tryWait() or FifoQueue::tryPop()) on the object which became ready, as another thread or interrupt may
+ * have consumed the readiness in the meantime.
+ *
+ * \warning This function must not be called from interrupt context!
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - EINVAL - \a objects is empty;
+ *
+ * \ingroup synchronization
+ */
+
+std::pair<int, size_t> waitForAny(WaitableObjectsRange objects);
+
+}	// namespace distortos
+
+#endif	// INCLUDE_DISTORTOS_WAITFORANY_HPP_
@@ -0,0 +1,298 @@
+/**
+ * \file
+ * \brief InplaceFunction template class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ESTD_INPLACEFUNCTION_HPP_
+#define ESTD_INPLACEFUNCTION_HPP_
+
+#include "estd/invoke.hpp"
+
+#include <new>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace estd
+{
+
+template<typename Signature, size_t Capacity>
+class InplaceFunction;
+
+/**
+ * \brief InplaceFunction template class is a move-only replacement of std::function which stores the target in its
+ * internal storage.
+ *
+ * The target is never allocated dynamically - if it doesn't fit in the internal storage (its size is greater than
+ * \a Capacity or its alignment is greater than alignment of std::max_align_t), compilation fails. The target doesn't
+ * have to be copyable, so lambdas capturing move-only objects can be used.
+ *
+ * \tparam R is the type returned by <em>InplaceFunction::operator()() const</em>
+ * \tparam Args are the types of arguments for <em>InplaceFunction::operator()() const</em>
+ * \tparam Capacity is the size of internal storage, bytes
+ */
+
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+public:
+
+	/**
+	 * \brief InplaceFunction's constructor of empty object
+	 */
+
+	constexpr InplaceFunction() noexcept :
+			storage_{},
+			invoker_{},
+			manager_{}
+	{
+
+	}
+
+	/**
+	 * \brief InplaceFunction's constructor of empty object
+	 */
+
+	constexpr InplaceFunction(std::nullptr_t) noexcept :
+			InplaceFunction{}
+	{
+
+	}
+
+	/**
+	 * \brief InplaceFunction's constructor
+	 *
+	 * \tparam F is the type of target
+	 *
+	 * \param [in] function is the target which will be moved (or copied) to internal storage
+	 */
+
+	template<typename F, typename = typename std::enable_if<
+			std::is_same<typename std::decay<F>::type, InplaceFunction>::value == false &&
+			std::is_same<typename std::decay<F>::type, std::nullptr_t>::value == false>::type>
+	InplaceFunction(F&& function) :
+			storage_{},
+			invoker_{&invoke<typename std::decay<F>::type>},
+			manager_{&manage<typename std::decay<F>::type>}
+	{
+		using Target = typename std::decay<F>::type;
+		static_assert(sizeof(Target) <= Capacity, "Target doesn't fit in internal storage of InplaceFunction!");
+		static_assert(alignof(Target) <= alignof(Storage), "Target's alignment requirement is too strict!");
+		new (&storage_) Target(std::forward<F>(function));
+	}
+
+	/**
+	 * \brief InplaceFunction's move constructor
+	 *
+	 * \param [in] other is a rvalue reference to InplaceFunction used as source of move, it is empty after the move
+	 */
+
+	InplaceFunction(InplaceFunction&& other) noexcept :
+			storage_{},
+			invoker_{other.invoker_},
+			manager_{other.manager_}
+	{
+		if (manager_ == nullptr)
+			return;
+
+		manager_(&storage_, &other.storage_);
+		other.invoker_ = {};
+		other.manager_ = {};
+	}
+
+	/**
+	 * \brief InplaceFunction's destructor
+	 *
+	 * Destroys the target.
+	 */
+
+	~InplaceFunction()
+	{
+		reset();
+	}
+
+	/**
+	 * \brief InplaceFunction's move assignment operator
+	 *
+	 * \param [in] other is a rvalue reference to InplaceFunction used as source of move, it is empty after the move
+	 *
+	 * \return reference to this
+	 */
+
+	InplaceFunction& operator=(InplaceFunction&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		reset();
+
+		if (other.manager_ == nullptr)
+			return *this;
+
+		other.manager_(&storage_, &other.storage_);
+		invoker_ = other.invoker_;
+		manager_ = other.manager_;
+		other.invoker_ = {};
+		other.manager_ = {};
+		return *this;
+	}
+
+	/**
+	 * \brief InplaceFunction's assignment operator which destroys the target
+	 *
+	 * \return reference to this
+	 */
+
+	InplaceFunction& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	/**
+	 * \return true if the object has a target, false otherwise
+	 */
+
+	explicit operator bool() const noexcept
+	{
+		return invoker_ != nullptr;
+	}
+
+	/**
+	 * \brief Function call operator of InplaceFunction
+	 *
+	 * \warning The object must have a target!
+	 *
+	 * \param [in,out] args are arguments for the target
+	 *
+	 * \return value returned by the target
+	 */
+
+	R operator()(Args... args) const
+	{
+		return invoker_(&storage_, std::forward<Args>(args)...);
+	}
+
+	InplaceFunction(const InplaceFunction&) = delete;
+	const InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+private:
+
+	/// type of internal storage
+	using Storage = typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type;
+
+	/// type of function which calls the target
+	using Invoker = R(void*, Args&&...);
+
+	/// type of function which moves the target from second storage to first storage (if second argument is not
+	/// nullptr) or destroys the target in first storage (if second argument is nullptr)
+	using Manager = void(void*, void*);
+
+	/**
+	 * \brief Calls the target.
+	 *
+	 * \tparam Target is the type of target
+	 *
+	 * \param [in] storage is a pointer to storage with the target
+	 * \param [in,out] args are arguments for the target
+	 *
+	 * \return value returned by the target
+	 */
+
+	template<typename Target>
+	static R invoke(void* const storage, Args&&... args)
+	{
+		return static_cast<R>(estd::invoke(*static_cast<Target*>(storage), std::forward<Args>(args)...));
+	}
+
+	/**
+	 * \brief Moves or destroys the target.
+	 *
+	 * \tparam Target is the type of target
+	 *
+	 * \param [in] storage is a pointer to storage to which the target will be moved, or which contains the target that
+	 * will be destroyed
+	 * \param [in] source is a pointer to storage with the target which will be moved, nullptr to destroy the target in
+	 * \a storage
+	 */
+
+	template<typename Target>
+	static void manage(void* const storage, void* const source)
+	{
+		if (source == nullptr)
+		{
+			static_cast<Target*>(storage)->~Target();
+			return;
+		}
+
+		auto& sourceTarget = *static_cast<Target*>(source);
+		new (storage) Target(std::move(sourceTarget));
+		sourceTarget.~Target();
+	}
+
+	/**
+	 * \brief Destroys the target (if any), the object is empty after this call.
+	 */
+
+	void reset()
+	{
+		if (manager_ != nullptr)
+			manager_(&storage_, nullptr);
+
+		invoker_ = {};
+		manager_ = {};
+	}
+
+	/// internal storage for the target, mutable because const operator()() may call non-const target
+	mutable Storage storage_;
+
+	/// pointer to function which calls the target, nullptr if the object is empty
+	Invoker* invoker_;
+
+	/// pointer to function which moves or destroys the target, nullptr if the object is empty
+	Manager* manager_;
+};
+
+/**
+ * \brief InplaceFunction's equality operator, overload for nullptr on the right side
+ *
+ * \tparam Signature is the signature of \a function
+ * \tparam Capacity is the size of internal storage of \a function, bytes
+ *
+ * \param [in] function is a reference to InplaceFunction object
+ *
+ * \return true if \a function is empty, false otherwise
+ */
+
+template<typename Signature, size_t Capacity>
+bool operator==(const InplaceFunction<Signature, Capacity>& function, std::nullptr_t)
+{
+	return static_cast<bool>(function) == false;
+}
+
+/**
+ * \brief InplaceFunction's inequality operator, overload for nullptr on the right side
+ *
+ * \tparam Signature is the signature of \a function
+ * \tparam Capacity is the size of internal storage of \a function, bytes
+ *
+ * \param [in] function is a reference to InplaceFunction object
+ *
+ * \return true if \a function has a target, false otherwise
+ */
+
+template<typename Signature, size_t Capacity>
+bool operator!=(const InplaceFunction<Signature, Capacity>& function, std::nullptr_t)
+{
+	return static_cast<bool>(function);
+}
+
+}	// namespace estd
+
+#endif	// ESTD_INPLACEFUNCTION_HPP_
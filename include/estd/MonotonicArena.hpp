@@ -0,0 +1,206 @@
+/**
+ * \file
+ * \brief MonotonicArena class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ESTD_MONOTONICARENA_HPP_
+#define ESTD_MONOTONICARENA_HPP_
+
+#include <memory>
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace estd
+{
+
+/**
+ * \brief MonotonicArena class is an allocator which only increments a pointer in its buffer and frees all allocated
+ * memory at once.
+ *
+ * Allocation is a constant-time operation which doesn't use any lock, deallocation of single block does nothing -
+ * memory is reclaimed only by reset() (or destruction of the arena). This makes the arena suitable for many small
+ * objects with common lifetime - for example all objects allocated during handling of single request.
+ *
+ * In the fixed-size variant (block size equal to 0) the arena uses only the buffer given during construction and
+ * allocation fails when this buffer is exhausted. In the chained variant, when the current buffer is exhausted,
+ * additional block of at least given size is allocated with std::malloc() - the blocks are chained and freed by
+ * reset().
+ *
+ * The arena is not thread-safe - it should be used by single thread or protected externally.
+ */
+
+class MonotonicArena
+{
+public:
+
+	/// default alignment of allocated memory, bytes
+	constexpr static size_t defaultAlignment {alignof(std::max_align_t)};
+
+	/**
+	 * \brief MonotonicArena's constructor
+	 *
+	 * \param [in] buffer is a pointer to initial buffer, may be nullptr if \a size is 0
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [in] blockSize is the minimal size of additional blocks allocated with std::malloc() when the current
+	 * buffer is exhausted, bytes, 0 to disable allocation of additional blocks, default - 0
+	 */
+
+	constexpr MonotonicArena(void* const buffer, const size_t size, const size_t blockSize = {}) :
+			buffer_{buffer},
+			current_{buffer},
+			blockList_{},
+			blockSize_{blockSize},
+			remainingSize_{size},
+			size_{size}
+	{
+
+	}
+
+	/**
+	 * \brief MonotonicArena's destructor
+	 *
+	 * Frees all additional blocks.
+	 */
+
+	~MonotonicArena()
+	{
+		reset();
+	}
+
+	/**
+	 * \brief Allocates memory from the arena.
+	 *
+	 * \param [in] size is the size of memory, bytes
+	 * \param [in] alignment is the required alignment of memory, must be a power of 2, default - defaultAlignment
+	 *
+	 * \return pointer to allocated memory, nullptr if the arena is exhausted and additional block could not be
+	 * allocated
+	 */
+
+	void* allocate(const size_t size, const size_t alignment = defaultAlignment)
+	{
+		auto memory = std::align(alignment, size, current_, remainingSize_);
+		if (memory == nullptr)
+		{
+			if (allocateBlock(size, alignment) == false)
+				return nullptr;
+
+			memory = std::align(alignment, size, current_, remainingSize_);
+		}
+
+		current_ = static_cast<uint8_t*>(current_) + size;
+		remainingSize_ -= size;
+		return memory;
+	}
+
+	/**
+	 * \brief Deallocates memory - this function does nothing, memory is reclaimed only by reset().
+	 */
+
+	void deallocate(void*, size_t)
+	{
+
+	}
+
+	/**
+	 * \return size of memory remaining in the current buffer, bytes
+	 */
+
+	size_t getRemainingSize() const
+	{
+		return remainingSize_;
+	}
+
+	/**
+	 * \brief Frees all memory allocated from the arena at once.
+	 *
+	 * All additional blocks are freed with std::free() and the arena starts to allocate from the beginning of initial
+	 * buffer again.
+	 *
+	 * \warning All objects allocated from the arena must be already destroyed.
+	 */
+
+	void reset()
+	{
+		while (blockList_ != nullptr)
+		{
+			const auto next = blockList_->next;
+			std::free(blockList_);
+			blockList_ = next;
+		}
+
+		current_ = buffer_;
+		remainingSize_ = size_;
+	}
+
+	MonotonicArena(const MonotonicArena&) = delete;
+	MonotonicArena(MonotonicArena&&) = delete;
+	const MonotonicArena& operator=(const MonotonicArena&) = delete;
+	MonotonicArena& operator=(MonotonicArena&&) = delete;
+
+private:
+
+	/// header of additional block
+	struct Block
+	{
+		/// pointer to previously allocated block, nullptr if this is the first one
+		Block* next;
+	};
+
+	/**
+	 * \brief Allocates additional block and makes it the current buffer.
+	 *
+	 * \param [in] size is the size of memory which must fit in the block, bytes
+	 * \param [in] alignment is the required alignment of memory, must be a power of 2
+	 *
+	 * \return true if the block was allocated, false otherwise
+	 */
+
+	bool allocateBlock(const size_t size, const size_t alignment)
+	{
+		if (blockSize_ == 0 || size > SIZE_MAX - sizeof(Block) - alignment)
+			return false;
+
+		const auto requiredSize = sizeof(Block) + alignment - 1 + size;
+		const auto blockSize = blockSize_ > requiredSize ? blockSize_ : requiredSize;
+		const auto memory = std::malloc(blockSize);
+		if (memory == nullptr)
+			return false;
+
+		blockList_ = new (memory) Block{blockList_};
+		current_ = blockList_ + 1;
+		remainingSize_ = blockSize - sizeof(Block);
+		return true;
+	}
+
+	/// pointer to initial buffer
+	void* buffer_;
+
+	/// pointer to first free byte in the current buffer
+	void* current_;
+
+	/// list of additional blocks, the most recently allocated one first
+	Block* blockList_;
+
+	/// minimal size of additional blocks, bytes, 0 if additional blocks are disabled
+	size_t blockSize_;
+
+	/// size of memory remaining in the current buffer, bytes
+	size_t remainingSize_;
+
+	/// size of initial buffer, bytes
+	size_t size_;
+};
+
+}	// namespace estd
+
+#endif	// ESTD_MONOTONICARENA_HPP_
@@ -0,0 +1,152 @@
+/**
+ * \file
+ * \brief MonotonicArenaAllocator template class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ESTD_MONOTONICARENAALLOCATOR_HPP_
+#define ESTD_MONOTONICARENAALLOCATOR_HPP_
+
+#include "estd/MonotonicArena.hpp"
+
+namespace estd
+{
+
+/**
+ * \brief MonotonicArenaAllocator template class is an allocator which satisfies C++ Allocator requirements and
+ * allocates memory from MonotonicArena.
+ *
+ * It can be used with standard containers - for example `std::vector<int, MonotonicArenaAllocator<int>>` - so that
+ * their elements are allocated from the arena instead of from the heap. Deallocation does nothing, memory is reclaimed
+ * by MonotonicArena::reset().
+ *
+ * \note As exceptions are disabled, allocate() returns nullptr when the arena is exhausted.
+ *
+ * \tparam T is the type of allocated objects
+ */
+
+template<typename T>
+class MonotonicArenaAllocator
+{
+	template<typename U>
+	friend class MonotonicArenaAllocator;
+
+public:
+
+	/// type of allocated objects
+	using value_type = T;
+
+	/**
+	 * \brief MonotonicArenaAllocator's constructor
+	 *
+	 * \param [in] monotonicArena is a reference to arena from which memory will be allocated
+	 */
+
+	constexpr explicit MonotonicArenaAllocator(MonotonicArena& monotonicArena) noexcept :
+			monotonicArena_{&monotonicArena}
+	{
+
+	}
+
+	/**
+	 * \brief MonotonicArenaAllocator's converting constructor
+	 *
+	 * \tparam U is the type of objects allocated by \a other
+	 *
+	 * \param [in] other is a reference to MonotonicArenaAllocator which will be copied
+	 */
+
+	template<typename U>
+	constexpr MonotonicArenaAllocator(const MonotonicArenaAllocator<U>& other) noexcept :
+			monotonicArena_{other.monotonicArena_}
+	{
+
+	}
+
+	/**
+	 * \brief Allocates memory for objects.
+	 *
+	 * \param [in] count is the number of objects
+	 *
+	 * \return pointer to allocated memory, nullptr if allocation failed
+	 */
+
+	T* allocate(const size_t count)
+	{
+		if (count > SIZE_MAX / sizeof(T))
+			return nullptr;
+
+		return static_cast<T*>(monotonicArena_->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/**
+	 * \brief Deallocates memory for objects - this function does nothing.
+	 *
+	 * \param [in] memory is a pointer to memory which will be deallocated
+	 * \param [in] count is the number of objects
+	 */
+
+	void deallocate(T* const memory, const size_t count)
+	{
+		monotonicArena_->deallocate(memory, count * sizeof(T));
+	}
+
+	/**
+	 * \return reference to arena from which memory is allocated
+	 */
+
+	MonotonicArena& getMonotonicArena() const
+	{
+		return *monotonicArena_;
+	}
+
+private:
+
+	/// pointer to arena from which memory is allocated
+	MonotonicArena* monotonicArena_;
+};
+
+/**
+ * \brief MonotonicArenaAllocator's equality operator
+ *
+ * \tparam T is the type of objects allocated by \a left
+ * \tparam U is the type of objects allocated by \a right
+ *
+ * \param [in] left is a reference to left operand of equality operator
+ * \param [in] right is a reference to right operand of equality operator
+ *
+ * \return true if both allocators use the same arena, false otherwise
+ */
+
+template<typename T, typename U>
+bool operator==(const MonotonicArenaAllocator<T>& left, const MonotonicArenaAllocator<U>& right)
+{
+	return &left.getMonotonicArena() == &right.getMonotonicArena();
+}
+
+/**
+ * \brief MonotonicArenaAllocator's inequality operator
+ *
+ * \tparam T is the type of objects allocated by \a left
+ * \tparam U is the type of objects allocated by \a right
+ *
+ * \param [in] left is a reference to left operand of inequality operator
+ * \param [in] right is a reference to right operand of inequality operator
+ *
+ * \return true if allocators use different arenas, false otherwise
+ */
+
+template<typename T, typename U>
+bool operator!=(const MonotonicArenaAllocator<T>& left, const MonotonicArenaAllocator<U>& right)
+{
+	return (left == right) == false;
+}
+
+}	// namespace estd
+
+#endif	// ESTD_MONOTONICARENAALLOCATOR_HPP_
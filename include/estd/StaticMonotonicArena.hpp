@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief StaticMonotonicArena class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ESTD_STATICMONOTONICARENA_HPP_
+#define ESTD_STATICMONOTONICARENA_HPP_
+
+#include "estd/MonotonicArena.hpp"
+
+#include <type_traits>
+
+namespace estd
+{
+
+/**
+ * \brief StaticMonotonicArena class is a variant of MonotonicArena that has automatic storage for initial buffer.
+ *
+ * \tparam Size is the size of initial buffer, bytes
+ * \tparam BlockSize is the minimal size of additional blocks allocated with std::malloc() when the current buffer is
+ * exhausted, bytes, 0 to disable allocation of additional blocks, default - 0
+ */
+
+template<size_t Size, size_t BlockSize = 0>
+class StaticMonotonicArena : public MonotonicArena
+{
+public:
+
+	/**
+	 * \brief StaticMonotonicArena's constructor
+	 */
+
+	StaticMonotonicArena() :
+			MonotonicArena{&storage_, sizeof(storage_), BlockSize}
+	{
+
+	}
+
+private:
+
+	/// storage for initial buffer
+	typename std::aligned_storage<Size, defaultAlignment>::type storage_;
+};
+
+}	// namespace estd
+
+#endif	// ESTD_STATICMONOTONICARENA_HPP_
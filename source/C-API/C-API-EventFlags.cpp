@@ -0,0 +1,172 @@
+/**
+ * \file
+ * \brief Implementation of C-API for distortos::EventFlags
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/C-API/EventFlags.h"
+
+#include "distortos/EventFlags.hpp"
+#include "distortos/fromCApi.hpp"
+
+#include <cerrno>
+
+#ifndef DISTORTOS_UNIT_TEST
+
+static_assert(sizeof(distortos_EventFlags) == sizeof(distortos::EventFlags),
+		"Size of distortos_EventFlags does not match size of distortos::EventFlags!");
+static_assert(alignof(distortos_EventFlags) == alignof(distortos::EventFlags),
+		"Alignment of distortos_EventFlags does not match alignment of distortos::EventFlags!");
+
+#endif	// !def DISTORTOS_UNIT_TEST
+
+static_assert(distortos_EventFlags_WaitMode_any == static_cast<uint8_t>(distortos::EventFlags::WaitMode::any),
+		"Value of distortos_EventFlags_WaitMode_any does not match value of distortos::EventFlags::WaitMode::any!");
+static_assert(distortos_EventFlags_WaitMode_all == static_cast<uint8_t>(distortos::EventFlags::WaitMode::all),
+		"Value of distortos_EventFlags_WaitMode_all does not match value of distortos::EventFlags::WaitMode::all!");
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks whether mode of waiting is valid.
+ *
+ * \param [in] mode is the mode of waiting that will be checked
+ *
+ * \return true if \a mode is valid, false otherwise
+ */
+
+bool isValidWaitMode(const uint8_t mode)
+{
+	return mode == distortos_EventFlags_WaitMode_any || mode == distortos_EventFlags_WaitMode_all;
+}
+
+/**
+ * \brief Converts result of one of distortos::EventFlags' wait functions to C-API.
+ *
+ * \param [in] result is the pair with return code and value of event flags
+ * \param [out] value is a pointer to variable into which value of event flags will be written, NULL to ignore
+ *
+ * \return return code from \a result
+ */
+
+int handleWaitResult(const std::pair<int, uint32_t> result, uint32_t* const value)
+{
+	if (value != nullptr)
+		*value = result.second;
+	return result.first;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int distortos_EventFlags_construct_1(distortos_EventFlags* const eventFlags, const uint32_t value)
+{
+	if (eventFlags == nullptr)
+		return EINVAL;
+
+	new (eventFlags) distortos::EventFlags {value};
+	return 0;
+}
+
+int distortos_EventFlags_destruct(distortos_EventFlags* const eventFlags)
+{
+	if (eventFlags == nullptr)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	realEventFlags.~EventFlags();
+	return 0;
+}
+
+int distortos_EventFlags_clear(distortos_EventFlags* const eventFlags, const uint32_t bitmask,
+		uint32_t* const previousValue)
+{
+	if (eventFlags == nullptr)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	const auto ret = realEventFlags.clear(bitmask);
+	if (previousValue != nullptr)
+		*previousValue = ret;
+	return 0;
+}
+
+int distortos_EventFlags_get(const distortos_EventFlags* const eventFlags, uint32_t* const value)
+{
+	if (eventFlags == nullptr || value == nullptr)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	*value = realEventFlags.get();
+	return 0;
+}
+
+int distortos_EventFlags_set(distortos_EventFlags* const eventFlags, const uint32_t bitmask,
+		uint32_t* const previousValue)
+{
+	if (eventFlags == nullptr)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	const auto ret = realEventFlags.set(bitmask);
+	if (previousValue != nullptr)
+		*previousValue = ret;
+	return 0;
+}
+
+int distortos_EventFlags_tryWait(distortos_EventFlags* const eventFlags, const uint32_t bitmask, const uint8_t mode,
+		const bool clearOnExit, uint32_t* const value)
+{
+	if (eventFlags == nullptr || isValidWaitMode(mode) == false)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	return handleWaitResult(realEventFlags.tryWait(bitmask, static_cast<distortos::EventFlags::WaitMode>(mode),
+			clearOnExit), value);
+}
+
+int distortos_EventFlags_tryWaitFor(distortos_EventFlags* const eventFlags, const uint32_t bitmask,
+		const uint8_t mode, const int64_t duration, const bool clearOnExit, uint32_t* const value)
+{
+	if (eventFlags == nullptr || isValidWaitMode(mode) == false)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	return handleWaitResult(realEventFlags.tryWaitFor(bitmask, static_cast<distortos::EventFlags::WaitMode>(mode),
+			distortos::TickClock::duration{duration}, clearOnExit), value);
+}
+
+int distortos_EventFlags_tryWaitUntil(distortos_EventFlags* const eventFlags, const uint32_t bitmask,
+		const uint8_t mode, const int64_t timePoint, const bool clearOnExit, uint32_t* const value)
+{
+	if (eventFlags == nullptr || isValidWaitMode(mode) == false)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	return handleWaitResult(realEventFlags.tryWaitUntil(bitmask, static_cast<distortos::EventFlags::WaitMode>(mode),
+			distortos::TickClock::time_point{distortos::TickClock::duration{timePoint}}, clearOnExit), value);
+}
+
+int distortos_EventFlags_wait(distortos_EventFlags* const eventFlags, const uint32_t bitmask, const uint8_t mode,
+		const bool clearOnExit, uint32_t* const value)
+{
+	if (eventFlags == nullptr || isValidWaitMode(mode) == false)
+		return EINVAL;
+
+	auto& realEventFlags = distortos::fromCApi(*eventFlags);
+	return handleWaitResult(realEventFlags.wait(bitmask, static_cast<distortos::EventFlags::WaitMode>(mode),
+			clearOnExit), value);
+}
@@ -9,5 +9,6 @@
 
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/C-API-ConditionVariable.cpp
+		${CMAKE_CURRENT_LIST_DIR}/C-API-EventFlags.cpp
 		${CMAKE_CURRENT_LIST_DIR}/C-API-Mutex.cpp
 		${CMAKE_CURRENT_LIST_DIR}/C-API-Semaphore.cpp)
@@ -40,6 +40,15 @@ void architectureLowLevelInitializer()
 #if __FPU_PRESENT == 1 && __FPU_USED == 1
 	SCB->CPACR |= 3 << 10 * 2 | 3 << 11 * 2;	// full access to CP10 and CP11
 #endif	// __FPU_PRESENT == 1 && __FPU_USED == 1
+#if defined(CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER) && CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+	// trace & debug blocks are powered and the cycle counter is started only when it is actually used
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifdef CONFIG_ARCHITECTURE_ARM_CORTEX_M7
+	DWT->LAR = 0xc5acce55;	// unlock write access to DWT registers
+#endif	// def CONFIG_ARCHITECTURE_ARM_CORTEX_M7
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif	// defined(CONFIG_ARCHITECTURE_HAS_CYCLE_COUNTER) && CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
 }
 
 BIND_LOW_LEVEL_INITIALIZER(30, architectureLowLevelInitializer);
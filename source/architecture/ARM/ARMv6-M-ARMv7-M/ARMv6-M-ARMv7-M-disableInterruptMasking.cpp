@@ -2,7 +2,7 @@
  * \file
  * \brief disableInterruptMasking() implementation for ARMv6-M and ARMv7-M
  *
- * \author Copyright (C) 2014-2016 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,6 +11,8 @@
 
 #include "distortos/architecture/disableInterruptMasking.hpp"
 
+#include "distortos/internal/synchronization/interruptMaskingSection.hpp"
+
 #include "distortos/chip/CMSIS-proxy.h"
 
 namespace distortos
@@ -28,16 +30,29 @@ InterruptMask disableInterruptMasking()
 #if CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI != 0
 
 	const auto interruptMask = __get_BASEPRI();
-	__set_BASEPRI(0);
-	return interruptMask;
 
 #else	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
 
 	const auto interruptMask = __get_PRIMASK();
+
+#endif	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+	if (interruptMask != 0)	// interrupts were masked before?
+		internal::interruptMaskingSectionEnd();
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#if CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI != 0
+
+	__set_BASEPRI(0);
+
+#else	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
 	__enable_irq();
-	return interruptMask;
 
 #endif	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
+	return interruptMask;
 }
 
 }	// namespace architecture
@@ -2,7 +2,7 @@
  * \file
  * \brief enableInterruptMasking() implementation for ARMv6-M and ARMv7-M
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,6 +11,8 @@
 
 #include "distortos/architecture/enableInterruptMasking.hpp"
 
+#include "distortos/internal/synchronization/interruptMaskingSection.hpp"
+
 #include "distortos/chip/CMSIS-proxy.h"
 
 namespace distortos
@@ -42,15 +44,19 @@ InterruptMask enableInterruptMasking()
 	__enable_irq();	// ARM Cortex-M7 r0p1 bug ID 837070
 #endif	// def CONFIG_ARCHITECTURE_ARM_CORTEX_M7_R0P1
 
-	return interruptMask;
-
 #else	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
 
 	const auto interruptMask = __get_PRIMASK();
 	__disable_irq();
-	return interruptMask;
 
 #endif	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+	if (interruptMask == 0)	// interrupts were not masked before?
+		internal::interruptMaskingSectionBegin(__builtin_return_address(0));
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+	return interruptMask;
 }
 
 }	// namespace architecture
@@ -2,7 +2,7 @@
  * \file
  * \brief restoreInterruptMasking() implementation for ARMv6-M and ARMv7-M
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,6 +11,8 @@
 
 #include "distortos/architecture/restoreInterruptMasking.hpp"
 
+#include "distortos/internal/synchronization/interruptMaskingSection.hpp"
+
 #include "distortos/chip/CMSIS-proxy.h"
 
 namespace distortos
@@ -25,6 +27,19 @@ namespace architecture
 
 void restoreInterruptMasking(const InterruptMask interruptMask)
 {
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#if CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI != 0
+	const InterruptMask previousInterruptMask = __get_BASEPRI();
+#else	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+	const InterruptMask previousInterruptMask = __get_PRIMASK();
+#endif	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
+	if (previousInterruptMask != 0 && interruptMask == 0)	// interrupts will be unmasked?
+		internal::interruptMaskingSectionEnd();
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
 #if CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI != 0
 
 #ifdef CONFIG_ARCHITECTURE_ARM_CORTEX_M7_R0P1
@@ -42,6 +57,11 @@ void restoreInterruptMasking(const InterruptMask interruptMask)
 	__set_PRIMASK(interruptMask);
 
 #endif	// CONFIG_ARCHITECTURE_ARMV7_M_KERNEL_BASEPRI == 0
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+	if (previousInterruptMask == 0 && interruptMask != 0)	// interrupts were masked?
+		internal::interruptMaskingSectionBegin(__builtin_return_address(0));
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
 }
 
 }	// namespace architecture
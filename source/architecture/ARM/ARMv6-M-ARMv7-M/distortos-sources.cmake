@@ -14,6 +14,7 @@ if(CONFIG_ARCHITECTURE_ARMV6_M OR CONFIG_ARCHITECTURE_ARMV7_M)
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-coreVectors.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-disableInterruptMasking.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-enableInterruptMasking.cpp
+			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-getCycleCounter.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-getMainStack.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-initializeStack.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv6-M-ARMv7-M-isInInterruptContext.cpp
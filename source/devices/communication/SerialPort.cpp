@@ -13,6 +13,8 @@
 
 #include "distortos/devices/communication/UartLowLevel.hpp"
 
+#include "distortos/internal/synchronization/getMultiWaiterList.hpp"
+
 #include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
 
 #include "distortos/InterruptMaskingLock.hpp"
@@ -65,31 +67,6 @@ size_t copySingleBlock(SerialPort::CircularBuffer& source, SerialPort::CircularB
 
 }	// namespace
 
-/*---------------------------------------------------------------------------------------------------------------------+
-| SerialPort::CircularBuffer public functions
-+---------------------------------------------------------------------------------------------------------------------*/
-
-std::pair<const uint8_t*, size_t> SerialPort::CircularBuffer::getReadBlock() const
-{
-	const auto readPosition = readPosition_ ;
-	const auto writePosition = writePosition_;
-	if (isEmpty(readPosition, writePosition) == true)
-		return {{}, {}};
-	return getBlock(readPosition, writePosition);
-}
-
-std::pair<uint8_t*, size_t> SerialPort::CircularBuffer::getWriteBlock() const
-{
-	if (isReadOnly() == true)
-		return {{}, {}};
-
-	const auto readPosition = readPosition_ ;
-	const auto writePosition = writePosition_;
-	if (isFull(readPosition, writePosition) == true)
-		return {{}, {}};
-	return getBlock(writePosition, readPosition);
-}
-
 /*---------------------------------------------------------------------------------------------------------------------+
 | public functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -284,6 +261,8 @@ void SerialPort::readCompleteEvent(const size_t bytesRead)
 	readInProgress_ = false;
 
 	startReadWrapper();
+
+	internal::notifyMultiWaiters(this);
 }
 
 void SerialPort::receiveErrorEvent(ErrorSet)
@@ -342,6 +321,11 @@ void SerialPort::writeCompleteEvent(const size_t bytesWritten)
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+bool SerialPort::isReadReady() const
+{
+	return openCount_ != 0 && readBuffer_.isEmpty() == false;
+}
+
 int SerialPort::readFromCircularBufferAndStartRead(CircularBuffer& buffer)
 {
 	while (copySingleBlock(readBuffer_, buffer) != 0)
@@ -430,6 +414,19 @@ int SerialPort::readImplementation(CircularBuffer& buffer, const size_t minSize,
 	return scopeGuardRet != 0 ? scopeGuardRet : semaphoreRet;
 }
 
+void SerialPort::requestReadReadinessNotification()
+{
+	// device is closed, read operation is arranged by read() or there's some data already?
+	if (openCount_ == 0 || currentReadBuffer_ != &readBuffer_ || readLimit_ != 0 || readBuffer_.isEmpty() == false)
+		return;
+
+	// restart read operation with size limit, notification after 1 byte will mean that the device is ready
+	stopReadWrapper();
+	if (readBuffer_.isEmpty() == true)
+		readLimit_ = 1;
+	startReadWrapper();
+}
+
 int SerialPort::startReadWrapper()
 {
 	if (readInProgress_ == true)
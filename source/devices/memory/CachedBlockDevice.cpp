@@ -0,0 +1,510 @@
+/**
+ * \file
+ * \brief CachedBlockDevice class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/CachedBlockDevice.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/assert.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+CachedBlockDevice::~CachedBlockDevice()
+{
+	assert(openCount_ == 0);
+}
+
+int CachedBlockDevice::close()
+{
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)	// device is not open anymore?
+		return EBADF;
+
+	if (openCount_ == 1)	// last close?
+	{
+		{
+			const auto ret = flush();
+			if (ret != 0)
+				return ret;
+		}
+		{
+			const auto ret = blockDevice_.close();
+			if (ret != 0)
+				return ret;
+		}
+	}
+
+	--openCount_;
+	return 0;
+}
+
+int CachedBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, getEraseBlockSize());
+		if (ret != 0)
+			return ret;
+	}
+
+	discardLines(address, size);
+	return blockDevice_.erase(address, size);
+}
+
+size_t CachedBlockDevice::getEraseBlockSize() const
+{
+	return std::max(blockDevice_.getEraseBlockSize(), lineSize_);
+}
+
+std::pair<bool, uint8_t> CachedBlockDevice::getErasedValue() const
+{
+	return blockDevice_.getErasedValue();
+}
+
+size_t CachedBlockDevice::getProgramBlockSize() const
+{
+	return lineSize_;
+}
+
+size_t CachedBlockDevice::getReadBlockSize() const
+{
+	return blockDevice_.getReadBlockSize();
+}
+
+uint64_t CachedBlockDevice::getSize() const
+{
+	return blockDevice_.getSize();
+}
+
+CachedBlockDevice::Statistics CachedBlockDevice::getStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	return statistics_;
+}
+
+int CachedBlockDevice::lock()
+{
+	return mutex_.lock();
+}
+
+int CachedBlockDevice::open()
+{
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	if (openCount_ == std::numeric_limits<decltype(openCount_)>::max())	// device is already opened too many times?
+		return EMFILE;
+
+	if (openCount_ == 0)	// first open?
+	{
+		{
+			const auto ret = blockDevice_.open();
+			if (ret != 0)
+				return ret;
+		}
+
+		const auto eraseBlockSize = blockDevice_.getEraseBlockSize();
+		if (linesCount_ == 0 || lineSize_ == 0 || lineSize_ % blockDevice_.getReadBlockSize() != 0 ||
+				lineSize_ % blockDevice_.getProgramBlockSize() != 0 ||
+				(eraseBlockSize % lineSize_ != 0 && lineSize_ % eraseBlockSize != 0) ||
+				blockDevice_.getSize() % lineSize_ != 0)
+		{
+			blockDevice_.close();
+			return EINVAL;
+		}
+
+		for (size_t i {}; i < linesCount_; ++i)
+			lines_[i] = {};
+		clockHand_ = {};
+	}
+
+	++openCount_;
+	return 0;
+}
+
+std::pair<int, size_t> CachedBlockDevice::program(const uint64_t address, const void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, lineSize_);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	if (size == 0)
+		return {{}, {}};
+
+	if (buffer == nullptr)
+		return {EINVAL, {}};
+
+	const auto bufferUint8 = static_cast<const uint8_t*>(buffer);
+	size_t bytesProgrammed {};
+	while (bytesProgrammed < size)
+	{
+		const auto lineAddress = address + bytesProgrammed;
+		auto line = findLine(lineAddress);
+		if (line != nullptr)
+		{
+			++statistics_.hits;
+			touchLine(*line);
+		}
+		else
+		{
+			++statistics_.misses;
+			const auto ret = allocateLine(lineAddress);
+			if (ret.first != 0)
+				return {ret.first, bytesProgrammed};
+
+			line = ret.second;
+		}
+
+		memcpy(getLineBuffer(*line), bufferUint8 + bytesProgrammed, lineSize_);
+		line->dirty = true;
+		bytesProgrammed += lineSize_;
+	}
+
+	return {{}, bytesProgrammed};
+}
+
+std::pair<int, size_t> CachedBlockDevice::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, getReadBlockSize());
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	if (size == 0)
+		return {{}, {}};
+
+	if (buffer == nullptr)
+		return {EINVAL, {}};
+
+	const auto bufferUint8 = static_cast<uint8_t*>(buffer);
+	size_t bytesRead {};
+	while (bytesRead < size)
+	{
+		const auto currentAddress = address + bytesRead;
+		const auto offset = static_cast<size_t>(currentAddress % lineSize_);
+		const auto lineAddress = currentAddress - offset;
+		const auto chunkSize = std::min(lineSize_ - offset, size - bytesRead);
+
+		{
+			const auto line = findLine(lineAddress);
+			if (line != nullptr)
+			{
+				++statistics_.hits;
+				touchLine(*line);
+				memcpy(bufferUint8 + bytesRead, getLineBuffer(*line) + offset, chunkSize);
+				bytesRead += chunkSize;
+				continue;
+			}
+		}
+
+		if (chunkSize == lineSize_)	// run of complete missing lines is read directly to buffer with single operation
+		{
+			size_t runSize {lineSize_};
+			while (bytesRead + runSize + lineSize_ <= size && findLine(lineAddress + runSize) == nullptr)
+				runSize += lineSize_;
+
+			{
+				const auto ret = blockDevice_.read(lineAddress, bufferUint8 + bytesRead, runSize);
+				if (ret.first != 0)
+					return {ret.first, bytesRead};
+			}
+
+			for (size_t lineOffset {}; lineOffset < runSize; lineOffset += lineSize_)
+			{
+				++statistics_.misses;
+				const auto ret = allocateLine(lineAddress + lineOffset);
+				if (ret.first != 0)
+					return {ret.first, bytesRead};
+
+				memcpy(getLineBuffer(*ret.second), bufferUint8 + bytesRead, lineSize_);
+				bytesRead += lineSize_;
+			}
+
+			continue;
+		}
+
+		++statistics_.misses;
+		const auto allocateLineRet = allocateLine(lineAddress);
+		if (allocateLineRet.first != 0)
+			return {allocateLineRet.first, bytesRead};
+
+		const auto line = allocateLineRet.second;
+		const auto lineBuffer = getLineBuffer(*line);
+		const auto ret = blockDevice_.read(lineAddress, lineBuffer, lineSize_);
+		if (ret.first != 0)
+		{
+			line->valid = false;
+			return {ret.first, bytesRead};
+		}
+
+		memcpy(bufferUint8 + bytesRead, lineBuffer + offset, chunkSize);
+		bytesRead += chunkSize;
+	}
+
+	return {{}, bytesRead};
+}
+
+void CachedBlockDevice::resetStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	statistics_ = {};
+}
+
+int CachedBlockDevice::synchronize()
+{
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	{
+		const auto ret = flush();
+		if (ret != 0)
+			return ret;
+	}
+
+	return blockDevice_.synchronize();
+}
+
+int CachedBlockDevice::trim(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<CachedBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, getEraseBlockSize());
+		if (ret != 0)
+			return ret;
+	}
+
+	discardLines(address, size);
+	return blockDevice_.trim(address, size);
+}
+
+int CachedBlockDevice::unlock()
+{
+	return mutex_.unlock();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, CachedBlockDevice::Line*> CachedBlockDevice::allocateLine(const uint64_t address)
+{
+	Line* line {};
+	for (size_t i {}; i < linesCount_; ++i)
+		if (lines_[i].valid == false)
+		{
+			line = &lines_[i];
+			break;
+		}
+
+	if (line == nullptr)	// no unused line, evict one
+	{
+		line = &selectVictim();
+		if (line->dirty == true)
+		{
+			const auto victimAddress = line->address;
+			const auto ret = writeBack(*line);
+			if (ret != 0)
+				return {ret, {}};
+
+			// write-back may move lines between slots
+			line = findLine(victimAddress);
+		}
+
+		++statistics_.evictions;
+	}
+
+	line->address = address;
+	line->dirty = false;
+	line->valid = true;
+	touchLine(*line);
+	return {{}, line};
+}
+
+int CachedBlockDevice::checkRange(const uint64_t address, const uint64_t size, const size_t blockSize) const
+{
+	if (openCount_ == 0)
+		return EBADF;
+
+	if (address % blockSize != 0 || size % blockSize != 0)
+		return EINVAL;
+
+	const auto deviceSize = getSize();
+	if (address > deviceSize || size > deviceSize - address)
+		return ENOSPC;
+
+	return {};
+}
+
+void CachedBlockDevice::discardLines(const uint64_t address, const uint64_t size)
+{
+	for (size_t i {}; i < linesCount_; ++i)
+	{
+		auto& line = lines_[i];
+		if (line.valid == true && line.address >= address && line.address - address < size)
+		{
+			line.dirty = false;
+			line.valid = false;
+		}
+	}
+}
+
+CachedBlockDevice::Line* CachedBlockDevice::findLine(const uint64_t address) const
+{
+	for (size_t i {}; i < linesCount_; ++i)
+		if (lines_[i].valid == true && lines_[i].address == address)
+			return &lines_[i];
+
+	return {};
+}
+
+int CachedBlockDevice::flush()
+{
+	Line* lowestLine;
+	do
+	{
+		lowestLine = {};
+		for (size_t i {}; i < linesCount_; ++i)
+		{
+			auto& line = lines_[i];
+			if (line.dirty == true && (lowestLine == nullptr || line.address < lowestLine->address))
+				lowestLine = &line;
+		}
+
+		if (lowestLine != nullptr)
+		{
+			const auto ret = writeBack(*lowestLine);
+			if (ret != 0)
+				return ret;
+		}
+	} while (lowestLine != nullptr);
+
+	return {};
+}
+
+CachedBlockDevice::Line& CachedBlockDevice::selectVictim()
+{
+	if (evictionPolicy_ == EvictionPolicy::clock)
+	{
+		// give second chance to all lines which were referenced since CLOCK hand passed them
+		while (lines_[clockHand_].referenced == true)
+		{
+			lines_[clockHand_].referenced = false;
+			clockHand_ = (clockHand_ + 1) % linesCount_;
+		}
+
+		auto& victim = lines_[clockHand_];
+		clockHand_ = (clockHand_ + 1) % linesCount_;
+		return victim;
+	}
+
+	auto victim = &lines_[0];
+	for (size_t i {1}; i < linesCount_; ++i)
+		// unsigned subtraction gives correct age even after use counter wraps around
+		if (static_cast<uint32_t>(useCounter_ - lines_[i].lastUse) >
+				static_cast<uint32_t>(useCounter_ - victim->lastUse))
+			victim = &lines_[i];
+
+	return *victim;
+}
+
+void CachedBlockDevice::touchLine(Line& line)
+{
+	line.lastUse = ++useCounter_;
+	line.referenced = true;
+}
+
+int CachedBlockDevice::writeBack(Line& line)
+{
+	assert(line.valid == true && line.dirty == true && "Line is not dirty!");
+
+	// find first line of the run of dirty lines with consecutive blocks
+	auto first = &line;
+	while (first->address >= lineSize_)
+	{
+		const auto previous = findLine(first->address - lineSize_);
+		if (previous == nullptr || previous->dirty == false)
+			break;
+
+		first = previous;
+	}
+
+	const auto firstAddress = first->address;
+	size_t count {1};
+	while (count < linesCount_)
+	{
+		const auto next = findLine(firstAddress + count * lineSize_);
+		if (next == nullptr || next->dirty == false)
+			break;
+
+		++count;
+	}
+
+	// gather the run in adjacent slots, so that it can be programmed with single operation
+	const auto firstIndex = std::min(static_cast<size_t>(first - lines_), linesCount_ - count);
+	for (size_t i {}; i < count; ++i)
+	{
+		auto& slot = lines_[firstIndex + i];
+		const auto current = findLine(firstAddress + i * lineSize_);
+		if (current == &slot)
+			continue;
+
+		const auto slotBuffer = getLineBuffer(slot);
+		std::swap_ranges(slotBuffer, slotBuffer + lineSize_, getLineBuffer(*current));
+		std::swap(slot, *current);
+	}
+
+	first = &lines_[firstIndex];
+	const auto ret = blockDevice_.program(firstAddress, getLineBuffer(*first), count * lineSize_);
+	++statistics_.writeBacks;
+
+	const auto programmedLines = ret.second / lineSize_;
+	for (size_t i {}; i < programmedLines; ++i)
+		first[i].dirty = false;
+
+	if (ret.first != 0)
+		return ret.first;
+
+	return programmedLines == count ? 0 : EIO;
+}
+
+}	// namespace devices
+
+}	// namespace distortos
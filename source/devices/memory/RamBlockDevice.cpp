@@ -0,0 +1,270 @@
+/**
+ * \file
+ * \brief RamBlockDevice class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/RamBlockDevice.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/ThisThread.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+RamBlockDevice::~RamBlockDevice()
+{
+	assert(openCount_ == 0);
+}
+
+int RamBlockDevice::close()
+{
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)	// device is not open anymore?
+		return EBADF;
+
+	--openCount_;
+	return 0;
+}
+
+int RamBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, eraseBlockSize_);
+		if (ret != 0)
+			return ret;
+	}
+
+	if (size == 0)
+		return {};
+
+	{
+		const auto ret = simulateLatency(latencies_.erase);
+		if (ret != 0)
+			return ret;
+	}
+
+	memset(buffer_ + address, erasedValue_, size);
+	++statistics_.erases;
+	statistics_.erasedBytes += size;
+	return {};
+}
+
+size_t RamBlockDevice::getEraseBlockSize() const
+{
+	return eraseBlockSize_;
+}
+
+std::pair<bool, uint8_t> RamBlockDevice::getErasedValue() const
+{
+	return {true, erasedValue_};
+}
+
+size_t RamBlockDevice::getProgramBlockSize() const
+{
+	return programBlockSize_;
+}
+
+size_t RamBlockDevice::getReadBlockSize() const
+{
+	return readBlockSize_;
+}
+
+uint64_t RamBlockDevice::getSize() const
+{
+	return size_;
+}
+
+RamBlockDevice::Statistics RamBlockDevice::getStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	return statistics_;
+}
+
+int RamBlockDevice::lock()
+{
+	return mutex_.lock();
+}
+
+int RamBlockDevice::open()
+{
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	if (openCount_ == std::numeric_limits<decltype(openCount_)>::max())	// device is already opened too many times?
+		return EMFILE;
+
+	assert(buffer_ != nullptr && readBlockSize_ != 0 && programBlockSize_ % readBlockSize_ == 0 &&
+			programBlockSize_ != 0 && eraseBlockSize_ % programBlockSize_ == 0 && eraseBlockSize_ != 0 &&
+			size_ % eraseBlockSize_ == 0 && "Invalid geometry of device!");
+
+	++openCount_;
+	return 0;
+}
+
+std::pair<int, size_t> RamBlockDevice::program(const uint64_t address, const void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, programBlockSize_);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	if (size == 0)
+		return {{}, {}};
+
+	if (buffer == nullptr)
+		return {EINVAL, {}};
+
+	{
+		const auto ret = simulateLatency(latencies_.program);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	const auto begin = buffer_ + address;
+	const auto end = begin + size;
+	const auto erasedValue = erasedValue_;
+	if (std::all_of(begin, end, [erasedValue](const uint8_t value)
+			{
+				return value == erasedValue;
+			}) == false)
+		return {EIO, {}};
+
+	memcpy(begin, buffer, size);
+	++statistics_.programs;
+	statistics_.programmedBytes += size;
+	return {{}, size};
+}
+
+std::pair<int, size_t> RamBlockDevice::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, readBlockSize_);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	if (size == 0)
+		return {{}, {}};
+
+	if (buffer == nullptr)
+		return {EINVAL, {}};
+
+	{
+		const auto ret = simulateLatency(latencies_.read);
+		if (ret != 0)
+			return {ret, {}};
+	}
+
+	memcpy(buffer, buffer_ + address, size);
+	++statistics_.reads;
+	statistics_.readBytes += size;
+	return {{}, size};
+}
+
+void RamBlockDevice::resetStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	statistics_ = {};
+}
+
+void RamBlockDevice::setLatencies(const Latencies& latencies)
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	latencies_ = latencies;
+}
+
+int RamBlockDevice::synchronize()
+{
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	return {};
+}
+
+int RamBlockDevice::trim(const uint64_t address, const uint64_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<RamBlockDevice> lockGuard {*this};
+
+	{
+		const auto ret = checkRange(address, size, eraseBlockSize_);
+		if (ret != 0)
+			return ret;
+	}
+
+	++statistics_.trims;
+	return {};
+}
+
+int RamBlockDevice::unlock()
+{
+	return mutex_.unlock();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int RamBlockDevice::checkRange(const uint64_t address, const uint64_t size, const size_t blockSize) const
+{
+	if (openCount_ == 0)
+		return EBADF;
+
+	if (address % blockSize != 0 || size % blockSize != 0)
+		return EINVAL;
+
+	if (address > size_ || size > size_ - address)
+		return ENOSPC;
+
+	return {};
+}
+
+int RamBlockDevice::simulateLatency(const TickClock::duration latency)
+{
+	if (latency <= TickClock::duration{})
+		return {};
+
+	return ThisThread::sleepFor(latency);
+}
+
+}	// namespace devices
+
+}	// namespace distortos
@@ -0,0 +1,267 @@
+/**
+ * \file
+ * \brief ReadAheadBlockDevice class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/memory/ReadAheadBlockDevice.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/assert.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+ReadAheadBlockDevice::~ReadAheadBlockDevice()
+{
+	assert(openCount_ == 0);
+}
+
+int ReadAheadBlockDevice::close()
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)	// device is not open anymore?
+		return EBADF;
+
+	if (openCount_ == 1)	// last close?
+	{
+		const auto ret = blockDevice_.close();
+		if (ret != 0)
+			return ret;
+	}
+
+	--openCount_;
+	return 0;
+}
+
+int ReadAheadBlockDevice::erase(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	invalidate(address, size);
+	return blockDevice_.erase(address, size);
+}
+
+size_t ReadAheadBlockDevice::getEraseBlockSize() const
+{
+	return blockDevice_.getEraseBlockSize();
+}
+
+std::pair<bool, uint8_t> ReadAheadBlockDevice::getErasedValue() const
+{
+	return blockDevice_.getErasedValue();
+}
+
+size_t ReadAheadBlockDevice::getProgramBlockSize() const
+{
+	return blockDevice_.getProgramBlockSize();
+}
+
+size_t ReadAheadBlockDevice::getReadBlockSize() const
+{
+	return blockDevice_.getReadBlockSize();
+}
+
+uint64_t ReadAheadBlockDevice::getSize() const
+{
+	return blockDevice_.getSize();
+}
+
+ReadAheadBlockDevice::Statistics ReadAheadBlockDevice::getStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	return statistics_;
+}
+
+int ReadAheadBlockDevice::lock()
+{
+	return mutex_.lock();
+}
+
+int ReadAheadBlockDevice::open()
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == std::numeric_limits<decltype(openCount_)>::max())	// device is already opened too many times?
+		return EMFILE;
+
+	if (openCount_ == 0)	// first open?
+	{
+		{
+			const auto ret = blockDevice_.open();
+			if (ret != 0)
+				return ret;
+		}
+
+		if (bufferSize_ < blockDevice_.getReadBlockSize())
+		{
+			blockDevice_.close();
+			return EINVAL;
+		}
+
+		nextAddress_ = std::numeric_limits<decltype(nextAddress_)>::max();
+		bufferedSize_ = {};
+		windowSize_ = {};
+	}
+
+	++openCount_;
+	return 0;
+}
+
+std::pair<int, size_t> ReadAheadBlockDevice::program(const uint64_t address, const void* const buffer,
+		const size_t size)
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return {EBADF, {}};
+
+	invalidate(address, size);
+	return blockDevice_.program(address, buffer, size);
+}
+
+std::pair<int, size_t> ReadAheadBlockDevice::read(const uint64_t address, void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return {EBADF, {}};
+
+	const auto readBlockSize = getReadBlockSize();
+	if (address % readBlockSize != 0 || size % readBlockSize != 0)
+		return {EINVAL, {}};
+
+	const auto deviceSize = getSize();
+	if (address > deviceSize || size > deviceSize - address)
+		return {ENOSPC, {}};
+
+	if (size == 0)
+		return {{}, {}};
+
+	if (buffer == nullptr)
+		return {EINVAL, {}};
+
+	const auto sequential = address == nextAddress_;
+	nextAddress_ = address + size;
+
+	const auto bufferUint8 = static_cast<uint8_t*>(buffer);
+	size_t bytesRead {};
+	if (address >= bufferAddress_ && address - bufferAddress_ < bufferedSize_)
+	{
+		const auto offset = static_cast<size_t>(address - bufferAddress_);
+		bytesRead = std::min(bufferedSize_ - offset, size);
+		memcpy(bufferUint8, buffer_ + offset, bytesRead);
+		if (bytesRead == size)
+		{
+			++statistics_.hits;
+			return {{}, bytesRead};
+		}
+	}
+
+	++statistics_.misses;
+
+	const auto currentAddress = address + bytesRead;
+	const auto remainingSize = size - bytesRead;
+
+	if (sequential == true)
+	{
+		const auto maxWindowSize = bufferSize_ - bufferSize_ % readBlockSize;
+		const auto minWindowSize = std::max(maxWindowSize / 4 - maxWindowSize / 4 % readBlockSize, readBlockSize);
+		windowSize_ = windowSize_ == 0 ? minWindowSize : std::min(windowSize_ * 2, maxWindowSize);
+	}
+	else
+		windowSize_ = {};
+
+	if (remainingSize >= windowSize_)	// non-sequential or large read - bypass the buffer
+	{
+		const auto ret = blockDevice_.read(currentAddress, bufferUint8 + bytesRead, remainingSize);
+		return {ret.first, bytesRead + ret.second};
+	}
+
+	const auto prefetchSize = static_cast<size_t>(std::min<uint64_t>(windowSize_, deviceSize - currentAddress));
+	const auto ret = blockDevice_.read(currentAddress, buffer_, prefetchSize);
+	++statistics_.prefetches;
+	if (ret.first != 0)
+	{
+		bufferedSize_ = {};
+		return {ret.first, bytesRead};
+	}
+
+	bufferAddress_ = currentAddress;
+	bufferedSize_ = ret.second;
+
+	memcpy(bufferUint8 + bytesRead, buffer_, remainingSize);
+	return {{}, size};
+}
+
+void ReadAheadBlockDevice::resetStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutex_};
+	statistics_ = {};
+}
+
+int ReadAheadBlockDevice::synchronize()
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	return blockDevice_.synchronize();
+}
+
+int ReadAheadBlockDevice::trim(const uint64_t address, const uint64_t size)
+{
+	const std::lock_guard<ReadAheadBlockDevice> lockGuard {*this};
+
+	if (openCount_ == 0)
+		return EBADF;
+
+	invalidate(address, size);
+	return blockDevice_.trim(address, size);
+}
+
+int ReadAheadBlockDevice::unlock()
+{
+	return mutex_.unlock();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void ReadAheadBlockDevice::invalidate(const uint64_t address, const uint64_t size)
+{
+	if (address < bufferAddress_ + bufferedSize_ && bufferAddress_ < address + size)
+		bufferedSize_ = {};
+}
+
+}	// namespace devices
+
+}	// namespace distortos
@@ -9,5 +9,8 @@
 
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/BlockDevice.cpp
+		${CMAKE_CURRENT_LIST_DIR}/CachedBlockDevice.cpp
+		${CMAKE_CURRENT_LIST_DIR}/RamBlockDevice.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ReadAheadBlockDevice.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SpiEeprom.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SpiSdMmcCard.cpp)
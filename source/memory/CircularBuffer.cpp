@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief CircularBuffer class implementation
+ *
+ * \author Copyright (C) 2016-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/memory/CircularBuffer.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<const uint8_t*, size_t> CircularBuffer::getReadBlock() const
+{
+	const auto readPosition = readPosition_ ;
+	const auto writePosition = writePosition_;
+	if (isEmpty(readPosition, writePosition) == true)
+		return {{}, {}};
+	return getBlock(readPosition, writePosition);
+}
+
+std::pair<uint8_t*, size_t> CircularBuffer::getWriteBlock() const
+{
+	if (isReadOnly() == true)
+		return {{}, {}};
+
+	const auto readPosition = readPosition_ ;
+	const auto writePosition = writePosition_;
+	if (isFull(readPosition, writePosition) == true)
+		return {{}, {}};
+	return getBlock(writePosition, readPosition);
+}
+
+}	// namespace internal
+
+}	// namespace distortos
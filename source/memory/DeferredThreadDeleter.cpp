@@ -2,7 +2,7 @@
  * \file
  * \brief DeferredThreadDeleter class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -18,6 +18,8 @@
 #include "distortos/internal/scheduler/RunnableThread.hpp"
 #include "distortos/internal/scheduler/ThreadControlBlock.hpp"
 
+#include "distortos/InterruptMaskingLock.hpp"
+
 namespace distortos
 {
 
@@ -28,17 +30,12 @@ namespace internal
 | public functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-int DeferredThreadDeleter::operator()(ThreadControlBlock& threadControlBlock)
+void DeferredThreadDeleter::operator()(ThreadControlBlock& threadControlBlock)
 {
+	const InterruptMaskingLock interruptMaskingLock;
+
 	list_.push_back(threadControlBlock);
 	notEmpty_ = true;
-
-	return mutex_.unlock();
-}
-
-int DeferredThreadDeleter::lock()
-{
-	return mutex_.lock();
 }
 
 int DeferredThreadDeleter::tryCleanup()
@@ -54,34 +51,15 @@ int DeferredThreadDeleter::tryCleanup()
 			return ret;
 	}
 
-	const auto ret = tryCleanupInternal();
+	decltype(list_) localList;
 
 	{
-		const auto ret2 = mallocMutex.unlock();
-		if (ret2 != 0)
-			return ret2;
-	}
-
-	return ret;
-}
+		const InterruptMaskingLock interruptMaskingLock;
 
-/*---------------------------------------------------------------------------------------------------------------------+
-| private functions
-+---------------------------------------------------------------------------------------------------------------------*/
-
-int DeferredThreadDeleter::tryCleanupInternal()
-{
-	{
-		const auto ret = mutex_.tryLock();
-		if (ret != 0)
-			return ret;
+		localList.swap(list_);
+		notEmpty_ = false;
 	}
 
-	decltype(list_) localList {std::move(list_)};
-	notEmpty_ = false;
-
-	const auto ret = mutex_.unlock();
-
 	while (localList.empty() == false)
 	{
 		const auto& runnableThread = localList.front().getOwner();
@@ -89,7 +67,7 @@ int DeferredThreadDeleter::tryCleanupInternal()
 		delete &runnableThread;
 	}
 
-	return ret;
+	return mallocMutex.unlock();
 }
 
 }	// namespace internal
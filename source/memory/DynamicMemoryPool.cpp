@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \brief DynamicMemoryPool class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/DynamicMemoryPool.hpp"
+
+#include "distortos/internal/memory/storageDeleter.hpp"
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+DynamicMemoryPool::DynamicMemoryPool(const size_t blockSize, const size_t blocks) :
+		MemoryPool{{new std::max_align_t[getRoundedBlockSize(blockSize) / alignment * blocks],
+				internal::storageDeleter<std::max_align_t>}, blockSize, blocks}
+{
+
+}
+
+}	// namespace distortos
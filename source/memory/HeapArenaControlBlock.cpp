@@ -0,0 +1,141 @@
+/**
+ * \file
+ * \brief HeapArenaControlBlock class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/memory/HeapArenaControlBlock.hpp"
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <new>
+
+#include <cstdlib>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// intrusive list of HeapArenaControlBlock objects
+using HeapArenaControlBlockList = estd::IntrusiveList<HeapArenaControlBlock, &HeapArenaControlBlock::node>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// list of all initialized HeapArenaControlBlock objects, protected with interrupt masking
+HeapArenaControlBlockList heapArenaControlBlockList;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+HeapArenaControlBlock::~HeapArenaControlBlock()
+{
+	if (isInitialized() == false)
+		return;
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+		node.unlink();
+	}
+
+	::free(memory_);
+}
+
+void* HeapArenaControlBlock::allocate(const size_t alignment, const size_t size)
+{
+	freeQueued();
+	return tlsfHeap_.allocateAligned(alignment, size);
+}
+
+HeapArenaControlBlock* HeapArenaControlBlock::find(const void* const memory)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	for (auto& heapArenaControlBlock : heapArenaControlBlockList)
+		if (heapArenaControlBlock.contains(memory) == true)
+			return &heapArenaControlBlock;
+
+	return {};
+}
+
+void HeapArenaControlBlock::free(void* const memory)
+{
+	freeQueued();
+	tlsfHeap_.free(memory);
+}
+
+int HeapArenaControlBlock::initialize(void* const memory)
+{
+	const auto ret = tlsfHeap_.initialize(memory, size_);
+	if (ret != 0)
+		return ret;
+
+	memory_ = memory;
+
+	const InterruptMaskingLock interruptMaskingLock;
+	heapArenaControlBlockList.push_back(*this);
+	return 0;
+}
+
+void HeapArenaControlBlock::queueFree(void* const memory)
+{
+	const auto queuedFree = new (memory) QueuedFree;
+
+	const InterruptMaskingLock interruptMaskingLock;
+	queuedFree->next = queuedFreeList_;
+	queuedFreeList_ = queuedFree;
+}
+
+void* HeapArenaControlBlock::reallocate(void* const memory, const size_t size)
+{
+	freeQueued();
+	return tlsfHeap_.reallocate(memory, size);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void HeapArenaControlBlock::freeQueued()
+{
+	QueuedFree* queuedFree;
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+		queuedFree = queuedFreeList_;
+		queuedFreeList_ = {};
+	}
+
+	while (queuedFree != nullptr)
+	{
+		const auto next = queuedFree->next;
+		tlsfHeap_.free(queuedFree);
+		queuedFree = next;
+	}
+}
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
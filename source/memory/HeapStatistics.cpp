@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief HeapStatistics class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/HeapStatistics.hpp"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+#include "distortos/internal/memory/getTlsfHeap.hpp"
+#include "distortos/internal/memory/heapTrace.hpp"
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include "distortos/internal/newlib/locking.hpp"
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+#include <mutex>
+
+namespace distortos
+{
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ring buffer with the most recent entries of the trace, zero-initialized, protected with interrupt masking
+HeapStatistics::TraceEntry trace[HeapStatistics::traceSize];
+
+/// number of all entries recorded in the trace, the next entry is written at (traceCount % traceSize)
+uint64_t traceCount;
+
+}	// namespace
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+HeapStatistics::Snapshot HeapStatistics::getSnapshot()
+{
+	const std::lock_guard<Mutex> lockGuard {internal::getMallocMutex()};
+
+	const auto& heap = internal::getTlsfHeap();
+	const auto freeBlocksSummary = heap.summarizeFreeBlocks();
+	Snapshot snapshot {};
+	snapshot.allocationCount = heap.getAllocationCount();
+	snapshot.failedAllocationCount = heap.getFailedAllocationCount();
+	snapshot.freeCount = heap.getFreeCount();
+	snapshot.size = heap.getSize();
+	snapshot.usedSize = heap.getUsedSize();
+	snapshot.maxUsedSize = heap.getMaxUsedSize();
+	snapshot.freeSize = freeBlocksSummary.totalSize;
+	snapshot.freeBlockCount = freeBlocksSummary.count;
+	snapshot.largestFreeBlockSize = freeBlocksSummary.largestSize;
+	if (freeBlocksSummary.totalSize != 0)
+		snapshot.fragmentation = static_cast<uint64_t>(freeBlocksSummary.totalSize - freeBlocksSummary.largestSize) *
+				1000 / freeBlocksSummary.totalSize;
+	return snapshot;
+}
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+size_t HeapStatistics::getTrace(TraceEntry* const entries, const size_t size)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto available = traceCount < traceSize ? static_cast<size_t>(traceCount) : traceSize;
+	const auto count = size < available ? size : available;
+	for (size_t i {}; i < count; ++i)
+		entries[i] = trace[(traceCount - count + i) % traceSize];
+
+	return count;
+}
+
+uint64_t HeapStatistics::getTraceCount()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return traceCount;
+}
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+void HeapStatistics::reset()
+{
+	const std::lock_guard<Mutex> lockGuard {internal::getMallocMutex()};
+
+	internal::getTlsfHeap().resetStatistics();
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	for (auto& entry : trace)
+		entry = {};
+	traceCount = {};
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+}
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void recordHeapOperation(const HeapStatistics::Operation operation, const void* const returnAddress,
+		const void* const memory, const void* const previousMemory, const size_t size)
+{
+	const auto& threadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	const InterruptMaskingLock interruptMaskingLock;
+	trace[traceCount % HeapStatistics::traceSize] = {{threadControlBlock, threadControlBlock.getSequenceNumber()},
+			returnAddress, memory, previousMemory, size, operation};
+	++traceCount;
+}
+
+}	// namespace internal
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+}	// namespace distortos
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
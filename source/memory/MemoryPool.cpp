@@ -0,0 +1,123 @@
+/**
+ * \file
+ * \brief MemoryPool class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/MemoryPool.hpp"
+
+#include "distortos/internal/synchronization/SemaphoreWaitFunctor.hpp"
+#include "distortos/internal/synchronization/SemaphoreTryWaitFunctor.hpp"
+#include "distortos/internal/synchronization/SemaphoreTryWaitForFunctor.hpp"
+#include "distortos/internal/synchronization/SemaphoreTryWaitUntilFunctor.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MemoryPool::MemoryPool(StorageUniquePointer&& storageUniquePointer, const size_t blockSize, const size_t blocks) :
+		semaphore_{blocks, blocks},
+		storageUniquePointer_{std::move(storageUniquePointer)},
+		freeList_{},
+		blockSize_{getRoundedBlockSize(blockSize)},
+		blocks_{blocks},
+		maxUsedBlocks_{}
+{
+	// link all blocks into the list of free blocks, starting from the last one, so that they are allocated in order
+	auto block = static_cast<uint8_t*>(storageUniquePointer_.get()) + blockSize_ * blocks_;
+	for (size_t i {}; i < blocks_; ++i)
+	{
+		block -= blockSize_;
+		*reinterpret_cast<void**>(block) = freeList_;
+		freeList_ = block;
+	}
+}
+
+std::pair<int, void*> MemoryPool::allocate()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const internal::SemaphoreWaitFunctor semaphoreWaitFunctor;
+	return allocateInternal(semaphoreWaitFunctor);
+}
+
+int MemoryPool::free(void* const block)
+{
+	const auto storageBegin = static_cast<uint8_t*>(storageUniquePointer_.get());
+	const auto storageEnd = storageBegin + blockSize_ * blocks_;
+	if (block < storageBegin || block >= storageEnd ||
+			static_cast<size_t>(static_cast<uint8_t*>(block) - storageBegin) % blockSize_ != 0)
+		return EINVAL;
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	// post fails when the pool is already full (block is freed twice), in that case the list must not be modified;
+	// thread unblocked by post cannot run before interrupts are unmasked, so the block is linked before it is taken
+	const auto ret = semaphore_.post();
+	if (ret != 0)
+		return ret;
+
+	*static_cast<void**>(block) = freeList_;
+	freeList_ = block;
+	return 0;
+}
+
+std::pair<int, void*> MemoryPool::tryAllocate()
+{
+	const internal::SemaphoreTryWaitFunctor semaphoreTryWaitFunctor;
+	return allocateInternal(semaphoreTryWaitFunctor);
+}
+
+std::pair<int, void*> MemoryPool::tryAllocateFor(const TickClock::duration duration)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const internal::SemaphoreTryWaitForFunctor semaphoreTryWaitForFunctor {duration};
+	return allocateInternal(semaphoreTryWaitForFunctor);
+}
+
+std::pair<int, void*> MemoryPool::tryAllocateUntil(const TickClock::time_point timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const internal::SemaphoreTryWaitUntilFunctor semaphoreTryWaitUntilFunctor {timePoint};
+	return allocateInternal(semaphoreTryWaitUntilFunctor);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, void*> MemoryPool::allocateInternal(const internal::SemaphoreFunctor& waitSemaphoreFunctor)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = waitSemaphoreFunctor(semaphore_);
+	if (ret != 0)
+		return {ret, nullptr};
+
+	const auto block = freeList_;
+	freeList_ = *static_cast<void**>(block);
+
+	const auto usedBlocks = blocks_ - semaphore_.getValue();
+	if (usedBlocks > maxUsedBlocks_)
+		maxUsedBlocks_ = usedBlocks;
+
+	return {0, block};
+}
+
+}	// namespace distortos
@@ -0,0 +1,517 @@
+/**
+ * \file
+ * \brief TlsfHeap class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include <tuple>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of header of each block - pointer to previous physical block and size of the block, bytes
+constexpr size_t headerSize {sizeof(void*) + sizeof(size_t)};
+
+/// minimum size of block - free block must be able to hold two pointers of the list, bytes
+constexpr size_t minimumBlockSize {(2 * sizeof(void*) + TlsfHeap::alignment - 1) / TlsfHeap::alignment *
+		TlsfHeap::alignment};
+
+/// minimum size of gap before aligned block - it must be possible to turn this gap into a free block, bytes
+constexpr size_t minimumGapSize {headerSize + minimumBlockSize};
+
+static_assert(headerSize % TlsfHeap::alignment == 0, "Size of block header must be a multiple of alignment!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Adjusts requested size of allocation to the size of block.
+ *
+ * \param [in] size is the requested size of allocation, bytes
+ *
+ * \return \a size rounded up to TlsfHeap::alignment and not smaller than minimumBlockSize, 0 if \a size is greater
+ * than TlsfHeap::maxAllocationSize
+ */
+
+size_t adjustSize(const size_t size)
+{
+	if (size > TlsfHeap::maxAllocationSize)
+		return 0;
+
+	const auto alignedSize = (size + TlsfHeap::alignment - 1) & ~(TlsfHeap::alignment - 1);
+	return alignedSize > minimumBlockSize ? alignedSize : minimumBlockSize;
+}
+
+/**
+ * \param [in] value is the value which will be scanned, must not be 0
+ *
+ * \return index of the least significant set bit in \a value
+ */
+
+uint8_t findFirstSet(const unsigned long value)
+{
+	return __builtin_ctzl(value);
+}
+
+/**
+ * \param [in] value is the value which will be scanned, must not be 0
+ *
+ * \return index of the most significant set bit in \a value
+ */
+
+uint8_t findLastSet(const unsigned long value)
+{
+	return sizeof(value) * CHAR_BIT - 1 - __builtin_clzl(value);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// Block struct is a header of single block of the heap
+struct TlsfHeap::Block
+{
+	/// flag set in sizeAndFreeFlag if the block is free
+	constexpr static size_t freeFlag {1};
+
+	/**
+	 * \param [in] memory is a pointer to memory of the block
+	 *
+	 * \return reference to block which contains \a memory
+	 */
+
+	static Block& fromMemory(const void* const memory)
+	{
+		return *reinterpret_cast<Block*>(reinterpret_cast<uintptr_t>(memory) - headerSize);
+	}
+
+	/**
+	 * \return pointer to memory of the block
+	 */
+
+	void* getMemory()
+	{
+		return reinterpret_cast<uint8_t*>(this) + headerSize;
+	}
+
+	/**
+	 * \return reference to next physical block
+	 */
+
+	Block& getNextPhysical()
+	{
+		return *reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(this) + headerSize + getSize());
+	}
+
+	/**
+	 * \return size of the block (without header), bytes
+	 */
+
+	size_t getSize() const
+	{
+		return sizeAndFreeFlag & ~freeFlag;
+	}
+
+	/**
+	 * \return true if the block is free, false otherwise
+	 */
+
+	bool isFree() const
+	{
+		return (sizeAndFreeFlag & freeFlag) != 0;
+	}
+
+	/**
+	 * \param [in] free selects whether the block is free (true) or used (false)
+	 */
+
+	void setFree(const bool free)
+	{
+		sizeAndFreeFlag = free == true ? sizeAndFreeFlag | freeFlag : sizeAndFreeFlag & ~freeFlag;
+	}
+
+	/**
+	 * \param [in] size is the new size of the block (without header), bytes
+	 */
+
+	void setSize(const size_t size)
+	{
+		sizeAndFreeFlag = size | (sizeAndFreeFlag & freeFlag);
+	}
+
+	/// pointer to previous physical block, nullptr for the first block of the heap
+	Block* previousPhysical;
+
+	/// size of the block (without header) with TlsfHeap::Block::freeFlag
+	size_t sizeAndFreeFlag;
+
+	/// pointer to next block on the list of free blocks, valid only if the block is free
+	Block* nextFree;
+
+	/// pointer to previous block on the list of free blocks, valid only if the block is free
+	Block* previousFree;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public static member variables
++---------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t TlsfHeap::alignment;
+
+constexpr uint8_t TlsfHeap::secondLevelIndexLog2;
+
+constexpr uint8_t TlsfHeap::secondLevelIndexCount;
+
+constexpr uint8_t TlsfHeap::maxBlockSizeLog2;
+
+constexpr size_t TlsfHeap::maxAllocationSize;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void* TlsfHeap::allocate(const size_t size)
+{
+	const auto adjustedSize = adjustSize(size);
+	const auto block = adjustedSize != 0 ? extractFreeBlock(adjustedSize) : nullptr;
+	if (block == nullptr)
+	{
+		++failedAllocationCount_;
+		return nullptr;
+	}
+
+	return useBlock(*block, adjustedSize);
+}
+
+void* TlsfHeap::allocateAligned(const size_t requiredAlignment, const size_t size)
+{
+	if (requiredAlignment == 0 || (requiredAlignment & (requiredAlignment - 1)) != 0)
+		return nullptr;
+
+	if (requiredAlignment <= alignment)
+		return allocate(size);
+
+	const auto adjustedSize = adjustSize(size);
+	// block must be large enough for the worst-case gap needed to reach aligned address
+	const auto block = adjustedSize != 0 && requiredAlignment <= maxAllocationSize - minimumGapSize &&
+			adjustedSize <= maxAllocationSize - minimumGapSize - requiredAlignment ?
+			extractFreeBlock(adjustedSize + requiredAlignment + minimumGapSize) : nullptr;
+	if (block == nullptr)
+	{
+		++failedAllocationCount_;
+		return nullptr;
+	}
+
+	const auto address = reinterpret_cast<uintptr_t>(block->getMemory());
+	auto alignedAddress = (address + requiredAlignment - 1) & ~(requiredAlignment - 1);
+	if (alignedAddress == address)
+		return useBlock(*block, adjustedSize);
+
+	// gap which is too small to become a free block must be extended to next aligned address
+	if (alignedAddress - address < minimumGapSize)
+		alignedAddress = (address + minimumGapSize + requiredAlignment - 1) & ~(requiredAlignment - 1);
+
+	const auto gapSize = alignedAddress - address;
+	auto& alignedBlock = Block::fromMemory(reinterpret_cast<void*>(alignedAddress));
+	alignedBlock.previousPhysical = block;
+	alignedBlock.sizeAndFreeFlag = block->getSize() - gapSize;
+	alignedBlock.getNextPhysical().previousPhysical = &alignedBlock;
+
+	// gap is returned to the heap, its previous physical block is used, as free blocks are always merged
+	block->setSize(gapSize - headerSize);
+	insertFreeBlock(*block);
+
+	return useBlock(alignedBlock, adjustedSize);
+}
+
+void TlsfHeap::free(void* const memory)
+{
+	if (memory == nullptr)
+		return;
+
+	auto& block = Block::fromMemory(memory);
+	++freeCount_;
+	usedSize_ -= block.getSize();
+	block.setFree(true);
+	insertFreeBlock(mergeFreeBlock(block));
+}
+
+size_t TlsfHeap::getUsableSize(const void* const memory)
+{
+	return Block::fromMemory(memory).getSize();
+}
+
+int TlsfHeap::initialize(void* const buffer, const size_t size)
+{
+	static_assert(offsetof(Block, nextFree) == headerSize, "Invalid layout of block header!");
+
+	const auto begin = (reinterpret_cast<uintptr_t>(buffer) + alignment - 1) & ~(alignment - 1);
+	const auto end = (reinterpret_cast<uintptr_t>(buffer) + size) & ~(alignment - 1);
+	if (end < begin || end - begin < 2 * headerSize + minimumBlockSize)
+		return EINVAL;
+
+	for (auto& freeLists : freeLists_)
+		for (auto& freeList : freeLists)
+			freeList = {};
+	for (auto& secondLevelBitmap : secondLevelBitmaps_)
+		secondLevelBitmap = {};
+	firstLevelBitmap_ = {};
+	usedSize_ = {};
+	resetStatistics();
+
+	// one free block spanning the whole buffer, followed by zero-sized used block which is never merged
+	constexpr auto maxBlockSize = (static_cast<size_t>(1) << maxBlockSizeLog2) - alignment;
+	const auto blockSize = end - begin - 2 * headerSize;
+	auto& block = *reinterpret_cast<Block*>(begin);
+	block.previousPhysical = {};
+	block.sizeAndFreeFlag = (blockSize < maxBlockSize ? blockSize : maxBlockSize) | Block::freeFlag;
+
+	auto& sentinel = block.getNextPhysical();
+	sentinel.previousPhysical = &block;
+	sentinel.sizeAndFreeFlag = {};
+
+	insertFreeBlock(block);
+	size_ = block.getSize() + 2 * headerSize;
+	return 0;
+}
+
+void* TlsfHeap::reallocate(void* const memory, const size_t size)
+{
+	if (memory == nullptr)
+		return allocate(size);
+
+	if (size == 0)
+	{
+		free(memory);
+		return nullptr;
+	}
+
+	const auto adjustedSize = adjustSize(size);
+	if (adjustedSize == 0)
+	{
+		++failedAllocationCount_;
+		return nullptr;
+	}
+
+	auto& block = Block::fromMemory(memory);
+	const auto blockSize = block.getSize();
+	if (adjustedSize > blockSize)
+	{
+		auto& nextBlock = block.getNextPhysical();
+		if (nextBlock.isFree() == false || blockSize + headerSize + nextBlock.getSize() < adjustedSize)
+		{
+			const auto newMemory = allocate(size);
+			if (newMemory == nullptr)
+				return nullptr;
+
+			memcpy(newMemory, memory, blockSize);
+			free(memory);
+			return newMemory;
+		}
+
+		removeFreeBlock(nextBlock);
+		block.setSize(blockSize + headerSize + nextBlock.getSize());
+		block.getNextPhysical().previousPhysical = &block;
+	}
+
+	trimBlock(block, adjustedSize);
+	updateUsedSize(block.getSize() - blockSize);
+	return memory;
+}
+
+void TlsfHeap::resetStatistics()
+{
+	allocationCount_ = {};
+	failedAllocationCount_ = {};
+	freeCount_ = {};
+	maxUsedSize_ = usedSize_;
+}
+
+TlsfHeap::FreeBlocksSummary TlsfHeap::summarizeFreeBlocks() const
+{
+	FreeBlocksSummary summary {};
+	for (const auto& freeLists : freeLists_)
+		for (auto block : freeLists)
+			while (block != nullptr)
+			{
+				const auto blockSize = block->getSize();
+				++summary.count;
+				summary.totalSize += blockSize;
+				if (blockSize > summary.largestSize)
+					summary.largestSize = blockSize;
+				block = block->nextFree;
+			}
+
+	return summary;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private static functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<uint8_t, uint8_t> TlsfHeap::getIndexes(const size_t size)
+{
+	// small blocks are kept in first level range 0, with second level lists holding blocks of exactly one size
+	if (size < static_cast<size_t>(1) << firstLevelShift)
+		return {0, static_cast<uint8_t>(size >> alignmentLog2)};
+
+	const auto lastSet = findLastSet(size);
+	const uint8_t firstLevelIndex = lastSet - firstLevelShift + 1;
+	const uint8_t secondLevelIndex = (size >> (lastSet - secondLevelIndexLog2)) - secondLevelIndexCount;
+	return {firstLevelIndex, secondLevelIndex};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+TlsfHeap::Block* TlsfHeap::extractFreeBlock(const size_t size)
+{
+	auto roundedSize = size;
+	if (size >= static_cast<size_t>(1) << firstLevelShift)
+		roundedSize += (static_cast<size_t>(1) << (findLastSet(size) - secondLevelIndexLog2)) - 1;
+
+	uint8_t firstLevelIndex;
+	uint8_t secondLevelIndex;
+	std::tie(firstLevelIndex, secondLevelIndex) = getIndexes(roundedSize);
+
+	auto secondLevelBitmap = secondLevelBitmaps_[firstLevelIndex] & (~Bitmap{} << secondLevelIndex);
+	if (secondLevelBitmap == 0)
+	{
+		const auto firstLevelBitmap = firstLevelBitmap_ & (~Bitmap{} << (firstLevelIndex + 1));
+		if (firstLevelBitmap == 0)
+			return nullptr;
+
+		firstLevelIndex = findFirstSet(firstLevelBitmap);
+		secondLevelBitmap = secondLevelBitmaps_[firstLevelIndex];
+	}
+
+	secondLevelIndex = findFirstSet(secondLevelBitmap);
+	const auto block = freeLists_[firstLevelIndex][secondLevelIndex];
+	removeFreeBlock(*block);
+	return block;
+}
+
+void TlsfHeap::insertFreeBlock(Block& block)
+{
+	uint8_t firstLevelIndex;
+	uint8_t secondLevelIndex;
+	std::tie(firstLevelIndex, secondLevelIndex) = getIndexes(block.getSize());
+
+	auto& head = freeLists_[firstLevelIndex][secondLevelIndex];
+	block.nextFree = head;
+	block.previousFree = {};
+	if (head != nullptr)
+		head->previousFree = &block;
+	head = &block;
+
+	secondLevelBitmaps_[firstLevelIndex] |= Bitmap{1} << secondLevelIndex;
+	firstLevelBitmap_ |= Bitmap{1} << firstLevelIndex;
+}
+
+TlsfHeap::Block& TlsfHeap::mergeFreeBlock(Block& block)
+{
+	auto mergedBlock = &block;
+
+	const auto previousBlock = block.previousPhysical;
+	if (previousBlock != nullptr && previousBlock->isFree() == true)
+	{
+		removeFreeBlock(*previousBlock);
+		previousBlock->setSize(previousBlock->getSize() + headerSize + block.getSize());
+		mergedBlock = previousBlock;
+	}
+
+	auto& nextBlock = mergedBlock->getNextPhysical();
+	if (nextBlock.isFree() == true)
+	{
+		removeFreeBlock(nextBlock);
+		mergedBlock->setSize(mergedBlock->getSize() + headerSize + nextBlock.getSize());
+	}
+
+	mergedBlock->getNextPhysical().previousPhysical = mergedBlock;
+	return *mergedBlock;
+}
+
+void TlsfHeap::removeFreeBlock(Block& block)
+{
+	const auto nextFree = block.nextFree;
+	const auto previousFree = block.previousFree;
+
+	if (nextFree != nullptr)
+		nextFree->previousFree = previousFree;
+
+	if (previousFree != nullptr)
+	{
+		previousFree->nextFree = nextFree;
+		return;
+	}
+
+	// block is the head of its list
+	uint8_t firstLevelIndex;
+	uint8_t secondLevelIndex;
+	std::tie(firstLevelIndex, secondLevelIndex) = getIndexes(block.getSize());
+
+	freeLists_[firstLevelIndex][secondLevelIndex] = nextFree;
+	if (nextFree != nullptr)
+		return;
+
+	secondLevelBitmaps_[firstLevelIndex] &= ~(Bitmap{1} << secondLevelIndex);
+	if (secondLevelBitmaps_[firstLevelIndex] == 0)
+		firstLevelBitmap_ &= ~(Bitmap{1} << firstLevelIndex);
+}
+
+void TlsfHeap::trimBlock(Block& block, const size_t size)
+{
+	const auto blockSize = block.getSize();
+	if (blockSize < size + headerSize + minimumBlockSize)
+		return;
+
+	block.setSize(size);
+	auto& remainder = block.getNextPhysical();
+	remainder.previousPhysical = &block;
+	remainder.sizeAndFreeFlag = (blockSize - size - headerSize) | Block::freeFlag;
+	insertFreeBlock(mergeFreeBlock(remainder));
+}
+
+void* TlsfHeap::useBlock(Block& block, const size_t size)
+{
+	block.setFree(false);
+	trimBlock(block, size);
+	++allocationCount_;
+	updateUsedSize(block.getSize());
+	return block.getMemory();
+}
+
+void TlsfHeap::updateUsedSize(const size_t difference)
+{
+	usedSize_ += difference;
+	if (usedSize_ > maxUsedSize_)
+		maxUsedSize_ = usedSize_;
+}
+
+}	// namespace internal
+
+}	// namespace distortos
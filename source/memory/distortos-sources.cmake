@@ -8,5 +8,12 @@
 #
 
 target_sources(distortos PRIVATE
+		${CMAKE_CURRENT_LIST_DIR}/CircularBuffer.cpp
 		${CMAKE_CURRENT_LIST_DIR}/DeferredThreadDeleter.cpp
-		${CMAKE_CURRENT_LIST_DIR}/getDeferredThreadDeleter.cpp)
+		${CMAKE_CURRENT_LIST_DIR}/DynamicMemoryPool.cpp
+		${CMAKE_CURRENT_LIST_DIR}/getDeferredThreadDeleter.cpp
+		${CMAKE_CURRENT_LIST_DIR}/getTlsfHeap.cpp
+		${CMAKE_CURRENT_LIST_DIR}/HeapArenaControlBlock.cpp
+		${CMAKE_CURRENT_LIST_DIR}/HeapStatistics.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MemoryPool.cpp
+		${CMAKE_CURRENT_LIST_DIR}/TlsfHeap.cpp)
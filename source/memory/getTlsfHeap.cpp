@@ -0,0 +1,35 @@
+/**
+ * \file
+ * \brief getTlsfHeap() definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/memory/getTlsfHeap.hpp"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// main instance of TlsfHeap, constant-initialized, so it may be used before any constructors are executed
+TlsfHeap tlsfHeapInstance;
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
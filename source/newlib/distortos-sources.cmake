@@ -10,5 +10,6 @@
 target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/assert_func.cpp
 		${CMAKE_CURRENT_LIST_DIR}/locking.cpp
+		${CMAKE_CURRENT_LIST_DIR}/malloc_r.cpp
 		${CMAKE_CURRENT_LIST_DIR}/sbrk_r.cpp
 		${CMAKE_CURRENT_LIST_DIR}/syscallsStubs.cpp)
@@ -0,0 +1,553 @@
+/**
+ * \file
+ * \brief Implementation of newlib's memory allocation functions with TLSF heap
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+#include "distortos/internal/memory/DeferredThreadDeleter.hpp"
+#include "distortos/internal/memory/getDeferredThreadDeleter.hpp"
+#include "distortos/internal/memory/getTlsfHeap.hpp"
+#include "distortos/internal/memory/HeapArenaControlBlock.hpp"
+#include "distortos/internal/memory/heapTrace.hpp"
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include "distortos/internal/newlib/locking.hpp"
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include <mutex>
+
+#include <malloc.h>
+
+#include <cerrno>
+#include <cstring>
+
+extern "C" void* _sbrk_r(_reent* reent, intptr_t size);
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Gets main instance of TlsfHeap, initializing it if needed.
+ *
+ * When called for the first time, all memory remaining between current end of heap (as returned by _sbrk_r()) and
+ * \a __heap_end (imported from linker script) is claimed with _sbrk_r() and used to initialize the heap.
+ *
+ * \note This function must be called with locked malloc() mutex.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ *
+ * \return reference to main instance of TlsfHeap
+ */
+
+distortos::internal::TlsfHeap& getInitializedTlsfHeap(_reent* const reent)
+{
+	auto& tlsfHeap = distortos::internal::getTlsfHeap();
+	if (tlsfHeap.getSize() != 0)
+		return tlsfHeap;
+
+	extern char __heap_end[];	// imported from linker script
+
+	const auto heapBegin = static_cast<char*>(_sbrk_r(reent, 0));
+	const auto size = __heap_end - heapBegin;
+	if (_sbrk_r(reent, size) == heapBegin)
+		tlsfHeap.initialize(heapBegin, size);
+
+	return tlsfHeap;
+}
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+/**
+ * \return pointer to HeapArenaControlBlock of arena used by current thread, nullptr if current thread uses the main
+ * heap
+ */
+
+distortos::internal::HeapArenaControlBlock* getCurrentHeapArenaControlBlock()
+{
+	return distortos::internal::getScheduler().getCurrentThreadControlBlock().getHeapArenaControlBlock();
+}
+
+/**
+ * \brief Allocates memory from the arena, initializing it if needed.
+ *
+ * When called for the first time, memory of the arena is allocated from the main heap.
+ *
+ * \param [in] heapArenaControlBlock is a reference to HeapArenaControlBlock of arena
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] alignment is the required alignment of memory, must be a power of 2
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if the arena could not be initialized or has no free block large enough
+ */
+
+void* allocateFromHeapArena(distortos::internal::HeapArenaControlBlock& heapArenaControlBlock, _reent* const reent,
+		const size_t alignment, const size_t size)
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {heapArenaControlBlock.getMutex()};
+
+	if (heapArenaControlBlock.isInitialized() == false)
+	{
+		const std::lock_guard<distortos::Mutex> mallocLockGuard {distortos::internal::getMallocMutex()};
+		auto& tlsfHeap = getInitializedTlsfHeap(reent);
+		const auto memory = tlsfHeap.allocate(heapArenaControlBlock.getSize());
+		if (memory == nullptr)
+			return nullptr;
+
+		if (heapArenaControlBlock.initialize(memory) != 0)
+		{
+			tlsfHeap.free(memory);
+			return nullptr;
+		}
+	}
+
+	return heapArenaControlBlock.allocate(alignment, size);
+}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+/**
+ * \brief Allocates memory.
+ *
+ * If current thread uses an arena, memory is allocated from this arena. If this is not possible, memory is allocated
+ * from the main heap.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] alignment is the required alignment of memory, must be a power of 2
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* allocateImplementation(_reent* const reent, const size_t alignment, const size_t size)
+{
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const auto heapArenaControlBlock = getCurrentHeapArenaControlBlock();
+	if (heapArenaControlBlock != nullptr)
+	{
+		const auto memory = allocateFromHeapArena(*heapArenaControlBlock, reent, alignment, size);
+		if (memory != nullptr)
+			return memory;
+	}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const std::lock_guard<distortos::Mutex> lockGuard {distortos::internal::getMallocMutex()};
+	return getInitializedTlsfHeap(reent).allocateAligned(alignment, size);
+}
+
+/**
+ * \brief Frees memory.
+ *
+ * If memory was allocated from an arena used by current thread, it is freed to this arena. If it was allocated from
+ * other arena, it is queued in that arena without locking its mutex. Otherwise it is freed to the main heap.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to memory which will be freed, must not be nullptr
+ */
+
+void deallocateImplementation(_reent* const reent, void* const memory)
+{
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const auto heapArenaControlBlock = distortos::internal::HeapArenaControlBlock::find(memory);
+	if (heapArenaControlBlock != nullptr)
+	{
+		if (heapArenaControlBlock != getCurrentHeapArenaControlBlock())
+		{
+			heapArenaControlBlock->queueFree(memory);
+			return;
+		}
+
+		const std::lock_guard<distortos::Mutex> lockGuard {heapArenaControlBlock->getMutex()};
+		heapArenaControlBlock->free(memory);
+		return;
+	}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const std::lock_guard<distortos::Mutex> lockGuard {distortos::internal::getMallocMutex()};
+	getInitializedTlsfHeap(reent).free(memory);
+}
+
+/**
+ * \brief Changes size of allocated memory.
+ *
+ * Memory allocated from an arena used by current thread is resized in this arena if possible. Memory allocated from
+ * other arena (or which cannot be resized in the arena of current thread) is moved to newly allocated block. Memory
+ * allocated from the main heap is resized in the main heap.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to allocated memory, must not be nullptr
+ * \param [in] size is the new size of memory, bytes, must not be 0
+ *
+ * \return pointer to resized memory, nullptr if reallocation failed (in that case \a memory is not freed)
+ */
+
+void* reallocateImplementation(_reent* const reent, void* const memory, const size_t size)
+{
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const auto heapArenaControlBlock = distortos::internal::HeapArenaControlBlock::find(memory);
+	if (heapArenaControlBlock != nullptr)
+	{
+		if (heapArenaControlBlock == getCurrentHeapArenaControlBlock())
+		{
+			const std::lock_guard<distortos::Mutex> lockGuard {heapArenaControlBlock->getMutex()};
+			const auto newMemory = heapArenaControlBlock->reallocate(memory, size);
+			if (newMemory != nullptr)
+				return newMemory;
+		}
+
+		const auto newMemory = allocateImplementation(reent, distortos::internal::TlsfHeap::alignment, size);
+		if (newMemory == nullptr)
+			return nullptr;
+
+		const auto usableSize = distortos::internal::TlsfHeap::getUsableSize(memory);
+		memcpy(newMemory, memory, usableSize < size ? usableSize : size);
+		deallocateImplementation(reent, memory);
+		return newMemory;
+	}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	const std::lock_guard<distortos::Mutex> lockGuard {distortos::internal::getMallocMutex()};
+	return getInitializedTlsfHeap(reent).reallocate(memory, size);
+}
+
+/**
+ * \brief Allocates memory and records the operation in the trace.
+ *
+ * If thread detachment is enabled, detached threads which terminated are deleted before the allocation (if malloc()
+ * mutex is not locked by other thread).
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] alignment is the required alignment of memory, must be a power of 2
+ * \param [in] size is the size of memory, bytes
+ * \param [in] returnAddress is the address of code which requested the allocation
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* allocate(_reent* const reent, const size_t alignment, const size_t size, const void* const returnAddress)
+{
+#if CONFIG_THREAD_DETACH_ENABLE == 1
+	distortos::internal::getDeferredThreadDeleter().tryCleanup();
+#endif	// CONFIG_THREAD_DETACH_ENABLE == 1
+
+	const auto memory = allocateImplementation(reent, alignment, size);
+	if (memory == nullptr)
+		reent->_errno = ENOMEM;
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+	distortos::internal::recordHeapOperation(distortos::HeapStatistics::Operation::allocation, returnAddress, memory,
+			nullptr, size);
+#else	// CONFIG_HEAP_TRACE_ENABLE != 1
+	static_cast<void>(returnAddress);	// suppress warning
+#endif	// CONFIG_HEAP_TRACE_ENABLE != 1
+
+	return memory;
+}
+
+/**
+ * \brief Allocates zero-initialized memory for an array and records the operation in the trace.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] count is the number of elements in the array
+ * \param [in] size is the size of single element, bytes
+ * \param [in] returnAddress is the address of code which requested the allocation
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* allocateArray(_reent* const reent, const size_t count, const size_t size, const void* const returnAddress)
+{
+	if (size != 0 && count > SIZE_MAX / size)
+	{
+		reent->_errno = ENOMEM;
+		return nullptr;
+	}
+
+	const auto memory = allocate(reent, distortos::internal::TlsfHeap::alignment, count * size, returnAddress);
+	if (memory != nullptr)
+		memset(memory, 0, count * size);
+	return memory;
+}
+
+/**
+ * \brief Frees memory and records the operation in the trace.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to memory which will be freed, nullptr is ignored
+ * \param [in] returnAddress is the address of code which requested the deallocation
+ */
+
+void deallocate(_reent* const reent, void* const memory, const void* const returnAddress)
+{
+	if (memory == nullptr)
+		return;
+
+	deallocateImplementation(reent, memory);
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+	distortos::internal::recordHeapOperation(distortos::HeapStatistics::Operation::deallocation, returnAddress, memory,
+			nullptr, 0);
+#else	// CONFIG_HEAP_TRACE_ENABLE != 1
+	static_cast<void>(returnAddress);	// suppress warning
+#endif	// CONFIG_HEAP_TRACE_ENABLE != 1
+}
+
+/**
+ * \brief Changes size of allocated memory and records the operation in the trace.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to allocated memory, nullptr is equivalent to allocate()
+ * \param [in] size is the new size of memory, bytes, 0 is equivalent to deallocate()
+ * \param [in] returnAddress is the address of code which requested the reallocation
+ *
+ * \return pointer to resized memory, nullptr if \a size is 0 or if reallocation failed (in that case \a memory is not
+ * freed)
+ */
+
+void* reallocate(_reent* const reent, void* const memory, const size_t size, const void* const returnAddress)
+{
+	if (memory == nullptr)
+		return allocate(reent, distortos::internal::TlsfHeap::alignment, size, returnAddress);
+
+	if (size == 0)
+	{
+		deallocate(reent, memory, returnAddress);
+		return nullptr;
+	}
+
+	const auto newMemory = reallocateImplementation(reent, memory, size);
+	if (newMemory == nullptr)
+		reent->_errno = ENOMEM;
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+	distortos::internal::recordHeapOperation(distortos::HeapStatistics::Operation::reallocation, returnAddress,
+			newMemory, memory, size);
+#else	// CONFIG_HEAP_TRACE_ENABLE != 1
+	static_cast<void>(returnAddress);	// suppress warning
+#endif	// CONFIG_HEAP_TRACE_ENABLE != 1
+
+	return newMemory;
+}
+
+}	// namespace
+
+extern "C"
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Allocates zero-initialized memory for an array.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] count is the number of elements in the array
+ * \param [in] size is the size of single element, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* _calloc_r(_reent* const reent, const size_t count, const size_t size)
+{
+	return allocateArray(reent, count, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Frees memory.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to memory which will be freed, nullptr is ignored
+ */
+
+void _free_r(_reent* const reent, void* const memory)
+{
+	deallocate(reent, memory, __builtin_return_address(0));
+}
+
+/**
+ * \brief Gets statistics of the heap.
+ *
+ * Only "arena" (total size of the heap), "uordblks" (size of allocated memory), "fordblks" (size of free memory),
+ * "ordblks" (number of free blocks) and "usmblks" (max size of allocated memory) fields are filled. More detailed
+ * statistics are available with HeapStatistics class.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ *
+ * \return statistics of the heap
+ */
+
+struct mallinfo _mallinfo_r(_reent* const reent)
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {distortos::internal::getMallocMutex()};
+	const auto& heap = getInitializedTlsfHeap(reent);
+	struct mallinfo info {};
+	info.arena = heap.getSize();
+	info.ordblks = heap.summarizeFreeBlocks().count;
+	info.usmblks = heap.getMaxUsedSize();
+	info.uordblks = heap.getUsedSize();
+	info.fordblks = heap.getSize() - heap.getUsedSize();
+	return info;
+}
+
+/**
+ * \brief Allocates memory.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* _malloc_r(_reent* const reent, const size_t size)
+{
+	return allocate(reent, distortos::internal::TlsfHeap::alignment, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Gets usable size of allocated memory.
+ *
+ * \param [in] memory is a pointer to allocated memory
+ *
+ * \return usable size of memory pointed by \a memory, bytes, 0 if \a memory is nullptr
+ */
+
+size_t _malloc_usable_size_r(_reent*, void* const memory)
+{
+	return memory != nullptr ? distortos::internal::TlsfHeap::getUsableSize(memory) : 0;
+}
+
+/**
+ * \brief Allocates aligned memory.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] alignment is the required alignment of memory, must be a power of 2
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* _memalign_r(_reent* const reent, const size_t alignment, const size_t size)
+{
+	return allocate(reent, alignment, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Changes size of allocated memory.
+ *
+ * \param [in] reent is a pointer to thread's reentrancy structure
+ * \param [in] memory is a pointer to allocated memory, nullptr is equivalent to _malloc_r()
+ * \param [in] size is the new size of memory, bytes, 0 is equivalent to _free_r()
+ *
+ * \return pointer to resized memory, nullptr if \a size is 0 or if reallocation failed (in that case \a memory is not
+ * freed)
+ */
+
+void* _realloc_r(_reent* const reent, void* const memory, const size_t size)
+{
+	return reallocate(reent, memory, size, __builtin_return_address(0));
+}
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+/*
+ * newlib's versions of functions below just call their reentrant counterparts, so the address recorded in the trace
+ * would be the address in newlib - these replacements pass the address of their caller instead.
+ */
+
+/**
+ * \brief Allocates zero-initialized memory for an array.
+ *
+ * \param [in] count is the number of elements in the array
+ * \param [in] size is the size of single element, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* calloc(const size_t count, const size_t size)
+{
+	return allocateArray(_REENT, count, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Frees memory.
+ *
+ * \param [in] memory is a pointer to memory which will be freed, nullptr is ignored
+ */
+
+void free(void* const memory)
+{
+	deallocate(_REENT, memory, __builtin_return_address(0));
+}
+
+/**
+ * \brief Allocates memory.
+ *
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* malloc(const size_t size)
+{
+	return allocate(_REENT, distortos::internal::TlsfHeap::alignment, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Allocates aligned memory.
+ *
+ * \param [in] alignment is the required alignment of memory, must be a power of 2
+ * \param [in] size is the size of memory, bytes
+ *
+ * \return pointer to allocated memory, nullptr if allocation failed
+ */
+
+void* memalign(const size_t alignment, const size_t size)
+{
+	return allocate(_REENT, alignment, size, __builtin_return_address(0));
+}
+
+/**
+ * \brief Changes size of allocated memory.
+ *
+ * \param [in] memory is a pointer to allocated memory, nullptr is equivalent to malloc()
+ * \param [in] size is the new size of memory, bytes, 0 is equivalent to free()
+ *
+ * \return pointer to resized memory, nullptr if \a size is 0 or if reallocation failed (in that case \a memory is not
+ * freed)
+ */
+
+void* realloc(void* const memory, const size_t size)
+{
+	return reallocate(_REENT, memory, size, __builtin_return_address(0));
+}
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+}	// extern "C"
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
@@ -2,7 +2,7 @@
  * \file
  * \brief RoundRobinQuantum class implementation
  *
- * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,6 +11,8 @@
 
 #include "distortos/internal/scheduler/RoundRobinQuantum.hpp"
 
+#include <cerrno>
+
 namespace distortos
 {
 
@@ -23,6 +25,22 @@ namespace internal
 
 constexpr decltype(RoundRobinQuantum::quantumRawInitializer_) RoundRobinQuantum::quantumRawInitializer_;
 
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int RoundRobinQuantum::setLength(const TickClock::duration length)
+{
+	if (length < Duration{1} || length > Duration::max())
+		return EINVAL;
+
+	length_ = std::chrono::duration_cast<Duration>(length);
+	if (quantum_ > length_)
+		quantum_ = length_;
+
+	return 0;
+}
+
 }	// namespace internal
 
 }	// namespace distortos
@@ -279,7 +279,7 @@ bool Scheduler::tickInterruptHandler()
 			getCurrentThreadControlBlock().getSchedulingPolicy() == SchedulingPolicy::roundRobin &&
 			getCurrentThreadControlBlock().getRoundRobinQuantum().isZero() == true)
 	{
-		getCurrentThreadControlBlock().getRoundRobinQuantum().reset();
+		getCurrentThreadControlBlock().getRoundRobinQuantum().rotate();
 		runnableList_.splice(currentThreadControlBlock_);
 	}
 
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadControlBlock class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -54,9 +54,13 @@ ThreadControlBlock::ThreadControlBlock(internal::Stack&& stack, const uint8_t pr
 				ThreadListNode{priority},
 				ownedProtocolMutexList_{},
 				stack_{std::move(stack)},
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+				heapArenaControlBlock_{},
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
 				list_{},
 				owner_{owner},
 				priorityInheritanceMutexControlBlock_{},
+				semaphoreWaitCount_{},
 				signalsReceiverControlBlock_{signalsReceiver != nullptr ?
 						&signalsReceiver->signalsReceiverControlBlock_ : nullptr},
 				threadGroupControlBlock_{threadGroupControlBlock},
@@ -79,9 +83,13 @@ ThreadControlBlock::ThreadControlBlock(internal::Stack&& stack, const uint8_t pr
 				ThreadListNode{priority},
 				ownedProtocolMutexList_{},
 				stack_{std::move(stack)},
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+				heapArenaControlBlock_{},
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
 				list_{},
 				owner_{owner},
 				priorityInheritanceMutexControlBlock_{},
+				semaphoreWaitCount_{},
 				threadGroupControlBlock_{threadGroupControlBlock},
 				unblockFunctor_{},
 				roundRobinQuantum_{},
@@ -102,6 +110,7 @@ ThreadControlBlock::~ThreadControlBlock()
 
 	const InterruptMaskingLock interruptMaskingLock;
 
+	threadGroupNode.unlink();	// thread group may be traversed with interrupts masked
 	_reclaim_reent(&reent_);
 }
 
@@ -119,6 +128,12 @@ int ThreadControlBlock::addHook()
 	return 0;
 }
 
+uint64_t ThreadControlBlock::getRoundRobinRotationCount() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return roundRobinQuantum_.getRotationCount();
+}
+
 void ThreadControlBlock::setPriority(const uint8_t priority, const bool alwaysBehind)
 {
 	const InterruptMaskingLock interruptMaskingLock;
@@ -141,6 +156,12 @@ void ThreadControlBlock::setPriority(const uint8_t priority, const bool alwaysBe
 		priorityInheritanceMutexControlBlock_->getOwner()->updateBoostedPriority();
 }
 
+int ThreadControlBlock::setRoundRobinQuantum(const TickClock::duration quantum)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return roundRobinQuantum_.setLength(quantum);
+}
+
 void ThreadControlBlock::setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
 {
 	const InterruptMaskingLock interruptMaskingLock;
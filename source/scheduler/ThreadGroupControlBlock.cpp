@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadGroupControlBlock class implementation
  *
- * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -13,6 +13,20 @@
 
 #include "distortos/internal/scheduler/ThreadControlBlock.hpp"
 
+#if CONFIG_SIGNALS_ENABLE == 1
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/internal/synchronization/SignalsReceiverControlBlock.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/SignalSet.hpp"
+
+#include <cerrno>
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
 namespace distortos
 {
 
@@ -28,6 +42,77 @@ void ThreadGroupControlBlock::add(ThreadControlBlock& threadControlBlock)
 	threadList_.push_back(threadControlBlock);
 }
 
+#if CONFIG_SIGNALS_ENABLE == 1
+
+std::pair<int, size_t> ThreadGroupControlBlock::generateSignal(const uint8_t signalNumber)
+{
+	return generateQueueSignal(signalNumber,
+			[signalNumber](SignalsReceiverControlBlock& signalsReceiverControlBlock,
+					ThreadControlBlock& threadControlBlock)
+			{
+				return signalsReceiverControlBlock.generateSignalLocked(signalNumber, threadControlBlock);
+			});
+}
+
+std::pair<int, size_t> ThreadGroupControlBlock::queueSignal(const uint8_t signalNumber, const sigval value)
+{
+	return generateQueueSignal(signalNumber,
+			[signalNumber, value](SignalsReceiverControlBlock& signalsReceiverControlBlock,
+					ThreadControlBlock& threadControlBlock)
+			{
+				return signalsReceiverControlBlock.queueSignalLocked(signalNumber, value, threadControlBlock);
+			});
+}
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+#if CONFIG_SIGNALS_ENABLE == 1
+
+template<typename Functor>
+std::pair<int, size_t> ThreadGroupControlBlock::generateQueueSignal(const uint8_t signalNumber, Functor functor)
+{
+	if (signalNumber >= SignalSet::Bitset{}.size())
+		return {EINVAL, {}};
+
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+	SignalsReceiverControlBlock* currentSignalsReceiverControlBlock {};
+	size_t acceptedCount {};
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		for (auto& threadControlBlock : threadList_)
+		{
+			if (threadControlBlock.getState() == ThreadState::terminated)
+				continue;
+
+			const auto signalsReceiverControlBlock = threadControlBlock.getSignalsReceiverControlBlock();
+			if (signalsReceiverControlBlock == nullptr)
+				continue;
+
+			const auto ret = functor(*signalsReceiverControlBlock, threadControlBlock);
+			if (ret.first != 0 || ret.second == false)	// error or signal is ignored?
+				continue;
+
+			++acceptedCount;
+			if (&threadControlBlock == &currentThreadControlBlock)
+				currentSignalsReceiverControlBlock = signalsReceiverControlBlock;
+		}
+	}
+
+	// signal may need to be delivered to current thread, which is possible only with interrupts unmasked
+	if (currentSignalsReceiverControlBlock != nullptr)
+		currentSignalsReceiverControlBlock->afterGenerateQueueUnlocked(signalNumber, currentThreadControlBlock);
+
+	return {{}, acceptedCount};
+}
+
+#endif	// CONFIG_SIGNALS_ENABLE == 1
+
 }	// namespace internal
 
 }	// namespace distortos
@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief Barrier class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/Barrier.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int Barrier::tryWaitFor(const TickClock::duration duration)
+{
+	return tryWaitUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int Barrier::tryWaitUntil(const TickClock::time_point timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitImplementation(&timePoint);
+}
+
+int Barrier::wait()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitImplementation(nullptr);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int Barrier::waitImplementation(const TickClock::time_point* const timePoint)
+{
+	auto& scheduler = internal::getScheduler();
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		++arrived_;
+		if (arrived_ != count_)	// not the last thread?
+		{
+			const auto phase = phase_;
+			auto ret = timePoint == nullptr ? scheduler.block(blockedList_, ThreadState::blockedOnBarrier) :
+					scheduler.blockUntil(blockedList_, ThreadState::blockedOnBarrier, *timePoint);
+
+			// wait was terminated while the last thread was completing the phase, so it cannot be cancelled anymore
+			while (ret != 0 && phase == phase_ && arrived_ == count_)
+				ret = scheduler.block(blockedList_, ThreadState::blockedOnBarrier);
+
+			if (ret == 0 || phase != phase_)	// phase completed?
+				return 0;
+
+			--arrived_;	// withdraw the arrival
+			return ret;
+		}
+	}
+
+	// completion function is executed with interrupts unmasked, arrived_ == count_ prevents cancellation of the phase
+	if (completionFunction_ != nullptr)
+		completionFunction_(completionArgument_);
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	arrived_ = 0;
+	++phase_;
+
+	while (blockedList_.empty() == false)
+		scheduler.unblock(blockedList_.begin());
+
+	return 0;
+}
+
+}	// namespace distortos
@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief EventFlags class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/EventFlags.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/internal/synchronization/getMultiWaiterList.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// EventFlagsWaitUnblockFunctor is a functor executed when unblocking a thread that is waiting for EventFlags
+class EventFlagsWaitUnblockFunctor : public internal::UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief EventFlagsWaitUnblockFunctor's constructor
+	 *
+	 * \param [in] eventFlagsWaiter is a reference to EventFlagsWaiter of the thread
+	 */
+
+	constexpr explicit EventFlagsWaitUnblockFunctor(internal::EventFlagsWaiter& eventFlagsWaiter) :
+			eventFlagsWaiter_{eventFlagsWaiter}
+	{
+
+	}
+
+	/**
+	 * \brief EventFlagsWaitUnblockFunctor's function call operator
+	 *
+	 * Removes EventFlagsWaiter of the thread from the list of waiters (if it is still there).
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock that is being unblocked
+	 * \param [in] unblockReason is the reason of thread unblocking
+	 */
+
+	void operator()(internal::ThreadControlBlock&, internal::UnblockReason) const override
+	{
+		if (eventFlagsWaiter_.node.isLinked() == true)
+			eventFlagsWaiter_.node.unlink();
+	}
+
+private:
+
+	/// reference to EventFlagsWaiter of the thread
+	internal::EventFlagsWaiter& eventFlagsWaiter_;
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+EventFlags::Value EventFlags::clear(const Value bitmask)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto previousValue = value_;
+	value_ &= ~bitmask;
+	return previousValue;
+}
+
+EventFlags::Value EventFlags::set(const Value bitmask)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto previousValue = value_;
+	value_ |= bitmask;
+
+	if (value_ == previousValue)	// no new flags were set, so no waiter can be satisfied
+		return previousValue;
+
+	auto& scheduler = internal::getScheduler();
+	Value clearedBitmask {};
+
+	auto iterator = waitersList_.begin();
+	while (iterator != waitersList_.end())
+	{
+		auto& waiter = *iterator;
+		++iterator;	// waiter will be removed from the list when its thread is unblocked
+
+		if (waiter.isSatisfiedBy(value_) == false)
+			continue;
+
+		waiter.setValue(value_);
+		if (waiter.getClearOnExit() == true)
+			clearedBitmask |= waiter.getBitmask();
+		scheduler.unblock(internal::ThreadList::iterator{waiter.getThreadControlBlock()});
+	}
+
+	value_ &= ~clearedBitmask;
+	internal::notifyMultiWaiters(this);
+	return previousValue;
+}
+
+std::pair<int, EventFlags::Value> EventFlags::tryWait(const Value bitmask, const WaitMode mode, const bool clearOnExit)
+{
+	return waitImplementation(bitmask, mode, clearOnExit, true, nullptr);
+}
+
+std::pair<int, EventFlags::Value> EventFlags::tryWaitFor(const Value bitmask, const WaitMode mode,
+		const TickClock::duration duration, const bool clearOnExit)
+{
+	return tryWaitUntil(bitmask, mode, TickClock::now() + duration + TickClock::duration{1}, clearOnExit);
+}
+
+std::pair<int, EventFlags::Value> EventFlags::tryWaitUntil(const Value bitmask, const WaitMode mode,
+		const TickClock::time_point timePoint, const bool clearOnExit)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitImplementation(bitmask, mode, clearOnExit, false, &timePoint);
+}
+
+std::pair<int, EventFlags::Value> EventFlags::wait(const Value bitmask, const WaitMode mode, const bool clearOnExit)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitImplementation(bitmask, mode, clearOnExit, false, nullptr);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, EventFlags::Value> EventFlags::waitImplementation(const Value bitmask, const WaitMode mode,
+		const bool clearOnExit, const bool nonBlocking, const TickClock::time_point* const timePoint)
+{
+	if (bitmask == 0)
+		return {EINVAL, get()};
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	auto& scheduler = internal::getScheduler();
+	internal::EventFlagsWaiter waiter {scheduler.getCurrentThreadControlBlock(), bitmask, mode, clearOnExit};
+
+	if (waiter.isSatisfiedBy(value_) == true)	// wait condition is satisfied, so no need to block
+	{
+		const auto value = value_;
+		if (clearOnExit == true)
+			value_ &= ~bitmask;
+		return {0, value};
+	}
+
+	if (nonBlocking == true)
+		return {EAGAIN, value_};
+
+	waitersList_.push_back(waiter);
+
+	internal::ThreadList waitingList;
+	const EventFlagsWaitUnblockFunctor eventFlagsWaitUnblockFunctor {waiter};
+	const auto ret = timePoint == nullptr ?
+			scheduler.block(waitingList, ThreadState::blockedOnEventFlags, &eventFlagsWaitUnblockFunctor) :
+			scheduler.blockUntil(waitingList, ThreadState::blockedOnEventFlags, *timePoint,
+					&eventFlagsWaitUnblockFunctor);
+	return {ret, ret == 0 ? waiter.getValue() : value_};
+}
+
+}	// namespace distortos
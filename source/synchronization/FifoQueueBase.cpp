@@ -2,7 +2,7 @@
  * \file
  * \brief FifoQueueBase class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -12,6 +12,7 @@
 #include "distortos/internal/synchronization/FifoQueueBase.hpp"
 
 #include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/QueueStatistics.hpp"
 
 namespace distortos
 {
@@ -32,6 +33,9 @@ FifoQueueBase::FifoQueueBase(StorageUniquePointer&& storageUniquePointer, const
 		readPosition_{storageUniquePointer_.get()},
 		writePosition_{storageUniquePointer_.get()},
 		elementSize_{elementSize}
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+		, statistics_{}
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
 {
 
 }
@@ -50,7 +54,18 @@ int FifoQueueBase::popPush(const SemaphoreFunctor& waitSemaphoreFunctor, const Q
 {
 	const InterruptMaskingLock interruptMaskingLock;
 
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+	const auto waitStart = statistics_ != nullptr && waitSemaphore.getValue() == 0 ? TickClock::now() :
+			TickClock::time_point::min();
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 	const auto ret = waitSemaphoreFunctor(waitSemaphore);
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr)
+		statistics_->record(&waitSemaphore == &pushSemaphore_, ret, waitStart);
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 	if (ret != 0)
 		return ret;
 
@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \brief InterruptMaskingStatistics class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/InterruptMaskingStatistics.hpp"
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#include "distortos/architecture/getCycleCounter.hpp"
+
+#include "distortos/internal/synchronization/interruptMaskingSection.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <utility>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// collected statistics, zero-initialized, so they are valid before any constructors are executed
+InterruptMaskingStatistics::Snapshot snapshot;
+
+/// address of code which started current section, nullptr if no section is started
+const void* currentReturnAddress;
+
+/// value of cycle counter at the beginning of current section
+uint32_t currentStart;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Records duration of section in the array of the longest sections.
+ *
+ * \param [in] returnAddress is the address of code which started the section
+ * \param [in] duration is the duration of the section, core clock cycles
+ */
+
+void recordLongestSection(const void* const returnAddress, const uint32_t duration)
+{
+	auto& longestSections = snapshot.longestSections;
+
+	// find entry with the same address or use the shortest one
+	size_t index {};
+	while (index < InterruptMaskingStatistics::longestSectionsSize - 1 &&
+			longestSections[index].returnAddress != returnAddress)
+		++index;
+
+	if (duration <= longestSections[index].duration)
+		return;
+
+	longestSections[index] = {returnAddress, duration};
+
+	// keep the array sorted from the longest section
+	while (index > 0 && longestSections[index - 1].duration < longestSections[index].duration)
+	{
+		std::swap(longestSections[index - 1], longestSections[index]);
+		--index;
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+InterruptMaskingStatistics::Snapshot InterruptMaskingStatistics::getSnapshot()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return snapshot;
+}
+
+void InterruptMaskingStatistics::reset()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	snapshot = {};
+}
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void interruptMaskingSectionBegin(const void* const returnAddress)
+{
+	currentReturnAddress = returnAddress;
+	currentStart = architecture::getCycleCounter();
+}
+
+void interruptMaskingSectionEnd()
+{
+	const uint32_t duration = architecture::getCycleCounter() - currentStart;
+	const auto returnAddress = currentReturnAddress;
+	if (returnAddress == nullptr)	// section was not started?
+		return;
+
+	currentReturnAddress = {};
+
+	++snapshot.sectionCount;
+	++snapshot.histogram[duration != 0 ? 31 - __builtin_clz(duration) : 0];
+	recordLongestSection(returnAddress, duration);
+}
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \brief MessageBuffer class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/MessageBuffer.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MessageBuffer::MessageBuffer(StorageUniquePointer&& storageUniquePointer, const size_t size) :
+		streamBufferBase_{std::move(storageUniquePointer), size}
+{
+
+}
+
+std::pair<int, size_t> MessageBuffer::receive(void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return receiveImplementation(buffer, size, false, nullptr);
+}
+
+int MessageBuffer::send(const void* const data, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return sendImplementation(data, size, false, nullptr);
+}
+
+std::pair<int, size_t> MessageBuffer::tryReceive(void* const buffer, const size_t size)
+{
+	return receiveImplementation(buffer, size, true, nullptr);
+}
+
+std::pair<int, size_t> MessageBuffer::tryReceiveFor(const TickClock::duration duration, void* const buffer,
+		const size_t size)
+{
+	return tryReceiveUntil(TickClock::now() + duration + TickClock::duration{1}, buffer, size);
+}
+
+std::pair<int, size_t> MessageBuffer::tryReceiveUntil(const TickClock::time_point timePoint, void* const buffer,
+		const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return receiveImplementation(buffer, size, false, &timePoint);
+}
+
+int MessageBuffer::trySend(const void* const data, const size_t size)
+{
+	return sendImplementation(data, size, true, nullptr);
+}
+
+int MessageBuffer::trySendFor(const TickClock::duration duration, const void* const data, const size_t size)
+{
+	return trySendUntil(TickClock::now() + duration + TickClock::duration{1}, data, size);
+}
+
+int MessageBuffer::trySendUntil(const TickClock::time_point timePoint, const void* const data, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return sendImplementation(data, size, false, &timePoint);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, size_t> MessageBuffer::receiveImplementation(void* const buffer, const size_t size,
+		const bool nonBlocking, const TickClock::time_point* const timePoint)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	// messages are written with interrupts masked, so the whole message is available once its length is available
+	const auto ret = streamBufferBase_.waitForData(sizeof(Length), nonBlocking, timePoint);
+	if (ret != 0)
+		return {ret, {}};
+
+	Length length;
+	streamBufferBase_.peek(&length, sizeof(length));
+	if (length > size)
+		return {EMSGSIZE, length};
+
+	streamBufferBase_.read(nullptr, sizeof(length));
+	streamBufferBase_.read(buffer, length);
+	return {0, length};
+}
+
+int MessageBuffer::sendImplementation(const void* const data, const size_t size, const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	if (size > getMaxMessageSize())
+		return EMSGSIZE;
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = streamBufferBase_.waitForSpace(sizeof(Length) + size, nonBlocking, timePoint);
+	if (ret != 0)
+		return ret;
+
+	const Length length {size};
+	streamBufferBase_.write(&length, sizeof(length));
+	streamBufferBase_.write(data, size);
+	return 0;
+}
+
+}	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief MessageQueueBase class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -12,6 +12,7 @@
 #include "distortos/internal/synchronization/MessageQueueBase.hpp"
 
 #include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/QueueStatistics.hpp"
 
 namespace distortos
 {
@@ -140,6 +141,9 @@ MessageQueueBase::MessageQueueBase(EntryStorageUniquePointer&& entryStorageUniqu
 		valueStorageUniquePointer_{std::move(valueStorageUniquePointer)},
 		entryList_{},
 		freeEntryList_{}
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+		, statistics_{}
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
 {
 	for (size_t i = 0; i < maxElements; ++i)
 	{
@@ -176,7 +180,18 @@ int MessageQueueBase::popPush(const SemaphoreFunctor& waitSemaphoreFunctor, cons
 {
 	const InterruptMaskingLock interruptMaskingLock;
 
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+	const auto waitStart = statistics_ != nullptr && waitSemaphore.getValue() == 0 ? TickClock::now() :
+			TickClock::time_point::min();
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 	const auto ret = waitSemaphoreFunctor(waitSemaphore);
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr)
+		statistics_->record(&waitSemaphore == &pushSemaphore_, ret, waitStart);
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
 	if (ret != 0)
 		return ret;
 
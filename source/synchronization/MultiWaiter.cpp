@@ -0,0 +1,37 @@
+/**
+ * \file
+ * \brief MultiWaiter class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/synchronization/MultiWaiter.hpp"
+
+#include "distortos/WaitableObject.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t MultiWaiter::findReady(const void* const object) const
+{
+	for (size_t i {}; i < size_; ++i)
+		if (objects_[i].getObject() == object && objects_[i].isReady() == true)
+			return i;
+
+	return size_;
+}
+
+}	// namespace internal
+
+}	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief Mutex class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -32,10 +32,23 @@ int Mutex::lock()
 	const InterruptMaskingLock interruptMaskingLock;
 
 	int ret;
+	if ((ret = tryLockInternal()) != EBUSY)	// lock successful, recursive lock not possible or deadlock detected?
+		return ret;
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	const auto waitStart = TickClock::now();
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	// break the loop when one of following conditions is true:
-	// - lock successful, recursive lock not possible or deadlock detected;
 	// - lock transferred successfully;
-	while ((ret = tryLockInternal()) == EBUSY && (ret = doBlock()) == EINTR);
+	// - lock successful, recursive lock not possible or deadlock detected after interrupted wait;
+	while ((ret = doBlock()) == EINTR && (ret = tryLockInternal()) == EBUSY);
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (ret == 0)	// wait is recorded once, regardless of the number of interrupted blocks
+		recordWait(TickClock::now() - waitStart);
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	return ret;
 }
 
@@ -56,11 +69,24 @@ int Mutex::tryLockUntil(const TickClock::time_point timePoint)
 	const InterruptMaskingLock interruptMaskingLock;
 
 	int ret;
+	if ((ret = tryLockInternal()) != EBUSY)	// lock successful, recursive lock not possible or deadlock detected?
+		return ret;
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	const auto waitStart = TickClock::now();
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	// break the loop when one of following conditions is true:
-	// - lock successful, recursive lock not possible or deadlock detected;
 	// - lock transferred successfully;
 	// - timeout expired;
-	while ((ret = tryLockInternal()) == EBUSY && (ret = doBlockUntil(timePoint)) == EINTR);
+	// - lock successful, recursive lock not possible or deadlock detected after interrupted wait;
+	while ((ret = doBlockUntil(timePoint)) == EINTR && (ret = tryLockInternal()) == EBUSY);
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (ret == 0)	// timed-out wait is not recorded
+		recordWait(TickClock::now() - waitStart);
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	return ret;
 }
 
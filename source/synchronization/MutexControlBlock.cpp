@@ -2,7 +2,7 @@
  * \file
  * \brief MutexControlBlock class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,6 +14,8 @@
 #include "distortos/internal/scheduler/getScheduler.hpp"
 #include "distortos/internal/scheduler/Scheduler.hpp"
 
+#include "distortos/MutexStatistics.hpp"
+
 namespace distortos
 {
 
@@ -120,19 +122,36 @@ void MutexControlBlock::doLock()
 	auto& scheduler = getScheduler();
 	owner_ = &scheduler.getCurrentThreadControlBlock();
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr)
+		statistics_->recordLock(*owner_);
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	if (getProtocol() == Protocol::none)
 		return;
 
 	getOwner()->getOwnedProtocolMutexList().push_front(*this);
 
 	if (getProtocol() == Protocol::priorityProtect)
+	{
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+		if (statistics_ != nullptr && getPriorityCeiling() > getOwner()->getEffectivePriority())
+			statistics_->recordPriorityBoost();
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 		getOwner()->updateBoostedPriority();
+	}
 }
 
 void MutexControlBlock::doUnlockOrTransferLock()
 {
 	auto& oldOwner = *getOwner();
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr)
+		statistics_->recordUnlock();
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	if (blockedList_.empty() == false)
 		doTransferLock();
 	else
@@ -149,6 +168,16 @@ void MutexControlBlock::doUnlockOrTransferLock()
 	getOwner()->updateBoostedPriority();
 }
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+void MutexControlBlock::recordWait(const TickClock::duration waitTime)
+{
+	if (statistics_ != nullptr)
+		statistics_->recordWait(waitTime);
+}
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -162,6 +191,11 @@ void MutexControlBlock::beforeBlock() const
 
 	currentThreadControlBlock.setPriorityInheritanceMutexControlBlock(this);
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr && currentThreadControlBlock.getEffectivePriority() > getOwner()->getEffectivePriority())
+		statistics_->recordPriorityBoost();
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	// calling thread is not yet on the blocked list, that's why it's effective priority is given explicitly
 	getOwner()->updateBoostedPriority(currentThreadControlBlock.getEffectivePriority());
 }
@@ -171,6 +205,11 @@ void MutexControlBlock::doTransferLock()
 	owner_ = &blockedList_.front();	// pass ownership to the unblocked thread
 	getScheduler().unblock(blockedList_.begin());
 
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+	if (statistics_ != nullptr)
+		statistics_->recordLock(*owner_);
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
 	if (node.isLinked() == false)
 		return;
 
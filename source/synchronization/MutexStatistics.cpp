@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \brief MutexStatistics class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/MutexStatistics.hpp"
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+#include "distortos/internal/scheduler/ThreadControlBlock.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Mutex.hpp"
+
+#include <mutex>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// intrusive list of MutexStatistics objects
+using MutexStatisticsList = estd::IntrusiveList<MutexStatistics, &MutexStatistics::node>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// list of all MutexStatistics objects
+MutexStatisticsList mutexStatisticsList;
+
+/// mutex protecting mutexStatisticsList
+Mutex mutexStatisticsListMutex;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MutexStatistics::MutexStatistics(Mutex& mutex, const char* const name) :
+		node{},
+		snapshot_{},
+		lockTimePoint_{},
+		mutex_{mutex},
+		name_{name}
+{
+	const std::lock_guard<Mutex> lockGuard {mutexStatisticsListMutex};
+
+	mutexStatisticsList.push_back(*this);
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (static_cast<internal::MutexControlBlock&>(mutex_).getOwner() != nullptr)	// mutex is already locked?
+		lockTimePoint_ = TickClock::now();
+	static_cast<internal::MutexControlBlock&>(mutex_).setStatistics(this);
+}
+
+MutexStatistics::~MutexStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {mutexStatisticsListMutex};
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+		static_cast<internal::MutexControlBlock&>(mutex_).setStatistics(nullptr);
+	}
+
+	node.unlink();
+}
+
+MutexStatistics::Snapshot MutexStatistics::getSnapshot() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	return snapshot_;
+}
+
+void MutexStatistics::reset()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+	snapshot_ = {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void MutexStatistics::forEachImplementation(const Visitor& visitor)
+{
+	const std::lock_guard<Mutex> lockGuard {mutexStatisticsListMutex};
+
+	for (const auto& mutexStatistics : mutexStatisticsList)
+		visitor(mutexStatistics);
+}
+
+void MutexStatistics::recordLock(const internal::ThreadControlBlock& owner)
+{
+	lockTimePoint_ = TickClock::now();
+	snapshot_.lastOwner = {owner, owner.getSequenceNumber()};
+	++snapshot_.lockCount;
+}
+
+void MutexStatistics::recordUnlock()
+{
+	const auto holdTime = TickClock::now() - lockTimePoint_;
+	if (holdTime > snapshot_.maxHoldTime)
+		snapshot_.maxHoldTime = holdTime;
+}
+
+void MutexStatistics::recordWait(const TickClock::duration waitTime)
+{
+	++snapshot_.contendedLockCount;
+	snapshot_.totalWaitTime += waitTime;
+	if (waitTime > snapshot_.maxWaitTime)
+		snapshot_.maxWaitTime = waitTime;
+}
+
+}	// namespace distortos
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief OnceFlag class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/OnceFlag.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// list of threads waiting for completion of callOnce() on any OnceFlag object
+internal::ThreadList onceFlagWaitersList;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool OnceFlag::start()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	// list is shared by all objects, so the thread may be unblocked when function for another object finishes
+	while (state_.load(std::memory_order_relaxed) == State::inProgress)
+		internal::getScheduler().block(onceFlagWaitersList, ThreadState::blockedOnOnceFlag);
+
+	if (state_.load(std::memory_order_relaxed) == State::done)
+		return false;
+
+	state_.store(State::inProgress, std::memory_order_relaxed);
+	return true;
+}
+
+void OnceFlag::finish()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	state_.store(State::done, std::memory_order_release);
+
+	auto& scheduler = internal::getScheduler();
+	while (onceFlagWaitersList.empty() == false)
+		scheduler.unblock(onceFlagWaitersList.begin());
+}
+
+}	// namespace distortos
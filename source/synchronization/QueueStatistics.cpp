@@ -0,0 +1,169 @@
+/**
+ * \file
+ * \brief QueueStatistics class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/QueueStatistics.hpp"
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Mutex.hpp"
+#include "distortos/RawFifoQueue.hpp"
+#include "distortos/RawMessageQueue.hpp"
+
+#include <mutex>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// intrusive list of QueueStatistics objects
+using QueueStatisticsList = estd::IntrusiveList<QueueStatistics, &QueueStatistics::node>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// list of all QueueStatistics objects
+QueueStatisticsList queueStatisticsList;
+
+/// mutex protecting queueStatisticsList
+Mutex queueStatisticsListMutex;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+QueueStatistics::QueueStatistics(RawFifoQueue& rawFifoQueue, const char* const name) :
+		QueueStatistics{rawFifoQueue.fifoQueueBase_, name}
+{
+
+}
+
+QueueStatistics::QueueStatistics(RawMessageQueue& rawMessageQueue, const char* const name) :
+		QueueStatistics{rawMessageQueue.messageQueueBase_, name}
+{
+
+}
+
+QueueStatistics::~QueueStatistics()
+{
+	const std::lock_guard<Mutex> lockGuard {queueStatisticsListMutex};
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+		statisticsPointer_ = nullptr;
+	}
+
+	node.unlink();
+}
+
+QueueStatistics::Snapshot QueueStatistics::getSnapshot() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	auto snapshot = snapshot_;
+	snapshot.depth = popSemaphore_.getValue();
+	return snapshot;
+}
+
+void QueueStatistics::reset()
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	snapshot_ = {};
+	snapshot_.maxDepth = popSemaphore_.getValue();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+QueueStatistics::QueueStatistics(internal::FifoQueueBase& fifoQueueBase, const char* const name) :
+		QueueStatistics{fifoQueueBase.statistics_, fifoQueueBase.getPopSemaphore(), name}
+{
+
+}
+
+QueueStatistics::QueueStatistics(internal::MessageQueueBase& messageQueueBase, const char* const name) :
+		QueueStatistics{messageQueueBase.statistics_, messageQueueBase.getPopSemaphore(), name}
+{
+
+}
+
+QueueStatistics::QueueStatistics(QueueStatistics*& statisticsPointer, const Semaphore& popSemaphore,
+		const char* const name) :
+		node{},
+		snapshot_{},
+		popSemaphore_{popSemaphore},
+		statisticsPointer_{statisticsPointer},
+		name_{name}
+{
+	const std::lock_guard<Mutex> lockGuard {queueStatisticsListMutex};
+
+	queueStatisticsList.push_back(*this);
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	snapshot_.maxDepth = popSemaphore_.getValue();
+	statisticsPointer_ = this;
+}
+
+void QueueStatistics::forEachImplementation(const Visitor& visitor)
+{
+	const std::lock_guard<Mutex> lockGuard {queueStatisticsListMutex};
+
+	for (const auto& queueStatistics : queueStatisticsList)
+		visitor(queueStatistics);
+}
+
+void QueueStatistics::record(const bool push, const int ret, const TickClock::time_point waitStart)
+{
+	// semaphore was not available and the operation was not a non-blocking attempt, so the thread had to block
+	if (waitStart != TickClock::time_point::min() && ret != EAGAIN)
+	{
+		++(push == true ? snapshot_.blockedPushCount : snapshot_.blockedPopCount);
+		snapshot_.totalBlockedTime += TickClock::now() - waitStart;
+	}
+
+	if (ret != 0)
+	{
+		if (push == true)
+			++snapshot_.failedPushCount;
+		return;
+	}
+
+	if (push == false)
+	{
+		++snapshot_.popCount;
+		return;
+	}
+
+	++snapshot_.pushCount;
+
+	// "pop" semaphore is posted after the element is actually pushed, so it doesn't include the new element yet
+	const size_t depth = popSemaphore_.getValue() + 1;
+	if (depth > snapshot_.maxDepth)
+		snapshot_.maxDepth = depth;
+}
+
+}	// namespace distortos
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
@@ -2,7 +2,7 @@
  * \file
  * \brief Semaphore class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,6 +14,8 @@
 #include "distortos/internal/scheduler/getScheduler.hpp"
 #include "distortos/internal/scheduler/Scheduler.hpp"
 
+#include "distortos/internal/synchronization/getMultiWaiterList.hpp"
+
 #include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
 
 #include "distortos/InterruptMaskingLock.hpp"
@@ -24,76 +26,150 @@ namespace distortos
 {
 
 /*---------------------------------------------------------------------------------------------------------------------+
-| public functions
+| private types
 +---------------------------------------------------------------------------------------------------------------------*/
 
-int Semaphore::post()
+/// SemaphoreUnblockFunctor is a functor executed when unblocking a thread that is blocked on a semaphore
+class Semaphore::SemaphoreUnblockFunctor : public internal::UnblockFunctor
 {
-	const InterruptMaskingLock interruptMaskingLock;
+public:
 
-	if (value_ == maxValue_)
-		return EOVERFLOW;
+	/**
+	 * \brief SemaphoreUnblockFunctor's constructor
+	 *
+	 * \param [in] semaphore is a reference to Semaphore that blocked the thread
+	 */
+
+	constexpr explicit SemaphoreUnblockFunctor(Semaphore& semaphore) :
+			semaphore_{semaphore}
+	{
+
+	}
 
-	if (blockedList_.empty() == false)
+	/**
+	 * \brief SemaphoreUnblockFunctor's function call operator
+	 *
+	 * If the wait for semaphore was interrupted, units which are available are given to threads which may be able to
+	 * acquire them now (e.g. threads with small requests waiting behind a thread with large request which gave up).
+	 *
+	 * \param [in] unblockReason is the reason of thread unblocking
+	 */
+
+	void operator()(internal::ThreadControlBlock&, const internal::UnblockReason unblockReason) const override
 	{
-		internal::getScheduler().unblock(blockedList_.begin());
-		return 0;
+		if (unblockReason == internal::UnblockReason::unblockRequest)	// units were given to this thread
+			return;
+
+		semaphore_.value_ = semaphore_.unblockWaiters(semaphore_.value_);
 	}
 
-	++value_;
+private:
+
+	/// reference to Semaphore that blocked the thread
+	Semaphore& semaphore_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int Semaphore::post(const Value count)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	// find the final value of the semaphore without modifying anything, "available" is wider than Value, so the sum
+	// cannot overflow
+	auto available = static_cast<uint64_t>(value_) + count;
+	for (auto iterator = blockedList_.begin();
+			iterator != blockedList_.end() && iterator->getSemaphoreWaitCount() <= available; ++iterator)
+		available -= iterator->getSemaphoreWaitCount();
+
+	if (available > maxValue_)
+		return EOVERFLOW;
+
+	const auto previousValue = value_;
+	value_ = unblockWaiters(static_cast<uint64_t>(value_) + count);
+	if (value_ > previousValue)
+		internal::notifyMultiWaiters(this);
 
 	return 0;
 }
 
-int Semaphore::tryWait()
+int Semaphore::tryWait(const Value count)
 {
 	const InterruptMaskingLock interruptMaskingLock;
-	return tryWaitInternal();
+	return tryWaitInternal(count);
 }
 
-int Semaphore::tryWaitFor(const TickClock::duration duration)
+int Semaphore::tryWaitFor(const TickClock::duration duration, const Value count)
 {
-	return tryWaitUntil(TickClock::now() + duration + TickClock::duration{1});
+	return tryWaitUntil(TickClock::now() + duration + TickClock::duration{1}, count);
 }
 
-int Semaphore::tryWaitUntil(const TickClock::time_point timePoint)
+int Semaphore::tryWaitUntil(const TickClock::time_point timePoint, const Value count)
 {
 	CHECK_FUNCTION_CONTEXT();
 
 	const InterruptMaskingLock interruptMaskingLock;
 
-	const auto ret = tryWaitInternal();
+	const auto ret = tryWaitInternal(count);
 	if (ret != EAGAIN)	// lock successful?
 		return ret;
 
-	return internal::getScheduler().blockUntil(blockedList_, ThreadState::blockedOnSemaphore, timePoint);
+	auto& scheduler = internal::getScheduler();
+	scheduler.getCurrentThreadControlBlock().setSemaphoreWaitCount(count);
+	const SemaphoreUnblockFunctor unblockFunctor {*this};
+	return scheduler.blockUntil(blockedList_, ThreadState::blockedOnSemaphore, timePoint, &unblockFunctor);
 }
 
-int Semaphore::wait()
+int Semaphore::wait(const Value count)
 {
 	CHECK_FUNCTION_CONTEXT();
 
 	const InterruptMaskingLock interruptMaskingLock;
 
-	const auto ret = tryWaitInternal();
+	const auto ret = tryWaitInternal(count);
 	if (ret != EAGAIN)	// lock successful?
 		return ret;
 
-	return internal::getScheduler().block(blockedList_, ThreadState::blockedOnSemaphore);
+	auto& scheduler = internal::getScheduler();
+	scheduler.getCurrentThreadControlBlock().setSemaphoreWaitCount(count);
+	const SemaphoreUnblockFunctor unblockFunctor {*this};
+	return scheduler.block(blockedList_, ThreadState::blockedOnSemaphore, &unblockFunctor);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | private functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-int Semaphore::tryWaitInternal()
+int Semaphore::tryWaitInternal(const Value count)
 {
-	if (value_ == 0)	// lock not possible?
+	if (count > maxValue_)	// request can never be satisfied?
+		return EINVAL;
+
+	if (value_ < count)	// lock not possible?
 		return EAGAIN;
 
-	--value_;
+	// units must not be taken ahead of a blocked thread with the same or higher priority
+	if (blockedList_.empty() == false && blockedList_.begin()->getEffectivePriority() >=
+			internal::getScheduler().getCurrentThreadControlBlock().getEffectivePriority())
+		return EAGAIN;
+
+	value_ -= count;
 
 	return 0;
 }
 
+uint64_t Semaphore::unblockWaiters(uint64_t available)
+{
+	auto& scheduler = internal::getScheduler();
+	while (blockedList_.empty() == false && blockedList_.begin()->getSemaphoreWaitCount() <= available)
+	{
+		available -= blockedList_.begin()->getSemaphoreWaitCount();
+		scheduler.unblock(blockedList_.begin());
+	}
+
+	return available;
+}
+
 }	// namespace distortos
@@ -0,0 +1,129 @@
+/**
+ * \file
+ * \brief SharedMutex class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/SharedMutex.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int SharedMutex::lock()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	int ret;
+	// break the loop when one of following conditions is true:
+	// - lock successful or deadlock detected;
+	// - lock transferred successfully;
+	while ((ret = doTryLock()) == EBUSY && (ret = doBlock(false)) == EINTR);
+	return ret;
+}
+
+int SharedMutex::lockShared()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	int ret;
+	// break the loop when one of following conditions is true:
+	// - lock successful or deadlock detected;
+	// - lock transferred successfully;
+	while (((ret = doTryLockShared()) == EBUSY || ret == EAGAIN) && (ret = doBlock(true)) == EINTR);
+	return ret;
+}
+
+int SharedMutex::tryLock()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+	const auto ret = doTryLock();
+	return ret != EDEADLK ? ret : EBUSY;
+}
+
+int SharedMutex::tryLockFor(const TickClock::duration duration)
+{
+	return tryLockUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int SharedMutex::tryLockShared()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+	const auto ret = doTryLockShared();
+	return ret != EDEADLK ? ret : EBUSY;
+}
+
+int SharedMutex::tryLockSharedFor(const TickClock::duration duration)
+{
+	return tryLockSharedUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int SharedMutex::tryLockSharedUntil(const TickClock::time_point timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	int ret;
+	// break the loop when one of following conditions is true:
+	// - lock successful or deadlock detected;
+	// - lock transferred successfully;
+	// - timeout expired;
+	while (((ret = doTryLockShared()) == EBUSY || ret == EAGAIN) && (ret = doBlockUntil(true, timePoint)) == EINTR);
+	return ret;
+}
+
+int SharedMutex::tryLockUntil(const TickClock::time_point timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	int ret;
+	// break the loop when one of following conditions is true:
+	// - lock successful or deadlock detected;
+	// - lock transferred successfully;
+	// - timeout expired;
+	while ((ret = doTryLock()) == EBUSY && (ret = doBlockUntil(false, timePoint)) == EINTR);
+	return ret;
+}
+
+int SharedMutex::unlock()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+	return doUnlock();
+}
+
+int SharedMutex::unlockShared()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	const InterruptMaskingLock interruptMaskingLock;
+	return doUnlockShared();
+}
+
+}	// namespace distortos
@@ -0,0 +1,292 @@
+/**
+ * \file
+ * \brief SharedMutexControlBlock class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/synchronization/SharedMutexControlBlock.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// SharedMutexUnblockFunctor is a functor executed when unblocking a thread that is blocked on a shared mutex
+class SharedMutexControlBlock::SharedMutexUnblockFunctor : public UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief SharedMutexUnblockFunctor's constructor
+	 *
+	 * \param [in] sharedMutexControlBlock is a reference to SharedMutexControlBlock that blocked the thread
+	 * \param [in] shared selects whether the thread waits for shared (true) or exclusive (false) ownership
+	 */
+
+	constexpr SharedMutexUnblockFunctor(SharedMutexControlBlock& sharedMutexControlBlock, const bool shared) :
+			sharedMutexControlBlock_{sharedMutexControlBlock},
+			shared_{shared}
+	{
+
+	}
+
+	/**
+	 * \brief SharedMutexUnblockFunctor's function call operator
+	 *
+	 * Decrements number of blocked "writers" if required. Pointer to MutexControlBlock with priorityInheritance
+	 * protocol which caused the thread to block is reset to nullptr. If the wait for shared mutex was interrupted,
+	 * ownership is transferred to threads which may be able to acquire it now (e.g. "readers" waiting behind a "writer"
+	 * which gave up) and boosted priority of current owner of the shared mutex is updated.
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock that is being unblocked
+	 * \param [in] unblockReason is the reason of thread unblocking
+	 */
+
+	void operator()(ThreadControlBlock& threadControlBlock, const UnblockReason unblockReason) const override
+	{
+		if (shared_ == false)
+			--sharedMutexControlBlock_.blockedWritersCount_;
+
+		if (sharedMutexControlBlock_.getProtocol() == MutexProtocol::priorityInheritance)
+			threadControlBlock.setPriorityInheritanceMutexControlBlock(nullptr);
+
+		if (unblockReason == UnblockReason::unblockRequest)	// ownership was transferred to this thread
+			return;
+
+		const auto owner = sharedMutexControlBlock_.getOwner();
+		sharedMutexControlBlock_.transferOwnership();
+		sharedMutexControlBlock_.updateOwner(owner);
+	}
+
+private:
+
+	/// reference to SharedMutexControlBlock that blocked the thread
+	SharedMutexControlBlock& sharedMutexControlBlock_;
+
+	/// selects whether the thread waits for shared (true) or exclusive (false) ownership
+	bool shared_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| protected functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int SharedMutexControlBlock::doBlock(const bool shared)
+{
+	beforeBlock(shared);
+
+	const SharedMutexUnblockFunctor unblockFunctor {*this, shared};
+	return getScheduler().block(getBlockedList(), shared == true ? ThreadState::blockedOnSharedMutexShared :
+			ThreadState::blockedOnSharedMutexExclusive, &unblockFunctor);
+}
+
+int SharedMutexControlBlock::doBlockUntil(const bool shared, const TickClock::time_point timePoint)
+{
+	beforeBlock(shared);
+
+	const SharedMutexUnblockFunctor unblockFunctor {*this, shared};
+	return getScheduler().blockUntil(getBlockedList(), shared == true ? ThreadState::blockedOnSharedMutexShared :
+			ThreadState::blockedOnSharedMutexExclusive, timePoint, &unblockFunctor);
+}
+
+int SharedMutexControlBlock::doTryLock()
+{
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	if (getOwner() == &currentThreadControlBlock || isReader(currentThreadControlBlock) == true)
+		return EDEADLK;
+
+	if (getOwner() != nullptr)
+		return EBUSY;
+
+	// shared mutex is unlocked, so there are no blocked threads
+	setOwner(&currentThreadControlBlock);
+	updateOwner(nullptr);
+	return 0;
+}
+
+int SharedMutexControlBlock::doTryLockShared()
+{
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	if (getOwner() == &currentThreadControlBlock || isReader(currentThreadControlBlock) == true)
+		return EDEADLK;
+
+	if (getOwner() != nullptr && readersCount_ == 0)	// exclusive ownership?
+		return EBUSY;
+
+	if (readersCount_ == maxReaders_)
+		return EAGAIN;
+
+	if (policy_ == Policy::writerPreference ? blockedWritersCount_ != 0 :
+			isWriterAhead(currentThreadControlBlock.getEffectivePriority()) == true)
+		return EBUSY;
+
+	const auto previousOwner = getOwner();
+	storageUniquePointer_[readersCount_++] = &currentThreadControlBlock;
+	updateOwner(previousOwner);
+	return 0;
+}
+
+int SharedMutexControlBlock::doUnlock()
+{
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	if (getOwner() != &currentThreadControlBlock || readersCount_ != 0)
+		return EPERM;
+
+	setOwner(nullptr);
+	transferOwnership();
+	updateOwner(&currentThreadControlBlock);
+	return 0;
+}
+
+int SharedMutexControlBlock::doUnlockShared()
+{
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	size_t index {};
+	while (index < readersCount_ && storageUniquePointer_[index] != &currentThreadControlBlock)
+		++index;
+
+	if (index == readersCount_)
+		return EPERM;
+
+	storageUniquePointer_[index] = storageUniquePointer_[--readersCount_];
+
+	const auto previousOwner = getOwner();
+	if (readersCount_ == 0)
+		setOwner(nullptr);
+	transferOwnership();
+	updateOwner(previousOwner);
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SharedMutexControlBlock::beforeBlock(const bool shared)
+{
+	if (shared == false)
+		++blockedWritersCount_;
+
+	if (getProtocol() != MutexProtocol::priorityInheritance)
+		return;
+
+	auto& currentThreadControlBlock = getScheduler().getCurrentThreadControlBlock();
+
+	currentThreadControlBlock.setPriorityInheritanceMutexControlBlock(this);
+
+	// calling thread is not yet on the blocked list, that's why it's effective priority is given explicitly
+	getOwner()->updateBoostedPriority(currentThreadControlBlock.getEffectivePriority());
+}
+
+bool SharedMutexControlBlock::isReader(const ThreadControlBlock& threadControlBlock) const
+{
+	for (size_t i {}; i < readersCount_; ++i)
+		if (storageUniquePointer_[i] == &threadControlBlock)
+			return true;
+
+	return false;
+}
+
+bool SharedMutexControlBlock::isWriterAhead(const uint8_t priority) const
+{
+	// list of blocked threads is sorted by effective priority, so only threads with priority higher or equal to given
+	// one need to be checked
+	for (const auto& threadControlBlock : getBlockedList())
+	{
+		if (threadControlBlock.getEffectivePriority() < priority)
+			return false;
+		if (threadControlBlock.getState() == ThreadState::blockedOnSharedMutexExclusive)
+			return true;
+	}
+
+	return false;
+}
+
+void SharedMutexControlBlock::transferOwnership()
+{
+	auto& blockedList = getBlockedList();
+	auto& scheduler = getScheduler();
+	const auto writerPreference = policy_ == Policy::writerPreference && blockedWritersCount_ != 0;
+
+	auto iterator = blockedList.begin();
+	while (iterator != blockedList.end())
+	{
+		const auto currentIterator = iterator;
+		++iterator;	// thread will be removed from the list when it is unblocked
+
+		auto& threadControlBlock = *currentIterator;
+		if (threadControlBlock.getState() == ThreadState::blockedOnSharedMutexExclusive)
+		{
+			// exclusive ownership can be granted only if shared mutex is unlocked, also by "readers" unblocked above
+			if (getOwner() == nullptr && readersCount_ == 0)
+			{
+				setOwner(&threadControlBlock);
+				scheduler.unblock(currentIterator);
+			}
+			return;
+		}
+
+		// "writers" have preference, so skip all "readers"
+		if (writerPreference == true)
+			continue;
+
+		if ((getOwner() != nullptr && readersCount_ == 0) || readersCount_ == maxReaders_)
+			return;
+
+		storageUniquePointer_[readersCount_++] = &threadControlBlock;
+		scheduler.unblock(currentIterator);
+	}
+}
+
+void SharedMutexControlBlock::updateOwner(ThreadControlBlock* const previousOwner)
+{
+	if (readersCount_ != 0)	// select the highest priority "reader" as the owner, keep previous one in case of a tie
+	{
+		auto owner = previousOwner != nullptr && isReader(*previousOwner) == true ? previousOwner :
+				storageUniquePointer_[0];
+		for (size_t i {}; i < readersCount_; ++i)
+			if (storageUniquePointer_[i]->getEffectivePriority() > owner->getEffectivePriority())
+				owner = storageUniquePointer_[i];
+		setOwner(owner);
+	}
+
+	if (getProtocol() != MutexProtocol::priorityInheritance)
+		return;
+
+	const auto owner = getOwner();
+	if (owner != previousOwner)
+	{
+		if (node.isLinked() == true)
+			node.unlink();
+		if (owner != nullptr)
+			owner->getOwnedProtocolMutexList().push_front(*this);
+		if (previousOwner != nullptr)
+			previousOwner->updateBoostedPriority();
+	}
+
+	if (owner != nullptr)
+		owner->updateBoostedPriority();
+}
+
+}	// namespace internal
+
+}	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief SignalInformationQueue class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -29,13 +29,14 @@ namespace internal
 
 SignalInformationQueue::SignalInformationQueue(StorageUniquePointer&& storageUniquePointer, const size_t maxElements) :
 		storageUniquePointer_{std::move(storageUniquePointer)},
-		signalInformationList_{},
-		freeSignalInformationList_{}
+		lastQueueNodes_{},
+		freeQueueNodes_{},
+		queuedSignalsBitmask_{}
 {
 	for (size_t i {}; i < maxElements; ++i)
 	{
-		auto& element = *new (&storageUniquePointer_[i]) QueueNode{{}, {{}, {}, {}}};
-		freeSignalInformationList_.push_front(element);
+		auto& element = *new (&storageUniquePointer_[i]) QueueNode{freeQueueNodes_, {{}, {}, {}}};
+		freeQueueNodes_ = &element;
 	}
 }
 
@@ -46,54 +47,54 @@ SignalInformationQueue::~SignalInformationQueue()
 
 std::pair<int, SignalInformation> SignalInformationQueue::acceptQueuedSignal(const uint8_t signalNumber)
 {
-	auto it = signalInformationList_.before_begin();
-	auto next = signalInformationList_.begin();
-	const auto last = signalInformationList_.end();
+	if (signalNumber >= signalNumbers || (queuedSignalsBitmask_ & (1u << signalNumber)) == 0)
+		return {EAGAIN, {{}, {}, {}}};
 
-	while (next != last)
+	auto& lastQueueNode = lastQueueNodes_[signalNumber];
+	auto& firstQueueNode = *lastQueueNode->next;
+	if (&firstQueueNode == lastQueueNode)	// this was the only queued object for this signal number?
 	{
-		if (next->signalInformation.getSignalNumber() == signalNumber)
-		{
-			const auto signalInformation = next->signalInformation;
-			List::splice_after(freeSignalInformationList_.before_begin(), it);
-			return {{}, signalInformation};
-		}
-
-		it = next;
-		++next;
+		lastQueueNode = nullptr;
+		queuedSignalsBitmask_ &= ~(1u << signalNumber);
 	}
+	else
+		lastQueueNode->next = firstQueueNode.next;
 
-	return {EAGAIN, {{}, {}, {}}};
+	firstQueueNode.next = freeQueueNodes_;
+	freeQueueNodes_ = &firstQueueNode;
+	return {{}, firstQueueNode.signalInformation};
 }
 
 SignalSet SignalInformationQueue::getQueuedSignalSet() const
 {
-	SignalSet queuedSignalSet {SignalSet::empty};
-	for (const auto& node : signalInformationList_)
-		queuedSignalSet.add(node.signalInformation.getSignalNumber());
-	return queuedSignalSet;
+	return SignalSet{queuedSignalsBitmask_};
 }
 
 int SignalInformationQueue::queueSignal(const uint8_t signalNumber, const sigval value)
 {
-	if (signalNumber >= SignalSet::Bitset{}.size())
+	if (signalNumber >= signalNumbers)
 		return EINVAL;
 
-	if (freeSignalInformationList_.empty() == true)
+	if (freeQueueNodes_ == nullptr)
 		return EAGAIN;
 
-	auto it = signalInformationList_.before_begin();
-	auto next = signalInformationList_.begin();
-	const auto last = signalInformationList_.end();
+	auto& queueNode = *freeQueueNodes_;
+	freeQueueNodes_ = queueNode.next;
+	queueNode.signalInformation = {signalNumber, SignalInformation::Code::queued, value};
 
-	while (next != last)	// find the iterator to the last element on the list ("before end")
+	auto& lastQueueNode = lastQueueNodes_[signalNumber];
+	if (lastQueueNode == nullptr)	// FIFO for this signal number is empty?
 	{
-		it = next;
-		++next;
+		queueNode.next = &queueNode;
+		queuedSignalsBitmask_ |= 1u << signalNumber;
+	}
+	else
+	{
+		queueNode.next = lastQueueNode->next;
+		lastQueueNode->next = &queueNode;
 	}
 
-	freeSignalInformationList_.front().signalInformation = {signalNumber, SignalInformation::Code::queued, value};
-	signalInformationList_.splice_after(it, freeSignalInformationList_.before_begin());
+	lastQueueNode = &queueNode;
 	return 0;
 }
 
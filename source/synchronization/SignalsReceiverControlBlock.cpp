@@ -2,7 +2,7 @@
  * \file
  * \brief SignalsReceiverControlBlock class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -65,6 +65,21 @@ std::pair<int, SignalInformation> SignalsReceiverControlBlock::acceptPendingSign
 	return {ret, SignalInformation{signalNumber, SignalInformation::Code::generated, sigval{}}};
 }
 
+void SignalsReceiverControlBlock::afterGenerateQueueUnlocked(const uint8_t signalNumber,
+		ThreadControlBlock& threadControlBlock) const
+{
+	assert(signalNumber < SignalSet::Bitset{}.size() && "Invalid signal number!");
+
+	if (signalsCatcherControlBlock_ == nullptr)
+		return;
+
+	const auto testResult = signalsCatcherControlBlock_->getSignalMask().test(signalNumber);
+	if (testResult.second == true)	// signal is masked?
+		return;
+
+	signalsCatcherControlBlock_->afterGenerateQueueUnlocked(threadControlBlock);
+}
+
 int SignalsReceiverControlBlock::deliveryOfSignalsStartedHook() const
 {
 	if (signalsCatcherControlBlock_ == nullptr)
@@ -79,25 +94,34 @@ int SignalsReceiverControlBlock::generateSignal(const uint8_t signalNumber, Thre
 	{
 		const InterruptMaskingLock interruptMaskingLock;
 
-		const auto isSignalIgnoredResult = isSignalIgnored(signalNumber);
-		if (isSignalIgnoredResult.first != 0)
-			return isSignalIgnoredResult.first;
-		if (isSignalIgnoredResult.second == true)	// is signal ignored?
-			return 0;
+		const auto ret = generateSignalLocked(signalNumber, threadControlBlock);
+		if (ret.first != 0 || ret.second == false)	// error or signal is ignored?
+			return ret.first;
+	}
 
-		{
-			const auto ret = beforeGenerateQueue(signalNumber, threadControlBlock);
-			if (ret != 0)
-				return ret;
-		}
+	afterGenerateQueueUnlocked(signalNumber, threadControlBlock);
+	return 0;
+}
 
-		pendingSignalSet_.add(signalNumber);	// signal number is valid (checked above)
+std::pair<int, bool> SignalsReceiverControlBlock::generateSignalLocked(const uint8_t signalNumber,
+		ThreadControlBlock& threadControlBlock)
+{
+	const auto isSignalIgnoredResult = isSignalIgnored(signalNumber);
+	if (isSignalIgnoredResult.first != 0)
+		return {isSignalIgnoredResult.first, {}};
+	if (isSignalIgnoredResult.second == true)	// is signal ignored?
+		return {{}, false};
 
-		afterGenerateQueueLocked(signalNumber, threadControlBlock);
+	{
+		const auto ret = beforeGenerateQueue(signalNumber, threadControlBlock);
+		if (ret != 0)
+			return {ret, {}};
 	}
 
-	afterGenerateQueueUnlocked(signalNumber, threadControlBlock);
-	return 0;
+	pendingSignalSet_.add(signalNumber);	// signal number is valid (checked above)
+
+	afterGenerateQueueLocked(signalNumber, threadControlBlock);
+	return {{}, true};
 }
 
 SignalSet SignalsReceiverControlBlock::getPendingSignalSet() const
@@ -129,36 +153,45 @@ SignalSet SignalsReceiverControlBlock::getSignalMask() const
 int SignalsReceiverControlBlock::queueSignal(const uint8_t signalNumber, const sigval value,
 		ThreadControlBlock& threadControlBlock) const
 {
-	if (signalInformationQueue_ == nullptr)
-		return ENOTSUP;
-
 	{
 		const InterruptMaskingLock interruptMaskingLock;
 
-		const auto isSignalIgnoredResult = isSignalIgnored(signalNumber);
-		if (isSignalIgnoredResult.first != 0)
-			return isSignalIgnoredResult.first;
-		if (isSignalIgnoredResult.second == true)	// is signal ignored?
-			return 0;
+		const auto ret = queueSignalLocked(signalNumber, value, threadControlBlock);
+		if (ret.first != 0 || ret.second == false)	// error or signal is ignored?
+			return ret.first;
+	}
 
-		if (signalInformationQueue_->canQueueSignal() == false)
-			return EAGAIN;
+	afterGenerateQueueUnlocked(signalNumber, threadControlBlock);
+	return 0;
+}
 
-		{
-			const auto ret = beforeGenerateQueue(signalNumber, threadControlBlock);
-			if (ret != 0)
-				return ret;
-		}
-		{
-			const auto ret = signalInformationQueue_->queueSignal(signalNumber, value);
-			assert(ret == 0 && "Queuing failed!");
-		}
+std::pair<int, bool> SignalsReceiverControlBlock::queueSignalLocked(const uint8_t signalNumber, const sigval value,
+		ThreadControlBlock& threadControlBlock) const
+{
+	if (signalInformationQueue_ == nullptr)
+		return {ENOTSUP, {}};
 
-		afterGenerateQueueLocked(signalNumber, threadControlBlock);
+	const auto isSignalIgnoredResult = isSignalIgnored(signalNumber);
+	if (isSignalIgnoredResult.first != 0)
+		return {isSignalIgnoredResult.first, {}};
+	if (isSignalIgnoredResult.second == true)	// is signal ignored?
+		return {{}, false};
+
+	if (signalInformationQueue_->canQueueSignal() == false)
+		return {EAGAIN, {}};
+
+	{
+		const auto ret = beforeGenerateQueue(signalNumber, threadControlBlock);
+		if (ret != 0)
+			return {ret, {}};
+	}
+	{
+		const auto ret = signalInformationQueue_->queueSignal(signalNumber, value);
+		assert(ret == 0 && "Queuing failed!");
 	}
 
-	afterGenerateQueueUnlocked(signalNumber, threadControlBlock);
-	return 0;
+	afterGenerateQueueLocked(signalNumber, threadControlBlock);
+	return {{}, true};
 }
 
 std::pair<int, SignalAction> SignalsReceiverControlBlock::setSignalAction(const uint8_t signalNumber,
@@ -217,21 +250,6 @@ void SignalsReceiverControlBlock::afterGenerateQueueLocked(const uint8_t signalN
 	getScheduler().unblock(ThreadList::iterator{threadControlBlock});
 }
 
-void SignalsReceiverControlBlock::afterGenerateQueueUnlocked(const uint8_t signalNumber,
-		ThreadControlBlock& threadControlBlock) const
-{
-	assert(signalNumber < SignalSet::Bitset{}.size() && "Invalid signal number!");
-
-	if (signalsCatcherControlBlock_ == nullptr)
-		return;
-
-	const auto testResult = signalsCatcherControlBlock_->getSignalMask().test(signalNumber);
-	if (testResult.second == true)	// signal is masked?
-		return;
-
-	signalsCatcherControlBlock_->afterGenerateQueueUnlocked(threadControlBlock);
-}
-
 int SignalsReceiverControlBlock::beforeGenerateQueue(const uint8_t signalNumber,
 		ThreadControlBlock& threadControlBlock) const
 {
@@ -0,0 +1,148 @@
+/**
+ * \file
+ * \brief StreamBuffer class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/StreamBuffer.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+StreamBuffer::StreamBuffer(StorageUniquePointer&& storageUniquePointer, const size_t size, const size_t triggerLevel) :
+		streamBufferBase_{std::move(storageUniquePointer), size},
+		triggerLevel_{std::max(std::min(triggerLevel, size), size_t{1})}
+{
+
+}
+
+int StreamBuffer::commit(const size_t size)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (size > streamBufferBase_.getWriteBlock().second)
+		return EINVAL;
+
+	streamBufferBase_.commit(size);
+	return 0;
+}
+
+std::pair<int, size_t> StreamBuffer::read(void* const buffer, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return readImplementation(buffer, size, nullptr);
+}
+
+std::pair<void*, size_t> StreamBuffer::reserve() const
+{
+	return streamBufferBase_.getWriteBlock();
+}
+
+int StreamBuffer::setTriggerLevel(const size_t triggerLevel)
+{
+	if (triggerLevel == 0 || triggerLevel > getCapacity())
+		return EINVAL;
+
+	triggerLevel_ = triggerLevel;
+	return 0;
+}
+
+std::pair<int, size_t> StreamBuffer::tryRead(void* const buffer, const size_t size)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto bytesRead = streamBufferBase_.read(buffer, size);
+	return {bytesRead == 0 && size != 0 ? EAGAIN : 0, bytesRead};
+}
+
+std::pair<int, size_t> StreamBuffer::tryReadFor(const TickClock::duration duration, void* const buffer,
+		const size_t size)
+{
+	return tryReadUntil(TickClock::now() + duration + TickClock::duration{1}, buffer, size);
+}
+
+std::pair<int, size_t> StreamBuffer::tryReadUntil(const TickClock::time_point timePoint, void* const buffer,
+		const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return readImplementation(buffer, size, &timePoint);
+}
+
+std::pair<int, size_t> StreamBuffer::tryWrite(const void* const data, const size_t size)
+{
+	return writeImplementation(data, size, true, nullptr);
+}
+
+std::pair<int, size_t> StreamBuffer::tryWriteFor(const TickClock::duration duration, const void* const data,
+		const size_t size)
+{
+	return tryWriteUntil(TickClock::now() + duration + TickClock::duration{1}, data, size);
+}
+
+std::pair<int, size_t> StreamBuffer::tryWriteUntil(const TickClock::time_point timePoint, const void* const data,
+		const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return writeImplementation(data, size, false, &timePoint);
+}
+
+std::pair<int, size_t> StreamBuffer::write(const void* const data, const size_t size)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return writeImplementation(data, size, false, nullptr);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, size_t> StreamBuffer::readImplementation(void* const buffer, const size_t size,
+		const TickClock::time_point* const timePoint)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	const auto ret = streamBufferBase_.waitForData(std::min(size, triggerLevel_), false, timePoint);
+	const auto bytesRead = streamBufferBase_.read(buffer, size);
+	return {bytesRead == 0 ? ret : 0, bytesRead};
+}
+
+std::pair<int, size_t> StreamBuffer::writeImplementation(const void* const data, const size_t size,
+		const bool nonBlocking, const TickClock::time_point* const timePoint)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	size_t bytesWritten {};
+	while (bytesWritten < size)
+	{
+		const auto ret = streamBufferBase_.waitForSpace(1, nonBlocking, timePoint);
+		if (ret != 0)	// in non-blocking mode writing only some of the bytes is not an error
+			return {nonBlocking == true && bytesWritten != 0 ? 0 : ret, bytesWritten};
+
+		bytesWritten += streamBufferBase_.write(static_cast<const uint8_t*>(data) + bytesWritten, size - bytesWritten);
+	}
+
+	return {0, bytesWritten};
+}
+
+}	// namespace distortos
@@ -0,0 +1,202 @@
+/**
+ * \file
+ * \brief StreamBufferBase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/synchronization/StreamBufferBase.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace internal
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Reads data from circular buffer.
+ *
+ * \param [in] circularBuffer is a reference to circular buffer from which the data will be read
+ * \param [out] buffer is a pointer to buffer for data, nullptr to discard data
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return number of bytes read from \a circularBuffer
+ */
+
+size_t readFromCircularBuffer(CircularBuffer& circularBuffer, void* const buffer, const size_t size)
+{
+	auto destination = static_cast<uint8_t*>(buffer);
+	size_t bytesRead {};
+	while (bytesRead < size)
+	{
+		const auto readBlock = circularBuffer.getReadBlock();
+		if (readBlock.second == 0)
+			break;
+
+		const auto chunk = std::min(readBlock.second, size - bytesRead);
+		if (destination != nullptr)
+		{
+			memcpy(destination, readBlock.first, chunk);
+			destination += chunk;
+		}
+		circularBuffer.increaseReadPosition(chunk);
+		bytesRead += chunk;
+	}
+
+	return bytesRead;
+}
+
+/**
+ * \brief Waits until given number of bytes is available.
+ *
+ * \param [in] waitersList is a reference to list of threads which are unblocked on each change of \a available
+ * \param [in] available is a functor which returns currently available number of bytes
+ * \param [in] size is the required number of bytes
+ * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode
+ * (true)
+ * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode
+ * is selected, nullptr to block without timeout
+ *
+ * \return 0 if at least \a size bytes are available, error code otherwise:
+ * - EAGAIN - not enough bytes are available and non-blocking mode was selected;
+ * - EINTR - the wait was interrupted by an unmasked, caught signal;
+ * - ETIMEDOUT - the wait was not completed before the specified timeout expired;
+ */
+
+template<typename Available>
+int waitUntilAvailable(ThreadList& waitersList, const Available available, const size_t size, const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	auto& scheduler = getScheduler();
+	while (available() < size)
+	{
+		if (nonBlocking == true)
+			return EAGAIN;
+
+		const auto ret = timePoint == nullptr ? scheduler.block(waitersList, ThreadState::blockedOnStreamBuffer) :
+				scheduler.blockUntil(waitersList, ThreadState::blockedOnStreamBuffer, *timePoint);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+StreamBufferBase::StreamBufferBase(StorageUniquePointer&& storageUniquePointer, const size_t size) :
+		dataWaitersList_{},
+		spaceWaitersList_{},
+		storageUniquePointer_{std::move(storageUniquePointer)},
+		circularBuffer_{storageUniquePointer_.get(), size}
+{
+
+}
+
+void StreamBufferBase::commit(const size_t size)
+{
+	if (size == 0)
+		return;
+
+	circularBuffer_.increaseWritePosition(size);
+	notify();
+}
+
+size_t StreamBufferBase::peek(void* const buffer, const size_t size) const
+{
+	auto circularBuffer = circularBuffer_;	// read from a copy, so that read position of the buffer is not changed
+	return readFromCircularBuffer(circularBuffer, buffer, size);
+}
+
+size_t StreamBufferBase::read(void* const buffer, const size_t size)
+{
+	const auto bytesRead = readFromCircularBuffer(circularBuffer_, buffer, size);
+	if (bytesRead != 0)
+		notify();
+	return bytesRead;
+}
+
+int StreamBufferBase::waitForData(const size_t size, const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	return waitUntilAvailable(dataWaitersList_,
+			[this]()
+			{
+				return getSize();
+			}, size, nonBlocking, timePoint);
+}
+
+int StreamBufferBase::waitForSpace(const size_t size, const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	return waitUntilAvailable(spaceWaitersList_,
+			[this]()
+			{
+				return getFreeSpace();
+			}, size, nonBlocking, timePoint);
+}
+
+size_t StreamBufferBase::write(const void* const data, const size_t size)
+{
+	auto source = static_cast<const uint8_t*>(data);
+	size_t bytesWritten {};
+	while (bytesWritten < size)
+	{
+		const auto writeBlock = circularBuffer_.getWriteBlock();
+		if (writeBlock.second == 0)
+			break;
+
+		const auto chunk = std::min(writeBlock.second, size - bytesWritten);
+		memcpy(writeBlock.first, source, chunk);
+		circularBuffer_.increaseWritePosition(chunk);
+		source += chunk;
+		bytesWritten += chunk;
+	}
+
+	if (bytesWritten != 0)
+		notify();
+	return bytesWritten;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void StreamBufferBase::notify()
+{
+	// threads may wait for different amounts of data or space, so all of them must reevaluate their conditions
+	auto& scheduler = getScheduler();
+	if (circularBuffer_.isEmpty() == false)
+		while (dataWaitersList_.empty() == false)
+			scheduler.unblock(dataWaitersList_.begin());
+	if (circularBuffer_.isFull() == false)
+		while (spaceWaitersList_.empty() == false)
+			scheduler.unblock(spaceWaitersList_.begin());
+}
+
+}	// namespace internal
+
+}	// namespace distortos
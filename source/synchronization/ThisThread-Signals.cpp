@@ -2,7 +2,7 @@
  * \file
  * \brief ThisThread::Signals namespace implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -15,6 +15,7 @@
 
 #include "distortos/internal/scheduler/getScheduler.hpp"
 #include "distortos/internal/scheduler/Scheduler.hpp"
+#include "distortos/internal/scheduler/ThreadGroupControlBlock.hpp"
 
 #include "distortos/internal/synchronization/SignalsReceiverControlBlock.hpp"
 
@@ -148,6 +149,14 @@ int generateSignal(const uint8_t signalNumber)
 	return ThisThread::get().generateSignal(signalNumber);
 }
 
+std::pair<int, size_t> generateSignalForThreadGroup(const uint8_t signalNumber)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return internal::getScheduler().getCurrentThreadControlBlock().getThreadGroupControlBlock()->
+			generateSignal(signalNumber);
+}
+
 SignalSet getPendingSignalSet()
 {
 	return ThisThread::get().getPendingSignalSet();
@@ -183,6 +192,14 @@ int queueSignal(const uint8_t signalNumber, const sigval value)
 	return ThisThread::get().queueSignal(signalNumber, value);
 }
 
+std::pair<int, size_t> queueSignalForThreadGroup(const uint8_t signalNumber, const sigval value)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return internal::getScheduler().getCurrentThreadControlBlock().getThreadGroupControlBlock()->
+			queueSignal(signalNumber, value);
+}
+
 std::pair<int, SignalAction> setSignalAction(const uint8_t signalNumber, const SignalAction& signalAction)
 {
 	CHECK_FUNCTION_CONTEXT();
@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief WaitableObject class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/WaitableObject.hpp"
+
+#include "distortos/devices/communication/SerialPort.hpp"
+
+#include "distortos/RawFifoQueue.hpp"
+#include "distortos/RawMessageQueue.hpp"
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+WaitableObject::WaitableObject(const RawFifoQueue& rawFifoQueue) :
+		WaitableObject{rawFifoQueue.fifoQueueBase_.getPopSemaphore()}
+{
+
+}
+
+WaitableObject::WaitableObject(const RawMessageQueue& rawMessageQueue) :
+		WaitableObject{rawMessageQueue.messageQueueBase_.getPopSemaphore()}
+{
+
+}
+
+const void* WaitableObject::getObject() const
+{
+	if (type_ == Type::semaphore)
+		return semaphore_;
+	if (type_ == Type::eventFlags)
+		return eventFlags_;
+	return serialPort_;
+}
+
+bool WaitableObject::isReady() const
+{
+	if (type_ == Type::semaphore)
+		return semaphore_->getValue() != 0;
+
+	if (type_ == Type::eventFlags)
+	{
+		const auto intersection = eventFlags_->get() & bitmask_;
+		return mode_ == EventFlags::WaitMode::any ? intersection != 0 : intersection == bitmask_;
+	}
+
+	return serialPort_->isReadReady();
+}
+
+void WaitableObject::prepare() const
+{
+	if (type_ == Type::serialPort)
+		serialPort_->requestReadReadinessNotification();
+}
+
+}	// namespace distortos
@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \brief WorkQueue class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/WorkQueue.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int WorkQueue::cancel(WorkItem& workItem)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (workItem.isQueued() == false)
+		return EINVAL;
+
+	// semaphore is not decremented - worker will just find the list empty
+	workItem.node.unlink();
+	return 0;
+}
+
+void WorkQueue::run()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	while (1)
+	{
+		if (semaphore_.wait() != 0)
+			continue;
+
+		WorkItem* workItem;
+
+		{
+			const InterruptMaskingLock interruptMaskingLock;
+
+			if (list_.empty() == true)	// work item was cancelled?
+				continue;
+
+			workItem = &list_.front();
+			list_.pop_front();
+		}
+
+		workItem->function_(workItem->argument_);
+	}
+}
+
+int WorkQueue::submit(WorkItem& workItem)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (workItem.isQueued() == true)
+		return EALREADY;
+
+	const auto ret = semaphore_.post();
+	if (ret != 0)
+		return ret;
+
+	list_.push_back(workItem);
+	return 0;
+}
+
+}	// namespace distortos
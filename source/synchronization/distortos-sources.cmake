@@ -8,16 +8,28 @@
 #
 
 target_sources(distortos PRIVATE
+		${CMAKE_CURRENT_LIST_DIR}/Barrier.cpp
 		${CMAKE_CURRENT_LIST_DIR}/ConditionVariable.cpp
+		${CMAKE_CURRENT_LIST_DIR}/DynamicMessageBuffer.cpp
 		${CMAKE_CURRENT_LIST_DIR}/DynamicRawFifoQueue.cpp
 		${CMAKE_CURRENT_LIST_DIR}/DynamicRawMessageQueue.cpp
+		${CMAKE_CURRENT_LIST_DIR}/DynamicSharedMutex.cpp
 		${CMAKE_CURRENT_LIST_DIR}/DynamicSignalsReceiver.cpp
+		${CMAKE_CURRENT_LIST_DIR}/DynamicStreamBuffer.cpp
+		${CMAKE_CURRENT_LIST_DIR}/EventFlags.cpp
 		${CMAKE_CURRENT_LIST_DIR}/FifoQueueBase.cpp
+		${CMAKE_CURRENT_LIST_DIR}/getMultiWaiterList.cpp
+		${CMAKE_CURRENT_LIST_DIR}/InterruptMaskingStatistics.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MemcpyPopQueueFunctor.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MemcpyPushQueueFunctor.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MessageBuffer.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MessageQueueBase.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MultiWaiter.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MutexControlBlock.cpp
 		${CMAKE_CURRENT_LIST_DIR}/Mutex.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MutexStatistics.cpp
+		${CMAKE_CURRENT_LIST_DIR}/OnceFlag.cpp
+		${CMAKE_CURRENT_LIST_DIR}/QueueStatistics.cpp
 		${CMAKE_CURRENT_LIST_DIR}/RawFifoQueue.cpp
 		${CMAKE_CURRENT_LIST_DIR}/RawMessageQueue.cpp
 		${CMAKE_CURRENT_LIST_DIR}/Semaphore.cpp
@@ -25,8 +37,15 @@ target_sources(distortos PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/SemaphoreTryWaitFunctor.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SemaphoreTryWaitUntilFunctor.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SemaphoreWaitFunctor.cpp
+		${CMAKE_CURRENT_LIST_DIR}/SharedMutexControlBlock.cpp
+		${CMAKE_CURRENT_LIST_DIR}/SharedMutex.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SignalInformationQueue.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SignalsCatcherControlBlock.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SignalSet.cpp
 		${CMAKE_CURRENT_LIST_DIR}/SignalsReceiverControlBlock.cpp
-		${CMAKE_CURRENT_LIST_DIR}/ThisThread-Signals.cpp)
+		${CMAKE_CURRENT_LIST_DIR}/StreamBuffer.cpp
+		${CMAKE_CURRENT_LIST_DIR}/StreamBufferBase.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ThisThread-Signals.cpp
+		${CMAKE_CURRENT_LIST_DIR}/WaitableObject.cpp
+		${CMAKE_CURRENT_LIST_DIR}/waitForAny.cpp
+		${CMAKE_CURRENT_LIST_DIR}/WorkQueue.cpp)
@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief multiWaiterListInstance definition and unblockReadyMultiWaiters() implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/synchronization/getMultiWaiterList.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+namespace distortos
+{
+
+namespace internal
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// main instance of MultiWaiterList
+MultiWaiterList multiWaiterListInstance;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void unblockReadyMultiWaiters(const void* const object)
+{
+	auto& multiWaiterList = getMultiWaiterList();
+	auto& scheduler = getScheduler();
+
+	auto iterator = multiWaiterList.begin();
+	while (iterator != multiWaiterList.end())
+	{
+		auto& multiWaiter = *iterator;
+		++iterator;	// multi-waiter will be removed from the list when its thread is unblocked
+
+		const auto readyIndex = multiWaiter.findReady(object);
+		if (readyIndex == multiWaiter.getSize())
+			continue;
+
+		multiWaiter.setReadyIndex(readyIndex);
+		scheduler.unblock(ThreadList::iterator{multiWaiter.getThreadControlBlock()});
+	}
+}
+
+}	// namespace internal
+
+}	// namespace distortos
@@ -0,0 +1,154 @@
+/**
+ * \file
+ * \brief waitForAny() implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/waitForAny.hpp"
+
+#include "distortos/internal/scheduler/getScheduler.hpp"
+#include "distortos/internal/scheduler/Scheduler.hpp"
+
+#include "distortos/internal/synchronization/getMultiWaiterList.hpp"
+
+#include "distortos/internal/CHECK_FUNCTION_CONTEXT.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// MultiWaiterUnblockFunctor is a functor executed when unblocking a thread that is waiting for multiple objects
+class MultiWaiterUnblockFunctor : public internal::UnblockFunctor
+{
+public:
+
+	/**
+	 * \brief MultiWaiterUnblockFunctor's constructor
+	 *
+	 * \param [in] multiWaiter is a reference to MultiWaiter of the thread
+	 */
+
+	constexpr explicit MultiWaiterUnblockFunctor(internal::MultiWaiter& multiWaiter) :
+			multiWaiter_{multiWaiter}
+	{
+
+	}
+
+	/**
+	 * \brief MultiWaiterUnblockFunctor's function call operator
+	 *
+	 * Removes MultiWaiter of the thread from the list of multi-waiters (if it is still there).
+	 *
+	 * \param [in] threadControlBlock is a reference to ThreadControlBlock that is being unblocked
+	 * \param [in] unblockReason is the reason of thread unblocking
+	 */
+
+	void operator()(internal::ThreadControlBlock&, internal::UnblockReason) const override
+	{
+		if (multiWaiter_.node.isLinked() == true)
+			multiWaiter_.node.unlink();
+	}
+
+private:
+
+	/// reference to MultiWaiter of the thread
+	internal::MultiWaiter& multiWaiter_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Implementation of waitForAny(), tryWaitForAny(), tryWaitForAnyFor() and tryWaitForAnyUntil().
+ *
+ * \param [in] objects is a range of objects that will be waited for
+ * \param [in] nonBlocking selects whether this function operates in blocking mode (false) or non-blocking mode (true)
+ * \param [in] timePoint is a pointer to time point at which the wait will be terminated, used only if blocking mode is
+ * selected, nullptr to block without timeout
+ *
+ * \return pair with return code (0 on success, error code otherwise) and index of object from \a objects which is ready
+ * (valid only on success); error codes:
+ * - EAGAIN - none of the objects is ready and non-blocking mode was selected;
+ * - EINVAL - \a objects is empty;
+ * - error codes returned by internal::Scheduler::block() (for blocking mode without timeout) /
+ * internal::Scheduler::blockUntil() (for blocking mode with timeout);
+ */
+
+std::pair<int, size_t> waitForAnyImplementation(const WaitableObjectsRange objects, const bool nonBlocking,
+		const TickClock::time_point* const timePoint)
+{
+	if (objects.size() == 0)
+		return {EINVAL, {}};
+
+	const InterruptMaskingLock interruptMaskingLock;
+
+	for (size_t i {}; i < objects.size(); ++i)
+	{
+		objects[i].prepare();
+		if (objects[i].isReady() == true)
+			return {0, i};
+	}
+
+	if (nonBlocking == true)
+		return {EAGAIN, {}};
+
+	auto& scheduler = internal::getScheduler();
+	internal::MultiWaiter multiWaiter {scheduler.getCurrentThreadControlBlock(), objects.begin(), objects.size()};
+	internal::getMultiWaiterList().push_back(multiWaiter);
+
+	internal::ThreadList waitingList;
+	const MultiWaiterUnblockFunctor multiWaiterUnblockFunctor {multiWaiter};
+	const auto ret = timePoint == nullptr ?
+			scheduler.block(waitingList, ThreadState::blockedOnMultipleObjects, &multiWaiterUnblockFunctor) :
+			scheduler.blockUntil(waitingList, ThreadState::blockedOnMultipleObjects, *timePoint,
+					&multiWaiterUnblockFunctor);
+	return {ret, ret == 0 ? multiWaiter.getReadyIndex() : size_t{}};
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, size_t> tryWaitForAny(const WaitableObjectsRange objects)
+{
+	return waitForAnyImplementation(objects, true, nullptr);
+}
+
+std::pair<int, size_t> tryWaitForAnyFor(const WaitableObjectsRange objects, const TickClock::duration duration)
+{
+	return tryWaitForAnyUntil(objects, TickClock::now() + duration + TickClock::duration{1});
+}
+
+std::pair<int, size_t> tryWaitForAnyUntil(const WaitableObjectsRange objects, const TickClock::time_point timePoint)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitForAnyImplementation(objects, false, &timePoint);
+}
+
+std::pair<int, size_t> waitForAny(const WaitableObjectsRange objects)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return waitForAnyImplementation(objects, false, nullptr);
+}
+
+}	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief DynamicThread class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -116,6 +116,26 @@ uint8_t DynamicThread::getPriority() const
 	return detachableThread_->getPriority();
 }
 
+TickClock::duration DynamicThread::getRoundRobinQuantum() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (detachableThread_ == nullptr)
+		return {};
+
+	return detachableThread_->getRoundRobinQuantum();
+}
+
+uint64_t DynamicThread::getRoundRobinRotationCount() const
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (detachableThread_ == nullptr)
+		return {};
+
+	return detachableThread_->getRoundRobinRotationCount();
+}
+
 SchedulingPolicy DynamicThread::getSchedulingPolicy() const
 {
 	const InterruptMaskingLock interruptMaskingLock;
@@ -192,6 +212,16 @@ void DynamicThread::setPriority(const uint8_t priority, const bool alwaysBehind)
 	detachableThread_->setPriority(priority, alwaysBehind);
 }
 
+int DynamicThread::setRoundRobinQuantum(const TickClock::duration quantum)
+{
+	const InterruptMaskingLock interruptMaskingLock;
+
+	if (detachableThread_ == nullptr)
+		return EINVAL;
+
+	return detachableThread_->setRoundRobinQuantum(quantum);
+}
+
 void DynamicThread::setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
 {
 	const InterruptMaskingLock interruptMaskingLock;
@@ -23,6 +23,12 @@
 
 #endif	// CONFIG_THREAD_DETACH_ENABLE == 1
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/HeapArena.hpp"
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 namespace distortos
 {
 
@@ -57,20 +63,12 @@ int DynamicThreadBase::detach()
 
 #if CONFIG_THREAD_DETACH_ENABLE == 1
 
-void DynamicThreadBase::exit0Hook()
-{
-	ThreadCommon::exit0Hook();
-
-	if (owner_ == nullptr)	// thread is detached?
-		getDeferredThreadDeleter().lock();	/// \todo error handling?
-}
-
 void DynamicThreadBase::exit1Hook()
 {
 	ThreadCommon::exit1Hook();
 
 	if (owner_ == nullptr)	// thread is detached?
-		getDeferredThreadDeleter()(getThreadControlBlock());	/// \todo error handling?
+		getDeferredThreadDeleter()(getThreadControlBlock());
 }
 
 #endif	// CONFIG_THREAD_DETACH_ENABLE == 1
@@ -81,6 +79,19 @@ void DynamicThreadBase::run()
 	boundFunction_ = {};
 }
 
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void DynamicThreadBase::setHeapArena(HeapArena* const heapArena)
+{
+	getThreadControlBlock().setHeapArenaControlBlock(heapArena != nullptr ? &heapArena->controlBlock_ : nullptr);
+}
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
 }	// namespace internal
 
 }	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief ThisThread namespace implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -77,6 +77,13 @@ uint8_t getPriority()
 	return internal::getScheduler().getCurrentThreadControlBlock().getPriority();
 }
 
+TickClock::duration getRoundRobinQuantum()
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return internal::getScheduler().getCurrentThreadControlBlock().getRoundRobinQuantum().getLength();
+}
+
 SchedulingPolicy getSchedulingPolicy()
 {
 	CHECK_FUNCTION_CONTEXT();
@@ -101,6 +108,13 @@ void setPriority(const uint8_t priority, const bool alwaysBehind)
 	internal::getScheduler().getCurrentThreadControlBlock().setPriority(priority, alwaysBehind);
 }
 
+int setRoundRobinQuantum(const TickClock::duration quantum)
+{
+	CHECK_FUNCTION_CONTEXT();
+
+	return internal::getScheduler().getCurrentThreadControlBlock().setRoundRobinQuantum(quantum);
+}
+
 void setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
 {
 	CHECK_FUNCTION_CONTEXT();
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadCommon class header
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -91,6 +91,16 @@ uint8_t ThreadCommon::getPriority() const
 	return getThreadControlBlock().getPriority();
 }
 
+TickClock::duration ThreadCommon::getRoundRobinQuantum() const
+{
+	return getThreadControlBlock().getRoundRobinQuantum().getLength();
+}
+
+uint64_t ThreadCommon::getRoundRobinRotationCount() const
+{
+	return getThreadControlBlock().getRoundRobinRotationCount();
+}
+
 SchedulingPolicy ThreadCommon::getSchedulingPolicy() const
 {
 	return getThreadControlBlock().getSchedulingPolicy();
@@ -142,6 +152,11 @@ void ThreadCommon::setPriority(const uint8_t priority, const bool alwaysBehind)
 	getThreadControlBlock().setPriority(priority, alwaysBehind);
 }
 
+int ThreadCommon::setRoundRobinQuantum(const TickClock::duration quantum)
+{
+	return getThreadControlBlock().setRoundRobinQuantum(quantum);
+}
+
 void ThreadCommon::setSchedulingPolicy(const SchedulingPolicy schedulingPolicy)
 {
 	getThreadControlBlock().setSchedulingPolicy(schedulingPolicy);
@@ -0,0 +1,197 @@
+/**
+ * \file
+ * \brief BarrierOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "BarrierOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/Barrier.hpp"
+#include "distortos/DynamicThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// number of test threads used in phase 3
+constexpr size_t phase3ThreadCount {3};
+
+/// number of barrier phases completed in phase 3
+constexpr size_t phase3PhaseCount {2};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Completion function which increments a counter.
+ *
+ * \param [in] argument is a pointer to counter (of size_t type) which will be incremented
+ */
+
+void incrementCounter(void* const argument)
+{
+	++*static_cast<size_t*>(argument);
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests barrier for single thread - each call to wait() must complete the phase immediately and execute the completion
+ * function.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	size_t counter {};
+	Barrier barrier {1, incrementCounter, &counter};
+
+	waitForNextTick();
+	const auto start = TickClock::now();
+
+	for (size_t i {}; i < 3; ++i)
+		if (barrier.wait() != 0 || counter != i + 1)
+			return false;
+
+	if (barrier.tryWaitFor(singleDuration) != 0 || barrier.tryWaitUntil(start + singleDuration) != 0 ||
+			counter != 5 || start != TickClock::now())
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests timeouts of tryWaitFor() and tryWaitUntil(). Arrival of the thread must be withdrawn after timeout, so the next
+ * attempt must also time-out and the completion function must never be executed.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	size_t counter {};
+	Barrier barrier {2, incrementCounter, &counter};
+
+	{
+		waitForNextTick();
+
+		const auto start = TickClock::now();
+		const auto ret = barrier.tryWaitFor(singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (ret != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1} || counter != 0)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// if previous arrival was not withdrawn, this call would complete the phase
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = barrier.tryWaitUntil(requestedTimePoint);
+		if (ret != ETIMEDOUT || requestedTimePoint != TickClock::now() || counter != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests multiple threads using the barrier for consecutive phases. Test threads have higher priority, so they arrive at
+ * the barrier first - main thread is always the last one, so it executes the completion function and releases all test
+ * threads. Completion function must be executed exactly once per phase.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	size_t counter {};
+	Barrier barrier {phase3ThreadCount + 1, incrementCounter, &counter};
+	int results[phase3ThreadCount][phase3PhaseCount] {};
+
+	const auto waitFunctor = [&barrier](int (&threadResults)[phase3PhaseCount])
+			{
+				for (auto& result : threadResults)
+					result = barrier.wait();
+			};
+
+	auto thread0 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[0]));
+	auto thread1 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[1]));
+	auto thread2 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[2]));
+
+	bool invalidState {};
+	for (size_t phase {}; phase < phase3PhaseCount; ++phase)
+	{
+		// all test threads have higher priority, so they are already blocked on the barrier
+		if (counter != phase)
+			invalidState = true;
+		if (barrier.wait() != 0)
+			invalidState = true;
+	}
+
+	thread0.join();
+	thread1.join();
+	thread2.join();
+
+	if (invalidState == true || counter != phase3PhaseCount)
+		return false;
+
+	for (const auto& threadResults : results)
+		for (const auto result : threadResults)
+			if (result != 0)
+				return false;
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool BarrierOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief BarrierOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BARRIER_BARRIEROPERATIONSTESTCASE_HPP_
+#define TEST_BARRIER_BARRIEROPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various barrier operations.
+ *
+ * Tests completion of phases with single and multiple threads, execution of completion function once per phase,
+ * reusing the barrier for consecutive phases and withdrawal of arrival when tryWaitFor() or tryWaitUntil() times out.
+ */
+
+class BarrierOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BARRIER_BARRIEROPERATIONSTESTCASE_HPP_
@@ -0,0 +1,34 @@
+/**
+ * \file
+ * \brief barrierTestCases object declaration
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BARRIER_BARRIERTESTCASES_HPP_
+#define TEST_BARRIER_BARRIERTESTCASES_HPP_
+
+namespace distortos
+{
+
+namespace test
+{
+
+class TestCaseGroup;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// group of test cases related to barriers
+extern const TestCaseGroup barrierTestCases;
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BARRIER_BARRIERTESTCASES_HPP_
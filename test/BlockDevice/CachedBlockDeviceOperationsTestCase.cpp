@@ -0,0 +1,383 @@
+/**
+ * \file
+ * \brief CachedBlockDeviceOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "CachedBlockDeviceOperationsTestCase.hpp"
+
+#include "distortos/devices/memory/RamBlockDevice.hpp"
+#include "distortos/devices/memory/StaticCachedBlockDevice.hpp"
+
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and number of bytes, as returned by read and program functions of block devices
+using Result = std::pair<int, size_t>;
+
+/// type of function executed by testWithCache()
+using TestFunction = bool(*)(devices::RamBlockDevice&, devices::CachedBlockDevice&);
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// read block size of RAM block device used in tests, bytes
+constexpr size_t readBlockSize {4};
+
+/// program block size of RAM block device used in tests, bytes
+constexpr size_t programBlockSize {readBlockSize * 2};
+
+/// erase block size of RAM block device used in tests, bytes
+constexpr size_t eraseBlockSize {programBlockSize * 4};
+
+/// size of RAM block device used in tests, bytes
+constexpr size_t deviceSize {eraseBlockSize * 8};
+
+/// number of lines of cache used in tests
+constexpr size_t linesCount {4};
+
+/// size of single line of cache used in tests, bytes
+constexpr size_t lineSize {eraseBlockSize / 2};
+
+/// test data
+constexpr uint8_t data[] {"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+		"zyxwvutsrqponmlkjihgfedcba9876543210"};
+
+static_assert(sizeof(data) > (linesCount + 1) * lineSize, "Test data is too short!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks statistics of cache.
+ *
+ * \param [in] cachedBlockDevice is a reference to checked device
+ * \param [in] expected are the expected statistics
+ *
+ * \return true if statistics of \a cachedBlockDevice are equal to \a expected, false otherwise
+ */
+
+bool checkStatistics(devices::CachedBlockDevice& cachedBlockDevice,
+		const devices::CachedBlockDevice::Statistics& expected)
+{
+	const auto statistics = cachedBlockDevice.getStatistics();
+	return statistics.evictions == expected.evictions && statistics.hits == expected.hits &&
+			statistics.misses == expected.misses && statistics.writeBacks == expected.writeBacks;
+}
+
+/**
+ * \brief Tests eviction of lines.
+ *
+ * All lines of cache are filled with separate reads, then the first line is read again. Reading of one more block
+ * requires eviction of one line - the line at \a retainedAddress must still be cached, while the line at
+ * \a evictedAddress must be read again from RAM block device.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ * \param [in] retainedAddress is the address of line which is expected to be retained
+ * \param [in] evictedAddress is the address of line which is expected to be evicted
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testEviction(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice,
+		const size_t retainedAddress, const size_t evictedAddress)
+{
+	if (ramBlockDevice.program(0, data, (linesCount + 1) * lineSize) != Result{0, (linesCount + 1) * lineSize})
+		return false;
+
+	ramBlockDevice.resetStatistics();
+
+	uint8_t buffer[lineSize];
+	for (size_t i {}; i < linesCount; ++i)
+		if (cachedBlockDevice.read(i * lineSize, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+				memcmp(buffer, data + i * lineSize, sizeof(buffer)) != 0)
+			return false;
+
+	if (cachedBlockDevice.read(0, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data, sizeof(buffer)) != 0)
+		return false;
+
+	// all lines are used, so one of them must be evicted
+	if (cachedBlockDevice.read(linesCount * lineSize, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data + linesCount * lineSize, sizeof(buffer)) != 0 ||
+			ramBlockDevice.getStatistics().reads != linesCount + 1)
+		return false;
+
+	if (cachedBlockDevice.read(retainedAddress, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data + retainedAddress, sizeof(buffer)) != 0 ||
+			ramBlockDevice.getStatistics().reads != linesCount + 1)
+		return false;
+
+	if (cachedBlockDevice.read(evictedAddress, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data + evictedAddress, sizeof(buffer)) != 0 ||
+			ramBlockDevice.getStatistics().reads != linesCount + 2)
+		return false;
+
+	return checkStatistics(cachedBlockDevice, {2, 2, linesCount + 2, 0});
+}
+
+/**
+ * \brief Tests eviction of lines with CLOCK policy.
+ *
+ * All lines were referenced when eviction is needed, so CLOCK hand makes a full turn and evicts the first line.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testClockEviction(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice)
+{
+	return testEviction(ramBlockDevice, cachedBlockDevice, lineSize, 0);
+}
+
+/**
+ * \brief Tests write-back during close.
+ *
+ * Dirty line must not be written back when the device is closed, but not for the last time. The last close must write
+ * back dirty line.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testClose(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice)
+{
+	if (cachedBlockDevice.open() != 0)
+		return false;
+
+	if (cachedBlockDevice.program(0, data, lineSize) != Result{0, lineSize} || cachedBlockDevice.close() != 0 ||
+			ramBlockDevice.getStatistics().programs != 0)
+		return false;
+
+	// last close
+	if (cachedBlockDevice.close() != 0 || ramBlockDevice.getStatistics().programs != 1)
+		return false;
+
+	uint8_t buffer[lineSize];
+	if (ramBlockDevice.read(0, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data, sizeof(buffer)) != 0)
+		return false;
+
+	return cachedBlockDevice.open() == 0;
+}
+
+/**
+ * \brief Tests coalescing of dirty lines during synchronization.
+ *
+ * Lines with consecutive blocks are programmed in random order, none of them may be written back before
+ * synchronization, which must write all of them with single program operation of RAM block device.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testCoalescing(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice)
+{
+	constexpr size_t indexes[] {3, 1, 2, 0};
+	static_assert(sizeof(indexes) / sizeof(*indexes) == linesCount, "Invalid number of indexes!");
+
+	for (const auto index : indexes)
+		if (cachedBlockDevice.program(index * lineSize, data + index * lineSize, lineSize) != Result{0, lineSize})
+			return false;
+
+	if (ramBlockDevice.getStatistics().programs != 0)
+		return false;
+
+	if (cachedBlockDevice.synchronize() != 0)
+		return false;
+
+	{
+		const auto statistics = ramBlockDevice.getStatistics();
+		if (statistics.programs != 1 || statistics.programmedBytes != linesCount * lineSize)
+			return false;
+	}
+
+	uint8_t buffer[linesCount * lineSize];
+	if (ramBlockDevice.read(0, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)} ||
+			memcmp(buffer, data, sizeof(buffer)) != 0)
+		return false;
+
+	// nothing is dirty, so next synchronization must not program anything
+	if (cachedBlockDevice.synchronize() != 0 || ramBlockDevice.getStatistics().programs != 1)
+		return false;
+
+	return checkStatistics(cachedBlockDevice, {0, 0, linesCount, 1});
+}
+
+/**
+ * \brief Tests discarding of dirty lines by erase.
+ *
+ * Dirty lines in erased range must be discarded without write-back, dirty line outside of this range must be written
+ * back during synchronization. Erased range must be read as erased.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testErase(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice)
+{
+	constexpr size_t eraseAddress {eraseBlockSize};
+
+	if (cachedBlockDevice.program(0, data, lineSize) != Result{0, lineSize} ||
+			cachedBlockDevice.program(eraseAddress, data, eraseBlockSize) != Result{0, eraseBlockSize})
+		return false;
+
+	if (cachedBlockDevice.erase(eraseAddress, eraseBlockSize) != 0 || cachedBlockDevice.synchronize() != 0)
+		return false;
+
+	{
+		const auto statistics = ramBlockDevice.getStatistics();
+		if (statistics.erases != 1 || statistics.programs != 1 || statistics.programmedBytes != lineSize)
+			return false;
+	}
+
+	uint8_t buffer[eraseBlockSize];
+	if (cachedBlockDevice.read(eraseAddress, buffer, sizeof(buffer)) != Result{0, sizeof(buffer)})
+		return false;
+	for (const auto value : buffer)
+		if (value != ramBlockDevice.getErasedValue().second)
+			return false;
+
+	if (ramBlockDevice.read(0, buffer, lineSize) != Result{0, lineSize} || memcmp(buffer, data, lineSize) != 0)
+		return false;
+
+	return checkStatistics(cachedBlockDevice, {0, 0, 1 + eraseBlockSize / lineSize * 2, 1});
+}
+
+/**
+ * \brief Tests eviction of lines with LRU policy.
+ *
+ * The first line was read again before eviction is needed, so the second line is the least recently used one.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a cachedBlockDevice
+ * \param [in] cachedBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testLruEviction(devices::RamBlockDevice& ramBlockDevice, devices::CachedBlockDevice& cachedBlockDevice)
+{
+	return testEviction(ramBlockDevice, cachedBlockDevice, 0, lineSize);
+}
+
+/**
+ * \brief Executes test function with CachedBlockDevice working on top of erased RamBlockDevice.
+ *
+ * \param [in] evictionPolicy is the eviction policy of cache
+ * \param [in] function is a reference to test function, it is called with both devices opened and with zeroed
+ * statistics of RAM block device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testWithCache(const devices::CachedBlockDevice::EvictionPolicy evictionPolicy, TestFunction function)
+{
+	uint8_t storage[deviceSize];
+	devices::RamBlockDevice ramBlockDevice {storage, sizeof(storage), readBlockSize, programBlockSize, eraseBlockSize};
+	if (ramBlockDevice.open() != 0)
+		return false;
+
+	bool ret {};
+	{
+		devices::StaticCachedBlockDevice<linesCount, lineSize> cachedBlockDevice {ramBlockDevice, evictionPolicy};
+		if (ramBlockDevice.erase(0, deviceSize) == 0 && cachedBlockDevice.open() == 0)
+		{
+			ramBlockDevice.resetStatistics();
+			ret = function(ramBlockDevice, cachedBlockDevice);
+			ret = cachedBlockDevice.close() == 0 && ret == true;
+		}
+	}
+
+	return ramBlockDevice.close() == 0 && ret == true;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests eviction of lines with LRU and CLOCK policies.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	return testWithCache(devices::CachedBlockDevice::EvictionPolicy::lru, testLruEviction) == true &&
+			testWithCache(devices::CachedBlockDevice::EvictionPolicy::clock, testClockEviction) == true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests coalescing of dirty lines and write-back during synchronization and close.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	return testWithCache(devices::CachedBlockDevice::EvictionPolicy::lru, testCoalescing) == true &&
+			testWithCache(devices::CachedBlockDevice::EvictionPolicy::lru, testClose) == true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests discarding of dirty lines by erase.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	return testWithCache(devices::CachedBlockDevice::EvictionPolicy::lru, testErase);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool CachedBlockDeviceOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief CachedBlockDeviceOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BLOCKDEVICE_CACHEDBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+#define TEST_BLOCKDEVICE_CACHEDBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various operations of CachedBlockDevice.
+ *
+ * Tests CachedBlockDevice working on top of RamBlockDevice - eviction of lines with LRU and CLOCK policies,
+ * coalescing of dirty lines into single program operation, write-back of dirty lines during synchronization and close
+ * and discarding of dirty lines by erase.
+ */
+
+class CachedBlockDeviceOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BLOCKDEVICE_CACHEDBLOCKDEVICEOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,288 @@
+/**
+ * \file
+ * \brief RamBlockDeviceOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "RamBlockDeviceOperationsTestCase.hpp"
+
+#include "distortos/devices/memory/RamBlockDevice.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and number of bytes, as returned by read and program functions of RamBlockDevice
+using Result = std::pair<int, size_t>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// read block size of device used in tests, bytes
+constexpr size_t readBlockSize {2};
+
+/// program block size of device used in tests, bytes
+constexpr size_t programBlockSize {readBlockSize * 2};
+
+/// erase block size of device used in tests, bytes
+constexpr size_t eraseBlockSize {programBlockSize * 4};
+
+/// size of device used in tests, bytes
+constexpr size_t deviceSize {eraseBlockSize * 4};
+
+/// value of erased bytes of device used in tests
+constexpr uint8_t erasedValue {0x5a};
+
+/// test data
+constexpr uint8_t data[] {"0123456789abcdefghijklmnopqrstuv"};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks statistics of RAM block device.
+ *
+ * \param [in] ramBlockDevice is a reference to checked device
+ * \param [in] expected are the expected statistics
+ *
+ * \return true if statistics of \a ramBlockDevice are equal to \a expected, false otherwise
+ */
+
+bool checkStatistics(devices::RamBlockDevice& ramBlockDevice, const devices::RamBlockDevice::Statistics& expected)
+{
+	const auto statistics = ramBlockDevice.getStatistics();
+	return statistics.erasedBytes == expected.erasedBytes && statistics.programmedBytes == expected.programmedBytes &&
+			statistics.readBytes == expected.readBytes && statistics.erases == expected.erases &&
+			statistics.programs == expected.programs && statistics.reads == expected.reads &&
+			statistics.trims == expected.trims;
+}
+
+/**
+ * \brief Tests validation of addresses and sizes.
+ *
+ * All operations with misaligned address or size must fail with EINVAL, all operations with range exceeding the size of
+ * device must fail with ENOSPC. None of them may be counted in statistics.
+ *
+ * \param [in] ramBlockDevice is a reference to tested device, must be opened
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testInvalidRanges(devices::RamBlockDevice& ramBlockDevice)
+{
+	uint8_t buffer[eraseBlockSize * 2];
+
+	if (ramBlockDevice.read(1, buffer, readBlockSize) != Result{EINVAL, 0} ||
+			ramBlockDevice.read(0, buffer, readBlockSize + 1) != Result{EINVAL, 0} ||
+			ramBlockDevice.read(0, nullptr, readBlockSize) != Result{EINVAL, 0} ||
+			ramBlockDevice.program(readBlockSize, data, programBlockSize) != Result{EINVAL, 0} ||
+			ramBlockDevice.program(0, data, readBlockSize) != Result{EINVAL, 0} ||
+			ramBlockDevice.program(0, nullptr, programBlockSize) != Result{EINVAL, 0} ||
+			ramBlockDevice.erase(programBlockSize, eraseBlockSize) != EINVAL ||
+			ramBlockDevice.erase(0, programBlockSize) != EINVAL ||
+			ramBlockDevice.trim(programBlockSize, eraseBlockSize) != EINVAL ||
+			ramBlockDevice.trim(0, programBlockSize) != EINVAL)
+		return false;
+
+	if (ramBlockDevice.read(deviceSize, buffer, readBlockSize) != Result{ENOSPC, 0} ||
+			ramBlockDevice.read(deviceSize - readBlockSize, buffer, readBlockSize * 2) != Result{ENOSPC, 0} ||
+			ramBlockDevice.program(deviceSize, data, programBlockSize) != Result{ENOSPC, 0} ||
+			ramBlockDevice.program(deviceSize - programBlockSize, data, programBlockSize * 2) != Result{ENOSPC, 0} ||
+			ramBlockDevice.erase(deviceSize, eraseBlockSize) != ENOSPC ||
+			ramBlockDevice.erase(deviceSize - eraseBlockSize, sizeof(buffer)) != ENOSPC ||
+			ramBlockDevice.trim(deviceSize, eraseBlockSize) != ENOSPC ||
+			ramBlockDevice.trim(deviceSize - eraseBlockSize, sizeof(buffer)) != ENOSPC)
+		return false;
+
+	return checkStatistics(ramBlockDevice, {});
+}
+
+/**
+ * \brief Tests emulation of flash memory and statistics.
+ *
+ * Programmed data must be read back, program of range which was not erased must fail with EIO without modifying the
+ * contents of device, erase must allow the range to be programmed again. Statistics must count all successful
+ * operations and bytes transferred by them.
+ *
+ * \param [in] ramBlockDevice is a reference to tested device, must be opened
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testOperations(devices::RamBlockDevice& ramBlockDevice)
+{
+	uint8_t buffer[deviceSize];
+
+	// whole device is erased, all bytes must be equal to erased value
+	if (ramBlockDevice.erase(0, deviceSize) != 0 || ramBlockDevice.read(0, buffer, deviceSize) != Result{0, deviceSize})
+		return false;
+	for (const auto value : buffer)
+		if (value != erasedValue)
+			return false;
+
+	if (checkStatistics(ramBlockDevice, {deviceSize, 0, deviceSize, 1, 0, 1, 0}) == false)
+		return false;
+
+	ramBlockDevice.resetStatistics();
+
+	constexpr size_t programAddress {programBlockSize};
+	constexpr size_t programSize {programBlockSize * 2};
+	if (ramBlockDevice.program(programAddress, data, programSize) != Result{0, programSize})
+		return false;
+
+	// only the programmed range may be modified
+	if (ramBlockDevice.read(0, buffer, eraseBlockSize) != Result{0, eraseBlockSize} ||
+			memcmp(buffer + programAddress, data, programSize) != 0 || buffer[programAddress - 1] != erasedValue ||
+			buffer[programAddress + programSize] != erasedValue)
+		return false;
+
+	// range overlapping with programmed data was not erased, so program must fail and not modify anything
+	if (ramBlockDevice.program(programAddress + programBlockSize, data + programSize, programSize) != Result{EIO, 0} ||
+			ramBlockDevice.read(0, buffer, eraseBlockSize) != Result{0, eraseBlockSize} ||
+			memcmp(buffer + programAddress, data, programSize) != 0 ||
+			buffer[programAddress + programSize] != erasedValue)
+		return false;
+
+	if (checkStatistics(ramBlockDevice, {0, programSize, eraseBlockSize * 2, 0, 1, 2, 0}) == false)
+		return false;
+
+	// after erase the same range can be programmed again
+	if (ramBlockDevice.erase(0, eraseBlockSize) != 0 ||
+			ramBlockDevice.program(programAddress, data + programSize, programSize) != Result{0, programSize} ||
+			ramBlockDevice.read(programAddress, buffer, programSize) != Result{0, programSize} ||
+			memcmp(buffer, data + programSize, programSize) != 0)
+		return false;
+
+	// trim must not modify the contents of device
+	if (ramBlockDevice.trim(0, eraseBlockSize) != 0 ||
+			ramBlockDevice.read(programAddress, buffer, programSize) != Result{0, programSize} ||
+			memcmp(buffer, data + programSize, programSize) != 0)
+		return false;
+
+	// operations with zero size succeed, but are not counted
+	if (ramBlockDevice.read(0, buffer, 0) != Result{0, 0} || ramBlockDevice.program(0, data, 0) != Result{0, 0} ||
+			ramBlockDevice.erase(0, 0) != 0)
+		return false;
+
+	return checkStatistics(ramBlockDevice,
+			{eraseBlockSize, programSize * 2, eraseBlockSize * 2 + programSize * 2, 1, 2, 4, 1});
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests operations on device which is not opened - all of them must fail with EBADF.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	uint8_t storage[deviceSize];
+	devices::RamBlockDevice ramBlockDevice {storage, sizeof(storage), readBlockSize, programBlockSize, eraseBlockSize,
+			erasedValue};
+	uint8_t buffer[eraseBlockSize];
+
+	// device was never opened
+	if (ramBlockDevice.close() != EBADF || ramBlockDevice.read(0, buffer, sizeof(buffer)) != Result{EBADF, 0} ||
+			ramBlockDevice.program(0, data, programBlockSize) != Result{EBADF, 0} ||
+			ramBlockDevice.erase(0, eraseBlockSize) != EBADF || ramBlockDevice.trim(0, eraseBlockSize) != EBADF ||
+			ramBlockDevice.synchronize() != EBADF)
+		return false;
+
+	if (ramBlockDevice.open() != 0 || ramBlockDevice.open() != 0 || ramBlockDevice.synchronize() != 0 ||
+			ramBlockDevice.close() != 0 || ramBlockDevice.synchronize() != 0 || ramBlockDevice.close() != 0)
+		return false;
+
+	// device was completely closed
+	if (ramBlockDevice.close() != EBADF || ramBlockDevice.read(0, buffer, sizeof(buffer)) != Result{EBADF, 0} ||
+			ramBlockDevice.program(0, data, programBlockSize) != Result{EBADF, 0} ||
+			ramBlockDevice.erase(0, eraseBlockSize) != EBADF || ramBlockDevice.trim(0, eraseBlockSize) != EBADF ||
+			ramBlockDevice.synchronize() != EBADF)
+		return false;
+
+	return checkStatistics(ramBlockDevice, {});
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests validation of addresses and sizes.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	uint8_t storage[deviceSize];
+	devices::RamBlockDevice ramBlockDevice {storage, sizeof(storage), readBlockSize, programBlockSize, eraseBlockSize,
+			erasedValue};
+
+	if (ramBlockDevice.open() != 0)
+		return false;
+
+	const auto ret = testInvalidRanges(ramBlockDevice);
+	return ramBlockDevice.close() == 0 && ret == true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests emulation of flash memory and statistics.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	uint8_t storage[deviceSize];
+	devices::RamBlockDevice ramBlockDevice {storage, sizeof(storage), readBlockSize, programBlockSize, eraseBlockSize,
+			erasedValue};
+
+	if (ramBlockDevice.open() != 0)
+		return false;
+
+	const auto ret = testOperations(ramBlockDevice);
+	return ramBlockDevice.close() == 0 && ret == true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool RamBlockDeviceOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
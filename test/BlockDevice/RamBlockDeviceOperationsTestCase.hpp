@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief RamBlockDeviceOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BLOCKDEVICE_RAMBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+#define TEST_BLOCKDEVICE_RAMBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various operations of RamBlockDevice.
+ *
+ * Tests rejection of operations on closed device, validation of addresses and sizes, emulation of flash memory (program
+ * of non-erased range must fail) and statistics of operations.
+ */
+
+class RamBlockDeviceOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BLOCKDEVICE_RAMBLOCKDEVICEOPERATIONSTESTCASE_HPP_
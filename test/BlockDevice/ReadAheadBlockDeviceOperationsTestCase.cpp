@@ -0,0 +1,388 @@
+/**
+ * \file
+ * \brief ReadAheadBlockDeviceOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ReadAheadBlockDeviceOperationsTestCase.hpp"
+
+#include "distortos/devices/memory/RamBlockDevice.hpp"
+#include "distortos/devices/memory/StaticReadAheadBlockDevice.hpp"
+
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and number of bytes, as returned by read and program functions of block devices
+using Result = std::pair<int, size_t>;
+
+/// type of function executed by testWithReadAhead()
+using TestFunction = bool(*)(devices::RamBlockDevice&, devices::ReadAheadBlockDevice&);
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// read block size of RAM block device used in tests, bytes
+constexpr size_t readBlockSize {4};
+
+/// erase block size of RAM block device used in tests, bytes
+constexpr size_t eraseBlockSize {readBlockSize * 4};
+
+/// size of RAM block device used in tests, bytes
+constexpr size_t deviceSize {eraseBlockSize * 16};
+
+/// size of buffer of read-ahead device used in tests, bytes
+constexpr size_t bufferSize {eraseBlockSize * 4};
+
+/// initial size of prefetch window of read-ahead device used in tests, bytes
+constexpr size_t initialWindowSize {bufferSize / 4};
+
+/// max size of single read executed in tests, bytes
+constexpr size_t maxReadSize {bufferSize};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks statistics of read-ahead.
+ *
+ * \param [in] readAheadBlockDevice is a reference to checked device
+ * \param [in] expected are the expected statistics
+ *
+ * \return true if statistics of \a readAheadBlockDevice are equal to \a expected, false otherwise
+ */
+
+bool checkStatistics(devices::ReadAheadBlockDevice& readAheadBlockDevice,
+		const devices::ReadAheadBlockDevice::Statistics& expected)
+{
+	const auto statistics = readAheadBlockDevice.getStatistics();
+	return statistics.hits == expected.hits && statistics.misses == expected.misses &&
+			statistics.prefetches == expected.prefetches;
+}
+
+/**
+ * \brief Reads data with read-ahead device and checks it.
+ *
+ * Read data must be equal to current contents of RAM block device and the number of bytes read from RAM block device
+ * must be equal to expected value.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ * \param [in] address is the address of data that will be read
+ * \param [in] size is the size of data that will be read, bytes
+ * \param [in] expectedReadBytes is the number of bytes which are expected to be read from \a ramBlockDevice
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testRead(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice,
+		const size_t address, const size_t size, const uint64_t expectedReadBytes)
+{
+	uint8_t buffer[maxReadSize];
+	if (size > sizeof(buffer))
+		return false;
+
+	const auto readBytes = ramBlockDevice.getStatistics().readBytes;
+	if (readAheadBlockDevice.read(address, buffer, size) != Result{0, size} ||
+			ramBlockDevice.getStatistics().readBytes - readBytes != expectedReadBytes)
+		return false;
+
+	uint8_t expectedBuffer[maxReadSize];
+	if (ramBlockDevice.read(address, expectedBuffer, size) != Result{0, size})
+		return false;
+
+	return memcmp(buffer, expectedBuffer, size) == 0;
+}
+
+/**
+ * \brief Tests bypass of large reads.
+ *
+ * Sequential read which is not smaller than the prefetch window must be read directly, without prefetch.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testBypass(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice)
+{
+	if (testRead(ramBlockDevice, readAheadBlockDevice, 0, readBlockSize, readBlockSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize, readBlockSize, initialWindowSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 2, initialWindowSize - readBlockSize,
+					0) == false)
+		return false;
+
+	// window is doubled, but the read is larger than it
+	constexpr size_t bypassAddress {readBlockSize + initialWindowSize};
+	if (testRead(ramBlockDevice, readAheadBlockDevice, bypassAddress, maxReadSize, maxReadSize) == false ||
+			checkStatistics(readAheadBlockDevice, {1, 3, 1}) == false)
+		return false;
+
+	// stream is still sequential, so the next read is prefetched with doubled window
+	return testRead(ramBlockDevice, readAheadBlockDevice, bypassAddress + maxReadSize, readBlockSize,
+			bufferSize) == true && checkStatistics(readAheadBlockDevice, {1, 4, 2}) == true;
+}
+
+/**
+ * \brief Tests limiting of prefetch at the end of device.
+ *
+ * Prefetch must not exceed the end of device, even if the window is larger than the remaining part of device.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testEndOfDevice(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice)
+{
+	constexpr size_t prefetchAddress {deviceSize - initialWindowSize - readBlockSize * 2};
+	if (testRead(ramBlockDevice, readAheadBlockDevice, prefetchAddress - readBlockSize, readBlockSize,
+			readBlockSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, prefetchAddress, readBlockSize, initialWindowSize) == false)
+		return false;
+
+	size_t address {prefetchAddress + readBlockSize};
+	for (; address < prefetchAddress + initialWindowSize; address += readBlockSize)
+		if (testRead(ramBlockDevice, readAheadBlockDevice, address, readBlockSize, 0) == false)
+			return false;
+
+	// window is doubled, but only the remaining part of device is prefetched
+	return testRead(ramBlockDevice, readAheadBlockDevice, address, readBlockSize, deviceSize - address) == true &&
+			testRead(ramBlockDevice, readAheadBlockDevice, address + readBlockSize, readBlockSize, 0) == true;
+}
+
+/**
+ * \brief Tests invalidation of the buffer.
+ *
+ * Erase, program and trim which overlap with the buffer must invalidate it, so that following read gets current data
+ * from RAM block device. Operations which don't overlap with the buffer must not invalidate it.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testInvalidation(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice)
+{
+	if (testRead(ramBlockDevice, readAheadBlockDevice, 0, readBlockSize, readBlockSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize, readBlockSize, initialWindowSize) == false)
+		return false;
+
+	if (readAheadBlockDevice.erase(0, eraseBlockSize) != 0 ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 2, readBlockSize,
+					initialWindowSize * 2) == false)
+		return false;
+
+	constexpr uint8_t data[readBlockSize * 2] {'0', '1', '2', '3', '4', '5', '6', '7'};
+	if (readAheadBlockDevice.program(readBlockSize * 2, data, sizeof(data)) != Result{0, sizeof(data)} ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 3, readBlockSize, bufferSize) == false)
+		return false;
+
+	if (readAheadBlockDevice.trim(eraseBlockSize, eraseBlockSize) != 0 ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 4, readBlockSize, bufferSize) == false)
+		return false;
+
+	// operations outside of the buffer
+	if (readAheadBlockDevice.erase(deviceSize - eraseBlockSize, eraseBlockSize) != 0 ||
+			readAheadBlockDevice.program(deviceSize - eraseBlockSize, data, sizeof(data)) != Result{0, sizeof(data)} ||
+			readAheadBlockDevice.trim(deviceSize - eraseBlockSize, eraseBlockSize) != 0)
+		return false;
+
+	return testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 5, readBlockSize, 0) == true &&
+			checkStatistics(readAheadBlockDevice, {1, 5, 4}) == true;
+}
+
+/**
+ * \brief Tests partial hits of the buffer.
+ *
+ * Read which starts in the buffer, but ends outside of it, must copy the first part from the buffer and prefetch the
+ * rest.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testPartialHit(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice)
+{
+	if (testRead(ramBlockDevice, readAheadBlockDevice, 0, readBlockSize, readBlockSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize, readBlockSize, initialWindowSize) == false ||
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize * 2, initialWindowSize - readBlockSize * 2,
+					0) == false)
+		return false;
+
+	// first half of the read is in the buffer, the second half is prefetched
+	if (testRead(ramBlockDevice, readAheadBlockDevice, initialWindowSize, readBlockSize * 2,
+			initialWindowSize * 2) == false)
+		return false;
+
+	return testRead(ramBlockDevice, readAheadBlockDevice, initialWindowSize + readBlockSize * 2, readBlockSize * 2,
+			0) == true && checkStatistics(readAheadBlockDevice, {2, 3, 2}) == true;
+}
+
+/**
+ * \brief Tests growth of prefetch window.
+ *
+ * Window must start at a quarter of the buffer and be doubled with each prefetch of a sequential stream, up to the size
+ * of the buffer. Reads from the prefetched range must be served from the buffer. Non-sequential read must reset the
+ * window.
+ *
+ * \param [in] ramBlockDevice is a reference to RAM block device associated with \a readAheadBlockDevice
+ * \param [in] readAheadBlockDevice is a reference to tested device
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testWindow(devices::RamBlockDevice& ramBlockDevice, devices::ReadAheadBlockDevice& readAheadBlockDevice)
+{
+	// first read is not sequential, so it is read directly
+	if (testRead(ramBlockDevice, readAheadBlockDevice, 0, readBlockSize, readBlockSize) == false)
+		return false;
+
+	constexpr size_t windowSizes[] {initialWindowSize, initialWindowSize * 2, bufferSize, bufferSize};
+	size_t address {readBlockSize};
+	size_t hits {};
+	for (const auto windowSize : windowSizes)
+	{
+		const auto end = address + windowSize;
+		if (testRead(ramBlockDevice, readAheadBlockDevice, address, readBlockSize, windowSize) == false)
+			return false;
+
+		for (address += readBlockSize; address < end; address += readBlockSize, ++hits)
+			if (testRead(ramBlockDevice, readAheadBlockDevice, address, readBlockSize, 0) == false)
+				return false;
+	}
+
+	constexpr size_t prefetches {sizeof(windowSizes) / sizeof(*windowSizes)};
+	if (checkStatistics(readAheadBlockDevice, {hits, prefetches + 1, prefetches}) == false)
+		return false;
+
+	// non-sequential read resets the window
+	return testRead(ramBlockDevice, readAheadBlockDevice, 0, readBlockSize, readBlockSize) == true &&
+			testRead(ramBlockDevice, readAheadBlockDevice, readBlockSize, readBlockSize, initialWindowSize) == true;
+}
+
+/**
+ * \brief Executes test function with ReadAheadBlockDevice working on top of RamBlockDevice.
+ *
+ * Each byte of RAM block device is equal to the lowest byte of its address.
+ *
+ * \param [in] function is a pointer to test function, it is called with both devices opened and with zeroed
+ * statistics
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testWithReadAhead(const TestFunction function)
+{
+	uint8_t storage[deviceSize];
+	devices::RamBlockDevice ramBlockDevice {storage, sizeof(storage), readBlockSize, readBlockSize, eraseBlockSize};
+	if (ramBlockDevice.open() != 0)
+		return false;
+
+	bool ret {ramBlockDevice.erase(0, deviceSize) == 0};
+	for (size_t address {}; ret == true && address < deviceSize; address += eraseBlockSize)
+	{
+		uint8_t buffer[eraseBlockSize];
+		for (size_t i {}; i < sizeof(buffer); ++i)
+			buffer[i] = static_cast<uint8_t>(address + i);
+		ret = ramBlockDevice.program(address, buffer, sizeof(buffer)) == Result{0, sizeof(buffer)};
+	}
+
+	if (ret == true)
+	{
+		devices::StaticReadAheadBlockDevice<bufferSize> readAheadBlockDevice {ramBlockDevice};
+		ret = readAheadBlockDevice.open() == 0;
+		if (ret == true)
+		{
+			ramBlockDevice.resetStatistics();
+			ret = function(ramBlockDevice, readAheadBlockDevice);
+			ret = readAheadBlockDevice.close() == 0 && ret == true;
+		}
+	}
+
+	return ramBlockDevice.close() == 0 && ret == true;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests growth and reset of prefetch window and partial hits of the buffer.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	return testWithReadAhead(testWindow) == true && testWithReadAhead(testPartialHit) == true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests bypass of large reads and limiting of prefetch at the end of device.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	return testWithReadAhead(testBypass) == true && testWithReadAhead(testEndOfDevice) == true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests invalidation of the buffer.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	return testWithReadAhead(testInvalidation);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ReadAheadBlockDeviceOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief ReadAheadBlockDeviceOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_BLOCKDEVICE_READAHEADBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+#define TEST_BLOCKDEVICE_READAHEADBLOCKDEVICEOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various operations of ReadAheadBlockDevice.
+ *
+ * Tests ReadAheadBlockDevice working on top of RamBlockDevice - growth of prefetch window for sequential reads and its
+ * reset by non-sequential read, partial hits of the buffer, bypass of large reads, limiting of prefetch at the end of
+ * device and invalidation of the buffer by program, erase and trim.
+ */
+
+class ReadAheadBlockDeviceOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_BLOCKDEVICE_READAHEADBLOCKDEVICEOPERATIONSTESTCASE_HPP_
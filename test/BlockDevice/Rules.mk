@@ -0,0 +1,22 @@
+#
+# file: Rules.mk
+#
+# author: Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+#
+# This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+# distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+
+#-----------------------------------------------------------------------------------------------------------------------
+# compilation flags
+#-----------------------------------------------------------------------------------------------------------------------
+
+CXXFLAGS_$(d) := $(CXXFLAGS_$(d)) -I$(d)
+CXXFLAGS_$(d) := $(CXXFLAGS_$(d)) -I$(DISTORTOS_PATH)test
+CXXFLAGS_$(d) := $(CXXFLAGS_$(d)) $(STANDARD_INCLUDES)
+
+#-----------------------------------------------------------------------------------------------------------------------
+# standard footer
+#-----------------------------------------------------------------------------------------------------------------------
+
+include $(DISTORTOS_PATH)footer.mk
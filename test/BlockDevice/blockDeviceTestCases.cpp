@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief blockDeviceTestCases object definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "blockDeviceTestCases.hpp"
+
+#include "CachedBlockDeviceOperationsTestCase.hpp"
+#include "RamBlockDeviceOperationsTestCase.hpp"
+#include "ReadAheadBlockDeviceOperationsTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// RamBlockDeviceOperationsTestCase instance
+const RamBlockDeviceOperationsTestCase ramBlockDeviceOperationsTestCase;
+
+/// CachedBlockDeviceOperationsTestCase instance
+const CachedBlockDeviceOperationsTestCase cachedBlockDeviceOperationsTestCase;
+
+/// ReadAheadBlockDeviceOperationsTestCase instance
+const ReadAheadBlockDeviceOperationsTestCase readAheadBlockDeviceOperationsTestCase;
+
+/// array with references to TestCase objects related to block devices
+const TestCaseGroup::Range::value_type blockDeviceTestCases_[]
+{
+		TestCaseGroup::Range::value_type{ramBlockDeviceOperationsTestCase},
+		TestCaseGroup::Range::value_type{cachedBlockDeviceOperationsTestCase},
+		TestCaseGroup::Range::value_type{readAheadBlockDeviceOperationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup blockDeviceTestCases {TestCaseGroup::Range{blockDeviceTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -2,7 +2,7 @@
  * \file
  * \brief CallOnceOperationsTestCase class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -155,7 +155,7 @@ bool CallOnceOperationsTestCase::run_() const
 
 	bool invalidState {};
 	for (size_t i = 1; i < threads.size(); ++i)
-		if (threads[i].getState() != ThreadState::blockedOnMutex)
+		if (threads[i].getState() != ThreadState::blockedOnOnceFlag)
 			invalidState = true;
 
 	for (auto& thread : threads)
@@ -0,0 +1,448 @@
+/**
+ * \file
+ * \brief EventFlagsOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "EventFlagsOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicThread.hpp"
+#include "distortos/EventFlags.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/statistics.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and value of event flags, as returned by EventFlags' wait functions
+using WaitResult = std::pair<int, EventFlags::Value>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// expected number of context switches in phase1 block involving tryWaitFor() or tryWaitUntil() (excluding
+/// waitForNextTick()): 1 - main thread blocks on event flags (main -> idle), 2 - main thread wakes up (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase1TryWaitForUntilContextSwitchCount {2};
+
+/// expected number of context switches in phase3 block involving test thread (excluding waitForNextTick()): 1 - test
+/// thread starts (main -> test), 2 - test thread goes to sleep (test -> main), 3 - main thread blocks on event flags
+/// (main -> idle), 4 - test thread wakes (idle -> test), 5 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase3ThreadContextSwitchCount {5};
+
+/// expected number of context switches in phase4 block involving software timer (excluding waitForNextTick()): 1 - main
+/// thread blocks on event flags (main -> idle), 2 - main thread is unblocked by interrupt (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase4SoftwareTimerContextSwitchCount {2};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tests EventFlags::tryWait() when wait condition is not satisfied - it must fail immediately and return EAGAIN
+ *
+ * \param [in] eventFlags is a reference to event flags that will be tested
+ * \param [in] bitmask is the bitmask of flags that will be waited for
+ * \param [in] mode is the mode of waiting
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testTryWaitWhenNotSatisfied(EventFlags& eventFlags, const EventFlags::Value bitmask,
+		const EventFlags::WaitMode mode)
+{
+	const auto value = eventFlags.get();
+	waitForNextTick();
+	const auto start = TickClock::now();
+	const auto ret = eventFlags.tryWait(bitmask, mode, true);
+	return ret == WaitResult{EAGAIN, value} && TickClock::now() == start && eventFlags.get() == value;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests whether all tryWait*() functions properly return some error when the wait condition is not satisfied or when
+ * the arguments are invalid.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	constexpr EventFlags::Value initialValue {0x0f};
+
+	EventFlags eventFlags {initialValue};
+
+	{
+		const auto ret = testTryWaitWhenNotSatisfied(eventFlags, 0xf0, EventFlags::WaitMode::any);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotSatisfied(eventFlags, 0x1f, EventFlags::WaitMode::all);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		// empty bitmask can never be satisfied, so it is rejected
+		const auto ret = eventFlags.tryWait(0, EventFlags::WaitMode::any);
+		if (ret != WaitResult{EINVAL, initialValue})
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// wait condition is not satisfied, so tryWaitFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = eventFlags.tryWaitFor(0x30, EventFlags::WaitMode::any, singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (ret != WaitResult{ETIMEDOUT, initialValue} || realDuration != singleDuration + decltype(singleDuration){1} ||
+				eventFlags.get() != initialValue ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase1TryWaitForUntilContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+
+		// wait condition is not satisfied, so tryWaitUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = eventFlags.tryWaitUntil(0xff, EventFlags::WaitMode::all, requestedTimePoint);
+		if (ret != WaitResult{ETIMEDOUT, initialValue} || requestedTimePoint != TickClock::now() ||
+				eventFlags.get() != initialValue ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase1TryWaitForUntilContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests whether all tryWait*() functions succeed immediately when the wait condition is satisfied, whether clearing on
+ * exit works and whether set() and clear() return previous value of event flags.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	EventFlags eventFlags {0x0f};
+
+	{
+		// "any" mode is satisfied by a single flag, value must not be modified
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = eventFlags.tryWait(0x18, EventFlags::WaitMode::any);
+		if (ret != WaitResult{0, 0x0f} || start != TickClock::now() || eventFlags.get() != 0x0f)
+			return false;
+	}
+
+	{
+		// "all" mode is satisfied, flags are cleared on exit
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = eventFlags.tryWaitFor(0x03, EventFlags::WaitMode::all, singleDuration, true);
+		if (ret != WaitResult{0, 0x0f} || start != TickClock::now() || eventFlags.get() != 0x0c)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotSatisfied(eventFlags, 0x03, EventFlags::WaitMode::any);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		// "any" mode is satisfied, only flags from bitmask are cleared on exit
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = eventFlags.tryWaitUntil(0x07, EventFlags::WaitMode::any, start + singleDuration, true);
+		if (ret != WaitResult{0, 0x0c} || start != TickClock::now() || eventFlags.get() != 0x08)
+			return false;
+	}
+
+	if (eventFlags.set(0x81) != 0x08 || eventFlags.get() != 0x89)
+		return false;
+
+	if (eventFlags.clear(0x09) != 0x89 || eventFlags.get() != 0x80)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests thread-thread signaling scenario. Main (current) thread waits for flags which are not set. Test thread sets the
+ * flags at specified time point, main thread is expected to be unblocked (with wait(), tryWaitFor() and tryWaitUntil())
+ * in the same moment and flags are expected to be cleared on exit.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	constexpr EventFlags::Value bitmask {0x50};
+
+	EventFlags eventFlags {0x01};
+
+	const auto sleepUntilFunctor = [&eventFlags](const TickClock::time_point timePoint)
+			{
+				ThisThread::sleepUntil(timePoint);
+				eventFlags.set(bitmask);
+			};
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, sleepUntilFunctor, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// flags are not set, but wait() should succeed at expected time
+		const auto ret = eventFlags.wait(bitmask, EventFlags::WaitMode::all, true);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 0x51} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != 0x01 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotSatisfied(eventFlags, bitmask, EventFlags::WaitMode::any);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, sleepUntilFunctor, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// flags are not set, but tryWaitFor() should succeed at expected time
+		const auto ret = eventFlags.tryWaitFor(bitmask, EventFlags::WaitMode::any,
+				wakeUpTimePoint - TickClock::now() + longDuration, true);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 0x51} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != 0x01 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	{
+		const auto ret = testTryWaitWhenNotSatisfied(eventFlags, bitmask, EventFlags::WaitMode::any);
+		if (ret != true)
+			return ret;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, sleepUntilFunctor, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// flags are not set, but tryWaitUntil() should succeed at expected time
+		const auto ret = eventFlags.tryWaitUntil(bitmask, EventFlags::WaitMode::all, wakeUpTimePoint + longDuration,
+				true);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 0x51} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != 0x01 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase3ThreadContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests interrupt-thread signaling scenario. Main (current) thread waits for flags which are not set. Software timer is
+ * used to set the flags at specified time point from interrupt context, main thread is expected to be unblocked (with
+ * wait(), tryWaitFor() and tryWaitUntil()) in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	constexpr EventFlags::Value bitmask {0x80000000};
+
+	EventFlags eventFlags {};
+	auto softwareTimer = makeStaticSoftwareTimer(&EventFlags::set, std::ref(eventFlags), bitmask);
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// flags are not set, but wait() should succeed at expected time
+		const auto ret = eventFlags.wait(bitmask, EventFlags::WaitMode::any, true);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (ret != WaitResult{0, bitmask} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase4SoftwareTimerContextSwitchCount)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// flags are not set, but tryWaitFor() should succeed at expected time
+		const auto ret = eventFlags.tryWaitFor(bitmask, EventFlags::WaitMode::all,
+				wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (ret != WaitResult{0, bitmask} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != bitmask ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase4SoftwareTimerContextSwitchCount)
+			return false;
+	}
+
+	eventFlags.clear(bitmask);
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// flags are not set, but tryWaitUntil() should succeed at expected time
+		const auto ret = eventFlags.tryWaitUntil(bitmask, EventFlags::WaitMode::any, wakeUpTimePoint + longDuration,
+				true);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (ret != WaitResult{0, bitmask} || wakeUpTimePoint != wokenUpTimePoint || eventFlags.get() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase4SoftwareTimerContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 5 of test case.
+ *
+ * Tests unblocking of multiple waiters with a single call to set(). All waiters satisfied by the same call must see the
+ * same value of flags and flags requested to be cleared on exit must be cleared only after all of them are unblocked.
+ * Waiters which are not satisfied must remain blocked.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase5()
+{
+	EventFlags eventFlags {};
+	WaitResult results[4] {};
+
+	const auto waitFunctor = [&eventFlags](WaitResult& result, const EventFlags::Value bitmask,
+			const EventFlags::WaitMode mode, const bool clearOnExit)
+			{
+				result = eventFlags.wait(bitmask, mode, clearOnExit);
+			};
+
+	auto thread0 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[0]),
+			0x01, EventFlags::WaitMode::any, true);
+	auto thread1 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[1]),
+			0x03, EventFlags::WaitMode::all, true);
+	auto thread2 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[2]),
+			0x04, EventFlags::WaitMode::any, false);
+	auto thread3 = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX}, waitFunctor, std::ref(results[3]),
+			0x08, EventFlags::WaitMode::any, false);
+
+	// all test threads have higher priority, so they are already blocked on event flags
+	eventFlags.set(0x07);
+	if (eventFlags.get() != 0x04)
+		return false;
+
+	thread0.join();
+	thread1.join();
+	thread2.join();
+
+	if (results[0] != WaitResult{0, 0x07} || results[1] != WaitResult{0, 0x07} || results[2] != WaitResult{0, 0x07} ||
+			results[3] != WaitResult{})
+		return false;
+
+	eventFlags.set(0x08);
+	thread3.join();
+
+	if (results[3] != WaitResult{0, 0x0c} || eventFlags.get() != 0x0c)
+		return false;
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool EventFlagsOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3, phase4, phase5})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,144 @@
+/**
+ * \file
+ * \brief HeapArenaTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "HeapArenaTestCase.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+#include "distortos/DynamicThread.hpp"
+#include "distortos/HeapArena.hpp"
+
+#include <memory>
+
+#include <cstdlib>
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of test arena, bytes
+constexpr size_t arenaSize {1024};
+
+/// size of block which fits in the arena, bytes
+constexpr size_t smallAllocationSize {100};
+
+/// size of block which doesn't fit in the arena, bytes
+constexpr size_t largeAllocationSize {arenaSize * 2};
+
+/// size of stack of test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Executes a function in a thread assigned to the arena and waits for it to finish.
+ *
+ * \tparam Function is the type of function
+ *
+ * \param [in] heapArena is a reference to arena
+ * \param [in] function is the function which will be executed
+ */
+
+template<typename Function>
+void runInArena(HeapArena& heapArena, Function function)
+{
+	DynamicThreadParameters parameters {testThreadStackSize, UINT8_MAX};
+	parameters.heapArena = &heapArena;
+	auto thread = makeAndStartDynamicThread(parameters, function);
+	thread.join();
+}
+
+}	// namespace
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool HeapArenaTestCase::run_() const
+{
+#if CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	// arena is allocated dynamically, as its control structure is too large for stack
+	const std::unique_ptr<HeapArena> heapArenaPointer {new HeapArena{arenaSize}};
+	auto& heapArena = *heapArenaPointer;
+	if (heapArena.getSize() != arenaSize || heapArena.isInitialized() != false || heapArena.getUsedSize() != 0)
+		return false;
+
+	// volatile prevents the compiler from optimizing out allocations
+	void* volatile memory {};
+	bool result {};
+
+	// allocation which fits is served from the arena, the other one - from the main heap
+	runInArena(heapArena,
+			[&heapArena, &memory, &result]()
+			{
+				memory = malloc(smallAllocationSize);
+				const auto usedSize = heapArena.getUsedSize();
+				void* volatile largeMemory {malloc(largeAllocationSize)};
+				result = memory != nullptr && heapArena.isInitialized() == true && usedSize >= smallAllocationSize &&
+						largeMemory != nullptr && heapArena.getUsedSize() == usedSize;
+				free(largeMemory);
+			});
+
+	if (result != true)
+	{
+		free(memory);
+		return false;
+	}
+
+	const auto usedSize = heapArena.getUsedSize();
+
+	// block freed by thread which is not assigned to the arena is only queued
+	free(memory);
+	if (heapArena.getUsedSize() != usedSize)
+		return false;
+
+	// queued block is returned to the arena during next allocation
+	result = {};
+	runInArena(heapArena,
+			[&heapArena, &result]()
+			{
+				void* volatile otherMemory {malloc(smallAllocationSize / 2)};
+				result = otherMemory != nullptr && heapArena.getUsedSize() < smallAllocationSize;
+				free(otherMemory);
+				result = result == true && heapArena.getUsedSize() == 0;
+			});
+
+	if (result != true)
+		return false;
+
+#endif	// CONFIG_HEAP_ARENAS_ENABLE == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
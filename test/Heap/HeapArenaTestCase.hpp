@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief HeapArenaTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_HEAP_HEAPARENATESTCASE_HPP_
+#define TEST_HEAP_HEAPARENATESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests heap arenas.
+ *
+ * Tests whether allocations of threads assigned to HeapArena are served from the arena, whether allocations which don't
+ * fit in the arena are served from the main heap and whether blocks freed by other threads are returned to the arena.
+ */
+
+class HeapArenaTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_HEAP_HEAPARENATESTCASE_HPP_
@@ -0,0 +1,148 @@
+/**
+ * \file
+ * \brief HeapStatisticsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "HeapStatisticsTestCase.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+#include "distortos/HeapStatistics.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cstdlib>
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of allocated block, bytes
+constexpr size_t allocationSize {100};
+
+/// size of allocation which must fail, bytes
+constexpr size_t failedAllocationSize {SIZE_MAX / 2};
+
+}	// namespace
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool HeapStatisticsTestCase::run_() const
+{
+#if CONFIG_TLSF_HEAP_ENABLE == 1
+
+	// volatile prevents the compiler from optimizing out allocations
+	void* volatile memory {};
+
+	HeapStatistics::reset();
+	const auto initialSnapshot = HeapStatistics::getSnapshot();
+	if (initialSnapshot.allocationCount != 0 || initialSnapshot.failedAllocationCount != 0 ||
+			initialSnapshot.freeCount != 0 || initialSnapshot.maxUsedSize != initialSnapshot.usedSize)
+		return false;
+
+	memory = malloc(failedAllocationSize);
+	if (memory != nullptr)
+	{
+		free(memory);
+		return false;
+	}
+
+	memory = malloc(allocationSize);
+	if (memory == nullptr)
+		return false;
+
+	{
+		const auto snapshot = HeapStatistics::getSnapshot();
+		if (snapshot.allocationCount != 1 || snapshot.failedAllocationCount != 1 || snapshot.freeCount != 0 ||
+				snapshot.size == 0 || snapshot.usedSize < initialSnapshot.usedSize + allocationSize ||
+				snapshot.maxUsedSize != snapshot.usedSize || snapshot.freeSize >= snapshot.size ||
+				snapshot.largestFreeBlockSize > snapshot.freeSize || snapshot.fragmentation > 1000 ||
+				(snapshot.freeBlockCount == 0) != (snapshot.freeSize == 0))
+		{
+			free(memory);
+			return false;
+		}
+	}
+
+	free(memory);
+
+	{
+		const auto snapshot = HeapStatistics::getSnapshot();
+		if (snapshot.allocationCount != 1 || snapshot.failedAllocationCount != 1 || snapshot.freeCount != 1 ||
+				snapshot.usedSize != initialSnapshot.usedSize ||
+				snapshot.maxUsedSize < initialSnapshot.usedSize + allocationSize)
+			return false;
+	}
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+	if (HeapStatistics::getTraceCount() != 3)
+		return false;
+
+	HeapStatistics::TraceEntry trace[4];
+	if (HeapStatistics::getTrace(trace, sizeof(trace) / sizeof(*trace)) != 3)
+		return false;
+
+	const auto identifier = ThisThread::getIdentifier();
+	for (size_t i {}; i < 3; ++i)
+		if (trace[i].thread != identifier || trace[i].returnAddress == nullptr)
+			return false;
+
+	if (trace[0].operation != HeapStatistics::Operation::allocation || trace[0].memory != nullptr ||
+			trace[0].size != failedAllocationSize)
+		return false;
+	if (trace[1].operation != HeapStatistics::Operation::allocation || trace[1].memory != memory ||
+			trace[1].size != allocationSize)
+		return false;
+	if (trace[2].operation != HeapStatistics::Operation::deallocation || trace[2].memory != memory)
+		return false;
+
+	// only the most recent entries are returned when the array is too small
+	if (HeapStatistics::getTrace(trace, 1) != 1 || trace[0].operation != HeapStatistics::Operation::deallocation)
+		return false;
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+	HeapStatistics::reset();
+	if (HeapStatistics::getSnapshot().allocationCount != 0)
+		return false;
+
+#if CONFIG_HEAP_TRACE_ENABLE == 1
+
+	if (HeapStatistics::getTraceCount() != 0)
+		return false;
+
+#endif	// CONFIG_HEAP_TRACE_ENABLE == 1
+
+#endif	// CONFIG_TLSF_HEAP_ENABLE == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief HeapStatisticsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_HEAP_HEAPSTATISTICSTESTCASE_HPP_
+#define TEST_HEAP_HEAPSTATISTICSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests statistics of the heap.
+ *
+ * Tests whether allocations and deallocations are reflected in HeapStatistics - in counters, in current and maximal
+ * usage of the heap and (if enabled) in the trace.
+ */
+
+class HeapStatisticsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_HEAP_HEAPSTATISTICSTESTCASE_HPP_
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief heapTestCases object definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "heapTestCases.hpp"
+
+#include "HeapArenaTestCase.hpp"
+#include "HeapStatisticsTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// HeapArenaTestCase instance
+const HeapArenaTestCase arenaTestCase;
+
+/// HeapStatisticsTestCase instance
+const HeapStatisticsTestCase statisticsTestCase;
+
+/// array with references to TestCase objects related to heap
+const TestCaseGroup::Range::value_type heapTestCases_[]
+{
+		TestCaseGroup::Range::value_type{statisticsTestCase},
+		TestCaseGroup::Range::value_type{arenaTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup heapTestCases {TestCaseGroup::Range{heapTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,346 @@
+/**
+ * \file
+ * \brief MemoryPoolOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "MemoryPoolOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicMemoryPool.hpp"
+#include "distortos/DynamicThread.hpp"
+#include "distortos/StaticMemoryPool.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// number of blocks in pools used in tests
+constexpr size_t poolBlocks {4};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of objects stored in static pool
+struct Frame
+{
+	/// some data
+	uint32_t data[3];
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tests non-blocking operations with given pool.
+ *
+ * All blocks are allocated with tryAllocate(), which must return distinct, properly aligned blocks, then allocation
+ * from empty pool must fail, freeing of invalid pointers must fail and statistics must be valid.
+ *
+ * \param [in] memoryPool is a reference to tested pool, all blocks must be free
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testNonBlocking(MemoryPool& memoryPool)
+{
+	if (memoryPool.getBlocks() != poolBlocks || memoryPool.getFreeBlocks() != poolBlocks ||
+			memoryPool.getBlockSize() % MemoryPool::alignment != 0)
+		return false;
+
+	void* blocks[poolBlocks] {};
+	for (size_t i {}; i < poolBlocks; ++i)
+	{
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != 0 || ret.second == nullptr ||
+				reinterpret_cast<uintptr_t>(ret.second) % MemoryPool::alignment != 0)
+			return false;
+		for (size_t j {}; j < i; ++j)
+			if (blocks[j] == ret.second)
+				return false;
+
+		blocks[i] = ret.second;
+		memset(blocks[i], 0xa5, memoryPool.getBlockSize());	// whole block must be usable
+	}
+
+	if (memoryPool.getFreeBlocks() != 0 || memoryPool.getMaxUsedBlocks() != poolBlocks)
+		return false;
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != EAGAIN || start != TickClock::now())
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// pool is empty, so tryAllocateFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = memoryPool.tryAllocateFor(singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (ret.first != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1})
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// pool is empty, so tryAllocateUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = memoryPool.tryAllocateUntil(requestedTimePoint);
+		if (ret.first != ETIMEDOUT || requestedTimePoint != TickClock::now())
+			return false;
+	}
+
+	// pointers which are not the beginning of any block
+	if (memoryPool.free(nullptr) != EINVAL || memoryPool.free(static_cast<uint8_t*>(blocks[0]) + 1) != EINVAL ||
+			memoryPool.free(static_cast<uint8_t*>(blocks[poolBlocks - 1]) + memoryPool.getBlockSize()) != EINVAL)
+		return false;
+
+	for (const auto block : blocks)
+		if (memoryPool.free(block) != 0)
+			return false;
+
+	if (memoryPool.getFreeBlocks() != poolBlocks || memoryPool.getMaxUsedBlocks() != poolBlocks)
+		return false;
+
+	// the most recently freed block is allocated first
+	{
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != 0 || ret.second != blocks[poolBlocks - 1] || memoryPool.free(ret.second) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests non-blocking operations with StaticMemoryPool and DynamicMemoryPool.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	{
+		StaticMemoryPool<Frame, poolBlocks> memoryPool;
+		if (memoryPool.getBlockSize() < sizeof(Frame) || testNonBlocking(memoryPool) != true)
+			return false;
+	}
+
+	{
+		DynamicMemoryPool memoryPool {1, poolBlocks};
+		if (memoryPool.getBlockSize() != MemoryPool::alignment || testNonBlocking(memoryPool) != true)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests thread-thread scenario. Main (current) thread tries to allocate a block from empty pool. Test thread frees one
+ * block at specified time point, main thread is expected to be unblocked (with allocate(), tryAllocateFor() and
+ * tryAllocateUntil()) in the same moment and to get exactly this block.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	StaticMemoryPool<Frame, poolBlocks> memoryPool;
+	void* blocks[poolBlocks] {};
+	for (auto& block : blocks)
+	{
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != 0)
+			return false;
+		block = ret.second;
+	}
+
+	using AllocateFunction = std::pair<int, void*>(*)(MemoryPool&, TickClock::time_point);
+	const AllocateFunction allocateFunctions[]
+	{
+			[](MemoryPool& pool, TickClock::time_point)
+			{
+				return pool.allocate();
+			},
+			[](MemoryPool& pool, const TickClock::time_point timePoint)
+			{
+				return pool.tryAllocateFor(timePoint - TickClock::now() + longDuration);
+			},
+			[](MemoryPool& pool, const TickClock::time_point timePoint)
+			{
+				return pool.tryAllocateUntil(timePoint + longDuration);
+			},
+	};
+
+	for (size_t i {}; i < sizeof(allocateFunctions) / sizeof(*allocateFunctions); ++i)
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&memoryPool](const TickClock::time_point timePoint, void* const block)
+				{
+					ThisThread::sleepUntil(timePoint);
+					memoryPool.free(block);
+				}, wakeUpTimePoint, blocks[i]);
+
+		ThisThread::yield();
+
+		// pool is empty, but allocation should succeed at expected time
+		const auto ret = allocateFunctions[i](memoryPool, wakeUpTimePoint);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret.first != 0 || ret.second != blocks[i] || wakeUpTimePoint != wokenUpTimePoint ||
+				memoryPool.getFreeBlocks() != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread scenario. Main (current) thread tries to allocate a block from empty pool. Software timer is
+ * used to free one block at specified time point from interrupt context, main thread is expected to be unblocked in the
+ * same moment and to get exactly this block.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	DynamicMemoryPool memoryPool {sizeof(Frame), 1};
+	const auto block = memoryPool.tryAllocate();
+	if (block.first != 0)
+		return false;
+
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&memoryPool, &block]()
+			{
+				memoryPool.free(block.second);
+			});
+
+	waitForNextTick();
+
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	// pool is empty, but allocate() should succeed at expected time
+	const auto ret = memoryPool.allocate();
+	const auto wokenUpTimePoint = TickClock::now();
+	if (ret != block || wakeUpTimePoint != wokenUpTimePoint)
+		return false;
+
+	return memoryPool.free(ret.second) == 0 && memoryPool.getFreeBlocks() == 1;
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests freeing of a block into a full pool. Such operation must fail with EOVERFLOW without modifying the pool - all
+ * blocks must be allocated afterwards, each of them exactly once.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	StaticMemoryPool<Frame, poolBlocks> memoryPool;
+
+	void* freedBlock;
+	{
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != 0 || memoryPool.free(ret.second) != 0)
+			return false;
+		freedBlock = ret.second;
+	}
+
+	// block is freed for the second time
+	if (memoryPool.free(freedBlock) != EOVERFLOW || memoryPool.getFreeBlocks() != poolBlocks)
+		return false;
+
+	void* blocks[poolBlocks] {};
+	for (size_t i {}; i < poolBlocks; ++i)
+	{
+		const auto ret = memoryPool.tryAllocate();
+		if (ret.first != 0)
+			return false;
+		for (size_t j {}; j < i; ++j)
+			if (blocks[j] == ret.second)
+				return false;
+
+		blocks[i] = ret.second;
+	}
+
+	if (memoryPool.tryAllocate().first != EAGAIN)
+		return false;
+
+	for (const auto block : blocks)
+		if (memoryPool.free(block) != 0)
+			return false;
+
+	return memoryPool.getFreeBlocks() == poolBlocks;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool MemoryPoolOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3, phase4})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
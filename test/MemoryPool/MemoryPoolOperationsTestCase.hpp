@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief MemoryPoolOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_MEMORYPOOL_MEMORYPOOLOPERATIONSTESTCASE_HPP_
+#define TEST_MEMORYPOOL_MEMORYPOOLOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various memory pool operations.
+ *
+ * Tests allocation (allocate(), tryAllocate(), tryAllocateFor() and tryAllocateUntil()) and freeing of blocks in
+ * StaticMemoryPool and DynamicMemoryPool, validation of freed pointers, statistics and unblocking of thread waiting for
+ * a free block by another thread and by interrupt.
+ */
+
+class MemoryPoolOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_MEMORYPOOL_MEMORYPOOLOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,273 @@
+/**
+ * \file
+ * \brief MessageBufferOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "MessageBufferOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicMessageBuffer.hpp"
+#include "distortos/DynamicThread.hpp"
+#include "distortos/StaticMessageBuffer.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// size of message buffers used in tests, bytes
+constexpr size_t bufferSize {4 * sizeof(MessageBuffer::Length) + 24};
+
+/// test message
+constexpr char message[] {"0123456789abcdefghij"};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Receives message with tryReceive() and checks whether it is equal to expected one.
+ *
+ * \param [in] messageBuffer is a reference to message buffer from which the message will be received
+ * \param [in] expected is a pointer to expected message
+ * \param [in] size is the size of expected message, bytes
+ *
+ * \return true if expected message was received, false otherwise
+ */
+
+bool receiveAndCheck(MessageBuffer& messageBuffer, const void* const expected, const size_t size)
+{
+	char buffer[sizeof(message)] {};
+	const auto ret = messageBuffer.tryReceive(buffer, sizeof(buffer));
+	return ret.first == 0 && ret.second == size && memcmp(buffer, expected, size) == 0;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests non-blocking operations - sending and receiving of messages of variable size (including empty message and
+ * messages which wrap around the end of storage), order of messages, errors for full and empty buffer and for messages
+ * that are too large.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	StaticMessageBuffer<bufferSize> messageBuffer;
+	if (messageBuffer.getCapacity() != bufferSize ||
+			messageBuffer.getMaxMessageSize() != bufferSize - sizeof(MessageBuffer::Length))
+		return false;
+
+	if (messageBuffer.tryReceive(nullptr, 0).first != EAGAIN)
+		return false;
+
+	if (messageBuffer.trySend(message, messageBuffer.getMaxMessageSize() + 1) != EMSGSIZE)
+		return false;
+
+	// fill the buffer with 3 messages of different size - 0, 5 and 10 bytes, which leaves space for 9 bytes of data
+	for (const auto size : {0, 5, 10})
+		if (messageBuffer.trySend(message, size) != 0)
+			return false;
+
+	if (messageBuffer.trySend(message, 10) != EAGAIN)
+		return false;
+
+	{
+		waitForNextTick();
+
+		// buffer is full, so trySendFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = messageBuffer.trySendFor(singleDuration, message, 10);
+		const auto realDuration = TickClock::now() - start;
+		if (ret != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1})
+			return false;
+	}
+
+	if (messageBuffer.trySend(message + 1, 9) != 0)
+		return false;
+
+	if (receiveAndCheck(messageBuffer, message, 0) != true)
+		return false;
+
+	// message is not removed from the buffer if the buffer for it is too small
+	{
+		char buffer[4] {};
+		const auto ret = messageBuffer.tryReceive(buffer, sizeof(buffer));
+		if (ret.first != EMSGSIZE || ret.second != 5)
+			return false;
+	}
+
+	if (receiveAndCheck(messageBuffer, message, 5) != true || receiveAndCheck(messageBuffer, message, 10) != true)
+		return false;
+
+	// this message wraps around the end of storage
+	if (messageBuffer.trySend(message + 2, 18) != 0)
+		return false;
+
+	if (receiveAndCheck(messageBuffer, message + 1, 9) != true ||
+			receiveAndCheck(messageBuffer, message + 2, 18) != true)
+		return false;
+
+	{
+		waitForNextTick();
+
+		// buffer is empty, so tryReceiveUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = messageBuffer.tryReceiveUntil(requestedTimePoint, nullptr, 0);
+		if (ret.first != ETIMEDOUT || requestedTimePoint != TickClock::now())
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests thread-thread scenario. Main (current) thread waits for a message in empty buffer and then for free space in
+ * full buffer. Test thread sends/receives a message at specified time point, main thread is expected to be unblocked in
+ * the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	DynamicMessageBuffer messageBuffer {bufferSize};
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&messageBuffer](const TickClock::time_point timePoint)
+				{
+					ThisThread::sleepUntil(timePoint);
+					messageBuffer.trySend(message, 7);
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// buffer is empty, but receive() should succeed at expected time
+		char buffer[sizeof(message)] {};
+		const auto ret = messageBuffer.receive(buffer, sizeof(buffer));
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret.first != 0 || ret.second != 7 || memcmp(buffer, message, 7) != 0 ||
+				wakeUpTimePoint != wokenUpTimePoint)
+			return false;
+	}
+
+	// fill the buffer completely with a single message
+	if (messageBuffer.trySend(message, messageBuffer.getMaxMessageSize()) != 0)
+		return false;
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&messageBuffer](const TickClock::time_point timePoint)
+				{
+					ThisThread::sleepUntil(timePoint);
+					char buffer[bufferSize] {};
+					messageBuffer.tryReceive(buffer, sizeof(buffer));
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// buffer is full, but trySendUntil() should succeed at expected time
+		const auto ret = messageBuffer.trySendUntil(wakeUpTimePoint + longDuration, message, 3);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || receiveAndCheck(messageBuffer, message, 3) != true)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread scenario. Main (current) thread waits for a message in empty buffer. Software timer is used to
+ * send a message at specified time point from interrupt context, main thread is expected to be unblocked in the same
+ * moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	StaticMessageBuffer<bufferSize> messageBuffer;
+
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&messageBuffer]()
+			{
+				messageBuffer.trySend(message, 11);
+			});
+
+	waitForNextTick();
+
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	// buffer is empty, but tryReceiveFor() should succeed at expected time
+	char buffer[sizeof(message)] {};
+	const auto ret = messageBuffer.tryReceiveFor(longDuration * 2, buffer, sizeof(buffer));
+	const auto wokenUpTimePoint = TickClock::now();
+	return ret.first == 0 && ret.second == 11 && memcmp(buffer, message, 11) == 0 &&
+			wakeUpTimePoint == wokenUpTimePoint;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool MessageBufferOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
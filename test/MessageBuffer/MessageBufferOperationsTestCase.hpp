@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief MessageBufferOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_MESSAGEBUFFER_MESSAGEBUFFEROPERATIONSTESTCASE_HPP_
+#define TEST_MESSAGEBUFFER_MESSAGEBUFFEROPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * rief Tests various message buffer operations.
+ *
+ * Tests sending (send(), trySend(), trySendFor() and trySendUntil()) and receiving (receive(), tryReceive(),
+ * tryReceiveFor() and tryReceiveUntil()) of messages of variable size, including messages which wrap around the end of
+ * storage, and unblocking of threads waiting for a message or for free space by another thread and by interrupt.
+ */
+
+class MessageBufferOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_MESSAGEBUFFER_MESSAGEBUFFEROPERATIONSTESTCASE_HPP_
@@ -0,0 +1,333 @@
+/**
+ * \file
+ * \brief StreamBufferOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "StreamBufferOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicStreamBuffer.hpp"
+#include "distortos/DynamicThread.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/StaticStreamBuffer.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and number of bytes, as returned by read and write functions of StreamBuffer
+using Result = std::pair<int, size_t>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// size of stream buffers used in tests, bytes
+constexpr size_t bufferSize {16};
+
+/// test data
+constexpr char data[] {"0123456789abcdefghijklmnopqrstuv"};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests non-blocking operations - writing and reading with wrap-around, partial writes to almost full buffer, errors
+ * for full and empty buffer, zero-copy writing with reserve() and commit(), and setting of trigger level.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	StaticStreamBuffer<bufferSize> streamBuffer;
+	if (streamBuffer.getCapacity() != bufferSize || streamBuffer.getTriggerLevel() != 1)
+		return false;
+
+	char buffer[bufferSize] {};
+	if (streamBuffer.tryRead(buffer, sizeof(buffer)).first != EAGAIN)
+		return false;
+
+	if (streamBuffer.tryWrite(data, 10) != Result{0, 10})
+		return false;
+
+	if (streamBuffer.tryRead(buffer, 6) != Result{0, 6} || memcmp(buffer, data, 6) != 0)
+		return false;
+
+	// only 12 bytes fit, data wraps around the end of storage
+	if (streamBuffer.tryWrite(data + 10, 20) != Result{0, 12} || streamBuffer.getSize() != bufferSize)
+		return false;
+
+	if (streamBuffer.tryWrite(data, 1).first != EAGAIN)
+		return false;
+
+	{
+		waitForNextTick();
+
+		// buffer is full, so tryWriteFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = streamBuffer.tryWriteFor(singleDuration, data, 1);
+		const auto realDuration = TickClock::now() - start;
+		if (ret != Result{ETIMEDOUT, 0} || realDuration != singleDuration + decltype(singleDuration){1})
+			return false;
+	}
+
+	if (streamBuffer.tryRead(buffer, sizeof(buffer)) != Result{0, bufferSize} || memcmp(buffer, data + 6, 16) != 0)
+		return false;
+
+	// zero-copy writing
+	{
+		const auto block = streamBuffer.reserve();
+		if (block.first == nullptr || block.second == 0 || block.second > bufferSize)
+			return false;
+		if (streamBuffer.commit(block.second + 1) != EINVAL)
+			return false;
+		memcpy(block.first, data, 1);
+		if (streamBuffer.commit(1) != 0)
+			return false;
+	}
+
+	if (streamBuffer.tryRead(buffer, sizeof(buffer)) != Result{0, 1} || buffer[0] != data[0])
+		return false;
+
+	if (streamBuffer.setTriggerLevel(0) != EINVAL || streamBuffer.setTriggerLevel(bufferSize + 1) != EINVAL ||
+			streamBuffer.setTriggerLevel(4) != 0 || streamBuffer.getTriggerLevel() != 4)
+		return false;
+
+	if (streamBuffer.tryWrite(data, 2) != Result{0, 2})
+		return false;
+
+	{
+		waitForNextTick();
+
+		// trigger level is not reached, so tryReadUntil() should time-out at exact expected time and return all
+		// available data
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = streamBuffer.tryReadUntil(requestedTimePoint, buffer, sizeof(buffer));
+		if (ret != Result{0, 2} || memcmp(buffer, data, 2) != 0 || requestedTimePoint != TickClock::now())
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// buffer is empty, so tryReadFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = streamBuffer.tryReadFor(singleDuration, buffer, sizeof(buffer));
+		const auto realDuration = TickClock::now() - start;
+		if (ret != Result{ETIMEDOUT, 0} || realDuration != singleDuration + decltype(singleDuration){1})
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests thread-thread scenario with trigger level. Main (current) thread reads from empty buffer. Test thread writes
+ * data in single bytes, the last byte - required to reach the trigger level - is written at specified time point. Main
+ * thread is expected to be unblocked in the same moment. Then main thread writes more data than the buffer can hold and
+ * test thread reads it at specified time point, main thread is expected to finish writing in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	constexpr size_t triggerLevel {4};
+	DynamicStreamBuffer streamBuffer {bufferSize, triggerLevel};
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&streamBuffer](const TickClock::time_point timePoint)
+				{
+					for (size_t i {}; i < triggerLevel - 1; ++i)
+					{
+						streamBuffer.tryWrite(data + i, 1);
+						ThisThread::sleepFor(singleDuration);
+					}
+					ThisThread::sleepUntil(timePoint);
+					streamBuffer.tryWrite(data + triggerLevel - 1, 1);
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// buffer is empty, but read() should succeed at expected time
+		char buffer[bufferSize] {};
+		const auto ret = streamBuffer.read(buffer, sizeof(buffer));
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != Result{0, triggerLevel} || memcmp(buffer, data, triggerLevel) != 0 ||
+				wakeUpTimePoint != wokenUpTimePoint)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&streamBuffer](const TickClock::time_point timePoint)
+				{
+					ThisThread::sleepUntil(timePoint);
+					char buffer[bufferSize] {};
+					streamBuffer.tryRead(buffer, sizeof(buffer));
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// only bufferSize bytes fit, but write() should finish at expected time
+		const auto ret = streamBuffer.write(data, bufferSize + 8);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != Result{0, bufferSize + 8} || wakeUpTimePoint != wokenUpTimePoint || streamBuffer.getSize() != 8)
+			return false;
+
+		char buffer[bufferSize] {};
+		if (streamBuffer.tryRead(buffer, sizeof(buffer)) != Result{0, 8} || memcmp(buffer, data + bufferSize, 8) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread scenario. Main (current) thread reads from empty buffer. Software timer is used to write the
+ * data at specified time point from interrupt context, main thread is expected to be unblocked in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	StaticStreamBuffer<bufferSize> streamBuffer;
+
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&streamBuffer]()
+			{
+				streamBuffer.tryWrite(data, 5);
+			});
+
+	waitForNextTick();
+
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	// buffer is empty, but read() should succeed at expected time
+	char buffer[bufferSize] {};
+	const auto ret = streamBuffer.read(buffer, sizeof(buffer));
+	const auto wokenUpTimePoint = TickClock::now();
+	return ret == Result{0, 5} && memcmp(buffer, data, 5) == 0 && wakeUpTimePoint == wokenUpTimePoint;
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests two threads waiting for different amounts of data. Both test threads read from empty buffer with trigger level
+ * 4 - the one with higher priority requests 8 bytes (so it waits for the trigger level), the other one requests single
+ * byte. Main (current) thread writes single byte, the thread which requested single byte is expected to be unblocked
+ * in the same moment, even though the other one is still waiting. Then main thread writes the rest of the data, which
+ * is expected to be received by the other thread.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	constexpr size_t triggerLevel {4};
+	DynamicStreamBuffer streamBuffer {bufferSize, triggerLevel};
+
+	Result largeResult {};
+	char largeBuffer[8] {};
+	auto largeReader = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+			[&streamBuffer, &largeResult, &largeBuffer]()
+			{
+				largeResult = streamBuffer.read(largeBuffer, sizeof(largeBuffer));
+			});
+
+	Result smallResult {};
+	TickClock::time_point smallTimePoint {};
+	auto smallReader = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX - 1},
+			[&streamBuffer, &smallResult, &smallTimePoint]()
+			{
+				char buffer[1] {};
+				smallResult = streamBuffer.read(buffer, sizeof(buffer));
+				smallTimePoint = TickClock::now();
+			});
+
+	waitForNextTick();
+
+	// single byte is enough for one of the readers, but not for the other one
+	const auto writeTimePoint = TickClock::now();
+	streamBuffer.tryWrite(data, 1);
+	const auto smallReaderState = smallReader.getState();
+	const auto largeReaderState = largeReader.getState();
+
+	streamBuffer.tryWrite(data + 1, triggerLevel);
+	largeReader.join();
+	smallReader.join();
+
+	return smallReaderState == ThreadState::terminated && smallResult == Result{0, 1} &&
+			smallTimePoint == writeTimePoint && largeReaderState == ThreadState::blockedOnStreamBuffer &&
+			largeResult == Result{0, triggerLevel} && memcmp(largeBuffer, data + 1, triggerLevel) == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool StreamBufferOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3, phase4})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
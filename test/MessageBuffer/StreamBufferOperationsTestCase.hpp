@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief StreamBufferOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_STREAMBUFFER_STREAMBUFFEROPERATIONSTESTCASE_HPP_
+#define TEST_STREAMBUFFER_STREAMBUFFEROPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * rief Tests various stream buffer operations.
+ *
+ * Tests writing (write(), tryWrite(), tryWriteFor() and tryWriteUntil()) and reading (read(), tryRead(), tryReadFor()
+ * and tryReadUntil()) of data, trigger level, zero-copy writing with reserve() and commit(), and unblocking of threads
+ * waiting for data or for free space by another thread and by interrupt.
+ */
+
+class StreamBufferOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_STREAMBUFFER_STREAMBUFFEROPERATIONSTESTCASE_HPP_
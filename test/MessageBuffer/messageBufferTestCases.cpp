@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief messageBufferTestCases object definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "messageBufferTestCases.hpp"
+
+#include "MessageBufferOperationsTestCase.hpp"
+#include "StreamBufferOperationsTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// MessageBufferOperationsTestCase instance
+const MessageBufferOperationsTestCase messageBufferOperationsTestCase;
+
+/// StreamBufferOperationsTestCase instance
+const StreamBufferOperationsTestCase streamBufferOperationsTestCase;
+
+/// array with references to TestCase objects related to message buffers and stream buffers
+const TestCaseGroup::Range::value_type messageBufferTestCases_[]
+{
+		TestCaseGroup::Range::value_type{messageBufferOperationsTestCase},
+		TestCaseGroup::Range::value_type{streamBufferOperationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup messageBufferTestCases {TestCaseGroup::Range{messageBufferTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,162 @@
+/**
+ * \file
+ * \brief MutexStatisticsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "MutexStatisticsTestCase.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicThread.hpp"
+#include "distortos/Mutex.hpp"
+#include "distortos/MutexStatistics.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/ThreadIdentifier.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// name of mutex used in test
+constexpr char mutexName[] {"MutexStatisticsTestCase"};
+
+/// duration for which the mutex is held while test thread waits for it
+constexpr TickClock::duration holdDuration {10};
+
+}	// namespace
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool MutexStatisticsTestCase::run_() const
+{
+#if CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	Mutex mutex {Mutex::Type::recursive, Mutex::Protocol::priorityInheritance};
+	MutexStatistics mutexStatistics {mutex, mutexName};
+
+	{
+		size_t found {};
+		MutexStatistics::forEach(
+				[&found, &mutexStatistics](const MutexStatistics& visited)
+				{
+					if (&visited == &mutexStatistics && std::strcmp(visited.getName(), mutexName) == 0)
+						++found;
+				});
+		if (found != 1)
+			return false;
+	}
+
+	{
+		// uncontended locking, recursive lock must not be counted
+		const auto lockRet = mutex.lock();
+		const auto recursiveLockRet = mutex.lock();
+		const auto recursiveUnlockRet = mutex.unlock();
+		const auto unlockRet = mutex.unlock();
+		if (lockRet != 0 || recursiveLockRet != 0 || recursiveUnlockRet != 0 || unlockRet != 0)
+			return false;
+
+		const auto snapshot = mutexStatistics.getSnapshot();
+		if (snapshot.lockCount != 1 || snapshot.contendedLockCount != 0 || snapshot.priorityBoostCount != 0 ||
+				snapshot.totalWaitTime != TickClock::duration{} || snapshot.lastOwner != ThisThread::getIdentifier())
+			return false;
+	}
+
+	{
+		// contended locking - higher priority thread blocks on the mutex while it is held for holdDuration
+		waitForNextTick();
+		const auto lockRet = mutex.lock();
+		if (lockRet != 0)
+			return false;
+
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&mutex]()
+				{
+					mutex.lock();
+					mutex.unlock();
+				});
+
+		ThisThread::sleepFor(holdDuration);
+		const auto unlockRet = mutex.unlock();
+		thread.join();
+		if (unlockRet != 0)
+			return false;
+
+		const auto snapshot = mutexStatistics.getSnapshot();
+		if (snapshot.lockCount != 3 || snapshot.contendedLockCount != 1 || snapshot.priorityBoostCount != 1 ||
+				snapshot.totalWaitTime < holdDuration || snapshot.maxWaitTime != snapshot.totalWaitTime ||
+				snapshot.maxHoldTime < holdDuration)
+			return false;
+	}
+
+	{
+		// timed-out wait of higher priority thread must not be counted as contended lock
+		const auto previousSnapshot = mutexStatistics.getSnapshot();
+		const auto lockRet = mutex.lock();
+		if (lockRet != 0)
+			return false;
+
+		int tryLockForRet {};
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&mutex, &tryLockForRet]()
+				{
+					tryLockForRet = mutex.tryLockFor(holdDuration);
+				});
+
+		thread.join();
+		const auto unlockRet = mutex.unlock();
+		if (tryLockForRet != ETIMEDOUT || unlockRet != 0)
+			return false;
+
+		const auto snapshot = mutexStatistics.getSnapshot();
+		if (snapshot.lockCount != previousSnapshot.lockCount + 1 ||
+				snapshot.contendedLockCount != previousSnapshot.contendedLockCount ||
+				snapshot.totalWaitTime != previousSnapshot.totalWaitTime)
+			return false;
+	}
+
+	mutexStatistics.reset();
+	const auto snapshot = mutexStatistics.getSnapshot();
+	if (snapshot.lockCount != 0 || snapshot.contendedLockCount != 0 || snapshot.maxHoldTime != TickClock::duration{})
+		return false;
+
+#endif	// CONFIG_MUTEX_STATISTICS_ENABLE == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
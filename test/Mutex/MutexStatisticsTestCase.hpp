@@ -0,0 +1,72 @@
+/**
+ * \file
+ * \brief MutexStatisticsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_MUTEX_MUTEXSTATISTICSTESTCASE_HPP_
+#define TEST_MUTEX_MUTEXSTATISTICSTESTCASE_HPP_
+
+#include "PrioritizedTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests MutexStatistics.
+ *
+ * Tests statistics collected for uncontended, contended and timed-out locking of recursive mutex with
+ * priorityInheritance protocol and enumeration of instrumented mutexes. When CONFIG_MUTEX_STATISTICS_ENABLE is not
+ * selected, this test case does nothing.
+ */
+
+class MutexStatisticsTestCase : public PrioritizedTestCase
+{
+	/// priority at which this test case should be executed
+	constexpr static uint8_t testCasePriority_ {UINT8_MAX - 1};
+
+public:
+
+	/**
+	 * \return priority at which this test case should be executed
+	 */
+
+	constexpr static uint8_t getTestCasePriority()
+	{
+		return testCasePriority_;
+	}
+
+	/**
+	 * \brief MutexStatisticsTestCase's constructor
+	 */
+
+	constexpr MutexStatisticsTestCase() :
+			PrioritizedTestCase{testCasePriority_}
+	{
+
+	}
+
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_MUTEX_MUTEXSTATISTICSTESTCASE_HPP_
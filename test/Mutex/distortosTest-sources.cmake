@@ -15,6 +15,7 @@ target_sources(distortosTest PRIVATE
 		${CMAKE_CURRENT_LIST_DIR}/MutexPriorityProtocolTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MutexPriorityTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/MutexRecursiveOperationsTestCase.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MutexStatisticsTestCase.cpp
 		${CMAKE_CURRENT_LIST_DIR}/mutexTestCases.cpp
 		${CMAKE_CURRENT_LIST_DIR}/mutexTestTryLockWhenLocked.cpp
 		${CMAKE_CURRENT_LIST_DIR}/mutexTestUnlockFromWrongThread.cpp)
@@ -0,0 +1,169 @@
+/**
+ * \file
+ * \brief QueueStatisticsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "QueueStatisticsTestCase.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/QueueStatistics.hpp"
+#include "distortos/StaticFifoQueue.hpp"
+#include "distortos/StaticMessageQueue.hpp"
+
+#include <cerrno>
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of queues used in test
+constexpr size_t queueSize {4};
+
+/// duration used for timed operations which are expected to time out
+constexpr TickClock::duration timeoutDuration {2};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tests statistics of FifoQueue.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testFifoQueue()
+{
+	StaticFifoQueue<uint8_t, queueSize> fifoQueue;
+	QueueStatistics queueStatistics {fifoQueue, "fifoQueue"};
+
+	for (size_t i = 0; i < queueSize; ++i)
+		if (fifoQueue.tryPush(i) != 0)
+			return false;
+
+	{
+		uint8_t value;
+		if (fifoQueue.tryPop(value) != 0 || value != 0)
+			return false;
+	}
+
+	{
+		const auto snapshot = queueStatistics.getSnapshot();
+		if (snapshot.depth != queueSize - 1 || snapshot.maxDepth != queueSize || snapshot.pushCount != queueSize ||
+				snapshot.popCount != 1 || snapshot.failedPushCount != 0 || snapshot.blockedPushCount != 0 ||
+				snapshot.blockedPopCount != 0 || snapshot.totalBlockedTime != TickClock::duration{})
+			return false;
+	}
+
+	if (fifoQueue.tryPush(queueSize) != 0 || fifoQueue.tryPush(queueSize) != EAGAIN)
+		return false;
+
+	waitForNextTick();
+	if (fifoQueue.tryPushFor(timeoutDuration, queueSize) != ETIMEDOUT)
+		return false;
+
+	{
+		const auto snapshot = queueStatistics.getSnapshot();
+		if (snapshot.depth != queueSize || snapshot.pushCount != queueSize + 1 || snapshot.failedPushCount != 2 ||
+				snapshot.blockedPushCount != 1 || snapshot.blockedPopCount != 0 ||
+				snapshot.totalBlockedTime < timeoutDuration)
+			return false;
+	}
+
+	queueStatistics.reset();
+	const auto snapshot = queueStatistics.getSnapshot();
+	return snapshot.depth == queueSize && snapshot.maxDepth == queueSize && snapshot.pushCount == 0 &&
+			snapshot.failedPushCount == 0 && snapshot.totalBlockedTime == TickClock::duration{};
+}
+
+/**
+ * \brief Tests statistics of MessageQueue and enumeration of instrumented queues.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testMessageQueue()
+{
+	StaticMessageQueue<uint16_t, queueSize> messageQueue;
+	QueueStatistics queueStatistics {messageQueue, "messageQueue"};
+
+	{
+		size_t found {};
+		QueueStatistics::forEach(
+				[&found, &queueStatistics](const QueueStatistics& visited)
+				{
+					if (&visited == &queueStatistics)
+						++found;
+				});
+		if (found != 1)
+			return false;
+	}
+
+	uint8_t priority;
+	uint16_t value;
+	if (messageQueue.tryPop(priority, value) != EAGAIN)
+		return false;
+
+	waitForNextTick();
+	if (messageQueue.tryPopFor(timeoutDuration, priority, value) != ETIMEDOUT)
+		return false;
+
+	if (messageQueue.tryPush(1, 0x1234) != 0 || messageQueue.tryPop(priority, value) != 0 || value != 0x1234)
+		return false;
+
+	const auto snapshot = queueStatistics.getSnapshot();
+	return snapshot.depth == 0 && snapshot.maxDepth == 1 && snapshot.pushCount == 1 && snapshot.popCount == 1 &&
+			snapshot.failedPushCount == 0 && snapshot.blockedPushCount == 0 && snapshot.blockedPopCount == 1 &&
+			snapshot.totalBlockedTime >= timeoutDuration;
+}
+
+}	// namespace
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool QueueStatisticsTestCase::run_() const
+{
+#if CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	if (testFifoQueue() == false)
+		return false;
+
+	if (testMessageQueue() == false)
+		return false;
+
+#endif	// CONFIG_QUEUE_STATISTICS_ENABLE == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
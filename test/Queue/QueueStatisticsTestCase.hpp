@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief QueueStatisticsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_QUEUE_QUEUESTATISTICSTESTCASE_HPP_
+#define TEST_QUEUE_QUEUESTATISTICSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests QueueStatistics.
+ *
+ * Tests statistics collected for successful, failed and blocking push and pop operations on FifoQueue and MessageQueue
+ * and enumeration of instrumented queues. When CONFIG_QUEUE_STATISTICS_ENABLE is not selected, this test case does
+ * nothing.
+ */
+
+class QueueStatisticsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_QUEUE_QUEUESTATISTICSTESTCASE_HPP_
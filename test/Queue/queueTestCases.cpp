@@ -2,7 +2,7 @@
  * \file
  * \brief queueTestCases object definition
  *
- * \author Copyright (C) 2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,6 +14,7 @@
 #include "QueueOperationsTestCase.hpp"
 #include "FifoQueuePriorityTestCase.hpp"
 #include "MessageQueuePriorityTestCase.hpp"
+#include "QueueStatisticsTestCase.hpp"
 
 #include "TestCaseGroup.hpp"
 
@@ -39,12 +40,16 @@ const FifoQueuePriorityTestCase fifoQueuePriorityTestCase;
 /// MessageQueuePriorityTestCase instance
 const MessageQueuePriorityTestCase messageQueuePriorityTestCase;
 
+/// QueueStatisticsTestCase instance
+const QueueStatisticsTestCase statisticsTestCase;
+
 /// array with references to TestCase objects related to queue
 const TestCaseGroup::Range::value_type queueTestCases_[]
 {
 		TestCaseGroup::Range::value_type{operationsTestCase},
 		TestCaseGroup::Range::value_type{fifoQueuePriorityTestCase},
 		TestCaseGroup::Range::value_type{messageQueuePriorityTestCase},
+		TestCaseGroup::Range::value_type{statisticsTestCase},
 };
 
 }	// namespace
@@ -2,7 +2,7 @@
  * \file
  * \brief SemaphoreOperationsTestCase class implementation
  *
- * \author Copyright (C) 2014-2016 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -55,6 +55,21 @@ constexpr decltype(statistics::getContextSwitchCount()) phase3ThreadContextSwitc
 /// thread blocks on semaphore (main -> idle), 2 - main thread is unblocked by interrupt (idle -> main)
 constexpr decltype(statistics::getContextSwitchCount()) phase4SoftwareTimerContextSwitchCount {2};
 
+/// expected number of context switches in phase6 block involving software timer (excluding waitForNextTick()): 1 - main
+/// thread blocks on semaphore (main -> idle), 2 - main thread is unblocked by interrupt (idle -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase6SoftwareTimerContextSwitchCount {2};
+
+/// expected number of context switches in phase7 block involving timed-out test thread (excluding waitForNextTick()):
+/// 1 - test thread starts (main -> test), 2 - test thread blocks on semaphore (test -> main), 3 - main thread blocks on
+/// semaphore (main -> idle), 4 - test thread times out (idle -> test), 5 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase7TimeoutContextSwitchCount {5};
+
+/// expected number of context switches in phase7 block involving software timer (excluding waitForNextTick()): 1 - test
+/// thread starts (main -> test), 2 - test thread blocks on semaphore (test -> main), 3 - main thread blocks on
+/// semaphore (main -> idle), 4 - main thread times out (idle -> main), 5 - test thread is unblocked by main thread
+/// (main -> test), 6 - test thread terminates (test -> main)
+constexpr decltype(statistics::getContextSwitchCount()) phase7SoftwareTimerContextSwitchCount {6};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -329,7 +344,11 @@ bool phase3()
 bool phase4()
 {
 	Semaphore semaphore {0};
-	auto softwareTimer = makeStaticSoftwareTimer(&Semaphore::post, std::ref(semaphore));
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&semaphore]()
+			{
+				semaphore.post();
+			});
 
 	{
 		waitForNextTick();
@@ -432,6 +451,164 @@ bool phase5()
 	return true;
 }
 
+/**
+ * \brief Phase 6 of test case.
+ *
+ * Tests operations on multiple units of semaphore. Units must never be acquired partially, posting must either succeed
+ * completely or fail with EOVERFLOW without modifying the semaphore. Requests for more units than max value of
+ * semaphore must fail immediately with EINVAL. Main (current) thread waits for multiple units of semaphore which are
+ * posted from interrupt context with single call to Semaphore::post(Value) - main thread is expected to acquire all
+ * units in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase6()
+{
+	constexpr Semaphore::Value maxValue {5};
+
+	Semaphore semaphore {0, maxValue};
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+
+		// value is 0, so units cannot be acquired
+		if (semaphore.tryWait(2) != EAGAIN || semaphore.getValue() != 0)
+			return false;
+
+		if (semaphore.post(3) != 0 || semaphore.getValue() != 3)
+			return false;
+
+		// value is 3, so 4 units cannot be acquired, semaphore must not be modified
+		if (semaphore.tryWait(4) != EAGAIN || semaphore.getValue() != 3)
+			return false;
+
+		if (semaphore.tryWait(3) != 0 || semaphore.getValue() != 0)
+			return false;
+
+		// max value would be exceeded, semaphore must not be modified
+		if (semaphore.post(maxValue + 1) != EOVERFLOW || semaphore.getValue() != 0)
+			return false;
+
+		// request greater than max value can never be satisfied, so all functions must fail immediately
+		if (semaphore.tryWait(maxValue + 1) != EINVAL || semaphore.wait(maxValue + 1) != EINVAL ||
+				semaphore.tryWaitFor(longDuration, maxValue + 1) != EINVAL ||
+				semaphore.tryWaitUntil(start + longDuration, maxValue + 1) != EINVAL || semaphore.getValue() != 0)
+			return false;
+
+		if (semaphore.post(1) != 0 || semaphore.getValue() != 1 || start != TickClock::now())
+			return false;
+	}
+
+	{
+		auto softwareTimer = makeStaticSoftwareTimer(
+				[&semaphore]()
+				{
+					semaphore.post(2);
+				});
+
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// only 1 unit is available, but all 3 units should be acquired at expected time
+		const auto ret = semaphore.wait(3);
+		const auto wokenUpTimePoint = TickClock::now();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || semaphore.getValue() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase6SoftwareTimerContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 7 of test case.
+ *
+ * Tests order in which multiple units of semaphore are given to blocked threads. Test thread (with higher priority)
+ * waits for 3 units - main (current) thread must not acquire 1 unit ahead of it, neither with tryWait() nor when unit
+ * is posted from interrupt context. When the wait of test thread times out, main thread waiting behind it is expected to
+ * acquire the unit which is already available in the same moment.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase7()
+{
+	constexpr size_t testThreadStackSize {512};
+	constexpr Semaphore::Value maxValue {5};
+
+	Semaphore semaphore {0, maxValue};
+
+	{
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		int threadRet {-1};
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&semaphore, &threadRet, wakeUpTimePoint]()
+				{
+					threadRet = semaphore.tryWaitUntil(wakeUpTimePoint, 3);
+				});
+
+		// 2 units are available, but test thread with higher priority waits for 3 units
+		const auto postRet = semaphore.post(2);
+		const auto tryWaitRet = semaphore.tryWait(1);
+		const auto value = semaphore.getValue();
+
+		// main thread should acquire 1 unit at the moment test thread gives up
+		const auto ret = semaphore.wait(1);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (postRet != 0 || tryWaitRet != EAGAIN || value != 2 || ret != 0 || threadRet != ETIMEDOUT ||
+				wakeUpTimePoint != wokenUpTimePoint || semaphore.getValue() != 1 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase7TimeoutContextSwitchCount)
+			return false;
+	}
+
+	{
+		auto softwareTimer = makeStaticSoftwareTimer(
+				[&semaphore]()
+				{
+					semaphore.post(1);
+				});
+
+		waitForNextTick();
+
+		const auto contextSwitchCount = statistics::getContextSwitchCount();
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		const auto threadTimeoutTimePoint = wakeUpTimePoint + longDuration * 2;
+		int threadRet {-1};
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&semaphore, &threadRet, threadTimeoutTimePoint]()
+				{
+					threadRet = semaphore.tryWaitUntil(threadTimeoutTimePoint, 3);
+				});
+
+		softwareTimer.start(wakeUpTimePoint);
+
+		// unit posted from interrupt context must not be given to main thread, as test thread waits ahead of it
+		const auto ret = semaphore.tryWaitUntil(wakeUpTimePoint + longDuration, 1);
+		const auto wokenUpTimePoint = TickClock::now();
+		const auto value = semaphore.getValue();
+
+		// test thread should acquire all 3 units when the last one is posted
+		const auto postRet = semaphore.post(1);
+		thread.join();
+		if (ret != ETIMEDOUT || wokenUpTimePoint != wakeUpTimePoint + longDuration || value != 2 || postRet != 0 ||
+				threadRet != 0 || semaphore.getValue() != 0 ||
+				statistics::getContextSwitchCount() - contextSwitchCount != phase7SoftwareTimerContextSwitchCount)
+			return false;
+	}
+
+	return true;
+}
+
 }	// namespace
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -448,12 +625,17 @@ bool SemaphoreOperationsTestCase::run_() const
 	constexpr auto phase4ExpectedContextSwitchCount = 6 * waitForNextTickContextSwitchCount +
 			3 * phase4SoftwareTimerContextSwitchCount;
 	constexpr auto phase5ExpectedContextSwitchCount = 1 * waitForNextTickContextSwitchCount;
+	constexpr auto phase6ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount +
+			phase6SoftwareTimerContextSwitchCount;
+	constexpr auto phase7ExpectedContextSwitchCount = 2 * waitForNextTickContextSwitchCount +
+			phase7TimeoutContextSwitchCount + phase7SoftwareTimerContextSwitchCount;
 	constexpr auto expectedContextSwitchCount = phase1ExpectedContextSwitchCount + phase2ExpectedContextSwitchCount +
-			phase3ExpectedContextSwitchCount + phase4ExpectedContextSwitchCount + phase5ExpectedContextSwitchCount;
+			phase3ExpectedContextSwitchCount + phase4ExpectedContextSwitchCount + phase5ExpectedContextSwitchCount +
+			phase6ExpectedContextSwitchCount + phase7ExpectedContextSwitchCount;
 
 	const auto contextSwitchCount = statistics::getContextSwitchCount();
 
-	for (const auto& function : {phase1, phase2, phase3, phase4, phase5})
+	for (const auto& function : {phase1, phase2, phase3, phase4, phase5, phase6, phase7})
 	{
 		const auto ret = function();
 		if (ret != true)
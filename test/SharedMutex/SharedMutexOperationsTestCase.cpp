@@ -0,0 +1,411 @@
+/**
+ * \file
+ * \brief SharedMutexOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "SharedMutexOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicSharedMutex.hpp"
+#include "distortos/DynamicThread.hpp"
+#include "distortos/StaticSharedMutex.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// priority of current test thread
+constexpr uint8_t testThreadPriority {SharedMutexOperationsTestCase::getTestCasePriority()};
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests whether all functions return proper error codes in invalid scenarios - locking of shared mutex which is already
+ * owned by current thread, unlocking of shared mutex which is not owned by current thread and exceeding the maximum
+ * number of threads with shared ownership.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	StaticSharedMutex<1> sharedMutex;
+
+	{
+		if (sharedMutex.unlock() != EPERM || sharedMutex.unlockShared() != EPERM)
+			return false;
+	}
+
+	{
+		if (sharedMutex.lock() != 0)
+			return false;
+
+		if (sharedMutex.lock() != EDEADLK || sharedMutex.lockShared() != EDEADLK || sharedMutex.tryLock() != EBUSY ||
+				sharedMutex.tryLockShared() != EBUSY || sharedMutex.tryLockFor(singleDuration) != EDEADLK ||
+				sharedMutex.tryLockSharedFor(singleDuration) != EDEADLK || sharedMutex.unlockShared() != EPERM ||
+				sharedMutex.getReadersCount() != 0)
+			return false;
+
+		if (sharedMutex.unlock() != 0 || sharedMutex.unlock() != EPERM)
+			return false;
+	}
+
+	{
+		if (sharedMutex.lockShared() != 0)
+			return false;
+
+		if (sharedMutex.lock() != EDEADLK || sharedMutex.lockShared() != EDEADLK || sharedMutex.tryLock() != EBUSY ||
+				sharedMutex.tryLockShared() != EBUSY || sharedMutex.unlock() != EPERM ||
+				sharedMutex.getReadersCount() != 1)
+			return false;
+
+		// maximum number of threads with shared ownership was reached
+		int ret {-1};
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+				[&sharedMutex, &ret]()
+				{
+					ret = sharedMutex.tryLockShared();
+				});
+		thread.join();
+		if (ret != EAGAIN)
+			return false;
+
+		if (sharedMutex.unlockShared() != 0 || sharedMutex.unlockShared() != EPERM ||
+				sharedMutex.getReadersCount() != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests timed variants of exclusive and shared locking. Test thread locks the shared mutex exclusively for a specified
+ * duration - main thread is expected to time-out when trying to lock it in any mode and then to acquire shared
+ * ownership at the moment the test thread unlocks it. Additionally it is tested whether multiple threads can have shared
+ * ownership at the same time.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	DynamicSharedMutex sharedMutex {2};
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+				[&sharedMutex, wakeUpTimePoint]()
+				{
+					sharedMutex.lock();
+					ThisThread::sleepUntil(wakeUpTimePoint);
+					sharedMutex.unlock();
+				});
+
+		{
+			const auto start = TickClock::now();
+			const auto ret = sharedMutex.tryLockFor(singleDuration);
+			if (ret != ETIMEDOUT || TickClock::now() - start != singleDuration + decltype(singleDuration){1})
+				return false;
+		}
+
+		{
+			const auto requestedTimePoint = TickClock::now() + singleDuration;
+			const auto ret = sharedMutex.tryLockSharedUntil(requestedTimePoint);
+			if (ret != ETIMEDOUT || requestedTimePoint != TickClock::now())
+				return false;
+		}
+
+		// shared mutex is locked exclusively, but tryLockSharedFor() should succeed at expected time
+		const auto ret = sharedMutex.tryLockSharedFor(wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != 0 || wakeUpTimePoint != wokenUpTimePoint || sharedMutex.getReadersCount() != 1)
+			return false;
+	}
+
+	{
+		int sharedRet {-1};
+		int exclusiveRet {-1};
+		size_t readersCount {};
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+				[&sharedMutex, &sharedRet, &exclusiveRet, &readersCount]()
+				{
+					sharedRet = sharedMutex.tryLockSharedUntil(TickClock::now() + singleDuration);
+					readersCount = sharedMutex.getReadersCount();
+					exclusiveRet = sharedMutex.tryLockUntil(TickClock::now() + singleDuration);
+					sharedMutex.unlockShared();
+				});
+		thread.join();
+		if (sharedRet != 0 || readersCount != 2 || exclusiveRet != EDEADLK)
+			return false;
+	}
+
+	if (sharedMutex.unlockShared() != 0 || sharedMutex.tryLock() != 0 || sharedMutex.unlock() != 0)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Tests granting of ownership with given policy.
+ *
+ * Main thread has shared ownership. Test thread W waits for exclusive ownership. Test thread R (with higher priority
+ * than W) tries to acquire shared ownership, test thread R2 (with the same priority as W) tries to acquire shared
+ * ownership and test thread R3 (with higher priority than W) waits for shared ownership. Then main thread releases
+ * shared ownership. Order in which the threads acquire ownership is recorded.
+ *
+ * \param [in] policy is the policy of granting ownership
+ * \param [in] expectedSequence is the expected sequence of acquired ownerships, 'R' - R, 'r' - R3, 'W' - W
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool testPolicy(const SharedMutex::Policy policy, const char* const expectedSequence)
+{
+	StaticSharedMutex<3> sharedMutex {policy};
+	std::array<char, 4> sequence {};
+	size_t index {};
+
+	if (sharedMutex.lockShared() != 0)
+		return false;
+
+	auto writerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+			[&sharedMutex, &sequence, &index]()
+			{
+				sharedMutex.lock();
+				sequence[index++] = 'W';
+				sharedMutex.unlock();
+			});
+
+	int readerRet {-1};
+	auto readerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 2},
+			[&sharedMutex, &sequence, &index, &readerRet]()
+			{
+				readerRet = sharedMutex.tryLockShared();
+				if (readerRet != 0)
+					return;
+				sequence[index++] = 'R';
+				sharedMutex.unlockShared();
+			});
+	readerThread.join();
+
+	// thread waiting for exclusive ownership with the same priority is always ahead
+	int samePriorityReaderRet {-1};
+	auto samePriorityReaderThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+			[&sharedMutex, &samePriorityReaderRet]()
+			{
+				samePriorityReaderRet = sharedMutex.tryLockShared();
+			});
+	samePriorityReaderThread.join();
+
+	auto blockingReaderThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 2},
+			[&sharedMutex, &sequence, &index]()
+			{
+				sharedMutex.lockShared();
+				sequence[index++] = 'r';
+				sharedMutex.unlockShared();
+			});
+
+	if (sharedMutex.unlockShared() != 0)
+		return false;
+
+	writerThread.join();
+	blockingReaderThread.join();
+
+	const auto expectedReaderRet = policy == SharedMutex::Policy::fair ? 0 : EBUSY;
+	if (readerRet != expectedReaderRet || samePriorityReaderRet != EBUSY ||
+			strcmp(sequence.data(), expectedSequence) != 0)
+		return false;
+
+	return sharedMutex.getReadersCount() == 0 && sharedMutex.tryLock() == 0 && sharedMutex.unlock() == 0;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests granting of ownership with writerPreference and fair policies.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	if (testPolicy(SharedMutex::Policy::writerPreference, "Wr") != true)
+		return false;
+
+	if (testPolicy(SharedMutex::Policy::fair, "RrW") != true)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 4 of test case.
+ *
+ * Tests priority inheritance. Main thread and test thread R (with higher priority) have shared ownership and R sleeps.
+ * Test thread W (with the highest priority) waits for exclusive ownership - R is expected to inherit its priority, main
+ * thread should not. When R releases shared ownership, main thread is expected to inherit priority of W. When main
+ * thread releases shared ownership, W acquires exclusive ownership and main thread's priority is expected to return to
+ * the original value.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase4()
+{
+	StaticSharedMutex<2> sharedMutex {SharedMutex::Policy::writerPreference,
+			SharedMutex::Protocol::priorityInheritance};
+
+	if (sharedMutex.lockShared() != 0)
+		return false;
+
+	waitForNextTick();
+
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	auto readerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+			[&sharedMutex, wakeUpTimePoint]()
+			{
+				sharedMutex.lockShared();
+				ThisThread::sleepUntil(wakeUpTimePoint);
+				sharedMutex.unlockShared();
+			});
+
+	bool writerLocked {};
+	auto writerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 3},
+			[&sharedMutex, &writerLocked]()
+			{
+				writerLocked = sharedMutex.lock() == 0;
+				sharedMutex.unlock();
+			});
+
+	if (sharedMutex.getReadersCount() != 2 || readerThread.getEffectivePriority() != testThreadPriority + 3 ||
+			ThisThread::getEffectivePriority() != testThreadPriority)
+		return false;
+
+	ThisThread::sleepUntil(wakeUpTimePoint + singleDuration);
+	readerThread.join();
+
+	if (sharedMutex.getReadersCount() != 1 || ThisThread::getEffectivePriority() != testThreadPriority + 3 ||
+			writerLocked != false)
+		return false;
+
+	if (sharedMutex.unlockShared() != 0)
+		return false;
+
+	writerThread.join();
+
+	if (writerLocked != true || ThisThread::getEffectivePriority() != testThreadPriority)
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 5 of test case.
+ *
+ * Tests transfer of ownership after exclusive unlock with fair policy. Main thread has exclusive ownership. Test thread
+ * R waits for shared ownership and test thread W (with lower priority than R) waits for exclusive ownership. When main
+ * thread releases exclusive ownership, only R may acquire it - W is expected to stay blocked until R releases shared
+ * ownership, even when R sleeps while holding it.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase5()
+{
+	StaticSharedMutex<1> sharedMutex {SharedMutex::Policy::fair};
+	std::array<char, 4> sequence {};
+	size_t index {};
+
+	if (sharedMutex.lock() != 0)
+		return false;
+
+	auto readerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 2},
+			[&sharedMutex, &sequence, &index]()
+			{
+				sharedMutex.lockShared();
+				sequence[index++] = 'R';
+				ThisThread::sleepFor(singleDuration);
+				sequence[index++] = 'r';
+				sharedMutex.unlockShared();
+			});
+
+	auto writerThread = makeAndStartDynamicThread({testThreadStackSize, testThreadPriority + 1},
+			[&sharedMutex, &sequence, &index]()
+			{
+				sharedMutex.lock();
+				sequence[index++] = 'W';
+				sharedMutex.unlock();
+			});
+
+	if (sharedMutex.unlock() != 0)
+		return false;
+
+	readerThread.join();
+	writerThread.join();
+
+	if (strcmp(sequence.data(), "RrW") != 0)
+		return false;
+
+	return sharedMutex.getReadersCount() == 0 && sharedMutex.tryLock() == 0 && sharedMutex.unlock() == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool SharedMutexOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3, phase4, phase5})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
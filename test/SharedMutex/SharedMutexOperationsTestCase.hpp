@@ -0,0 +1,74 @@
+/**
+ * \file
+ * \brief SharedMutexOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_SHAREDMUTEX_SHAREDMUTEXOPERATIONSTESTCASE_HPP_
+#define TEST_SHAREDMUTEX_SHAREDMUTEXOPERATIONSTESTCASE_HPP_
+
+#include "PrioritizedTestCase.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various shared mutex operations.
+ *
+ * Tests:
+ * - error codes returned in invalid scenarios,
+ * - timed variants of exclusive and shared locking,
+ * - granting of ownership with writerPreference and fair policies,
+ * - priority inheritance by the thread with exclusive ownership and by the highest priority "reader".
+ */
+
+class SharedMutexOperationsTestCase : public PrioritizedTestCase
+{
+	/// priority at which this test case should be executed
+	constexpr static uint8_t testCasePriority_ {1};
+
+public:
+
+	/**
+	 * \return priority at which this test case should be executed
+	 */
+
+	constexpr static uint8_t getTestCasePriority()
+	{
+		return testCasePriority_;
+	}
+
+	/**
+	 * \brief SharedMutexOperationsTestCase's constructor
+	 */
+
+	constexpr SharedMutexOperationsTestCase() :
+			PrioritizedTestCase{testCasePriority_}
+	{
+
+	}
+
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_SHAREDMUTEX_SHAREDMUTEXOPERATIONSTESTCASE_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief SignalsQueuedOperationsTestCase class implementation
  *
- * \author Copyright (C) 2015-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2015-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -42,6 +42,9 @@ namespace
 /// size of stack for test thread, bytes
 constexpr size_t testThreadStackSize {512};
 
+/// number of test threads used in phase 3
+constexpr size_t phase3ThreadCount {2};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -124,6 +127,62 @@ bool phase2()
 	return true;
 }
 
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests queuing of signal for whole thread group. Test threads have higher priority, so they are already waiting for
+ * the signal when it is queued with ThisThread::Signals::queueSignalForThreadGroup(). Each test thread must receive the
+ * signal with expected value and all of them must be included in the number of threads which accepted it. If current
+ * thread also accepted the signal, it is accepted here, so that no signals are pending after the test.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	constexpr uint8_t testSignalNumber {17};
+	constexpr int testValue {0x2a5d};
+
+	SignalInformation signalInformations[phase3ThreadCount]
+	{
+			SignalInformation{{}, {}, {}},
+			SignalInformation{{}, {}, {}},
+	};
+	int results[phase3ThreadCount] {};
+
+	const auto waitFunctor = [testSignalNumber](int& result, SignalInformation& signalInformation)
+			{
+				const auto waitResult = ThisThread::Signals::wait(SignalSet{1u << testSignalNumber});
+				result = waitResult.first;
+				signalInformation = waitResult.second;
+			};
+
+	auto thread0 = makeAndStartDynamicThread({testThreadStackSize, true, 1, 0, UINT8_MAX}, waitFunctor,
+			std::ref(results[0]), std::ref(signalInformations[0]));
+	auto thread1 = makeAndStartDynamicThread({testThreadStackSize, true, 1, 0, UINT8_MAX}, waitFunctor,
+			std::ref(results[1]), std::ref(signalInformations[1]));
+
+	const auto queueResult = ThisThread::Signals::queueSignalForThreadGroup(testSignalNumber, sigval{testValue});
+
+	thread0.join();
+	thread1.join();
+
+	if (signalsTestSelfOneSignalPending(testSignalNumber) == true &&
+			ThisThread::Signals::tryWait(SignalSet{1u << testSignalNumber}).first != 0)
+		return false;
+
+	if (queueResult.first != 0 || queueResult.second < phase3ThreadCount)
+		return false;
+
+	for (size_t i {}; i < phase3ThreadCount; ++i)
+		if (results[i] != 0 || signalInformations[i].getSignalNumber() != testSignalNumber ||
+				signalInformations[i].getCode() != SignalInformation::Code::queued ||
+				signalInformations[i].getValue().sival_int != testValue)
+			return false;
+
+	return true;
+}
+
 }	// namespace
 
 #endif	// CONFIG_SIGNALS_ENABLE == 1
@@ -136,7 +195,7 @@ bool SignalsQueuedOperationsTestCase::run_() const
 {
 #if CONFIG_SIGNALS_ENABLE == 1
 
-	for (const auto& function : {phase1, phase2})
+	for (const auto& function : {phase1, phase2, phase3})
 	{
 		// initially no signals may be pending
 		if (ThisThread::Signals::getPendingSignalSet().getBitset().none() == false)
@@ -2,7 +2,7 @@
  * \file
  * \brief ThreadSchedulingPolicyTestCase class implementation
  *
- * \author Copyright (C) 2014-2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -20,6 +20,8 @@
 
 #include <malloc.h>
 
+#include <cerrno>
+
 namespace distortos
 {
 
@@ -129,6 +131,18 @@ bool ThreadSchedulingPolicyTestCase::run_() const
 					makeTestThread(schedulingPolicy, sequenceAsserter, {7 * multiplier, 7 * multiplier + step}),
 			}};
 
+			{
+				auto& thread = threads[0];
+				if (thread.setRoundRobinQuantum(TickClock::duration{}) != EINVAL ||
+						thread.setRoundRobinQuantum(TickClock::duration{UINT8_MAX + 1}) != EINVAL ||
+						thread.getRoundRobinQuantum() != internal::RoundRobinQuantum::getInitial())
+					return false;
+
+				if (thread.setRoundRobinQuantum(internal::RoundRobinQuantum::getInitial()) != 0 ||
+						thread.getRoundRobinQuantum() != internal::RoundRobinQuantum::getInitial())
+					return false;
+			}
+
 			decltype(TickClock::now()) testStart;
 
 			{
@@ -148,6 +162,11 @@ bool ThreadSchedulingPolicyTestCase::run_() const
 
 			const auto testDuration = TickClock::now() - testStart;
 
+			// each round-robin thread is rotated at least once, fifo threads are never rotated
+			for (const auto& thread : threads)
+				if ((thread.getRoundRobinRotationCount() != 0) != (schedulingPolicy == SchedulingPolicy::roundRobin))
+					return false;
+
 			if (sequenceAsserter.assertSequence(totalThreads * 2) == false)
 				return false;
 
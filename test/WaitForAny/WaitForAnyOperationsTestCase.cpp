@@ -0,0 +1,312 @@
+/**
+ * \file
+ * \brief WaitForAnyOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "WaitForAnyOperationsTestCase.hpp"
+
+#include "waitForNextTick.hpp"
+
+#include "distortos/DynamicThread.hpp"
+#include "distortos/StaticFifoQueue.hpp"
+#include "distortos/StaticRawMessageQueue.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/waitForAny.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// pair with return code and index of ready object, as returned by waitForAny() and its variants
+using WaitResult = std::pair<int, size_t>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// long duration used in tests
+constexpr auto longDuration = singleDuration * 10;
+
+/// size of stack for test thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/// size of queues used in tests
+constexpr size_t queueSize {4};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests whether all functions properly return some error when none of the objects is ready or when the range of
+ * objects is empty, and whether the index of first ready object is returned immediately when some objects are ready.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	Semaphore semaphore {0};
+	EventFlags eventFlags {0x0f};
+	StaticFifoQueue<uint8_t, queueSize> fifoQueue;
+	const WaitableObject objects[]
+	{
+			WaitableObject{semaphore},
+			WaitableObject{eventFlags, 0x30, EventFlags::WaitMode::any},
+			WaitableObject{fifoQueue},
+			WaitableObject{eventFlags, 0x1f, EventFlags::WaitMode::all},
+	};
+
+	if (tryWaitForAny(WaitableObjectsRange{}).first != EINVAL || waitForAny(WaitableObjectsRange{}).first != EINVAL)
+		return false;
+
+	{
+		waitForNextTick();
+		const auto start = TickClock::now();
+		const auto ret = tryWaitForAny(WaitableObjectsRange{objects});
+		if (ret.first != EAGAIN || start != TickClock::now())
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// none of the objects is ready, so tryWaitForAnyFor() should time-out at expected time
+		const auto start = TickClock::now();
+		const auto ret = tryWaitForAnyFor(WaitableObjectsRange{objects}, singleDuration);
+		const auto realDuration = TickClock::now() - start;
+		if (ret.first != ETIMEDOUT || realDuration != singleDuration + decltype(singleDuration){1})
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		// none of the objects is ready, so tryWaitForAnyUntil() should time-out at exact expected time
+		const auto requestedTimePoint = TickClock::now() + singleDuration;
+		const auto ret = tryWaitForAnyUntil(WaitableObjectsRange{objects}, requestedTimePoint);
+		if (ret.first != ETIMEDOUT || requestedTimePoint != TickClock::now())
+			return false;
+	}
+
+	// flags which don't satisfy any of the wait conditions
+	eventFlags.set(0x40);
+	if (tryWaitForAny(WaitableObjectsRange{objects}).first != EAGAIN)
+		return false;
+
+	// readiness is not consumed - the same index is returned until the object is "used"
+	eventFlags.set(0x10);
+	for (size_t i {}; i < 2; ++i)
+		if (tryWaitForAny(WaitableObjectsRange{objects}) != WaitResult{0, 3})
+			return false;
+
+	if (fifoQueue.tryPush(0x5a) != 0 || tryWaitForAny(WaitableObjectsRange{objects}) != WaitResult{0, 2})
+		return false;
+
+	if (semaphore.post() != 0 || tryWaitForAnyFor(WaitableObjectsRange{objects}, singleDuration) != WaitResult{0, 0})
+		return false;
+
+	if (semaphore.tryWait() != 0)
+		return false;
+
+	{
+		uint8_t value {};
+		if (fifoQueue.tryPop(value) != 0 || value != 0x5a)
+			return false;
+	}
+
+	eventFlags.set(0x20);
+	if (tryWaitForAnyUntil(WaitableObjectsRange{objects}, TickClock::now() + singleDuration) != WaitResult{0, 1})
+		return false;
+
+	return true;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests thread-thread signaling scenario. Main (current) thread waits for multiple objects which are not ready. Test
+ * thread makes one of them ready at specified time point, main thread is expected to be unblocked (with waitForAny(),
+ * tryWaitForAnyFor() and tryWaitForAnyUntil()) in the same moment and to get index of this object. Making an object
+ * ready in a way which doesn't satisfy the wait condition must not unblock the main thread.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	Semaphore semaphore {0};
+	EventFlags eventFlags {};
+	StaticRawMessageQueue<sizeof(uint16_t), queueSize> rawMessageQueue;
+	const WaitableObject objects[]
+	{
+			WaitableObject{semaphore},
+			WaitableObject{eventFlags, 0x0c, EventFlags::WaitMode::all},
+			WaitableObject{rawMessageQueue},
+	};
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&eventFlags](const TickClock::time_point timePoint)
+				{
+					// only half of the flags - wait condition is not satisfied
+					eventFlags.set(0x04);
+					ThisThread::sleepUntil(timePoint);
+					eventFlags.set(0x08);
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// none of the objects is ready, but waitForAny() should succeed at expected time
+		const auto ret = waitForAny(WaitableObjectsRange{objects});
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 1} || wakeUpTimePoint != wokenUpTimePoint)
+			return false;
+	}
+
+	eventFlags.clear(0x0c);
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&rawMessageQueue](const TickClock::time_point timePoint)
+				{
+					ThisThread::sleepUntil(timePoint);
+					const uint16_t value {0x1234};
+					rawMessageQueue.tryPush(1, value);
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// none of the objects is ready, but tryWaitForAnyFor() should succeed at expected time
+		const auto ret = tryWaitForAnyFor(WaitableObjectsRange{objects},
+				wakeUpTimePoint - TickClock::now() + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 2} || wakeUpTimePoint != wokenUpTimePoint)
+			return false;
+
+		uint8_t priority {};
+		uint16_t value {};
+		if (rawMessageQueue.tryPop(priority, value) != 0 || priority != 1 || value != 0x1234)
+			return false;
+	}
+
+	{
+		waitForNextTick();
+
+		const auto wakeUpTimePoint = TickClock::now() + longDuration;
+		auto thread = makeAndStartDynamicThread({testThreadStackSize, UINT8_MAX},
+				[&semaphore](const TickClock::time_point timePoint)
+				{
+					ThisThread::sleepUntil(timePoint);
+					semaphore.post();
+				}, wakeUpTimePoint);
+
+		ThisThread::yield();
+
+		// none of the objects is ready, but tryWaitForAnyUntil() should succeed at expected time
+		const auto ret = tryWaitForAnyUntil(WaitableObjectsRange{objects}, wakeUpTimePoint + longDuration);
+		const auto wokenUpTimePoint = TickClock::now();
+		thread.join();
+		if (ret != WaitResult{0, 0} || wakeUpTimePoint != wokenUpTimePoint || semaphore.tryWait() != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Phase 3 of test case.
+ *
+ * Tests interrupt-thread signaling scenario. Main (current) thread waits for multiple objects which are not ready.
+ * Software timer is used to push a value to the queue at specified time point from interrupt context, main thread is
+ * expected to be unblocked in the same moment and to get index of the queue.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase3()
+{
+	Semaphore semaphore {0};
+	StaticFifoQueue<uint8_t, queueSize> fifoQueue;
+	const WaitableObject objects[]
+	{
+			WaitableObject{semaphore},
+			WaitableObject{fifoQueue},
+	};
+
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&fifoQueue]()
+			{
+				fifoQueue.tryPush(0xa5);
+			});
+
+	waitForNextTick();
+
+	const auto wakeUpTimePoint = TickClock::now() + longDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	// none of the objects is ready, but waitForAny() should succeed at expected time
+	const auto ret = waitForAny(WaitableObjectsRange{objects});
+	const auto wokenUpTimePoint = TickClock::now();
+	if (ret != WaitResult{0, 1} || wakeUpTimePoint != wokenUpTimePoint)
+		return false;
+
+	uint8_t value {};
+	if (fifoQueue.tryPop(value) != 0 || value != 0xa5)
+		return false;
+
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool WaitForAnyOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2, phase3})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
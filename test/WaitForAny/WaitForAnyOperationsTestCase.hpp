@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief WaitForAnyOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_WAITFORANY_WAITFORANYOPERATIONSTESTCASE_HPP_
+#define TEST_WAITFORANY_WAITFORANYOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests waiting for any of multiple objects.
+ *
+ * Tests waitForAny(), tryWaitForAny(), tryWaitForAnyFor() and tryWaitForAnyUntil() with semaphores, event flags and
+ * queues, in thread-thread and interrupt-thread scenarios.
+ */
+
+class WaitForAnyOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_WAITFORANY_WAITFORANYOPERATIONSTESTCASE_HPP_
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief waitForAnyTestCases object definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "waitForAnyTestCases.hpp"
+
+#include "WaitForAnyOperationsTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// WaitForAnyOperationsTestCase instance
+const WaitForAnyOperationsTestCase operationsTestCase;
+
+/// array with references to TestCase objects related to waiting for any of multiple objects
+const TestCaseGroup::Range::value_type waitForAnyTestCases_[]
+{
+		TestCaseGroup::Range::value_type{operationsTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup waitForAnyTestCases {TestCaseGroup::Range{waitForAnyTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
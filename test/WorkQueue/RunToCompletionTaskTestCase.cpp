@@ -0,0 +1,189 @@
+/**
+ * \file
+ * \brief RunToCompletionTaskTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "RunToCompletionTaskTestCase.hpp"
+
+#include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
+
+#include "distortos/RunToCompletionTask.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/StaticWorkQueue.hpp"
+#include "distortos/TaskResource.hpp"
+#include "distortos/ThisThread.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// context shared by both tasks
+struct TaskContext
+{
+	/// reference to SequenceAsserter object
+	SequenceAsserter& sequenceAsserter;
+
+	/// reference to resource shared by both tasks
+	TaskResource& taskResource;
+
+	/// pointer to task of higher preemption level
+	RunToCompletionTask* highTask;
+
+	/// sequence point which will be marked by task of higher preemption level
+	unsigned int highSequencePoint;
+
+	/// results of operations executed by task of lower preemption level
+	int lowRets[4];
+
+	/// result of locking of resource by task of higher preemption level
+	int highRet;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// priority of lower preemption level
+constexpr uint8_t lowPriority {UINT8_MAX - 1};
+
+/// priority of higher preemption level - also the ceiling of resource
+constexpr uint8_t highPriority {UINT8_MAX};
+
+/// size of stack for preemption level, bytes
+constexpr size_t testThreadStackSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Work item function which terminates worker thread.
+ */
+
+void exitThread(void*)
+{
+	ThisThread::exit();
+}
+
+/**
+ * \brief Function of task of higher preemption level.
+ *
+ * Marks sequence point and locks the resource, which must always be free.
+ *
+ * \param [in] argument is a pointer to TaskContext object
+ */
+
+void highTaskFunction(void* const argument)
+{
+	auto& context = *static_cast<TaskContext*>(argument);
+	context.sequenceAsserter.sequencePoint(context.highSequencePoint);
+	context.highRet = context.taskResource.lock();
+	if (context.highRet == 0)
+		context.highRet = context.taskResource.unlock();
+}
+
+/**
+ * \brief Function of task of lower preemption level.
+ *
+ * Activates task of higher preemption level twice - first one preempts this task immediately, second one (executed
+ * with locked resource) is deferred until the resource is unlocked.
+ *
+ * \param [in] argument is a pointer to TaskContext object
+ */
+
+void lowTaskFunction(void* const argument)
+{
+	auto& context = *static_cast<TaskContext*>(argument);
+	context.sequenceAsserter.sequencePoint(0);
+	context.highSequencePoint = 1;
+	context.lowRets[0] = context.highTask->activate();
+	context.lowRets[1] = context.taskResource.lock();
+	context.highSequencePoint = 3;
+	context.lowRets[2] = context.highTask->activate();
+	context.sequenceAsserter.sequencePoint(2);
+	context.lowRets[3] = context.taskResource.unlock();
+	context.sequenceAsserter.sequencePoint(4);
+}
+
+/**
+ * \brief Terminates worker thread of preemption level and waits for its termination.
+ *
+ * \param [in] preemptionLevel is a reference to preemption level which will be stopped
+ *
+ * \return true if worker thread was terminated, false otherwise
+ */
+
+bool stopPreemptionLevel(StaticWorkQueue<testThreadStackSize>& preemptionLevel)
+{
+	WorkItem exitWorkItem {exitThread};
+	return preemptionLevel.submit(exitWorkItem) == 0 && preemptionLevel.join() == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool RunToCompletionTaskTestCase::run_() const
+{
+	StaticWorkQueue<testThreadStackSize> lowPreemptionLevel {lowPriority};
+	StaticWorkQueue<testThreadStackSize> highPreemptionLevel {highPriority};
+	if (lowPreemptionLevel.start() != 0 || highPreemptionLevel.start() != 0)
+		return false;
+
+	SequenceAsserter sequenceAsserter;
+	TaskResource taskResource {highPriority};
+	TaskContext context {sequenceAsserter, taskResource, nullptr, {}, {-1, -1, -1, -1}, -1};
+	RunToCompletionTask lowTask {lowPreemptionLevel, lowTaskFunction, &context};
+	RunToCompletionTask highTask {highPreemptionLevel, highTaskFunction, &context};
+	context.highTask = &highTask;
+
+	int ret {-1};
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&lowTask, &ret]()
+			{
+				ret = lowTask.activate();
+			});
+
+	waitForNextTick();
+	const auto wakeUpTimePoint = TickClock::now() + singleDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	ThisThread::sleepUntil(wakeUpTimePoint + singleDuration);
+
+	const auto invalidState = ret != 0 || context.lowRets[0] != 0 || context.lowRets[1] != 0 ||
+			context.lowRets[2] != 0 || context.lowRets[3] != 0 || context.highRet != 0 ||
+			lowTask.isActivated() != false || highTask.isActivated() != false ||
+			sequenceAsserter.assertSequence(5) == false;
+
+	const auto lowStopped = stopPreemptionLevel(lowPreemptionLevel);
+	const auto highStopped = stopPreemptionLevel(highPreemptionLevel);
+	if (lowStopped == false || highStopped == false)
+		return false;
+
+	return invalidState == false;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,245 @@
+/**
+ * \file
+ * \brief WorkQueueOperationsTestCase class implementation
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "WorkQueueOperationsTestCase.hpp"
+
+#include "SequenceAsserter.hpp"
+#include "waitForNextTick.hpp"
+
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/StaticWorkQueue.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// argument of markSequencePoint()
+struct SequencePointContext
+{
+	/// reference to SequenceAsserter object
+	SequenceAsserter& sequenceAsserter;
+
+	/// sequence point which will be marked
+	unsigned int sequencePoint;
+};
+
+/// argument of resubmitOnce()
+struct ResubmitContext
+{
+	/// reference to work queue to which the work item will be submitted again
+	WorkQueue& workQueue;
+
+	/// pointer to work item which will be submitted again
+	WorkItem* workItem;
+
+	/// number of executions
+	unsigned int executions;
+
+	/// result of re-submission
+	int ret;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single duration used in tests
+constexpr auto singleDuration = TickClock::duration{1};
+
+/// size of stack for worker thread, bytes
+constexpr size_t testThreadStackSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Work item function which terminates worker thread.
+ */
+
+void exitThread(void*)
+{
+	ThisThread::exit();
+}
+
+/**
+ * \brief Work item function which marks sequence point.
+ *
+ * \param [in] argument is a pointer to SequencePointContext object
+ */
+
+void markSequencePoint(void* const argument)
+{
+	const auto& context = *static_cast<const SequencePointContext*>(argument);
+	context.sequenceAsserter.sequencePoint(context.sequencePoint);
+}
+
+/**
+ * \brief Work item function which submits its own work item again during first execution.
+ *
+ * \param [in] argument is a pointer to ResubmitContext object
+ */
+
+void resubmitOnce(void* const argument)
+{
+	auto& context = *static_cast<ResubmitContext*>(argument);
+	if (context.executions++ == 0)
+		context.ret = context.workQueue.submit(*context.workItem);
+}
+
+/**
+ * \brief Terminates worker thread of work queue and waits for its termination.
+ *
+ * \tparam StackSize is the size of stack of worker thread, bytes
+ *
+ * \param [in] workQueue is a reference to work queue which will be stopped
+ *
+ * \return true if worker thread was terminated, false otherwise
+ */
+
+template<size_t StackSize>
+bool stopWorkQueue(StaticWorkQueue<StackSize>& workQueue)
+{
+	WorkItem exitWorkItem {exitThread};
+	return workQueue.submit(exitWorkItem) == 0 && workQueue.join() == 0;
+}
+
+/**
+ * \brief Phase 1 of test case.
+ *
+ * Tests operations from thread context. Worker thread has lower priority, so submitted work items are executed only
+ * when main thread is blocked. Work items must be executed in FIFO order, second submission of queued work item must
+ * be coalesced and cancelled work item must not be executed.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase1()
+{
+	SequenceAsserter sequenceAsserter;
+	SequencePointContext contexts[]
+	{
+			{sequenceAsserter, 0},
+			{sequenceAsserter, 1},
+			{sequenceAsserter, 2},
+	};
+	WorkItem workItem0 {markSequencePoint, &contexts[0]};
+	WorkItem cancelledWorkItem {markSequencePoint, &contexts[2]};
+	WorkItem workItem1 {markSequencePoint, &contexts[1]};
+
+	StaticWorkQueue<testThreadStackSize> workQueue {1};
+	if (workQueue.start() != 0)
+		return false;
+
+	bool invalidState {};
+	if (workQueue.submit(workItem0) != 0 || workQueue.submit(cancelledWorkItem) != 0 ||
+			workQueue.submit(workItem1) != 0 || workQueue.submit(workItem0) != EALREADY)
+		invalidState = true;
+	if (workItem0.isQueued() != true || cancelledWorkItem.isQueued() != true)
+		invalidState = true;
+	if (workQueue.cancel(cancelledWorkItem) != 0 || workQueue.cancel(cancelledWorkItem) != EINVAL ||
+			cancelledWorkItem.isQueued() != false)
+		invalidState = true;
+	if (sequenceAsserter.assertSequence(0) == false)	// nothing may be executed yet
+		invalidState = true;
+
+	ThisThread::sleepFor(singleDuration);
+
+	if (sequenceAsserter.assertSequence(2) == false || workItem0.isQueued() != false ||
+			workItem1.isQueued() != false)
+		invalidState = true;
+
+	if (stopWorkQueue(workQueue) == false)
+		return false;
+
+	return invalidState == false;
+}
+
+/**
+ * \brief Phase 2 of test case.
+ *
+ * Tests submission from interrupt context. Worker thread has higher priority, so submitted work items are executed
+ * immediately after return from interrupt. Second submission of queued work item must be coalesced. Work item
+ * submitted again during its execution must be executed once more.
+ *
+ * \return true if test succeeded, false otherwise
+ */
+
+bool phase2()
+{
+	StaticWorkQueue<testThreadStackSize> workQueue {UINT8_MAX};
+	if (workQueue.start() != 0)
+		return false;
+
+	SequenceAsserter sequenceAsserter;
+	SequencePointContext sequencePointContext {sequenceAsserter, 0};
+	WorkItem workItem {markSequencePoint, &sequencePointContext};
+	ResubmitContext resubmitContext {workQueue, nullptr, {}, -1};
+	WorkItem resubmittedWorkItem {resubmitOnce, &resubmitContext};
+	resubmitContext.workItem = &resubmittedWorkItem;
+
+	int rets[3] {-1, -1, -1};
+	auto softwareTimer = makeStaticSoftwareTimer(
+			[&workQueue, &workItem, &resubmittedWorkItem, &rets]()
+			{
+				rets[0] = workQueue.submit(workItem);
+				rets[1] = workQueue.submit(workItem);
+				rets[2] = workQueue.submit(resubmittedWorkItem);
+			});
+
+	waitForNextTick();
+	const auto wakeUpTimePoint = TickClock::now() + singleDuration;
+	softwareTimer.start(wakeUpTimePoint);
+
+	ThisThread::sleepUntil(wakeUpTimePoint + singleDuration);
+
+	const auto invalidState = rets[0] != 0 || rets[1] != EALREADY || rets[2] != 0 ||
+			sequenceAsserter.assertSequence(1) == false || resubmitContext.executions != 2 || resubmitContext.ret != 0;
+
+	if (stopWorkQueue(workQueue) == false)
+		return false;
+
+	return invalidState == false;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool WorkQueueOperationsTestCase::run_() const
+{
+	for (const auto& function : {phase1, phase2})
+	{
+		const auto ret = function();
+		if (ret != true)
+			return ret;
+	}
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief WorkQueueOperationsTestCase class header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_WORKQUEUE_WORKQUEUEOPERATIONSTESTCASE_HPP_
+#define TEST_WORKQUEUE_WORKQUEUEOPERATIONSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests various work queue operations.
+ *
+ * Tests FIFO order of execution, coalescing of submissions of work item which is already queued, cancellation of queued
+ * work items, submission from interrupt context and re-submission of work item during its execution.
+ */
+
+class WorkQueueOperationsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_WORKQUEUE_WORKQUEUEOPERATIONSTESTCASE_HPP_
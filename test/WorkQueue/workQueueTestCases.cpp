@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief workQueueTestCases object definition
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "workQueueTestCases.hpp"
+
+#include "RunToCompletionTaskTestCase.hpp"
+#include "WorkQueueOperationsTestCase.hpp"
+
+#include "TestCaseGroup.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// WorkQueueOperationsTestCase instance
+const WorkQueueOperationsTestCase operationsTestCase;
+
+/// RunToCompletionTaskTestCase instance
+const RunToCompletionTaskTestCase runToCompletionTaskTestCase;
+
+/// array with references to TestCase objects related to work queues
+const TestCaseGroup::Range::value_type workQueueTestCases_[]
+{
+		TestCaseGroup::Range::value_type{operationsTestCase},
+		TestCaseGroup::Range::value_type{runToCompletionTaskTestCase},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const TestCaseGroup workQueueTestCases {TestCaseGroup::Range{workQueueTestCases_}};
+
+}	// namespace test
+
+}	// namespace distortos
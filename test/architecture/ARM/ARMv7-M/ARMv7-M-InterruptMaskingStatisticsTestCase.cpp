@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \brief InterruptMaskingStatisticsTestCase class implementation for ARMv7-M
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ARMv7-M-InterruptMaskingStatisticsTestCase.hpp"
+
+#include "distortos/distortosConfiguration.h"
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+#include "distortos/architecture/getCycleCounter.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/InterruptMaskingStatistics.hpp"
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+namespace distortos
+{
+
+namespace test
+{
+
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of iterations of busy loop executed in masked section, each iteration takes at least one cycle
+constexpr uint32_t loopIterations {10000};
+
+}	// namespace
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool InterruptMaskingStatisticsTestCase::run_() const
+{
+#if CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+	InterruptMaskingStatistics::reset();
+
+	const auto start = architecture::getCycleCounter();
+
+	{
+		const InterruptMaskingLock interruptMaskingLock;
+
+		volatile uint32_t counter {};
+		while (counter < loopIterations)
+			++counter;
+
+		{
+			// nested masking must not start new section
+			const InterruptMaskingLock nestedInterruptMaskingLock;
+		}
+	}
+
+	const auto maxDuration = architecture::getCycleCounter() - start;
+	const auto snapshot = InterruptMaskingStatistics::getSnapshot();
+
+	const auto& longestSection = snapshot.longestSections[0];
+	if (longestSection.returnAddress == nullptr || longestSection.duration < loopIterations ||
+			longestSection.duration > maxDuration)
+		return false;
+
+	for (size_t i {1}; i < InterruptMaskingStatistics::longestSectionsSize; ++i)
+		if (snapshot.longestSections[i].duration > snapshot.longestSections[i - 1].duration)
+			return false;
+
+	uint64_t histogramSum {};
+	for (const auto count : snapshot.histogram)
+		histogramSum += count;
+
+	if (snapshot.sectionCount == 0 || histogramSum != snapshot.sectionCount)
+		return false;
+
+#endif	// CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE == 1
+
+	return true;
+}
+
+}	// namespace test
+
+}	// namespace distortos
@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief InterruptMaskingStatisticsTestCase class header for ARMv7-M
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TEST_ARCHITECTURE_ARM_ARMV7_M_ARMV7_M_INTERRUPTMASKINGSTATISTICSTESTCASE_HPP_
+#define TEST_ARCHITECTURE_ARM_ARMV7_M_ARMV7_M_INTERRUPTMASKINGSTATISTICSTESTCASE_HPP_
+
+#include "TestCaseCommon.hpp"
+
+namespace distortos
+{
+
+namespace test
+{
+
+/**
+ * \brief Tests InterruptMaskingStatistics.
+ *
+ * Executes nested interrupt masked sections of known minimal length and checks whether the outer section was recorded
+ * as a whole, whether its duration is consistent with cycle counter read outside of the section and whether histogram
+ * is consistent with the number of sections. When CONFIG_INTERRUPT_MASKING_STATISTICS_ENABLE is not selected, this test
+ * case does nothing.
+ */
+
+class InterruptMaskingStatisticsTestCase : public TestCaseCommon
+{
+private:
+
+	/**
+	 * \brief Runs the test case.
+	 *
+	 * \return true if the test case succeeded, false otherwise
+	 */
+
+	bool run_() const override;
+};
+
+}	// namespace test
+
+}	// namespace distortos
+
+#endif	// TEST_ARCHITECTURE_ARM_ARMV7_M_ARMV7_M_INTERRUPTMASKINGSTATISTICSTESTCASE_HPP_
@@ -14,6 +14,7 @@ if(CONFIG_ARCHITECTURE_ARMV7_M)
 			${CMAKE_CURRENT_LIST_DIR}/ARMv7-M-checkFpuRegisters.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv7-M-FpuSignalTestCase.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv7-M-FpuThreadTestCase.cpp
+			${CMAKE_CURRENT_LIST_DIR}/ARMv7-M-InterruptMaskingStatisticsTestCase.cpp
 			${CMAKE_CURRENT_LIST_DIR}/ARMv7-M-setFpuRegisters.cpp)
 
 endif()
@@ -2,7 +2,7 @@
  * \file
  * \brief testCases object definition
  *
- * \author Copyright (C) 2014-2015 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2014-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,11 +14,20 @@
 #include "Thread/threadTestCases.hpp"
 #include "SoftwareTimer/softwareTimerTestCases.hpp"
 #include "Semaphore/semaphoreTestCases.hpp"
+#include "EventFlags/eventFlagsTestCases.hpp"
+#include "Barrier/barrierTestCases.hpp"
 #include "Mutex/mutexTestCases.hpp"
+#include "SharedMutex/sharedMutexTestCases.hpp"
 #include "ConditionVariable/conditionVariableTestCases.hpp"
 #include "Queue/queueTestCases.hpp"
+#include "MessageBuffer/messageBufferTestCases.hpp"
+#include "MemoryPool/memoryPoolTestCases.hpp"
+#include "Heap/heapTestCases.hpp"
 #include "Signals/signalsTestCases.hpp"
+#include "WaitForAny/waitForAnyTestCases.hpp"
 #include "CallOnce/callOnceTestCases.hpp"
+#include "WorkQueue/workQueueTestCases.hpp"
+#include "BlockDevice/blockDeviceTestCases.hpp"
 #include "architecture/architectureTestCases.hpp"
 
 #include "TestCaseGroup.hpp"
@@ -42,11 +51,20 @@ const TestCaseGroup::Range::value_type testCases_[]
 		TestCaseGroup::Range::value_type{threadTestCases},
 		TestCaseGroup::Range::value_type{softwareTimerTestCases},
 		TestCaseGroup::Range::value_type{semaphoreTestCases},
+		TestCaseGroup::Range::value_type{eventFlagsTestCases},
+		TestCaseGroup::Range::value_type{barrierTestCases},
 		TestCaseGroup::Range::value_type{mutexTestCases},
+		TestCaseGroup::Range::value_type{sharedMutexTestCases},
 		TestCaseGroup::Range::value_type{conditionVariableTestCases},
 		TestCaseGroup::Range::value_type{queueTestCases},
+		TestCaseGroup::Range::value_type{messageBufferTestCases},
+		TestCaseGroup::Range::value_type{memoryPoolTestCases},
+		TestCaseGroup::Range::value_type{heapTestCases},
 		TestCaseGroup::Range::value_type{signalsTestCases},
+		TestCaseGroup::Range::value_type{waitForAnyTestCases},
 		TestCaseGroup::Range::value_type{callOnceTestCases},
+		TestCaseGroup::Range::value_type{workQueueTestCases},
+		TestCaseGroup::Range::value_type{blockDeviceTestCases},
 		TestCaseGroup::Range::value_type{architectureTestCases},
 };
 
@@ -0,0 +1,268 @@
+/**
+ * \file
+ * \brief EventFlags C-API test cases
+ *
+ * This test checks whether event flags C-API functions properly call appropriate functions from distortos::EventFlags
+ * class.
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/fromCApi.hpp"
+#include "distortos/EventFlags.hpp"
+#include "distortos/C-API/EventFlags.h"
+
+using trompeloeil::_;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing DISTORTOS_EVENTFLAGS_INITIALIZER()", "[initializer]")
+{
+	constexpr uint32_t randomValue {0x4f0b5a1e};
+
+	const distortos_EventFlags eventFlags = DISTORTOS_EVENTFLAGS_INITIALIZER(eventFlags, randomValue);
+	REQUIRE(eventFlags.value == randomValue);
+}
+
+TEST_CASE("Testing DISTORTOS_EVENTFLAGS_CONSTRUCT_1()", "[construct]")
+{
+	constexpr uint32_t randomValue {0x90c3d7e2};
+
+	DISTORTOS_EVENTFLAGS_CONSTRUCT_1(eventFlags, randomValue);
+	REQUIRE(eventFlags.value == randomValue);
+}
+
+TEST_CASE("Testing DISTORTOS_EVENTFLAGS_CONSTRUCT()", "[construct]")
+{
+	DISTORTOS_EVENTFLAGS_CONSTRUCT(eventFlags);
+	REQUIRE(eventFlags.value == 0);
+}
+
+TEST_CASE("Testing distortos_EventFlags_construct_1()", "[construct]")
+{
+	constexpr uint32_t randomValue {0x1a6c8e35};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	std::aligned_storage<sizeof(distortos::EventFlags), alignof(distortos::EventFlags)>::type storage;
+
+	REQUIRE(distortos_EventFlags_construct_1(nullptr, randomValue) == EINVAL);
+
+	distortos::EventFlags::getProxyInstance() = &eventFlagsMock;
+	REQUIRE_CALL(eventFlagsMock, construct(randomValue));
+	REQUIRE(distortos_EventFlags_construct_1(reinterpret_cast<distortos_EventFlags*>(&storage), randomValue) == 0);
+	distortos::EventFlags::getProxyInstance() = {};
+
+	reinterpret_cast<distortos::EventFlags*>(&storage)->~EventFlags();
+}
+
+TEST_CASE("Testing distortos_EventFlags_construct()", "[construct]")
+{
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	std::aligned_storage<sizeof(distortos::EventFlags), alignof(distortos::EventFlags)>::type storage;
+
+	REQUIRE(distortos_EventFlags_construct(nullptr) == EINVAL);
+
+	distortos::EventFlags::getProxyInstance() = &eventFlagsMock;
+	REQUIRE_CALL(eventFlagsMock, construct(0u));
+	REQUIRE(distortos_EventFlags_construct(reinterpret_cast<distortos_EventFlags*>(&storage)) == 0);
+	distortos::EventFlags::getProxyInstance() = {};
+
+	reinterpret_cast<distortos::EventFlags*>(&storage)->~EventFlags();
+}
+
+TEST_CASE("Testing distortos_EventFlags_destruct()", "[destruct]")
+{
+	distortos::FromCApiMock fromCApiMock;
+	trompeloeil::deathwatched<distortos::EventFlags> eventFlagsMock;
+	distortos_EventFlags eventFlags;
+
+	REQUIRE(distortos_EventFlags_destruct(nullptr) == EINVAL);
+
+	{
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_DESTRUCTION(eventFlagsMock);
+		REQUIRE(distortos_EventFlags_destruct(&eventFlags) == 0);
+	}
+}
+
+TEST_CASE("Testing distortos_EventFlags_clear()", "[clear]")
+{
+	constexpr uint32_t randomBitmask {0x6e1d02c4};
+	constexpr uint32_t randomValue {0xd85b7f31};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+
+	REQUIRE(distortos_EventFlags_clear(nullptr, randomBitmask, nullptr) == EINVAL);
+
+	{
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, clear(randomBitmask)).RETURN(randomValue);
+		REQUIRE(distortos_EventFlags_clear(&eventFlags, randomBitmask, nullptr) == 0);
+	}
+	{
+		uint32_t previousValue {};
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, clear(randomBitmask)).RETURN(randomValue);
+		REQUIRE(distortos_EventFlags_clear(&eventFlags, randomBitmask, &previousValue) == 0);
+		REQUIRE(previousValue == randomValue);
+	}
+}
+
+TEST_CASE("Testing distortos_EventFlags_get()", "[get]")
+{
+	constexpr uint32_t randomValue {0x2b97e640};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	const distortos_EventFlags eventFlags {};
+	uint32_t value;
+
+	REQUIRE(distortos_EventFlags_get(nullptr, nullptr) == EINVAL);
+	REQUIRE(distortos_EventFlags_get(nullptr, &value) == EINVAL);
+	REQUIRE(distortos_EventFlags_get(&eventFlags, nullptr) == EINVAL);
+
+	REQUIRE_CALL(fromCApiMock, getConstEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+	REQUIRE_CALL(eventFlagsMock, get()).RETURN(randomValue);
+	REQUIRE(distortos_EventFlags_get(&eventFlags, &value) == 0);
+	REQUIRE(value == randomValue);
+}
+
+TEST_CASE("Testing distortos_EventFlags_set()", "[set]")
+{
+	constexpr uint32_t randomBitmask {0x83e0f51a};
+	constexpr uint32_t randomValue {0x0c4a9d67};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+
+	REQUIRE(distortos_EventFlags_set(nullptr, randomBitmask, nullptr) == EINVAL);
+
+	{
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, set(randomBitmask)).RETURN(randomValue);
+		REQUIRE(distortos_EventFlags_set(&eventFlags, randomBitmask, nullptr) == 0);
+	}
+	{
+		uint32_t previousValue {};
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, set(randomBitmask)).RETURN(randomValue);
+		REQUIRE(distortos_EventFlags_set(&eventFlags, randomBitmask, &previousValue) == 0);
+		REQUIRE(previousValue == randomValue);
+	}
+}
+
+TEST_CASE("Testing distortos_EventFlags_tryWait()", "[tryWait]")
+{
+	constexpr uint32_t randomBitmask {0x5f13c2a8};
+	constexpr uint32_t randomValue {0xa7260e9b};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+	uint32_t value {};
+
+	REQUIRE(distortos_EventFlags_tryWait(nullptr, randomBitmask, distortos_EventFlags_WaitMode_any, false, &value) ==
+			EINVAL);
+	REQUIRE(distortos_EventFlags_tryWait(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all + 1, false,
+			&value) == EINVAL);
+
+	{
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, tryWait(randomBitmask, distortos::EventFlags::WaitMode::any, false))
+				.RETURN(std::make_pair(EAGAIN, randomValue));
+		REQUIRE(distortos_EventFlags_tryWait(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_any, false,
+				nullptr) == EAGAIN);
+	}
+	{
+		REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+		REQUIRE_CALL(eventFlagsMock, tryWait(randomBitmask, distortos::EventFlags::WaitMode::all, true))
+				.RETURN(std::make_pair(0, randomValue));
+		REQUIRE(distortos_EventFlags_tryWait(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all, true,
+				&value) == 0);
+		REQUIRE(value == randomValue);
+	}
+}
+
+TEST_CASE("Testing distortos_EventFlags_tryWaitFor()", "[tryWaitFor]")
+{
+	constexpr uint32_t randomBitmask {0x19d0b7e3};
+	constexpr int64_t randomDuration {0x4d2a6e0f91c3b785};
+	constexpr uint32_t randomValue {0x7c58a016};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+	uint32_t value {};
+
+	REQUIRE(distortos_EventFlags_tryWaitFor(nullptr, randomBitmask, distortos_EventFlags_WaitMode_any,
+			randomDuration, false, &value) == EINVAL);
+	REQUIRE(distortos_EventFlags_tryWaitFor(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all + 1,
+			randomDuration, false, &value) == EINVAL);
+
+	REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+	const auto duration = distortos::TickClock::duration{randomDuration};
+	REQUIRE_CALL(eventFlagsMock, tryWaitFor(randomBitmask, distortos::EventFlags::WaitMode::all, duration, true))
+			.RETURN(std::make_pair(ETIMEDOUT, randomValue));
+	REQUIRE(distortos_EventFlags_tryWaitFor(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all,
+			randomDuration, true, &value) == ETIMEDOUT);
+	REQUIRE(value == randomValue);
+}
+
+TEST_CASE("Testing distortos_EventFlags_tryWaitUntil()", "[tryWaitUntil]")
+{
+	constexpr uint32_t randomBitmask {0xe4079c5d};
+	constexpr int64_t randomTimePoint {0x2f86d13ac7e05b49};
+	constexpr uint32_t randomValue {0x38b1f4c2};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+	uint32_t value {};
+
+	REQUIRE(distortos_EventFlags_tryWaitUntil(nullptr, randomBitmask, distortos_EventFlags_WaitMode_any,
+			randomTimePoint, false, &value) == EINVAL);
+	REQUIRE(distortos_EventFlags_tryWaitUntil(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all + 1,
+			randomTimePoint, false, &value) == EINVAL);
+
+	REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+	const auto timePoint = distortos::TickClock::time_point{distortos::TickClock::duration{randomTimePoint}};
+	REQUIRE_CALL(eventFlagsMock, tryWaitUntil(randomBitmask, distortos::EventFlags::WaitMode::any, timePoint, false))
+			.RETURN(std::make_pair(ETIMEDOUT, randomValue));
+	REQUIRE(distortos_EventFlags_tryWaitUntil(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_any,
+			randomTimePoint, false, &value) == ETIMEDOUT);
+	REQUIRE(value == randomValue);
+}
+
+TEST_CASE("Testing distortos_EventFlags_wait()", "[wait]")
+{
+	constexpr uint32_t randomBitmask {0x0b6e25fa};
+	constexpr uint32_t randomValue {0xc1937d48};
+
+	distortos::FromCApiMock fromCApiMock;
+	distortos::EventFlags eventFlagsMock;
+	distortos_EventFlags eventFlags;
+	uint32_t value {};
+
+	REQUIRE(distortos_EventFlags_wait(nullptr, randomBitmask, distortos_EventFlags_WaitMode_any, false, &value) ==
+			EINVAL);
+	REQUIRE(distortos_EventFlags_wait(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_all + 1, false,
+			&value) == EINVAL);
+
+	REQUIRE_CALL(fromCApiMock, getEventFlags(_)).LR_WITH(&_1 == &eventFlags).LR_RETURN(std::ref(eventFlagsMock));
+	REQUIRE_CALL(eventFlagsMock, wait(randomBitmask, distortos::EventFlags::WaitMode::any, true))
+			.RETURN(std::make_pair(EINTR, randomValue));
+	REQUIRE(distortos_EventFlags_wait(&eventFlags, randomBitmask, distortos_EventFlags_WaitMode_any, true, &value) ==
+			EINTR);
+	REQUIRE(value == randomValue);
+}
@@ -0,0 +1,278 @@
+/**
+ * \file
+ * \brief TlsfHeap benchmark
+ *
+ * Executes the same pseudo-random sequence of allocations and deallocations with TlsfHeap and with the allocator of the
+ * host (malloc() and free()), reporting average and worst-case latency of both. For TlsfHeap it also reports
+ * fragmentation of free memory at the end of the sequence (1 - largest allocatable block / free memory) and the number
+ * of failed allocations.
+ *
+ * The results depend on the host, so this is not a pass/fail test.
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using distortos::internal::TlsfHeap;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// latency statistics of single operation
+struct Latency
+{
+	/// number of measured operations
+	uint64_t count;
+
+	/// sum of durations of all measured operations, nanoseconds
+	uint64_t total;
+
+	/// duration of the slowest operation, nanoseconds
+	uint64_t max;
+};
+
+/// results of single run of the benchmark
+struct Results
+{
+	/// latency of allocations
+	Latency allocate;
+
+	/// latency of deallocations
+	Latency free;
+
+	/// number of failed allocations
+	uint64_t failedAllocations;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of buffer used by TlsfHeap, bytes
+constexpr size_t bufferSize {4 * 1024 * 1024};
+
+/// number of operations in the sequence
+constexpr size_t operations {2000000};
+
+/// max number of blocks allocated at the same time
+constexpr size_t maxLiveBlocks {4000};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// buffer used by TlsfHeap
+alignas(TlsfHeap::alignment) uint8_t buffer[bufferSize];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Executes a function and records its duration.
+ *
+ * \tparam Function is the type of function
+ *
+ * \param [in,out] latency is a reference to latency statistics which will be updated
+ * \param [in] function is the function which will be executed
+ *
+ * \return value returned by \a function
+ */
+
+template<typename Function>
+auto measure(Latency& latency, Function function) -> decltype(function())
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto ret = function();
+	const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+			start).count();
+	++latency.count;
+	latency.total += duration;
+	if (static_cast<uint64_t>(duration) > latency.max)
+		latency.max = duration;
+	return ret;
+}
+
+/**
+ * \brief Executes pseudo-random sequence of allocations and deallocations.
+ *
+ * Sizes of blocks are mostly small with occasional large ones, life time of blocks is random. All blocks are freed at
+ * the end, except \a survivors blocks, which are left allocated and returned to the caller.
+ *
+ * \tparam Allocate is the type of allocation function
+ * \tparam Free is the type of deallocation function
+ *
+ * \param [in] allocate is the allocation function
+ * \param [in] free is the deallocation function
+ * \param [out] survivors is a reference to vector which will hold blocks left allocated at the end
+ *
+ * \return results of the benchmark
+ */
+
+template<typename Allocate, typename Free>
+Results run(Allocate allocate, Free free, std::vector<void*>& survivors)
+{
+	std::mt19937 generator {0x6d1b0c43};
+	std::uniform_int_distribution<size_t> smallSizeDistribution {1, 256};
+	std::uniform_int_distribution<size_t> largeSizeDistribution {257, 16384};
+	std::uniform_int_distribution<int> percentDistribution {0, 99};
+
+	Results results {};
+	std::vector<void*> blocks;
+	blocks.reserve(maxLiveBlocks);
+
+	for (size_t i {}; i < operations; ++i)
+	{
+		if (blocks.size() < maxLiveBlocks && (blocks.empty() == true || percentDistribution(generator) < 50))
+		{
+			const auto size = percentDistribution(generator) < 90 ? smallSizeDistribution(generator) :
+					largeSizeDistribution(generator);
+			const auto memory = measure(results.allocate,
+					[allocate, size]()
+					{
+						return allocate(size);
+					});
+			if (memory != nullptr)
+				blocks.push_back(memory);
+			else
+				++results.failedAllocations;
+		}
+		else
+		{
+			const auto index = std::uniform_int_distribution<size_t>{0, blocks.size() - 1}(generator);
+			const auto memory = blocks[index];
+			blocks[index] = blocks.back();
+			blocks.pop_back();
+			measure(results.free,
+					[free, memory]()
+					{
+						free(memory);
+						return 0;
+					});
+		}
+	}
+
+	// every tenth block survives - this is the fragmented state of a long-running application
+	for (size_t i {}; i < blocks.size(); ++i)
+		if (i % 10 == 0)
+			survivors.push_back(blocks[i]);
+		else
+			free(blocks[i]);
+
+	return results;
+}
+
+/**
+ * \brief Finds the largest block which can be allocated from the heap.
+ *
+ * \param [in] heap is a reference to TlsfHeap object
+ *
+ * \return size of the largest block which can be allocated, bytes
+ */
+
+size_t findLargestAllocation(TlsfHeap& heap)
+{
+	size_t low {};
+	size_t high {heap.getSize()};
+	while (low < high)
+	{
+		const auto middle = low + (high - low + 1) / 2;
+		const auto memory = heap.allocate(middle);
+		if (memory != nullptr)
+		{
+			heap.free(memory);
+			low = middle;
+		}
+		else
+			high = middle - 1;
+	}
+
+	return low;
+}
+
+/**
+ * \brief Prints results of the benchmark.
+ *
+ * \param [in] name is the name of allocator
+ * \param [in] results is a reference to results of the benchmark
+ */
+
+void print(const char* const name, const Results& results)
+{
+	printf("%-8s allocate: average %6" PRIu64 " ns, max %8" PRIu64 " ns; free: average %6" PRIu64 " ns, max %8" PRIu64
+			" ns; failed allocations: %" PRIu64 "\n", name, results.allocate.total / results.allocate.count,
+			results.allocate.max, results.free.total / results.free.count, results.free.max,
+			results.failedAllocations);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	// touch whole buffer, so that page faults of the host don't influence the results
+	memset(buffer, 0, sizeof(buffer));
+
+	static TlsfHeap heap;
+	if (heap.initialize(buffer, bufferSize) != 0)
+		return EXIT_FAILURE;
+
+	std::vector<void*> tlsfSurvivors;
+	const auto tlsfResults = run(
+			[](const size_t size)
+			{
+				return heap.allocate(size);
+			},
+			[](void* const memory)
+			{
+				heap.free(memory);
+			}, tlsfSurvivors);
+
+	std::vector<void*> mallocSurvivors;
+	const auto mallocResults = run(
+			[](const size_t size)
+			{
+				return malloc(size);
+			},
+			[](void* const memory)
+			{
+				free(memory);
+			}, mallocSurvivors);
+
+	print("TlsfHeap", tlsfResults);
+	print("malloc", mallocResults);
+
+	const auto freeSize = heap.getSize() - heap.getUsedSize();
+	const auto largestAllocation = findLargestAllocation(heap);
+	printf("TlsfHeap fragmentation with %zu surviving blocks: %zu bytes used, %zu bytes free, largest allocation %zu "
+			"bytes, fragmentation %.3f\n", tlsfSurvivors.size(), heap.getUsedSize(), freeSize, largestAllocation,
+			1 - static_cast<double>(largestAllocation) / freeSize);
+
+	for (const auto memory : tlsfSurvivors)
+		heap.free(memory);
+	for (const auto memory : mallocSurvivors)
+		free(memory);
+
+	return heap.getUsedSize() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,404 @@
+/**
+ * \file
+ * \brief TlsfHeap test cases
+ *
+ * This test checks whether TlsfHeap allocates non-overlapping, properly aligned blocks, merges freed blocks and keeps
+ * contents of blocks intact during reallocation.
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "distortos/internal/memory/TlsfHeap.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <cstring>
+
+using distortos::internal::TlsfHeap;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// allocated block with its size and fill pattern
+struct Allocation
+{
+	/// pointer to allocated block
+	uint8_t* memory;
+
+	/// requested size of block, bytes
+	size_t size;
+
+	/// value used to fill the block
+	uint8_t pattern;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of buffer used by the heap, bytes
+constexpr size_t bufferSize {256 * 1024};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// buffer used by the heap
+alignas(TlsfHeap::alignment) uint8_t buffer[bufferSize];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks whether whole block is filled with its pattern.
+ *
+ * \param [in] allocation is a reference to checked allocation
+ *
+ * \return true if whole block is filled with its pattern, false otherwise
+ */
+
+bool checkPattern(const Allocation& allocation)
+{
+	for (size_t i {}; i < allocation.size; ++i)
+		if (allocation.memory[i] != allocation.pattern)
+			return false;
+
+	return true;
+}
+
+/**
+ * \brief Checks whether given pointer is aligned.
+ *
+ * \param [in] memory is the checked pointer
+ * \param [in] alignment is the required alignment
+ *
+ * \return true if \a memory is aligned to \a alignment, false otherwise
+ */
+
+bool isAligned(const void* const memory, const size_t alignment)
+{
+	return reinterpret_cast<uintptr_t>(memory) % alignment == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing initialize()", "[initialize]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.getSize() == 0);
+	REQUIRE(heap.initialize(buffer, 0) == EINVAL);
+	REQUIRE(heap.initialize(buffer, TlsfHeap::alignment) == EINVAL);
+
+	REQUIRE(heap.initialize(buffer + 1, bufferSize - 1) == 0);
+	REQUIRE(heap.getSize() <= bufferSize - TlsfHeap::alignment);
+	REQUIRE(heap.getUsedSize() == 0);
+
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+	REQUIRE(heap.getSize() == bufferSize);
+	REQUIRE(heap.getUsedSize() == 0);
+}
+
+TEST_CASE("Testing allocate() and free()", "[allocate][free]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+
+	const auto first = heap.allocate(1);
+	REQUIRE(first != nullptr);
+	heap.free(first);
+	REQUIRE(heap.getUsedSize() == 0);
+
+	SECTION("Blocks are aligned, non-overlapping and have requested size")
+	{
+		std::vector<Allocation> allocations;
+		for (size_t size {}; size < 1000; size += 7)
+		{
+			const auto memory = static_cast<uint8_t*>(heap.allocate(size));
+			REQUIRE(memory != nullptr);
+			REQUIRE(isAligned(memory, TlsfHeap::alignment) == true);
+			REQUIRE(TlsfHeap::getUsableSize(memory) >= size);
+			const auto pattern = static_cast<uint8_t>(allocations.size());
+			memset(memory, pattern, size);
+			allocations.push_back({memory, size, pattern});
+		}
+
+		for (const auto& allocation : allocations)
+			REQUIRE(checkPattern(allocation) == true);
+
+		for (const auto& allocation : allocations)
+			heap.free(allocation.memory);
+	}
+	SECTION("Too large and unsatisfiable requests fail")
+	{
+		REQUIRE(heap.allocate(TlsfHeap::maxAllocationSize + 1) == nullptr);
+		REQUIRE(heap.allocate(SIZE_MAX) == nullptr);
+		REQUIRE(heap.allocate(bufferSize) == nullptr);
+		REQUIRE(heap.getUsedSize() == 0);
+	}
+	SECTION("Heap can be exhausted")
+	{
+		std::vector<void*> allocations;
+		void* memory;
+		while ((memory = heap.allocate(1000)) != nullptr)
+			allocations.push_back(memory);
+
+		REQUIRE(allocations.size() >= bufferSize / 1100);
+		REQUIRE(allocations.size() <= bufferSize / 1000);
+
+		for (const auto allocation : allocations)
+			heap.free(allocation);
+	}
+	SECTION("Freed blocks are merged")
+	{
+		// three blocks spanning whole heap, freed in order which requires merging with both neighbours
+		const auto size = bufferSize / 4;
+		const auto a = heap.allocate(size);
+		const auto b = heap.allocate(size);
+		const auto c = heap.allocate(size);
+		REQUIRE(a != nullptr);
+		REQUIRE(b != nullptr);
+		REQUIRE(c != nullptr);
+		heap.free(a);
+		heap.free(c);
+		REQUIRE(heap.allocate(size * 2) == nullptr);
+		heap.free(b);
+		const auto d = heap.allocate(size * 2);
+		REQUIRE(d != nullptr);
+		heap.free(d);
+	}
+
+	// after freeing everything, the heap is a single free block again
+	REQUIRE(heap.getUsedSize() == 0);
+	REQUIRE(heap.allocate(1) == first);
+}
+
+TEST_CASE("Testing allocateAligned()", "[allocateAligned]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+
+	const auto first = heap.allocate(1);
+	REQUIRE(first != nullptr);
+	heap.free(first);
+
+	REQUIRE(heap.allocateAligned(0, 1) == nullptr);
+	REQUIRE(heap.allocateAligned(3, 1) == nullptr);
+	REQUIRE(heap.allocateAligned(TlsfHeap::alignment * 3, 1) == nullptr);
+
+	std::vector<Allocation> allocations;
+	for (size_t alignment {1}; alignment <= 4096; alignment *= 2)
+		for (size_t size {1}; size < 200; size += 50)
+		{
+			const auto memory = static_cast<uint8_t*>(heap.allocateAligned(alignment, size));
+			REQUIRE(memory != nullptr);
+			REQUIRE(isAligned(memory, alignment) == true);
+			REQUIRE(isAligned(memory, TlsfHeap::alignment) == true);
+			REQUIRE(TlsfHeap::getUsableSize(memory) >= size);
+			const auto pattern = static_cast<uint8_t>(allocations.size() + 1);
+			memset(memory, pattern, size);
+			allocations.push_back({memory, size, pattern});
+		}
+
+	for (const auto& allocation : allocations)
+		REQUIRE(checkPattern(allocation) == true);
+
+	for (const auto& allocation : allocations)
+		heap.free(allocation.memory);
+
+	REQUIRE(heap.getUsedSize() == 0);
+	REQUIRE(heap.allocate(1) == first);
+}
+
+TEST_CASE("Testing reallocate()", "[reallocate]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+
+	SECTION("nullptr is equivalent to allocate(), 0 is equivalent to free()")
+	{
+		const auto memory = heap.reallocate(nullptr, 100);
+		REQUIRE(memory != nullptr);
+		REQUIRE(heap.getUsedSize() != 0);
+		REQUIRE(heap.reallocate(memory, 0) == nullptr);
+	}
+	SECTION("Block is resized in place when possible")
+	{
+		const auto memory = static_cast<uint8_t*>(heap.allocate(100));
+		REQUIRE(memory != nullptr);
+		memset(memory, 0x5a, 100);
+
+		// block is followed by free space
+		REQUIRE(heap.reallocate(memory, 1000) == memory);
+		REQUIRE(TlsfHeap::getUsableSize(memory) >= 1000);
+		REQUIRE(checkPattern({memory, 100, 0x5a}) == true);
+		REQUIRE(heap.reallocate(memory, 10) == memory);
+		REQUIRE(checkPattern({memory, 10, 0x5a}) == true);
+		heap.free(memory);
+	}
+	SECTION("Block is moved when it cannot be resized in place")
+	{
+		const auto memory = static_cast<uint8_t*>(heap.allocate(100));
+		const auto blocker = heap.allocate(100);
+		REQUIRE(memory != nullptr);
+		REQUIRE(blocker != nullptr);
+		memset(memory, 0xa5, 100);
+
+		const auto newMemory = static_cast<uint8_t*>(heap.reallocate(memory, 1000));
+		REQUIRE(newMemory != nullptr);
+		REQUIRE(newMemory != memory);
+		REQUIRE(checkPattern({newMemory, 100, 0xa5}) == true);
+
+		// failed reallocation leaves the block intact
+		REQUIRE(heap.reallocate(newMemory, bufferSize) == nullptr);
+		REQUIRE(checkPattern({newMemory, 100, 0xa5}) == true);
+
+		heap.free(newMemory);
+		heap.free(blocker);
+	}
+
+	REQUIRE(heap.getUsedSize() == 0);
+}
+
+TEST_CASE("Testing random sequence of operations", "[random]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+
+	const auto first = heap.allocate(1);
+	REQUIRE(first != nullptr);
+	heap.free(first);
+
+	std::mt19937 generator {0x1e5c2a31};
+	std::uniform_int_distribution<size_t> sizeDistribution {0, 2048};
+	std::uniform_int_distribution<int> operationDistribution {0, 9};
+	std::vector<Allocation> allocations;
+	size_t usedSize {};
+
+	for (size_t i {}; i < 100000; ++i)
+	{
+		const auto operation = operationDistribution(generator);
+		if (allocations.empty() == true || operation < 5)
+		{
+			const auto size = sizeDistribution(generator);
+			const auto alignment = operation == 0 ? TlsfHeap::alignment << (i % 6) : 0;
+			const auto memory = static_cast<uint8_t*>(alignment != 0 ? heap.allocateAligned(alignment, size) :
+					heap.allocate(size));
+			if (memory == nullptr)
+				continue;
+
+			REQUIRE(isAligned(memory, alignment != 0 ? alignment : TlsfHeap::alignment) == true);
+			const auto pattern = static_cast<uint8_t>(i);
+			memset(memory, pattern, size);
+			allocations.push_back({memory, size, pattern});
+			usedSize += TlsfHeap::getUsableSize(memory);
+		}
+		else
+		{
+			const auto index = std::uniform_int_distribution<size_t>{0, allocations.size() - 1}(generator);
+			auto& allocation = allocations[index];
+			REQUIRE(checkPattern(allocation) == true);
+			usedSize -= TlsfHeap::getUsableSize(allocation.memory);
+
+			if (operation < 8)
+			{
+				heap.free(allocation.memory);
+				allocation = allocations.back();
+				allocations.pop_back();
+			}
+			else
+			{
+				const auto size = sizeDistribution(generator) + 1;
+				const auto memory = static_cast<uint8_t*>(heap.reallocate(allocation.memory, size));
+				if (memory != nullptr)
+				{
+					allocation.memory = memory;
+					allocation.size = std::min(allocation.size, size);
+				}
+				REQUIRE(checkPattern(allocation) == true);
+				usedSize += TlsfHeap::getUsableSize(allocation.memory);
+			}
+		}
+
+		REQUIRE(heap.getUsedSize() == usedSize);
+	}
+
+	for (const auto& allocation : allocations)
+	{
+		REQUIRE(checkPattern(allocation) == true);
+		heap.free(allocation.memory);
+	}
+
+	REQUIRE(heap.getUsedSize() == 0);
+	REQUIRE(heap.allocate(1) == first);
+}
+
+TEST_CASE("Testing statistics", "[statistics]")
+{
+	TlsfHeap heap;
+	REQUIRE(heap.initialize(buffer, bufferSize) == 0);
+
+	{
+		const auto summary = heap.summarizeFreeBlocks();
+		REQUIRE(summary.count == 1);
+		REQUIRE(summary.largestSize == summary.totalSize);
+		REQUIRE(summary.totalSize < bufferSize);
+	}
+
+	void* allocations[8];
+	for (auto& allocation : allocations)
+	{
+		allocation = heap.allocate(1000);
+		REQUIRE(allocation != nullptr);
+	}
+
+	REQUIRE(heap.allocate(bufferSize) == nullptr);
+	REQUIRE(heap.getAllocationCount() == 8);
+	REQUIRE(heap.getFailedAllocationCount() == 1);
+	REQUIRE(heap.getFreeCount() == 0);
+	const auto maxUsedSize = heap.getUsedSize();
+	REQUIRE(heap.getMaxUsedSize() == maxUsedSize);
+
+	// free every other block - freed blocks cannot be merged
+	for (size_t i {}; i < 8; i += 2)
+		heap.free(allocations[i]);
+
+	{
+		const auto summary = heap.summarizeFreeBlocks();
+		REQUIRE(summary.count == 5);
+		REQUIRE(summary.largestSize < summary.totalSize);
+	}
+
+	REQUIRE(heap.getFreeCount() == 4);
+	REQUIRE(heap.getUsedSize() == maxUsedSize / 2);
+	REQUIRE(heap.getMaxUsedSize() == maxUsedSize);
+
+	heap.resetStatistics();
+	REQUIRE(heap.getAllocationCount() == 0);
+	REQUIRE(heap.getFailedAllocationCount() == 0);
+	REQUIRE(heap.getFreeCount() == 0);
+	REQUIRE(heap.getMaxUsedSize() == maxUsedSize / 2);
+
+	for (size_t i {1}; i < 8; i += 2)
+		heap.free(allocations[i]);
+
+	REQUIRE(heap.getFreeCount() == 4);
+	REQUIRE(heap.getUsedSize() == 0);
+	REQUIRE(heap.summarizeFreeBlocks().count == 1);
+}
@@ -0,0 +1,204 @@
+/**
+ * \file
+ * \brief estd::InplaceFunction test cases
+ *
+ * This test checks whether estd::InplaceFunction calls its target with forwarded arguments, supports move-only
+ * targets, transfers the target on move and destroys it exactly once.
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "estd/InplaceFunction.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// InplaceFunction with capacity large enough for all targets used in tests
+template<typename Signature>
+using TestFunction = estd::InplaceFunction<Signature, 4 * sizeof(void*)>;
+
+/// functor which counts its live instances
+class CountingFunctor
+{
+public:
+
+	/**
+	 * \brief CountingFunctor's constructor
+	 *
+	 * \param [in] instances is a reference to counter of live instances
+	 */
+
+	explicit CountingFunctor(int& instances) :
+			instances_{&instances}
+	{
+		++*instances_;
+	}
+
+	/**
+	 * \brief CountingFunctor's copy constructor
+	 *
+	 * \param [in] other is a reference to CountingFunctor object used as source of copy
+	 */
+
+	CountingFunctor(const CountingFunctor& other) :
+			instances_{other.instances_}
+	{
+		++*instances_;
+	}
+
+	/**
+	 * \brief CountingFunctor's destructor
+	 */
+
+	~CountingFunctor()
+	{
+		--*instances_;
+	}
+
+	/**
+	 * \return number of live instances
+	 */
+
+	int operator()() const
+	{
+		return *instances_;
+	}
+
+	CountingFunctor& operator=(const CountingFunctor&) = delete;
+
+private:
+
+	/// pointer to counter of live instances
+	int* instances_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Adds two values.
+ *
+ * \param [in] a is the first value
+ * \param [in] b is the second value
+ *
+ * \return sum of \a a and \a b
+ */
+
+int add(const int a, const int b)
+{
+	return a + b;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing empty object", "[empty]")
+{
+	TestFunction<void()> function;
+	REQUIRE(static_cast<bool>(function) == false);
+	REQUIRE(function == nullptr);
+
+	TestFunction<void()> nullFunction {nullptr};
+	REQUIRE(nullFunction == nullptr);
+
+	TestFunction<void()> movedFunction {std::move(function)};
+	REQUIRE(movedFunction == nullptr);
+}
+
+TEST_CASE("Testing calls", "[call]")
+{
+	SECTION("Function pointer")
+	{
+		TestFunction<int(int, int)> function {add};
+		REQUIRE(function != nullptr);
+		REQUIRE(function(1, 2) == 3);
+	}
+	SECTION("Lambda with captures")
+	{
+		int value {};
+		TestFunction<void(int)> function {[&value](const int increment)
+				{
+					value += increment;
+				}};
+		function(3);
+		function(4);
+		REQUIRE(value == 7);
+	}
+	SECTION("Bound function")
+	{
+		TestFunction<int()> function {std::bind(add, 5, 6)};
+		REQUIRE(function() == 11);
+	}
+	SECTION("Reference argument")
+	{
+		TestFunction<void(int&)> function {[](int& value)
+				{
+					value = 8;
+				}};
+		int value {};
+		function(value);
+		REQUIRE(value == 8);
+	}
+	SECTION("Move-only target and argument")
+	{
+		std::unique_ptr<int> pointer {new int{9}};
+		TestFunction<int(std::unique_ptr<int>)> function {[pointer = std::move(pointer)](std::unique_ptr<int> other)
+				{
+					return *pointer + *other;
+				}};
+		REQUIRE(function(std::unique_ptr<int>{new int{10}}) == 19);
+	}
+}
+
+TEST_CASE("Testing lifetime of target", "[lifetime]")
+{
+	int instances {};
+
+	{
+		TestFunction<int()> function {CountingFunctor{instances}};
+		REQUIRE(instances == 1);
+		REQUIRE(function() == 1);
+
+		SECTION("Move construction transfers the target")
+		{
+			TestFunction<int()> movedFunction {std::move(function)};
+			REQUIRE(instances == 1);
+			REQUIRE(function == nullptr);
+			REQUIRE(movedFunction() == 1);
+		}
+		SECTION("Move assignment destroys previous target")
+		{
+			TestFunction<int()> otherFunction {CountingFunctor{instances}};
+			REQUIRE(instances == 2);
+			otherFunction = std::move(function);
+			REQUIRE(instances == 1);
+			REQUIRE(function == nullptr);
+			REQUIRE(otherFunction() == 1);
+		}
+		SECTION("Assignment of nullptr destroys the target")
+		{
+			function = nullptr;
+			REQUIRE(instances == 0);
+			REQUIRE(function == nullptr);
+		}
+	}
+
+	REQUIRE(instances == 0);
+}
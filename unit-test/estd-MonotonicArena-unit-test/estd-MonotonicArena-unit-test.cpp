@@ -0,0 +1,183 @@
+/**
+ * \file
+ * \brief estd::MonotonicArena test cases
+ *
+ * This test checks whether estd::MonotonicArena allocates non-overlapping, properly aligned blocks in fixed-size and
+ * chained variants, frees everything with reset() and can be used with standard containers via
+ * estd::MonotonicArenaAllocator.
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "unit-test-common.hpp"
+
+#include "estd/MonotonicArenaAllocator.hpp"
+#include "estd/StaticMonotonicArena.hpp"
+
+#include <list>
+#include <vector>
+
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of buffer used by the arena, bytes
+constexpr size_t bufferSize {256};
+
+/// minimal size of additional blocks, bytes
+constexpr size_t blockSize {128};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks whether given pointer is inside buffer.
+ *
+ * \param [in] memory is the checked pointer
+ * \param [in] buffer is a pointer to beginning of buffer
+ * \param [in] size is the size of buffer, bytes
+ *
+ * \return true if \a memory is inside buffer, false otherwise
+ */
+
+bool isInside(const void* const memory, const void* const buffer, const size_t size)
+{
+	const auto address = reinterpret_cast<uintptr_t>(memory);
+	const auto begin = reinterpret_cast<uintptr_t>(buffer);
+	return address >= begin && address < begin + size;
+}
+
+/**
+ * \brief Checks whether given pointer is aligned.
+ *
+ * \param [in] memory is the checked pointer
+ * \param [in] alignment is the required alignment
+ *
+ * \return true if \a memory is aligned to \a alignment, false otherwise
+ */
+
+bool isAligned(const void* const memory, const size_t alignment)
+{
+	return reinterpret_cast<uintptr_t>(memory) % alignment == 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global test cases
++---------------------------------------------------------------------------------------------------------------------*/
+
+TEST_CASE("Testing fixed-size variant", "[fixed]")
+{
+	estd::StaticMonotonicArena<bufferSize> arena;
+	REQUIRE(arena.getRemainingSize() == bufferSize);
+
+	const auto first = static_cast<uint8_t*>(arena.allocate(1));
+	REQUIRE(first != nullptr);
+	REQUIRE(isAligned(first, estd::MonotonicArena::defaultAlignment) == true);
+
+	SECTION("Blocks are aligned and consecutive")
+	{
+		const auto second = static_cast<uint8_t*>(arena.allocate(3, 1));
+		REQUIRE(second == first + 1);
+		const auto third = arena.allocate(8, 8);
+		REQUIRE(third != nullptr);
+		REQUIRE(isAligned(third, 8) == true);
+		REQUIRE(static_cast<uint8_t*>(third) >= second + 3);
+	}
+	SECTION("Arena can be exhausted")
+	{
+		size_t count {1};
+		while (arena.allocate(1, 1) != nullptr)
+			++count;
+
+		REQUIRE(count == bufferSize);
+		REQUIRE(arena.getRemainingSize() == 0);
+		REQUIRE(arena.allocate(bufferSize) == nullptr);
+	}
+	SECTION("Too large request fails")
+	{
+		REQUIRE(arena.allocate(bufferSize) == nullptr);
+		REQUIRE(arena.allocate(SIZE_MAX) == nullptr);
+		REQUIRE(arena.getRemainingSize() == bufferSize - 1);
+	}
+
+	// after reset, allocation starts from the beginning of buffer again
+	arena.reset();
+	REQUIRE(arena.getRemainingSize() == bufferSize);
+	REQUIRE(arena.allocate(1) == first);
+}
+
+TEST_CASE("Testing chained variant", "[chained]")
+{
+	alignas(estd::MonotonicArena::defaultAlignment) uint8_t buffer[bufferSize];
+	estd::MonotonicArena arena {buffer, sizeof(buffer), blockSize};
+
+	const auto first = arena.allocate(bufferSize);
+	REQUIRE(first == buffer);
+
+	SECTION("Small requests are served from additional blocks")
+	{
+		const auto second = arena.allocate(blockSize / 4);
+		REQUIRE(second != nullptr);
+		REQUIRE(isInside(second, buffer, sizeof(buffer)) == false);
+		const auto third = arena.allocate(blockSize / 4);
+		REQUIRE(static_cast<uint8_t*>(third) == static_cast<uint8_t*>(second) + blockSize / 4);
+	}
+	SECTION("Requests larger than block size get dedicated blocks")
+	{
+		const auto second = static_cast<uint8_t*>(arena.allocate(blockSize * 4, 64));
+		REQUIRE(second != nullptr);
+		REQUIRE(isAligned(second, 64) == true);
+		memset(second, 0x5a, blockSize * 4);
+	}
+	SECTION("Unsatisfiable request fails")
+	{
+		REQUIRE(arena.allocate(SIZE_MAX) == nullptr);
+	}
+
+	arena.reset();
+	REQUIRE(arena.getRemainingSize() == bufferSize);
+	REQUIRE(arena.allocate(1) == buffer);
+}
+
+TEST_CASE("Testing MonotonicArenaAllocator", "[allocator]")
+{
+	estd::StaticMonotonicArena<bufferSize, blockSize> arena;
+	estd::MonotonicArenaAllocator<int> allocator {arena};
+	estd::MonotonicArenaAllocator<char> otherAllocator {allocator};
+	estd::StaticMonotonicArena<bufferSize> otherArena;
+	REQUIRE(allocator == otherAllocator);
+	REQUIRE(allocator != estd::MonotonicArenaAllocator<int>{otherArena});
+
+	{
+		std::vector<int, estd::MonotonicArenaAllocator<int>> vector {allocator};
+		for (int i {}; i < 100; ++i)
+			vector.push_back(i);
+
+		std::list<int, estd::MonotonicArenaAllocator<int>> list {allocator};
+		for (int i {}; i < 100; ++i)
+			list.push_back(i);
+
+		int i {};
+		for (const auto value : vector)
+			REQUIRE(value == i++);
+
+		i = {};
+		for (const auto value : list)
+			REQUIRE(value == i++);
+	}
+
+	arena.reset();
+	REQUIRE(arena.getRemainingSize() == bufferSize);
+}
@@ -2,7 +2,7 @@
  * \file
  * \brief Mocks of fromCApi()
  *
- * \author Copyright (C) 2017 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ * \author Copyright (C) 2017-2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -18,6 +18,10 @@
 #include "distortos/C-API/ConditionVariable.h"
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_INCLUDE_CONDITIONVARIABLE
 
+#ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_INCLUDE_EVENTFLAGS
+#include "distortos/C-API/EventFlags.h"
+#endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_INCLUDE_EVENTFLAGS
+
 #ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_INCLUDE_MUTEX
 #include "distortos/C-API/Mutex.h"
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_INCLUDE_MUTEX
@@ -33,6 +37,10 @@ extern "C"
 struct distortos_ConditionVariable;
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_CONDITIONVARIABLE
 
+#ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+struct distortos_EventFlags;
+#endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
 #ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
 struct distortos_Mutex;
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
@@ -50,6 +58,10 @@ namespace distortos
 class ConditionVariable;
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_CONDITIONVARIABLE
 
+#ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+class EventFlags;
+#endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
 #ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
 class Mutex;
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
@@ -82,6 +94,13 @@ public:
 
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_CONDITIONVARIABLE
 
+#ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
+	MAKE_CONST_MOCK1(getEventFlags, distortos::EventFlags&(distortos_EventFlags&));
+	MAKE_CONST_MOCK1(getConstEventFlags, const distortos::EventFlags&(const distortos_EventFlags&));
+
+#endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
 #ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
 
 	MAKE_CONST_MOCK1(getMutex, distortos::Mutex&(distortos_Mutex&));
@@ -125,6 +144,20 @@ inline static const distortos::ConditionVariable& fromCApi(const distortos_Condi
 
 #endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_CONDITIONVARIABLE
 
+#ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
+inline static distortos::EventFlags& fromCApi(distortos_EventFlags& eventFlags)
+{
+	return FromCApiMock::getInstance().getEventFlags(eventFlags);
+}
+
+inline static const distortos::EventFlags& fromCApi(const distortos_EventFlags& eventFlags)
+{
+	return FromCApiMock::getInstance().getConstEventFlags(eventFlags);
+}
+
+#endif	// def DISTORTOS_UNIT_TEST_FROMCAPIMOCK_EVENTFLAGS
+
 #ifdef DISTORTOS_UNIT_TEST_FROMCAPIMOCK_MUTEX
 
 inline static distortos::Mutex& fromCApi(distortos_Mutex& mutex)
@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \brief Mock of getMultiWaiterList.hpp header
+ *
+ * \author Copyright (C) 2018 Kamil Szczygiel http://www.distortec.com http://www.freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef UNIT_TEST_INCLUDE_MOCKS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_
+#define UNIT_TEST_INCLUDE_MOCKS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_
+
+namespace distortos
+{
+
+namespace internal
+{
+
+inline static void notifyMultiWaiters(const void*)
+{
+
+}
+
+}	// namespace internal
+
+}	// namespace distortos
+
+#endif	// UNIT_TEST_INCLUDE_MOCKS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_DISTORTOS_INTERNAL_SYNCHRONIZATION_GETMULTIWAITERLIST_HPP_